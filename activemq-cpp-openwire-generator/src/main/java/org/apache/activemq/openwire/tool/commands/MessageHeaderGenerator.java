@@ -52,7 +52,11 @@ public class MessageHeaderGenerator extends CommandHeaderGenerator {
         out.println("");
         out.println("        // Message properties, these are Marshaled and Unmarshaled from the Message");
         out.println("        // Command's marshaledProperties vector.");
-        out.println("        activemq::util::PrimitiveMap properties;");
+        out.println("        mutable activemq::util::PrimitiveMap properties;");
+        out.println("");
+        out.println("        // Indicates if the marshaledProperties of a received Message still need to be");
+        out.println("        // unmarshaled into the properties map, this is put off until they are accessed.");
+        out.println("        mutable bool propertiesUnmarshalPending;");
         out.println("");
         out.println("        // Indicates if the Message Properties are Read Only");
         out.println("        bool readOnlyProperties;");
@@ -60,6 +64,12 @@ public class MessageHeaderGenerator extends CommandHeaderGenerator {
         out.println("        // Indicates if the Message Body are Read Only");
         out.println("        bool readOnlyBody;");
         out.println("");
+        out.println("        /**");
+        out.println("         * Unmarshals the marshaledProperties of a received Message into the");
+        out.println("         * properties map the first time the properties are accessed.");
+        out.println("         */");
+        out.println("        void unmarshalProperties() const;");
+        out.println("");
         out.println("    protected:");
         out.println("");
         out.println("        core::ActiveMQConnection* connection;");
@@ -170,9 +180,15 @@ public class MessageHeaderGenerator extends CommandHeaderGenerator {
         out.println("         * @return a reference to the Primitive Map that holds message properties.");
         out.println("         */");
         out.println("        util::PrimitiveMap& getMessageProperties() {");
+        out.println("            if (this->propertiesUnmarshalPending) {");
+        out.println("                this->unmarshalProperties();");
+        out.println("            }");
         out.println("            return this->properties;");
         out.println("        }");
         out.println("        const util::PrimitiveMap& getMessageProperties() const {");
+        out.println("            if (this->propertiesUnmarshalPending) {");
+        out.println("                this->unmarshalProperties();");
+        out.println("            }");
         out.println("            return this->properties;");
         out.println("        }");
         out.println("");
@@ -37,6 +37,7 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         result.append(super.generateInitializerList());
         result.append(", ackHandler(NULL)");
         result.append(", properties()");
+        result.append(", propertiesUnmarshalPending(false)");
         result.append(", readOnlyProperties(false)");
         result.append(", readOnlyBody(false)");
         result.append(", connection(NULL)");
@@ -48,6 +49,7 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         super.generateCopyDataStructureBody(out);
 
         out.println("    this->properties.copy(srcPtr->properties);");
+        out.println("    this->propertiesUnmarshalPending = srcPtr->propertiesUnmarshalPending;");
         out.println("    this->setAckHandler(srcPtr->getAckHandler());");
         out.println("    this->setReadOnlyBody(srcPtr->isReadOnlyBody());");
         out.println("    this->setReadOnlyProperties(srcPtr->isReadOnlyProperties());");
@@ -65,7 +67,7 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         out.println("        return false;");
         out.println("    }");
         out.println("");
-        out.println("    if (!properties.equals(valuePtr->properties)) {");
+        out.println("    if (!getMessageProperties().equals(valuePtr->getMessageProperties())) {");
         out.println("        return false;");
         out.println("    }");
         out.println("");
@@ -112,6 +114,13 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         out.println("void Message::beforeMarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {");
         out.println("");
         out.println("    try {");
+        out.println("");
+        out.println("        // Properties that were never unmarshaled can't have changed, so the");
+        out.println("        // marshaled form that arrived with the Message is sent as is.");
+        out.println("        if (propertiesUnmarshalPending) {");
+        out.println("            return;");
+        out.println("        }");
+        out.println("");
         out.println("        marshalledProperties.clear();");
         out.println("        if (!properties.isEmpty()) {");
         out.println("            wireformat::openwire::marshal::PrimitiveTypesMarshaller::marshal(");
@@ -126,9 +135,17 @@ public class MessageSourceGenerator extends CommandSourceGenerator {
         out.println("////////////////////////////////////////////////////////////////////////////////");
         out.println("void Message::afterUnmarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {");
         out.println("");
+        out.println("    this->properties.clear();");
+        out.println("    this->propertiesUnmarshalPending = !marshalledProperties.empty();");
+        out.println("}");
+        out.println("");
+        out.println("////////////////////////////////////////////////////////////////////////////////");
+        out.println("void Message::unmarshalProperties() const {");
+        out.println("");
         out.println("    try {");
         out.println("        wireformat::openwire::marshal::PrimitiveTypesMarshaller::unmarshal(");
         out.println("            &properties, marshalledProperties);");
+        out.println("        this->propertiesUnmarshalPending = false;");
         out.println("    }");
         out.println("    AMQ_CATCH_RETHROW(decaf::io::IOException)");
         out.println("    AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)");
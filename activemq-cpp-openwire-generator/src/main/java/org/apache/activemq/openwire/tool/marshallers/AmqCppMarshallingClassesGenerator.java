@@ -24,9 +24,13 @@ import org.codehaus.jam.JProperty;
 
 import java.io.PrintWriter;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Collections;
 import java.util.Comparator;
+import java.util.HashSet;
 import java.util.List;
+import java.util.Set;
+import java.util.TreeSet;
 
 /**
  *
@@ -34,6 +38,15 @@ import java.util.List;
  */
 public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersGenerator {
 
+    // Types marshaled for every message sent or received, the ids nested in these
+    // are handled by calling the id's marshaller directly instead of looking it up.
+    private static final Set<String> FAST_PATH_TYPES = new HashSet<String>(Arrays.asList(
+        "Message", "MessageDispatch", "MessageAck", "ProducerAck", "KeepAliveInfo", "MessageId"));
+
+    // Id types that are never subclassed so the marshaller for them is known up front.
+    private static final Set<String> FAST_PATH_IDS = new HashSet<String>(Arrays.asList(
+        "MessageId", "ProducerId", "ConsumerId"));
+
     protected String getFilePostFix() {
         return ".cpp";
     }
@@ -43,6 +56,16 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
         return className;
     }
 
+    /**
+     * Checks if the given property is an id that is marshaled using the id's own
+     * marshaller directly rather than through the OpenWireFormat marshaller table.
+     * @returns true if the property is handled by the fast path.
+     */
+    protected boolean isFastPathId(JProperty property) {
+        return FAST_PATH_TYPES.contains(jclass.getSimpleName()) &&
+               FAST_PATH_IDS.contains(property.getType().getSimpleName());
+    }
+
     /**
      * Checks if the tightMarshal1 method needs an casted version of its
      * dataStructure argument and then returns true or false to indicate this
@@ -149,6 +172,7 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
     protected void generateTightUnmarshalBodyForProperty(PrintWriter out, JProperty property, JAnnotationValue size, String indent) {
 
         String setter = property.getSetter().getSimpleName();
+        String getter = property.getGetter().getSimpleName();
         String type = property.getType().getSimpleName();
         String nativeType = toCppType(property.getType());
 
@@ -178,13 +202,18 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
                 out.println(indent + "info->" + setter + "(tightUnmarshalConstByteArray(dataIn, bs, "+ size.asInt() +"));");
             }
             else {
-                out.println(indent + "info->" + setter + "(tightUnmarshalByteArray(dataIn, bs));");
+                out.println(indent + "tightUnmarshalByteArray(dataIn, bs, info->" + getter + "());");
             }
         }
         else if( isThrowable( property.getType() ) ) {
             out.println(indent + "info->" + setter + "(Pointer<"+nativeType+">(dynamic_cast<" + nativeType + "* >(");
             out.println(indent + "    tightUnmarshalBrokerError(wireFormat, dataIn, bs))));");
         }
+        else if( isFastPathId(property) ) {
+            String method = isCachedProperty(property) ? "tightUnmarshalCachedId" : "tightUnmarshalNestedId";
+            out.println(indent + "info->" + setter + "(Pointer<"+nativeType+">(");
+            out.println(indent + "    " + method + "<" + nativeType + ", " + nativeType + "Marshaller>(wireFormat, dataIn, bs)));");
+        }
         else if( isCachedProperty(property) ) {
             out.println(indent + "info->" + setter + "(Pointer<"+nativeType+">(dynamic_cast<" + nativeType + "* >(");
             out.println(indent + "    tightUnmarshalCachedObject(wireFormat, dataIn, bs))));");
@@ -375,6 +404,83 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
         }
     }
 
+    protected void generateTightMarshalBody(PrintWriter out) {
+
+        for ( JProperty property : getProperties() ) {
+
+            JAnnotation annotation = property.getAnnotation("openwire:property");
+            JAnnotationValue version = annotation.getValue("version");
+            JAnnotationValue size = annotation.getValue("size");
+            JClass propertyType = property.getType();
+            String type = propertyType.getSimpleName();
+            String getter = "info->" + property.getGetter().getSimpleName() + "()";
+            String indent = "        ";
+
+            if( version.asInt() > 1 ) {
+                indent = indent + "    ";
+                out.println("        if (wireVersion >= " + version.asInt() + ") {");
+            }
+
+            if (type.equals("boolean")) {
+                out.println(indent + "bs->writeBoolean(" + getter + ");");
+            }
+            else if (type.equals("byte")) {
+                out.println(indent + "dataOut->write(" + getter + ");");
+            }
+            else if (type.equals("char")) {
+                out.println(indent + "dataOut->write(" + getter + ");");
+            }
+            else if (type.equals("short")) {
+                out.println(indent + "dataOut->writeShort(" + getter + ");");
+            }
+            else if (type.equals("int")) {
+                out.println(indent + "dataOut->writeInt(" + getter + ");");
+            }
+            else if (type.equals("long")) {
+                out.println(indent + "tightMarshalLong(wireFormat, " + getter + ", dataOut, bs);");
+            }
+            else if (type.equals("String")) {
+                out.println(indent + "tightMarshalString(" + getter + ", dataOut, bs);");
+            }
+            else if (type.equals("byte[]") || type.equals("ByteSequence")) {
+                if (size != null) {
+                    out.println(indent + "dataOut->write((const unsigned char*)(&" + getter + "[0]), " + size.asInt() + ", 0, " + size.asInt() + ");");
+                }
+                else {
+                    out.println(indent + "bs->writeBoolean(" + getter + ".size() != 0);");
+                    out.println(indent + "if (" + getter + ".size() != 0) {");
+                    out.println(indent + "    dataOut->writeInt((int)" + getter + ".size() );");
+                    out.println(indent + "    dataOut->write((const unsigned char*)(&" + getter + "[0]), (int)" + getter + ".size(), 0, (int)" + getter + ".size());");
+                    out.println(indent + "}");
+                }
+            }
+            else if (propertyType.isArrayType()) {
+                if (size != null) {
+                    out.println(indent + "tightMarshalObjectArrayConstSize(wireFormat, " + getter + ", dataOut, bs, " + size.asInt() + ");");
+                }
+                else {
+                    out.println(indent + "tightMarshalObjectArray(wireFormat, " + getter + ", dataOut, bs);");
+                }
+            } else if( isThrowable(propertyType) ) {
+                out.println(indent + "tightMarshalBrokerError(wireFormat, " + getter + ".get(), dataOut, bs);");
+            } else if( isFastPathId(property) ) {
+                String method = isCachedProperty(property) ? "tightMarshalCachedId" : "tightMarshalNestedId";
+                out.println(indent + method + "<" + propertyType.getSimpleName() + "Marshaller>(wireFormat, "+getter+".get(), dataOut, bs);");
+            } else {
+                if( isCachedProperty(property) ) {
+                    out.println(indent + "tightMarshalCachedObject(wireFormat, "+getter+".get(), dataOut, bs);");
+                }
+                else {
+                    out.println(indent + "tightMarshalNestedObject(wireFormat, "+getter+".get(), dataOut, bs);");
+                }
+            }
+
+            if( version.asInt() > 1 ) {
+                out.println("        }");
+            }
+        }
+    }
+
     //////////////////////////////////////////////////////////////////////////////////////
     // This section is for the loose wire format encoding generator
     //////////////////////////////////////////////////////////////////////////////////////
@@ -412,6 +518,7 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
         String type = property.getType().getSimpleName();
         String nativeType = toCppType(property.getType());
         String setter = property.getSetter().getSimpleName();
+        String getter = property.getGetter().getSimpleName();
 
         if (type.equals("boolean")) {
             out.println(indent + "info->" + setter + "(dataIn->readBoolean());");
@@ -439,13 +546,18 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
                 out.println(indent + "info->" + setter + "(looseUnmarshalConstByteArray(dataIn, " + size.asInt() + "));");
             }
             else {
-                out.println(indent + "info->" + setter + "(looseUnmarshalByteArray(dataIn));");
+                out.println(indent + "looseUnmarshalByteArray(dataIn, info->" + getter + "());");
             }
         }
         else if (isThrowable(property.getType())) {
             out.println(indent + "info->" + setter + "(Pointer<"+nativeType+">(dynamic_cast< " + nativeType + "*>(");
             out.println(indent + "    looseUnmarshalBrokerError(wireFormat, dataIn))));");
         }
+        else if (isFastPathId(property)) {
+            String method = isCachedProperty(property) ? "looseUnmarshalCachedId" : "looseUnmarshalNestedId";
+            out.println(indent + "info->" + setter + "(Pointer<"+nativeType+">(");
+            out.println(indent + "    " + method + "<" + nativeType + ", " + nativeType + "Marshaller>(wireFormat, dataIn)));");
+        }
         else if (isCachedProperty(property)) {
             out.println(indent + "info->" + setter + "(Pointer<"+nativeType+">(dynamic_cast<" + nativeType + "*>(");
             out.println(indent + "    looseUnmarshalCachedObject(wireFormat, dataIn))));");
@@ -548,6 +660,10 @@ public class AmqCppMarshallingClassesGenerator extends AmqCppMarshallingHeadersG
             else if( isThrowable( propertyType ) ) {
                 out.println(indent + "looseMarshalBrokerError(wireFormat, " + getter + ".get(), dataOut);");
             }
+            else if( isFastPathId( property ) ) {
+                String method = isCachedProperty(property) ? "looseMarshalCachedId" : "looseMarshalNestedId";
+                out.println(indent + method + "<" + propertyType.getSimpleName() + "Marshaller>(wireFormat, "+getter+".get(), dataOut);");
+            }
             else {
                 if( isCachedProperty( property ) ) {
                     out.println(indent + "looseMarshalCachedObject(wireFormat, "+getter+".get(), dataOut);");
@@ -571,6 +687,16 @@ out.println("");
 out.println("#include <activemq/wireformat/openwire/marshal/generated/"+className+".h>");
 out.println("");
 out.println("#include <activemq/commands/"+jclass.getSimpleName()+".h>");
+
+    Set<String> fastPathIds = new TreeSet<String>();
+    for ( JProperty property : getProperties() ) {
+        if( isFastPathId(property) && !property.getType().getSimpleName().equals(jclass.getSimpleName()) ) {
+            fastPathIds.add(property.getType().getSimpleName());
+        }
+    }
+    for ( String id : fastPathIds ) {
+out.println("#include <activemq/wireformat/openwire/marshal/generated/"+id+"Marshaller.h>");
+    }
 out.println("#include <activemq/exceptions/ActiveMQException.h>");
 out.println("#include <decaf/lang/Pointer.h>");
 out.println("");
@@ -718,6 +844,43 @@ out.println("    AMQ_CATCHALL_THROW(decaf::io::IOException)" );
 out.println("}");
 out.println("");
 out.println("///////////////////////////////////////////////////////////////////////////////");
+out.println("void "+className+"::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {");
+out.println("");
+out.println("    try {");
+out.println("");
+
+    if( !properties.isEmpty() || marshallerAware ) {
+        String properClassName = getProperClassName( jclass.getSimpleName() );
+out.println("        "+properClassName+"* info =");
+out.println("            dynamic_cast<"+properClassName+"*>(dataStructure);");
+out.println("");
+    }
+
+    if( marshallerAware ) {
+out.println("        info->beforeMarshal(wireFormat);");
+    }
+
+out.println("        "+baseClass+"::tightMarshal(wireFormat, dataStructure, dataOut, bs);");
+
+    if( checkNeedsWireFormatVersion() ) {
+        out.println("");
+        out.println("        int wireVersion = wireFormat->getVersion();");
+        out.println("");
+    }
+
+    generateTightMarshalBody(out);
+
+    if( marshallerAware ) {
+out.println("        info->afterMarshal(wireFormat);");
+    }
+
+out.println("    }");
+out.println("    AMQ_CATCH_RETHROW(decaf::io::IOException)" );
+out.println("    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)" );
+out.println("    AMQ_CATCHALL_THROW(decaf::io::IOException)" );
+out.println("}");
+out.println("");
+out.println("///////////////////////////////////////////////////////////////////////////////");
 out.println("void "+className+"::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {");
 out.println("");
 out.println("    try {");
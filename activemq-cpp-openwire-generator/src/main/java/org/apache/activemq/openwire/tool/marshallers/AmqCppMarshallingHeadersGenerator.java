@@ -285,6 +285,11 @@ out.println("                                   commands::DataStructure* dataStr
 out.println("                                   decaf::io::DataOutputStream* dataOut,");
 out.println("                                   utils::BooleanStream* bs);");
 out.println("");
+out.println("        virtual void tightMarshal(OpenWireFormat* wireFormat,");
+out.println("                                  commands::DataStructure* dataStructure,");
+out.println("                                  decaf::io::DataOutputStream* dataOut,");
+out.println("                                  utils::BooleanStream* bs);");
+out.println("");
 out.println("        virtual void looseUnmarshal(OpenWireFormat* wireFormat,");
 out.println("                                    commands::DataStructure* dataStructure,");
 out.println("                                    decaf::io::DataInputStream* dataIn);");
@@ -48,7 +48,7 @@ Message::Message() :
       groupID(""), groupSequence(0), correlationId(""), persistent(false), expiration(0), priority(0), replyTo(NULL), timestamp(0), 
       type(""), content(), marshalledProperties(), dataStructure(NULL), targetConsumerId(NULL), compressed(false), redeliveryCounter(0), 
       brokerPath(), arrival(0), userID(""), recievedByDFBridge(false), droppable(false), cluster(), brokerInTime(0), brokerOutTime(0), 
-      jMSXGroupFirstForConsumer(false), ackHandler(NULL), properties(), readOnlyProperties(false), readOnlyBody(false), connection(NULL) {
+      jMSXGroupFirstForConsumer(false), ackHandler(NULL), properties(), propertiesUnmarshalPending(false), readOnlyProperties(false), readOnlyBody(false), connection(NULL) {
 
 }
 
@@ -116,6 +116,7 @@ void Message::copyDataStructure(const DataStructure* src) {
     this->setBrokerOutTime(srcPtr->getBrokerOutTime());
     this->setJMSXGroupFirstForConsumer(srcPtr->isJMSXGroupFirstForConsumer());
     this->properties.copy(srcPtr->properties);
+    this->propertiesUnmarshalPending = srcPtr->propertiesUnmarshalPending;
     this->setAckHandler(srcPtr->getAckHandler());
     this->setReadOnlyBody(srcPtr->isReadOnlyBody());
     this->setReadOnlyProperties(srcPtr->isReadOnlyProperties());
@@ -440,7 +441,7 @@ bool Message::equals(const DataStructure* value) const {
         return false;
     }
 
-    if (!properties.equals(valuePtr->properties)) {
+    if (!getMessageProperties().equals(valuePtr->getMessageProperties())) {
         return false;
     }
 
@@ -873,6 +874,13 @@ unsigned int Message::getSize() const {
 void Message::beforeMarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {
 
     try {
+
+        // Properties that were never unmarshaled can't have changed, so the
+        // marshaled form that arrived with the Message is sent as is.
+        if (propertiesUnmarshalPending) {
+            return;
+        }
+
         marshalledProperties.clear();
         if (!properties.isEmpty()) {
             wireformat::openwire::marshal::PrimitiveTypesMarshaller::marshal(
@@ -887,9 +895,17 @@ void Message::beforeMarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {
 ////////////////////////////////////////////////////////////////////////////////
 void Message::afterUnmarshal(wireformat::WireFormat* wireFormat AMQCPP_UNUSED) {
 
+    this->properties.clear();
+    this->propertiesUnmarshalPending = !marshalledProperties.empty();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Message::unmarshalProperties() const {
+
     try {
         wireformat::openwire::marshal::PrimitiveTypesMarshaller::unmarshal(
             &properties, marshalledProperties);
+        this->propertiesUnmarshalPending = false;
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
@@ -102,7 +102,11 @@ namespace commands{
 
         // Message properties, these are Marshaled and Unmarshaled from the Message
         // Command's marshaledProperties vector.
-        activemq::util::PrimitiveMap properties;
+        mutable activemq::util::PrimitiveMap properties;
+
+        // Indicates if the marshaledProperties of a received Message still need to be
+        // unmarshaled into the properties map, this is put off until they are accessed.
+        mutable bool propertiesUnmarshalPending;
 
         // Indicates if the Message Properties are Read Only
         bool readOnlyProperties;
@@ -110,6 +114,12 @@ namespace commands{
         // Indicates if the Message Body are Read Only
         bool readOnlyBody;
 
+        /**
+         * Unmarshals the marshaledProperties of a received Message into the
+         * properties map the first time the properties are accessed.
+         */
+        void unmarshalProperties() const;
+
     protected:
 
         core::ActiveMQConnection* connection;
@@ -234,9 +244,15 @@ namespace commands{
          * @return a reference to the Primitive Map that holds message properties.
          */
         util::PrimitiveMap& getMessageProperties() {
+            if (this->propertiesUnmarshalPending) {
+                this->unmarshalProperties();
+            }
             return this->properties;
         }
         const util::PrimitiveMap& getMessageProperties() const {
+            if (this->propertiesUnmarshalPending) {
+                this->unmarshalProperties();
+            }
             return this->properties;
         }
 
@@ -207,6 +207,9 @@ namespace commands{
         const std::vector<unsigned char>& getMarshalledProperties() const {
             return marshalledProperties;
         }
+        std::vector<unsigned char>& getMarshalledProperties() {
+            return marshalledProperties;
+        }
 
         /**
          * Sets the value of the marshalledProperties field
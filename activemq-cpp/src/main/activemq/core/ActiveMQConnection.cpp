@@ -153,6 +153,7 @@ namespace core {
         Pointer<util::IdGenerator> clientIdGenerator;
         Pointer<Scheduler> scheduler;
         Pointer<ExecutorService> executor;
+        Pointer<TaskRunnerFactory> sessionTaskRunner;
 
         util::LongSequenceGenerator sessionIds;
         util::LongSequenceGenerator consumerIdGenerator;
@@ -193,6 +194,8 @@ namespace core {
         long long optimizedAckScheduledAckInterval;
         long long consumerFailoverRedeliveryWaitPeriod;
         bool consumerExpiryCheckEnabled;
+        bool useDedicatedTaskRunner;
+        bool useLockFreeDispatchChannel;
 
         std::auto_ptr<PrefetchPolicy> defaultPrefetchPolicy;
         std::auto_ptr<RedeliveryPolicy> defaultRedeliveryPolicy;
@@ -228,6 +231,7 @@ namespace core {
                              clientIdGenerator(),
                              scheduler(),
                              executor(),
+                             sessionTaskRunner(),
                              sessionIds(),
                              consumerIdGenerator(),
                              tempDestinationIds(),
@@ -263,6 +267,8 @@ namespace core {
                              optimizedAckScheduledAckInterval(0),
                              consumerFailoverRedeliveryWaitPeriod(0),
                              consumerExpiryCheckEnabled(true),
+                             useDedicatedTaskRunner(true),
+                             useLockFreeDispatchChannel(false),
                              defaultPrefetchPolicy(NULL),
                              defaultRedeliveryPolicy(NULL),
                              exceptionListener(NULL),
@@ -294,10 +300,15 @@ namespace core {
 
             this->transportInterruptionProcessingComplete.reset(new AtomicInteger());
             this->protocolVersion.reset(new AtomicInteger(OpenWireFormat::MAX_SUPPORTED_VERSION));
-            this->executor.reset(
+            ThreadPoolExecutor* connectionExecutor =
                 new ThreadPoolExecutor(1, 1, 5, TimeUnit::SECONDS,
                     new LinkedBlockingQueue<Runnable*>(),
-                    new ConnectionThreadFactory(connectionId->toString())));
+                    new ConnectionThreadFactory(connectionId->toString()));
+
+            // The executor only runs the occasional error notification, don't keep
+            // a thread per Connection parked in it.
+            connectionExecutor->allowCoreThreadTimeout(true);
+            this->executor.reset(connectionExecutor);
 
             this->connectionInfo->setConnectionId(connectionId);
             this->scheduler.reset(new Scheduler(std::string("ActiveMQConnection[")+uniqueId+"] Scheduler"));
@@ -769,6 +780,24 @@ void ActiveMQConnection::close() {
             }
         }
 
+        try {
+            // The Sessions are closed so none of their runners are still using the pool.
+            Pointer<TaskRunnerFactory> sessionTaskRunner;
+            synchronized(&this->config->mutex) {
+                sessionTaskRunner = this->config->sessionTaskRunner;
+            }
+
+            if (sessionTaskRunner != NULL) {
+                sessionTaskRunner->shutdown();
+            }
+        } catch (Exception& error) {
+            if (!hasException) {
+                ex = error;
+                ex.setMark(__FILE__, __LINE__);
+                hasException = true;
+            }
+        }
+
         try {
             if (this->config->executor != NULL) {
                 this->config->executor->shutdown();
@@ -1678,6 +1707,19 @@ ExecutorService* ActiveMQConnection::getExecutor() const {
     return this->config->executor.get();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+Pointer<TaskRunnerFactory> ActiveMQConnection::getSessionTaskRunner() {
+
+    synchronized(&this->config->mutex) {
+        if (this->config->sessionTaskRunner == NULL) {
+            this->config->sessionTaskRunner.reset(new TaskRunnerFactory(
+                "ActiveMQ Session Task", this->config->useDedicatedTaskRunner));
+        }
+    }
+
+    return this->config->sessionTaskRunner;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ArrayList< Pointer<ActiveMQSessionKernel> > ActiveMQConnection::getSessions() const {
     ArrayList< Pointer<ActiveMQSessionKernel> > result;
@@ -1960,3 +2002,23 @@ bool ActiveMQConnection::isConsumerExpiryCheckEnabled() {
 void ActiveMQConnection::setConsumerExpiryCheckEnabled(bool consumerExpiryCheckEnabled) {
     this->config->consumerExpiryCheckEnabled = consumerExpiryCheckEnabled;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::isUseDedicatedTaskRunner() const {
+    return this->config->useDedicatedTaskRunner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setUseDedicatedTaskRunner(bool useDedicatedTaskRunner) {
+    this->config->useDedicatedTaskRunner = useDedicatedTaskRunner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnection::isUseLockFreeDispatchChannel() const {
+    return this->config->useLockFreeDispatchChannel;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnection::setUseLockFreeDispatchChannel(bool useLockFreeDispatchChannel) {
+    this->config->useLockFreeDispatchChannel = useLockFreeDispatchChannel;
+}
@@ -29,6 +29,7 @@
 #include <activemq/transport/Transport.h>
 #include <activemq/transport/TransportListener.h>
 #include <activemq/threads/Scheduler.h>
+#include <activemq/threads/TaskRunnerFactory.h>
 #include <activemq/core/kernels/ActiveMQProducerKernel.h>
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <decaf/util/Properties.h>
@@ -822,6 +823,40 @@ namespace core {
          */
         void setConsumerExpiryCheckEnabled(bool consumerExpiryCheckEnabled);
 
+        /**
+         * @return true if each asynchronous Session gets a dispatch thread of its own.
+         */
+        bool isUseDedicatedTaskRunner() const;
+
+        /**
+         * Sets whether each Session that dispatches asynchronously is given a thread of its
+         * own, the default, or whether the Sessions share a pool sized to the number of
+         * processors.  Pooling keeps the thread count down for Connections with many mostly
+         * idle Sessions while still delivering each Session's messages one at a time.  Must
+         * be set before the first Session starts dispatching.
+         *
+         * @param useDedicatedTaskRunner
+         *      true to give each Session its own thread, false to use a shared pool.
+         */
+        void setUseDedicatedTaskRunner(bool useDedicatedTaskRunner);
+
+        /**
+         * @return true if Sessions and consumers queue incoming messages in a lock-free channel.
+         */
+        bool isUseLockFreeDispatchChannel() const;
+
+        /**
+         * Sets whether Sessions and consumers created from now on queue the messages handed to
+         * them in a LockFreeMessageDispatchChannel, so that the transport thread enqueuing and
+         * the dispatch thread dequeuing don't contend on a monitor for every message.  The
+         * default is the monitor based FifoMessageDispatchChannel.  When message priority is
+         * supported the priority channel is always used.
+         *
+         * @param useLockFreeDispatchChannel
+         *      true to use the lock-free dispatch channel.
+         */
+        void setUseLockFreeDispatchChannel(bool useLockFreeDispatchChannel);
+
         /**
          * @return the current connection's OpenWire protocol version.
          */
@@ -1031,6 +1066,12 @@ namespace core {
          */
         decaf::util::concurrent::ExecutorService* getExecutor() const;
 
+        /**
+         * @return the factory used to create the TaskRunners that dispatch messages for
+         *         this Connection's Sessions.
+         */
+        Pointer<threads::TaskRunnerFactory> getSessionTaskRunner();
+
         /**
          * Adds the given Temporary Destination to this Connections collection of known
          * Temporary Destinations.
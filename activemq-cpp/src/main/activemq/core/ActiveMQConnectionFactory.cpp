@@ -100,6 +100,8 @@ namespace core{
         long long optimizedAckScheduledAckInterval;
         long long consumerFailoverRedeliveryWaitPeriod;
         bool consumerExpiryCheckEnabled;
+        bool useDedicatedTaskRunner;
+        bool useLockFreeDispatchChannel;
 
         cms::ExceptionListener* defaultListener;
         cms::MessageTransformer* defaultTransformer;
@@ -136,6 +138,8 @@ namespace core{
                             optimizedAckScheduledAckInterval(0),
                             consumerFailoverRedeliveryWaitPeriod(0),
                             consumerExpiryCheckEnabled(true),
+                            useDedicatedTaskRunner(true),
+                            useLockFreeDispatchChannel(false),
                             defaultListener(NULL),
                             defaultTransformer(NULL),
                             defaultPrefetchPolicy(new DefaultPrefetchPolicy()),
@@ -224,6 +228,10 @@ namespace core{
                 properties->getProperty("connection.alwaysSessionAsync", Boolean::toString(alwaysSessionAsync)));
             this->consumerExpiryCheckEnabled = Boolean::parseBoolean(
                 properties->getProperty("connection.consumerExpiryCheckEnabled", Boolean::toString(consumerExpiryCheckEnabled)));
+            this->useDedicatedTaskRunner = Boolean::parseBoolean(
+                properties->getProperty("connection.useDedicatedTaskRunner", Boolean::toString(useDedicatedTaskRunner)));
+            this->useLockFreeDispatchChannel = Boolean::parseBoolean(
+                properties->getProperty("connection.useLockFreeDispatchChannel", Boolean::toString(useLockFreeDispatchChannel)));
 
             this->defaultPrefetchPolicy->configure(*properties);
             this->defaultRedeliveryPolicy->configure(*properties);
@@ -421,6 +429,8 @@ void ActiveMQConnectionFactory::configureConnection(ActiveMQConnection* connecti
     connection->setConsumerFailoverRedeliveryWaitPeriod(this->settings->consumerFailoverRedeliveryWaitPeriod);
     connection->setAlwaysSessionAsync(this->settings->alwaysSessionAsync);
     connection->setConsumerExpiryCheckEnabled(this->settings->consumerExpiryCheckEnabled);
+    connection->setUseDedicatedTaskRunner(this->settings->useDedicatedTaskRunner);
+    connection->setUseLockFreeDispatchChannel(this->settings->useLockFreeDispatchChannel);
 
     if (this->settings->defaultListener) {
         connection->setExceptionListener(this->settings->defaultListener);
@@ -762,3 +772,23 @@ bool ActiveMQConnectionFactory::isConsumerExpiryCheckEnabled() {
 void ActiveMQConnectionFactory::setConsumerExpiryCheckEnabled(bool consumerExpiryCheckEnabled) {
     this->settings->consumerExpiryCheckEnabled = consumerExpiryCheckEnabled;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnectionFactory::isUseDedicatedTaskRunner() {
+    return this->settings->useDedicatedTaskRunner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setUseDedicatedTaskRunner(bool useDedicatedTaskRunner) {
+    this->settings->useDedicatedTaskRunner = useDedicatedTaskRunner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ActiveMQConnectionFactory::isUseLockFreeDispatchChannel() {
+    return this->settings->useLockFreeDispatchChannel;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQConnectionFactory::setUseLockFreeDispatchChannel(bool useLockFreeDispatchChannel) {
+    this->settings->useLockFreeDispatchChannel = useLockFreeDispatchChannel;
+}
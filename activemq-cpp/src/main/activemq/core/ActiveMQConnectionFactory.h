@@ -672,6 +672,37 @@ namespace core {
          */
         void setConsumerExpiryCheckEnabled(bool consumerExpiryCheckEnabled);
 
+        /**
+         * @return true if each Session created by new Connections dispatches from its own thread.
+         */
+        bool isUseDedicatedTaskRunner();
+
+        /**
+         * Configures whether each Session of the Connections this factory creates gets a
+         * dedicated dispatch thread, or shares a small pool of threads with the other Sessions
+         * of its Connection.  Dedicated threads are used by default.
+         *
+         * @param useDedicatedTaskRunner
+         *      False if Sessions should dispatch from a shared thread pool.
+         */
+        void setUseDedicatedTaskRunner(bool useDedicatedTaskRunner);
+
+        /**
+         * @return true if the Connections this factory creates hand messages to their Sessions
+         *         and consumers through a LockFreeMessageDispatchChannel.
+         */
+        bool isUseLockFreeDispatchChannel();
+
+        /**
+         * Configures whether the Sessions and consumers of the Connections this factory creates
+         * queue their incoming messages in a LockFreeMessageDispatchChannel instead of the
+         * default monitor based FIFO channel.  Has no effect when message priority is supported.
+         *
+         * @param useLockFreeDispatchChannel
+         *      True if the lock-free dispatch channel should be used.
+         */
+        void setUseLockFreeDispatchChannel(bool useLockFreeDispatchChannel);
+
     public:
 
         /**
@@ -22,9 +22,10 @@
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <activemq/core/ActiveMQSession.h>
 #include <activemq/core/FifoMessageDispatchChannel.h>
-#include <activemq/core/SimplePriorityMessageDispatchChannel.h>
+#include <activemq/core/LockFreeMessageDispatchChannel.h>
+#include <activemq/core/IndexedPriorityMessageDispatchChannel.h>
 #include <activemq/commands/ConsumerInfo.h>
-#include <activemq/threads/DedicatedTaskRunner.h>
+#include <activemq/threads/TaskRunnerFactory.h>
 
 using namespace std;
 using namespace activemq;
@@ -41,7 +42,9 @@ ActiveMQSessionExecutor::ActiveMQSessionExecutor(ActiveMQSessionKernel* session)
     session(session), messageQueue(), taskRunner() {
 
     if (this->session->getConnection()->isMessagePrioritySupported()) {
-        this->messageQueue.reset(new SimplePriorityMessageDispatchChannel());
+        this->messageQueue.reset(new IndexedPriorityMessageDispatchChannel());
+    } else if (this->session->getConnection()->isUseLockFreeDispatchChannel()) {
+        this->messageQueue.reset(new LockFreeMessageDispatchChannel());
     } else {
         this->messageQueue.reset(new FifoMessageDispatchChannel());
     }
@@ -110,7 +113,7 @@ void ActiveMQSessionExecutor::wakeup() {
             if (!messageQueue->isRunning()) {
                 return;
             }
-            this->taskRunner.reset(new DedicatedTaskRunner(this));
+            this->taskRunner = this->session->getConnection()->getSessionTaskRunner()->createTaskRunner(this);
             this->taskRunner->start();
         }
 
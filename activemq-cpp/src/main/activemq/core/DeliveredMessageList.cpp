@@ -0,0 +1,367 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DeliveredMessageList.h"
+
+#include <activemq/commands/Message.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/exceptions/ExceptionDefines.h>
+#include <decaf/util/NoSuchElementException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace core {
+
+    class DeliveredMessageList::DeliveredMessageListIterator : public Iterator< Pointer<MessageDispatch> > {
+    private:
+
+        DeliveredMessageList* list;
+        ListNode* current;
+        ListNode* lastReturned;
+
+    private:
+
+        DeliveredMessageListIterator(const DeliveredMessageListIterator&);
+        DeliveredMessageListIterator& operator=(const DeliveredMessageListIterator&);
+
+    public:
+
+        DeliveredMessageListIterator(DeliveredMessageList* list) :
+            Iterator< Pointer<MessageDispatch> >(), list(list), current(&list->head), lastReturned(NULL) {
+        }
+
+        virtual ~DeliveredMessageListIterator() {}
+
+        virtual Pointer<MessageDispatch> next() {
+            if (this->current->next == &this->list->tail) {
+                throw NoSuchElementException(
+                    __FILE__, __LINE__, "No more elements to return from next()");
+            }
+
+            this->current = this->current->next;
+            this->lastReturned = this->current;
+            return this->current->value;
+        }
+
+        virtual bool hasNext() const {
+            return this->current->next != &this->list->tail;
+        }
+
+        virtual void remove() {
+            if (this->lastReturned == NULL) {
+                throw IllegalStateException(
+                    __FILE__, __LINE__, "Invalid State to call remove, must call next() before remove()");
+            }
+
+            this->current = this->lastReturned->prev;
+            this->list->unlink(this->lastReturned);
+            delete this->lastReturned;
+            this->lastReturned = NULL;
+        }
+    };
+
+    class DeliveredMessageList::ConstDeliveredMessageListIterator : public Iterator< Pointer<MessageDispatch> > {
+    private:
+
+        const DeliveredMessageList* list;
+        const ListNode* current;
+
+    private:
+
+        ConstDeliveredMessageListIterator(const ConstDeliveredMessageListIterator&);
+        ConstDeliveredMessageListIterator& operator=(const ConstDeliveredMessageListIterator&);
+
+    public:
+
+        ConstDeliveredMessageListIterator(const DeliveredMessageList* list) :
+            Iterator< Pointer<MessageDispatch> >(), list(list), current(&list->head) {
+        }
+
+        virtual ~ConstDeliveredMessageListIterator() {}
+
+        virtual Pointer<MessageDispatch> next() {
+            if (this->current->next == &this->list->tail) {
+                throw NoSuchElementException(
+                    __FILE__, __LINE__, "No more elements to return from next()");
+            }
+
+            this->current = this->current->next;
+            return this->current->value;
+        }
+
+        virtual bool hasNext() const {
+            return this->current->next != &this->list->tail;
+        }
+
+        virtual void remove() {
+            throw UnsupportedOperationException(
+                __FILE__, __LINE__, "Cannot write to a const Iterator.");
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+int DeliveredMessageList::IndexKeyHash::operator()(const IndexKey& key) const {
+
+    // Only fields compared by MessageId::equals are used so that equal keys hash equally.
+    const Pointer<ProducerId>& producerId = key.id->getProducerId();
+    long long hash = key.id->getProducerSequenceId();
+    hash = 31 * hash + producerId->getValue();
+    hash = 31 * hash + producerId->getSessionId();
+
+    return HashCode<long long>()(hash);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DeliveredMessageList::DeliveredMessageList() :
+    AbstractCollection< Pointer<MessageDispatch> >(), head(), tail(), listSize(0), unindexed(0), index() {
+
+    this->head.next = &this->tail;
+    this->tail.prev = &this->head;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DeliveredMessageList::~DeliveredMessageList() {
+    try {
+        this->clear();
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DeliveredMessageList::addFirst(const Pointer<MessageDispatch>& dispatch) {
+    this->linkAfter(&this->head, new ListNode(dispatch));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DeliveredMessageList::addLast(const Pointer<MessageDispatch>& dispatch) {
+    this->linkAfter(this->tail.prev, new ListNode(dispatch));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool DeliveredMessageList::add(const Pointer<MessageDispatch>& dispatch) {
+    this->addLast(dispatch);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> DeliveredMessageList::getFirst() const {
+    if (this->listSize == 0) {
+        throw NoSuchElementException(__FILE__, __LINE__, "The list is Empty");
+    }
+
+    return this->head.next->value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> DeliveredMessageList::getLast() const {
+    if (this->listSize == 0) {
+        throw NoSuchElementException(__FILE__, __LINE__, "The list is Empty");
+    }
+
+    return this->tail.prev->value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> DeliveredMessageList::removeLast() {
+    if (this->listSize == 0) {
+        throw NoSuchElementException(__FILE__, __LINE__, "The list is Empty");
+    }
+
+    ListNode* node = this->tail.prev;
+    Pointer<MessageDispatch> result = node->value;
+    this->unlink(node);
+    delete node;
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> DeliveredMessageList::removeByMessageId(const MessageId& messageId) {
+
+    ListNode* node = NULL;
+
+    if (messageId.getProducerId() != NULL) {
+        IndexKey key(&messageId);
+        if (this->index.containsKey(key)) {
+            node = this->index.get(key);
+        }
+    }
+
+    if (node == NULL && this->unindexed > 0) {
+        for (ListNode* current = this->head.next; current != &this->tail; current = current->next) {
+            Pointer<Message> message = current->value->getMessage();
+            if (message != NULL && messageId.equals(message->getMessageId().get())) {
+                node = current;
+                break;
+            }
+        }
+    }
+
+    if (node == NULL) {
+        return Pointer<MessageDispatch>();
+    }
+
+    Pointer<MessageDispatch> result = node->value;
+    this->unlink(node);
+    delete node;
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool DeliveredMessageList::contains(const Pointer<MessageDispatch>& dispatch) const {
+    return this->findNode(dispatch) != NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool DeliveredMessageList::remove(const Pointer<MessageDispatch>& dispatch) {
+
+    ListNode* node = this->findNode(dispatch);
+    if (node == NULL) {
+        return false;
+    }
+
+    this->unlink(node);
+    delete node;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DeliveredMessageList::clear() {
+
+    ListNode* current = this->head.next;
+    while (current != &this->tail) {
+        ListNode* next = current->next;
+        delete current;
+        current = next;
+    }
+
+    this->head.next = &this->tail;
+    this->tail.prev = &this->head;
+    this->listSize = 0;
+    this->unindexed = 0;
+    this->index.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool DeliveredMessageList::isEmpty() const {
+    return this->listSize == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int DeliveredMessageList::size() const {
+    return this->listSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Iterator< Pointer<MessageDispatch> >* DeliveredMessageList::iterator() {
+    return new DeliveredMessageListIterator(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Iterator< Pointer<MessageDispatch> >* DeliveredMessageList::iterator() const {
+    return new ConstDeliveredMessageListIterator(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool DeliveredMessageList::keyFor(const Pointer<MessageDispatch>& dispatch, IndexKey& key) {
+
+    if (dispatch == NULL || dispatch->getMessage() == NULL) {
+        return false;
+    }
+
+    const Pointer<MessageId>& messageId = dispatch->getMessage()->getMessageId();
+    if (messageId == NULL || messageId->getProducerId() == NULL) {
+        return false;
+    }
+
+    key.id = messageId.get();
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DeliveredMessageList::ListNode* DeliveredMessageList::findNode(const Pointer<MessageDispatch>& dispatch) const {
+
+    IndexKey key;
+    if (keyFor(dispatch, key) && this->index.containsKey(key)) {
+        ListNode* node = this->index.get(key);
+        if (node->value == dispatch) {
+            return node;
+        }
+    }
+
+    // The dispatch can only be outside the index if some entries were left out of it.
+    if (this->unindexed > 0) {
+        for (ListNode* current = this->head.next; current != &this->tail; current = current->next) {
+            if (current->value == dispatch) {
+                return current;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DeliveredMessageList::linkAfter(ListNode* location, ListNode* node) {
+
+    node->prev = location;
+    node->next = location->next;
+    location->next->prev = node;
+    location->next = node;
+    this->listSize++;
+
+    IndexKey key;
+    if (keyFor(node->value, key) && !this->index.containsKey(key)) {
+        this->index.put(key, node);
+        node->indexed = true;
+    } else {
+        this->unindexed++;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DeliveredMessageList::unlink(ListNode* node) {
+
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->prev = NULL;
+    node->next = NULL;
+    this->listSize--;
+
+    if (node->indexed) {
+        IndexKey key(node->value->getMessage()->getMessageId().get());
+        this->index.remove(key);
+        node->indexed = false;
+    } else {
+        this->unindexed--;
+    }
+}
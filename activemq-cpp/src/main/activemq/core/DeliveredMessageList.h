@@ -0,0 +1,209 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_DELIVEREDMESSAGELIST_H_
+#define _ACTIVEMQ_CORE_DELIVEREDMESSAGELIST_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/MessageId.h>
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/util/AbstractCollection.h>
+#include <decaf/util/HashCode.h>
+#include <decaf/util/HashMap.h>
+#include <decaf/util/Iterator.h>
+
+namespace activemq {
+namespace core {
+
+    using decaf::lang::Pointer;
+    using activemq::commands::MessageDispatch;
+
+    /**
+     * Holds the messages a consumer has delivered but not yet acknowledged.  The messages
+     * are kept in order like a LinkedList, newest first when added with addFirst, and are
+     * also indexed by their MessageId so that contains, remove and removeByMessageId don't
+     * have to scan the list.  A dispatch that has no MessageId, or whose MessageId is
+     * already held by another entry, is kept in the list but not in the index and is found
+     * by a scan instead.
+     *
+     * This class is not thread safe, callers synchronize on the list itself as they would
+     * with any other decaf Collection.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API DeliveredMessageList : public decaf::util::AbstractCollection< Pointer<MessageDispatch> > {
+    private:
+
+        class ListNode {
+        public:
+
+            Pointer<MessageDispatch> value;
+            ListNode* prev;
+            ListNode* next;
+            bool indexed;
+
+        private:
+
+            ListNode(const ListNode&);
+            ListNode& operator=(const ListNode&);
+
+        public:
+
+            ListNode() : value(), prev(NULL), next(NULL), indexed(false) {}
+
+            ListNode(const Pointer<MessageDispatch>& value) : value(value), prev(NULL), next(NULL), indexed(false) {}
+        };
+
+        /**
+         * Index key that refers to the MessageId of the message held in a node, the node
+         * keeps the message alive for as long as the key is in the index.
+         */
+        class IndexKey {
+        public:
+
+            const commands::MessageId* id;
+
+            IndexKey() : id(NULL) {}
+
+            IndexKey(const commands::MessageId* id) : id(id) {}
+
+            bool operator==(const IndexKey& other) const {
+                return this->id == other.id || this->id->equals(*other.id);
+            }
+        };
+
+        struct IndexKeyHash : public decaf::util::HashCodeUnaryBase<const IndexKey&> {
+            int operator()(const IndexKey& key) const;
+        };
+
+        class DeliveredMessageListIterator;
+        class ConstDeliveredMessageListIterator;
+
+        ListNode head;
+        ListNode tail;
+        int listSize;
+        int unindexed;
+        decaf::util::HashMap<IndexKey, ListNode*, IndexKeyHash> index;
+
+    private:
+
+        DeliveredMessageList(const DeliveredMessageList&);
+        DeliveredMessageList& operator=(const DeliveredMessageList&);
+
+    public:
+
+        DeliveredMessageList();
+
+        virtual ~DeliveredMessageList();
+
+        /**
+         * Adds the given dispatch to the front of the list.
+         *
+         * @param dispatch
+         *      The MessageDispatch to add.
+         */
+        void addFirst(const Pointer<MessageDispatch>& dispatch);
+
+        /**
+         * Adds the given dispatch to the end of the list.
+         *
+         * @param dispatch
+         *      The MessageDispatch to add.
+         */
+        void addLast(const Pointer<MessageDispatch>& dispatch);
+
+        /**
+         * @return the dispatch at the front of the list.
+         *
+         * @throws NoSuchElementException if the list is empty.
+         */
+        Pointer<MessageDispatch> getFirst() const;
+
+        /**
+         * @return the dispatch at the end of the list.
+         *
+         * @throws NoSuchElementException if the list is empty.
+         */
+        Pointer<MessageDispatch> getLast() const;
+
+        /**
+         * Removes and returns the dispatch at the end of the list.
+         *
+         * @return the dispatch that was removed.
+         *
+         * @throws NoSuchElementException if the list is empty.
+         */
+        Pointer<MessageDispatch> removeLast();
+
+        /**
+         * Removes the first dispatch in the list whose message has the given MessageId.
+         *
+         * @param messageId
+         *      The MessageId of the message to remove.
+         *
+         * @return the dispatch that was removed or NULL if no message had that MessageId.
+         */
+        Pointer<MessageDispatch> removeByMessageId(const commands::MessageId& messageId);
+
+        /**
+         * {@inheritDoc}
+         *
+         * The dispatch is added to the end of the list.
+         */
+        virtual bool add(const Pointer<MessageDispatch>& dispatch);
+
+        /**
+         * {@inheritDoc}
+         *
+         * Dispatches are compared by identity, as with a LinkedList of Pointers.
+         */
+        virtual bool contains(const Pointer<MessageDispatch>& dispatch) const;
+
+        /**
+         * {@inheritDoc}
+         *
+         * Dispatches are compared by identity, as with a LinkedList of Pointers.
+         */
+        virtual bool remove(const Pointer<MessageDispatch>& dispatch);
+
+        virtual void clear();
+
+        virtual bool isEmpty() const;
+
+        virtual int size() const;
+
+        virtual decaf::util::Iterator< Pointer<MessageDispatch> >* iterator();
+
+        virtual decaf::util::Iterator< Pointer<MessageDispatch> >* iterator() const;
+
+    private:
+
+        static bool keyFor(const Pointer<MessageDispatch>& dispatch, IndexKey& key);
+
+        ListNode* findNode(const Pointer<MessageDispatch>& dispatch) const;
+
+        void linkAfter(ListNode* location, ListNode* node);
+
+        void unlink(ListNode* node);
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_DELIVEREDMESSAGELIST_H_ */
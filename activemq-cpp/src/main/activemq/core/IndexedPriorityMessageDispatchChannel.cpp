@@ -0,0 +1,337 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "IndexedPriorityMessageDispatchChannel.h"
+
+#include <cms/Message.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace core {
+
+    /**
+     * A growable ring buffer holding the messages of one priority.  The capacity is always
+     * a power of two so that positions wrap with a mask.
+     */
+    class IndexedPriorityMessageDispatchChannel::PriorityLevel {
+    private:
+
+        static const int INITIAL_CAPACITY = 16;
+
+        Pointer<MessageDispatch>* elements;
+        int capacity;
+        int head;
+        int count;
+
+    private:
+
+        PriorityLevel(const PriorityLevel&);
+        PriorityLevel& operator=(const PriorityLevel&);
+
+    public:
+
+        PriorityLevel() : elements(NULL), capacity(0), head(0), count(0) {}
+
+        ~PriorityLevel() {
+            delete [] elements;
+        }
+
+        bool isEmpty() const {
+            return this->count == 0;
+        }
+
+        void addLast(const Pointer<MessageDispatch>& dispatch) {
+            ensureCapacity();
+            this->elements[(this->head + this->count) & (this->capacity - 1)] = dispatch;
+            this->count++;
+        }
+
+        void addFirst(const Pointer<MessageDispatch>& dispatch) {
+            ensureCapacity();
+            this->head = (this->head - 1) & (this->capacity - 1);
+            this->elements[this->head] = dispatch;
+            this->count++;
+        }
+
+        const Pointer<MessageDispatch>& getFirst() const {
+            return this->elements[this->head];
+        }
+
+        Pointer<MessageDispatch> removeFirst() {
+            Pointer<MessageDispatch> result;
+            result.swap(this->elements[this->head]);
+            this->head = (this->head + 1) & (this->capacity - 1);
+            this->count--;
+            return result;
+        }
+
+        void drainTo(std::vector<Pointer<MessageDispatch> >& result) {
+            for (int i = 0; i < this->count; ++i) {
+                Pointer<MessageDispatch>& element = this->elements[(this->head + i) & (this->capacity - 1)];
+                result.push_back(element);
+                element.reset(NULL);
+            }
+            this->head = 0;
+            this->count = 0;
+        }
+
+        void clear() {
+            for (int i = 0; i < this->count; ++i) {
+                this->elements[(this->head + i) & (this->capacity - 1)].reset(NULL);
+            }
+            this->head = 0;
+            this->count = 0;
+        }
+
+    private:
+
+        void ensureCapacity() {
+            if (this->count < this->capacity) {
+                return;
+            }
+
+            int newCapacity = this->capacity == 0 ? INITIAL_CAPACITY : this->capacity * 2;
+            Pointer<MessageDispatch>* newElements = new Pointer<MessageDispatch>[newCapacity];
+            for (int i = 0; i < this->count; ++i) {
+                newElements[i].swap(this->elements[(this->head + i) & (this->capacity - 1)]);
+            }
+
+            delete [] this->elements;
+            this->elements = newElements;
+            this->capacity = newCapacity;
+            this->head = 0;
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+const int IndexedPriorityMessageDispatchChannel::MAX_PRIORITIES = 10;
+
+////////////////////////////////////////////////////////////////////////////////
+IndexedPriorityMessageDispatchChannel::IndexedPriorityMessageDispatchChannel() :
+    closed(false), running(false), mutex(), levels(new PriorityLevel[MAX_PRIORITIES]), nonEmptyLevels(0), enqueued(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+IndexedPriorityMessageDispatchChannel::~IndexedPriorityMessageDispatchChannel() {
+    delete [] this->levels;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannel::enqueue(const Pointer<MessageDispatch>& message) {
+    synchronized(&mutex) {
+        int priority = getPriority(message);
+        this->levels[priority].addLast(message);
+        this->nonEmptyLevels |= (1u << priority);
+        this->enqueued++;
+        mutex.notify();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannel::enqueueFirst(const Pointer<MessageDispatch>& message) {
+    synchronized(&mutex) {
+        int priority = getPriority(message);
+        this->levels[priority].addFirst(message);
+        this->nonEmptyLevels |= (1u << priority);
+        this->enqueued++;
+        mutex.notify();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool IndexedPriorityMessageDispatchChannel::isEmpty() const {
+    return this->enqueued == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> IndexedPriorityMessageDispatchChannel::dequeue(long long timeout) {
+
+    synchronized(&mutex) {
+        // Wait until the channel is ready to deliver messages.
+        while (timeout != 0 && !closed && (isEmpty() || !running)) {
+            if (timeout == -1) {
+                mutex.wait();
+            } else {
+                mutex.wait(timeout);
+                break;
+            }
+        }
+
+        if (closed || !running || isEmpty()) {
+            return Pointer<MessageDispatch>();
+        }
+
+        return removeFirst();
+    }
+
+    return Pointer<MessageDispatch>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> IndexedPriorityMessageDispatchChannel::dequeueNoWait() {
+    synchronized(&mutex) {
+        if (closed || !running || isEmpty()) {
+            return Pointer<MessageDispatch>();
+        }
+        return removeFirst();
+    }
+
+    return Pointer<MessageDispatch>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> IndexedPriorityMessageDispatchChannel::peek() const {
+    synchronized(&mutex) {
+        if (closed || !running || isEmpty()) {
+            return Pointer<MessageDispatch>();
+        }
+        return this->levels[highestLevel(this->nonEmptyLevels)].getFirst();
+    }
+
+    return Pointer<MessageDispatch>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannel::start() {
+    synchronized(&mutex) {
+        if (!closed) {
+            running = true;
+            mutex.notifyAll();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannel::stop() {
+    synchronized(&mutex) {
+        running = false;
+        mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannel::close() {
+    synchronized(&mutex) {
+        if (!closed) {
+            running = false;
+            closed = true;
+        }
+        mutex.notifyAll();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannel::clear() {
+    synchronized(&mutex) {
+        for (int i = 0; i < MAX_PRIORITIES; i++) {
+            this->levels[i].clear();
+        }
+        this->nonEmptyLevels = 0;
+        this->enqueued = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int IndexedPriorityMessageDispatchChannel::size() const {
+    synchronized(&mutex) {
+        return this->enqueued;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<Pointer<MessageDispatch> > IndexedPriorityMessageDispatchChannel::removeAll() {
+    std::vector<Pointer<MessageDispatch> > result;
+
+    synchronized(&mutex) {
+        result.reserve(this->enqueued);
+        while (this->nonEmptyLevels != 0) {
+            int priority = highestLevel(this->nonEmptyLevels);
+            this->levels[priority].drainTo(result);
+            this->nonEmptyLevels &= ~(1u << priority);
+        }
+        this->enqueued = 0;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int IndexedPriorityMessageDispatchChannel::getPriority(const Pointer<MessageDispatch>& dispatch) {
+
+    int priority = cms::Message::DEFAULT_MSG_PRIORITY;
+
+    if (dispatch->getMessage() != NULL) {
+        priority = dispatch->getMessage()->getPriority();
+        if (priority > MAX_PRIORITIES - 1) {
+            priority = MAX_PRIORITIES - 1;
+        }
+    }
+
+    return priority;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int IndexedPriorityMessageDispatchChannel::highestLevel(unsigned int mask) {
+
+    // Callers guarantee the mask is non-zero, the builtins are undefined for zero.
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(mask);
+#elif defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanReverse(&index, mask);
+    return (int) index;
+#else
+    int index = 0;
+    while (mask >>= 1) {
+        index++;
+    }
+    return index;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> IndexedPriorityMessageDispatchChannel::removeFirst() {
+
+    int priority = highestLevel(this->nonEmptyLevels);
+    PriorityLevel& level = this->levels[priority];
+
+    Pointer<MessageDispatch> result = level.removeFirst();
+    if (level.isEmpty()) {
+        this->nonEmptyLevels &= ~(1u << priority);
+    }
+    this->enqueued--;
+
+    return result;
+}
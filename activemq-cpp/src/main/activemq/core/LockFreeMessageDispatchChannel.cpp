@@ -0,0 +1,337 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LockFreeMessageDispatchChannel.h"
+
+#include <decaf/lang/System.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+#include <decaf/util/concurrent/locks/LockSupport.h>
+
+using namespace std;
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+using namespace decaf::util::concurrent::locks;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace core {
+
+    class LockFreeMessageDispatchChannel::IncomingNode {
+    private:
+
+        IncomingNode(const IncomingNode&);
+        IncomingNode& operator=(const IncomingNode&);
+
+    public:
+
+        Pointer<MessageDispatch> message;
+        IncomingNode* next;
+
+        IncomingNode(const Pointer<MessageDispatch>& message) : message(message), next(NULL) {}
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+LockFreeMessageDispatchChannel::LockFreeMessageDispatchChannel() :
+    closed(false), running(false), incoming(), count(0), consumerLock(), pending(),
+    waiterCount(0), waitersLock(), waiters(), monitor() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+LockFreeMessageDispatchChannel::~LockFreeMessageDispatchChannel() {
+
+    IncomingNode* node = this->incoming.getAndSet(NULL);
+    while (node != NULL) {
+        IncomingNode* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::enqueue(const Pointer<MessageDispatch>& message) {
+
+    IncomingNode* node = new IncomingNode(message);
+
+    // Counted before it becomes visible so the count never drops below zero.
+    this->count.incrementAndGet();
+
+    IncomingNode* head = NULL;
+    do {
+        head = this->incoming.get();
+        node->next = head;
+    } while (!this->incoming.compareAndSet(head, node));
+
+    wakeWaiters();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::enqueueFirst(const Pointer<MessageDispatch>& message) {
+
+    synchronized(&consumerLock) {
+        this->count.incrementAndGet();
+        this->pending.addFirst(message);
+    }
+
+    wakeWaiters();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool LockFreeMessageDispatchChannel::isEmpty() const {
+    return this->count.get() == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> LockFreeMessageDispatchChannel::dequeue(long long timeout) {
+
+    if (timeout == 0) {
+        return dequeueNoWait();
+    }
+
+    long long deadline = 0;
+    if (timeout > 0) {
+        deadline = System::nanoTime() + TimeUnit::MILLISECONDS.toNanos(timeout);
+    }
+
+    Thread* waiter = NULL;
+
+    try {
+
+        while (!this->closed.get()) {
+
+            if (this->running.get()) {
+                Pointer<MessageDispatch> result;
+                synchronized(&consumerLock) {
+                    result = pollPending();
+                }
+
+                if (result != NULL) {
+                    if (waiter != NULL) {
+                        removeWaiter(waiter);
+                    }
+                    return result;
+                }
+            }
+
+            long long remaining = 0;
+            if (timeout > 0) {
+                remaining = deadline - System::nanoTime();
+                if (remaining <= 0) {
+                    break;
+                }
+            }
+
+            // Register before parking and go around once more, an enqueue that raced with
+            // the check above either is seen on the recheck or unparks this thread.
+            if (waiter == NULL) {
+                waiter = Thread::currentThread();
+                addWaiter(waiter);
+                continue;
+            }
+
+            if (timeout > 0) {
+                LockSupport::parkNanos(remaining);
+            } else {
+                LockSupport::park();
+            }
+        }
+    } catch (...) {
+        if (waiter != NULL) {
+            removeWaiter(waiter);
+        }
+        throw;
+    }
+
+    if (waiter != NULL) {
+        removeWaiter(waiter);
+    }
+
+    return Pointer<MessageDispatch>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> LockFreeMessageDispatchChannel::dequeueNoWait() {
+
+    if (this->closed.get() || !this->running.get()) {
+        return Pointer<MessageDispatch>();
+    }
+
+    synchronized(&consumerLock) {
+        return pollPending();
+    }
+
+    return Pointer<MessageDispatch>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> LockFreeMessageDispatchChannel::peek() const {
+
+    if (this->closed.get() || !this->running.get()) {
+        return Pointer<MessageDispatch>();
+    }
+
+    synchronized(&consumerLock) {
+        drainIncoming();
+        if (!this->pending.isEmpty()) {
+            return this->pending.getFirst();
+        }
+    }
+
+    return Pointer<MessageDispatch>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::start() {
+    if (!this->closed.get()) {
+        // The exchange orders the write before wakeWaiters reads the waiter count.
+        this->running.getAndSet(true);
+        wakeWaiters();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::stop() {
+    this->running.getAndSet(false);
+    wakeWaiters();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::close() {
+    if (this->closed.compareAndSet(false, true)) {
+        this->running.set(false);
+    }
+    wakeWaiters();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::clear() {
+    synchronized(&consumerLock) {
+        drainIncoming();
+        this->count.addAndGet(-this->pending.size());
+        this->pending.clear();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int LockFreeMessageDispatchChannel::size() const {
+    return this->count.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<Pointer<MessageDispatch> > LockFreeMessageDispatchChannel::removeAll() {
+    std::vector<Pointer<MessageDispatch> > result;
+
+    synchronized(&consumerLock) {
+        drainIncoming();
+        result = this->pending.toArray();
+        this->count.addAndGet(-this->pending.size());
+        this->pending.clear();
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::notify() {
+    this->monitor.notify();
+    wakeWaiters();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::notifyAll() {
+    this->monitor.notifyAll();
+    wakeWaiters();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::drainIncoming() const {
+
+    IncomingNode* node = this->incoming.getAndSet(NULL);
+    if (node == NULL) {
+        return;
+    }
+
+    // The stack holds the newest message first, reverse it to get arrival order.
+    IncomingNode* ordered = NULL;
+    while (node != NULL) {
+        IncomingNode* next = node->next;
+        node->next = ordered;
+        ordered = node;
+        node = next;
+    }
+
+    while (ordered != NULL) {
+        IncomingNode* next = ordered->next;
+        this->pending.addLast(ordered->message);
+        delete ordered;
+        ordered = next;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<MessageDispatch> LockFreeMessageDispatchChannel::pollPending() {
+
+    if (this->pending.isEmpty()) {
+        drainIncoming();
+        if (this->pending.isEmpty()) {
+            return Pointer<MessageDispatch>();
+        }
+    }
+
+    this->count.decrementAndGet();
+    return this->pending.removeFirst();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::addWaiter(Thread* thread) {
+    synchronized(&waitersLock) {
+        this->waiters.add(thread);
+    }
+    this->waiterCount.incrementAndGet();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::removeWaiter(Thread* thread) {
+    this->waiterCount.decrementAndGet();
+    synchronized(&waitersLock) {
+        this->waiters.remove(thread);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannel::wakeWaiters() {
+
+    // Producers only pay for the waiters lock when a consumer is actually blocked.
+    if (this->waiterCount.get() == 0) {
+        return;
+    }
+
+    synchronized(&waitersLock) {
+        Pointer< Iterator<Thread*> > iter(this->waiters.iterator());
+        while (iter->hasNext()) {
+            LockSupport::unpark(iter->next());
+        }
+    }
+}
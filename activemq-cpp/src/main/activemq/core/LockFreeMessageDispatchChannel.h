@@ -0,0 +1,164 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_CORE_LOCKFREEMESSAGEDISPATCHCHANNEL_H_
+#define _ACTIVEMQ_CORE_LOCKFREEMESSAGEDISPATCHCHANNEL_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/core/MessageDispatchChannel.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/util/LinkedList.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/util/concurrent/atomic/AtomicReference.h>
+
+namespace activemq {
+namespace core {
+
+    /**
+     * A FIFO MessageDispatchChannel whose enqueue path takes no locks, intended for the case
+     * where many threads hand messages to a single thread that consumes them, such as the
+     * transport reader feeding a session or consumer.
+     *
+     * Producers push new messages onto a lock-free stack.  The consuming side takes the whole
+     * stack in one atomic exchange and moves it, in arrival order, onto a list that only the
+     * consuming side touches.  The consuming side operations are serialized by a mutex that
+     * producers never acquire, so more than one consuming thread is safe but they will contend
+     * with each other.  A blocked dequeue parks its thread and is unparked by the next enqueue,
+     * producers only look at the waiting threads when there are any.
+     *
+     * The monitor provided through the Synchronizable interface is independent of the channel
+     * operations, it exists for callers that need to make several calls on the channel
+     * atomically with respect to each other.  Calling notify or notifyAll also wakes any thread
+     * blocked in dequeue so that it can recheck its state.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API LockFreeMessageDispatchChannel : public MessageDispatchChannel {
+    private:
+
+        class IncomingNode;
+
+        decaf::util::concurrent::atomic::AtomicBoolean closed;
+        decaf::util::concurrent::atomic::AtomicBoolean running;
+
+        // Messages pushed by producers and not yet seen by the consumer, newest first.
+        mutable decaf::util::concurrent::atomic::AtomicReference<IncomingNode> incoming;
+
+        // Count of messages in both the incoming stack and the pending list.
+        decaf::util::concurrent::atomic::AtomicInteger count;
+
+        // Guards the pending list, only ever taken by the consuming side.
+        mutable decaf::util::concurrent::Mutex consumerLock;
+        mutable decaf::util::LinkedList< Pointer<MessageDispatch> > pending;
+
+        decaf::util::concurrent::atomic::AtomicInteger waiterCount;
+        mutable decaf::util::concurrent::Mutex waitersLock;
+        decaf::util::LinkedList<decaf::lang::Thread*> waiters;
+
+        mutable decaf::util::concurrent::Mutex monitor;
+
+    private:
+
+        LockFreeMessageDispatchChannel(const LockFreeMessageDispatchChannel&);
+        LockFreeMessageDispatchChannel& operator=(const LockFreeMessageDispatchChannel&);
+
+    public:
+
+        LockFreeMessageDispatchChannel();
+
+        virtual ~LockFreeMessageDispatchChannel();
+
+        virtual void enqueue(const Pointer<MessageDispatch>& message);
+
+        virtual void enqueueFirst(const Pointer<MessageDispatch>& message);
+
+        virtual bool isEmpty() const;
+
+        virtual bool isClosed() const {
+            return this->closed.get();
+        }
+
+        virtual bool isRunning() const {
+            return this->running.get();
+        }
+
+        virtual Pointer<MessageDispatch> dequeue(long long timeout);
+
+        virtual Pointer<MessageDispatch> dequeueNoWait();
+
+        virtual Pointer<MessageDispatch> peek() const;
+
+        virtual void start();
+
+        virtual void stop();
+
+        virtual void close();
+
+        virtual void clear();
+
+        virtual int size() const;
+
+        virtual std::vector<Pointer<MessageDispatch> > removeAll();
+
+    public:
+
+        virtual void lock() {
+            monitor.lock();
+        }
+
+        virtual bool tryLock() {
+            return monitor.tryLock();
+        }
+
+        virtual void unlock() {
+            monitor.unlock();
+        }
+
+        virtual void wait() {
+            monitor.wait();
+        }
+
+        virtual void wait(long long millisecs) {
+            monitor.wait(millisecs);
+        }
+
+        virtual void wait(long long millisecs, int nanos) {
+            monitor.wait(millisecs, nanos);
+        }
+
+        virtual void notify();
+
+        virtual void notifyAll();
+
+    private:
+
+        // The following are called with the consumerLock held.
+        void drainIncoming() const;
+        Pointer<MessageDispatch> pollPending();
+
+        void addWaiter(decaf::lang::Thread* thread);
+        void removeWaiter(decaf::lang::Thread* thread);
+        void wakeWaiters();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_CORE_LOCKFREEMESSAGEDISPATCHCHANNEL_H_ */
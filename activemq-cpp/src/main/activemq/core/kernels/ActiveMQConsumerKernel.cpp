@@ -45,8 +45,10 @@
 #include <activemq/core/ActiveMQConstants.h>
 #include <activemq/core/ActiveMQTransactionContext.h>
 #include <activemq/core/ActiveMQAckHandler.h>
+#include <activemq/core/DeliveredMessageList.h>
 #include <activemq/core/FifoMessageDispatchChannel.h>
-#include <activemq/core/SimplePriorityMessageDispatchChannel.h>
+#include <activemq/core/LockFreeMessageDispatchChannel.h>
+#include <activemq/core/IndexedPriorityMessageDispatchChannel.h>
 #include <activemq/core/RedeliveryPolicy.h>
 #include <activemq/core/kernels/ActiveMQSessionKernel.h>
 #include <activemq/threads/Scheduler.h>
@@ -101,7 +103,7 @@ namespace kernels {
         AtomicBoolean started;
         AtomicBoolean closeSyncRegistered;
         Pointer<MessageDispatchChannel> unconsumedMessages;
-        decaf::util::LinkedList< decaf::lang::Pointer<commands::MessageDispatch> > deliveredMessages;
+        DeliveredMessageList deliveredMessages;
         long long lastDeliveredSequenceId;
         Pointer<commands::MessageAck> pendingAck;
         int deliveredCounter;
@@ -232,14 +234,9 @@ namespace kernels {
 
         // called with deliveredMessages locked
         void removeFromDeliveredMessages(Pointer<MessageId> key) {
-            Pointer< Iterator< Pointer<MessageDispatch> > > iter(this->deliveredMessages.iterator());
-            while (iter->hasNext()) {
-                Pointer<MessageDispatch> candidate = iter->next();
-                if (key->equals(candidate->getMessage()->getMessageId().get())) {
-                    session->getConnection()->rollbackDuplicate(this->parent, candidate->getMessage());
-                    iter->remove();
-                    break;
-                }
+            Pointer<MessageDispatch> candidate = this->deliveredMessages.removeByMessageId(*key);
+            if (candidate != NULL) {
+                session->getConnection()->rollbackDuplicate(this->parent, candidate->getMessage());
             }
         }
 
@@ -781,7 +778,9 @@ ActiveMQConsumerKernel::ActiveMQConsumerKernel(ActiveMQSessionKernel* session,
     this->internal->scheduler = this->session->getScheduler();
 
     if (this->session->getConnection()->isMessagePrioritySupported()) {
-        this->internal->unconsumedMessages.reset(new SimplePriorityMessageDispatchChannel());
+        this->internal->unconsumedMessages.reset(new IndexedPriorityMessageDispatchChannel());
+    } else if (this->session->getConnection()->isUseLockFreeDispatchChannel()) {
+        this->internal->unconsumedMessages.reset(new LockFreeMessageDispatchChannel());
     } else {
         this->internal->unconsumedMessages.reset(new FifoMessageDispatchChannel());
     }
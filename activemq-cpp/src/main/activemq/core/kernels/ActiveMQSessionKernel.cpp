@@ -53,10 +53,14 @@
 #include <decaf/lang/Runnable.h>
 #include <decaf/lang/Long.h>
 #include <decaf/lang/Math.h>
+#include <decaf/lang/Thread.h>
 #include <decaf/util/Queue.h>
 #include <decaf/util/LinkedList.h>
+#include <decaf/util/HashMap.h>
 #include <decaf/util/concurrent/Mutex.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/util/concurrent/atomic/AtomicReference.h>
 #include <decaf/util/concurrent/locks/ReentrantReadWriteLock.h>
 #include <decaf/lang/exceptions/InvalidStateException.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
@@ -82,6 +86,44 @@ namespace kernels{
 
     class CloseSynhcronization;
 
+    /**
+     * An immutable copy of a Session's consumers that the dispatch path reads without
+     * locking, a new one is published each time a consumer is added or removed.
+     */
+    class ConsumerSnapshot {
+    private:
+
+        ConsumerSnapshot(const ConsumerSnapshot&);
+        ConsumerSnapshot& operator=(const ConsumerSnapshot&);
+
+    public:
+
+        std::vector< Pointer<ActiveMQConsumerKernel> > consumers;
+
+        // Every consumer of a session shares its connection and session ids so they are
+        // indexed by value alone.
+        decaf::util::HashMap< long long, Pointer<ActiveMQConsumerKernel> > byValue;
+
+    public:
+
+        ConsumerSnapshot() : consumers(), byValue() {}
+
+        ConsumerSnapshot(const decaf::util::LinkedList< Pointer<ActiveMQConsumerKernel> >& source) :
+            consumers(), byValue() {
+
+            consumers.reserve(source.size());
+
+            Pointer<Iterator< Pointer<ActiveMQConsumerKernel> > > iter(source.iterator());
+            while (iter->hasNext()) {
+                Pointer<ActiveMQConsumerKernel> consumer = iter->next();
+                consumers.push_back(consumer);
+                byValue.put(consumer->getConsumerId()->getValue(), consumer);
+            }
+        }
+
+        ~ConsumerSnapshot() {}
+    };
+
     class SessionConfig {
     private:
 
@@ -95,6 +137,21 @@ namespace kernels{
         decaf::util::LinkedList< Pointer<ActiveMQProducerKernel> > producers;
         decaf::util::concurrent::locks::ReentrantReadWriteLock consumerLock;
         decaf::util::LinkedList< Pointer<ActiveMQConsumerKernel> > consumers;
+
+        // The published copy of consumers, replaced under the consumerLock write lock.
+        // Readers take no lock, they count themselves in for the current epoch while
+        // they look at the copy.  A writer frees the copy it replaced once the readers
+        // of both epochs that could have seen it have left.
+        AtomicReference<ConsumerSnapshot> consumerSnapshot;
+        AtomicInteger snapshotEpoch;
+        AtomicInteger evenEpochReaders;
+        AtomicInteger oddEpochReaders;
+
+        // The consumers taken from the snapshot for one dispatch round, kept between
+        // rounds so the session's dispatch thread doesn't allocate for each one.
+        AtomicBoolean dispatchConsumersInUse;
+        std::vector< Pointer<ActiveMQConsumerKernel> > dispatchConsumers;
+
         Pointer<Scheduler> scheduler;
         Pointer<CloseSynhcronization> closeSync;
         Mutex sendMutex;
@@ -106,9 +163,77 @@ namespace kernels{
 
         SessionConfig() : synchronizationRegistered(false),
                           producerLock(), producers(), consumerLock(), consumers(),
+                          consumerSnapshot(new ConsumerSnapshot()), snapshotEpoch(),
+                          evenEpochReaders(), oddEpochReaders(),
+                          dispatchConsumersInUse(false), dispatchConsumers(),
                           scheduler(), closeSync(), sendMutex(), transformer(NULL),
                           hashCode(), sessionAsyncDispatch(true) {}
-        ~SessionConfig() {}
+
+        ~SessionConfig() {
+            delete consumerSnapshot.get();
+        }
+
+        AtomicInteger& epochReaders(int epoch) {
+            return (epoch & 1) == 0 ? evenEpochReaders : oddEpochReaders;
+        }
+
+        /**
+         * Replaces the published snapshot with one built from the current consumers list,
+         * the caller must hold the consumerLock write lock.
+         */
+        void publishConsumers() {
+
+            ConsumerSnapshot* retired = consumerSnapshot.getAndSet(new ConsumerSnapshot(consumers));
+
+            // A reader counted in under either epoch may still be looking at the retired
+            // copy, a reader that read the epoch before the last flip may only just be
+            // counting itself in under the older one.  Flipping twice and waiting for
+            // each epoch's readers to drain covers both.  Readers never run user code
+            // while counted in, so the wait is short.
+            for (int i = 0; i < 2; ++i) {
+                AtomicInteger& readers = epochReaders(snapshotEpoch.getAndIncrement());
+                while (readers.get() != 0) {
+                    Thread::yield();
+                }
+            }
+
+            // Releasing the copy can destroy the last reference to a consumer.
+            delete retired;
+        }
+    };
+
+    /**
+     * Counts the caller in as a reader of the published consumer snapshot for as long
+     * as it is in scope, the snapshot must not be used once it has gone.
+     */
+    class ConsumerSnapshotReader {
+    private:
+
+        SessionConfig* config;
+        int epoch;
+        const ConsumerSnapshot* snapshot;
+
+    private:
+
+        ConsumerSnapshotReader(const ConsumerSnapshotReader&);
+        ConsumerSnapshotReader& operator=(const ConsumerSnapshotReader&);
+
+    public:
+
+        ConsumerSnapshotReader(SessionConfig* config) :
+            config(config), epoch(config->snapshotEpoch.get()), snapshot(NULL) {
+
+            config->epochReaders(epoch).incrementAndGet();
+            snapshot = config->consumerSnapshot.get();
+        }
+
+        ~ConsumerSnapshotReader() {
+            config->epochReaders(epoch).decrementAndGet();
+        }
+
+        const ConsumerSnapshot* operator->() const {
+            return snapshot;
+        }
     };
 
     /**
@@ -378,6 +503,7 @@ void ActiveMQSessionKernel::dispose() {
                 }
             }
             this->config->consumers.clear();
+            this->config->publishConsumers();
             this->config->consumerLock.writeLock().unlock();
         } catch (Exception& ex) {
             this->config->consumerLock.writeLock().unlock();
@@ -1247,6 +1373,7 @@ void ActiveMQSessionKernel::addConsumer(Pointer<ActiveMQConsumerKernel> consumer
         this->config->consumerLock.writeLock().lock();
         try {
             this->config->consumers.add(consumer);
+            this->config->publishConsumers();
             this->config->consumerLock.writeLock().unlock();
         } catch (Exception& ex) {
             this->config->consumerLock.writeLock().unlock();
@@ -1268,7 +1395,9 @@ void ActiveMQSessionKernel::removeConsumer(Pointer<ActiveMQConsumerKernel> consu
         this->connection->removeDispatcher(consumer->getConsumerId());
         this->config->consumerLock.writeLock().lock();
         try {
-            this->config->consumers.remove(consumer);
+            if (this->config->consumers.remove(consumer)) {
+                this->config->publishConsumers();
+            }
             this->connection->removeAuditedDispatcher(consumer.get());
             this->config->consumerLock.writeLock().unlock();
         } catch (Exception& ex) {
@@ -1350,21 +1479,14 @@ Pointer<ActiveMQProducerKernel> ActiveMQSessionKernel::lookupProducerKernel(Poin
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<ActiveMQConsumerKernel> ActiveMQSessionKernel::lookupConsumerKernel(Pointer<ConsumerId> id) {
 
-    this->config->consumerLock.readLock().lock();
-    try {
-        Pointer<Iterator< Pointer<ActiveMQConsumerKernel> > > iter(this->config->consumers.iterator());
+    ConsumerSnapshotReader snapshot(this->config);
 
-        while (iter->hasNext()) {
-            Pointer<ActiveMQConsumerKernel> consumer = iter->next();
-            if (consumer->getConsumerId()->equals(*id)) {
-                this->config->consumerLock.readLock().unlock();
-                return consumer;
-            }
+    // Consumers are indexed by value, the full compare only confirms the one candidate.
+    if (snapshot->byValue.containsKey(id->getValue())) {
+        const Pointer<ActiveMQConsumerKernel>& consumer = snapshot->byValue.get(id->getValue());
+        if (consumer->getConsumerId()->equals(*id)) {
+            return consumer;
         }
-        this->config->consumerLock.readLock().unlock();
-    } catch (Exception& ex) {
-        this->config->consumerLock.readLock().unlock();
-        throw;
     }
 
     return Pointer<ActiveMQConsumerKernel>();
@@ -1377,24 +1499,44 @@ bool ActiveMQSessionKernel::iterateConsumers() {
         return false;
     }
 
-    this->config->consumerLock.readLock().lock();
+    // The consumers are copied out so that a listener that closes a consumer isn't run
+    // while counted in as a reader, the copies are dropped after the round so closed
+    // consumers can be freed.  Normally only the dispatch thread gets here, but one that
+    // restarted the session from a listener can still be finishing its round.
+    std::vector< Pointer<ActiveMQConsumerKernel> > overlapping;
+    bool reuse = this->config->dispatchConsumersInUse.compareAndSet(false, true);
+    std::vector< Pointer<ActiveMQConsumerKernel> >& consumers =
+        reuse ? this->config->dispatchConsumers : overlapping;
+
+    bool more = false;
+
     try {
-        Pointer<Iterator< Pointer<ActiveMQConsumerKernel> > > iter(this->config->consumers.iterator());
+        {
+            ConsumerSnapshotReader snapshot(this->config);
+            consumers.assign(snapshot->consumers.begin(), snapshot->consumers.end());
+        }
 
-        while (iter->hasNext()) {
-            Pointer<ActiveMQConsumerKernel> consumer = iter->next();
-            if (consumer->iterate()) {
-                this->config->consumerLock.readLock().unlock();
-                return true;
+        std::vector< Pointer<ActiveMQConsumerKernel> >::const_iterator iter = consumers.begin();
+        for (; iter != consumers.end(); ++iter) {
+            if ((*iter)->iterate()) {
+                more = true;
+                break;
             }
         }
-        this->config->consumerLock.readLock().unlock();
-    } catch (Exception& ex) {
-        this->config->consumerLock.readLock().unlock();
+    } catch (...) {
+        consumers.clear();
+        if (reuse) {
+            this->config->dispatchConsumersInUse.set(false);
+        }
         throw;
     }
 
-    return false;
+    consumers.clear();
+    if (reuse) {
+        this->config->dispatchConsumersInUse.set(false);
+    }
+
+    return more;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -23,6 +23,7 @@
 #include <activemq/transport/discovery/DiscoveryAgentRegistry.h>
 
 #include <activemq/util/IdGenerator.h>
+#include <activemq/threads/SchedulerTimerPool.h>
 
 #include <activemq/wireformat/stomp/StompWireFormatFactory.h>
 #include <activemq/wireformat/openwire/OpenWireFormatFactory.h>
@@ -30,6 +31,7 @@
 #include <activemq/transport/mock/MockTransportFactory.h>
 #include <activemq/transport/tcp/TcpTransportFactory.h>
 #include <activemq/transport/tcp/SslTransportFactory.h>
+#include <activemq/transport/nio/NioTransportFactory.h>
 #include <activemq/transport/failover/FailoverTransportFactory.h>
 #include <activemq/transport/discovery/DiscoveryTransportFactory.h>
 
@@ -38,8 +40,10 @@
 using namespace activemq;
 using namespace activemq::library;
 using namespace activemq::util;
+using namespace activemq::threads;
 using namespace activemq::transport;
 using namespace activemq::transport::tcp;
+using namespace activemq::transport::nio;
 using namespace activemq::transport::mock;
 using namespace activemq::transport::failover;
 using namespace activemq::transport::discovery;
@@ -70,6 +74,9 @@ void ActiveMQCPP::initializeLibrary(int argc, char** argv) {
 
     // Start the IdGenerator Kernel
     IdGenerator::initialize();
+
+    // Start the shared Scheduler Timers Kernel
+    SchedulerTimerPool::initialize();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -80,6 +87,9 @@ void ActiveMQCPP::initializeLibrary() {
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQCPP::shutdownLibrary() {
 
+    // Stop the shared Scheduler Timers
+    SchedulerTimerPool::shutdown();
+
     // Shutdown the IdGenerator Kernel
     IdGenerator::shutdown();
 
@@ -110,7 +120,7 @@ void ActiveMQCPP::registerTransports() {
 
     TransportRegistry::getInstance().registerFactory("tcp", new TcpTransportFactory());
     TransportRegistry::getInstance().registerFactory("ssl", new SslTransportFactory());
-    TransportRegistry::getInstance().registerFactory("nio", new TcpTransportFactory());
+    TransportRegistry::getInstance().registerFactory("nio", new NioTransportFactory());
     TransportRegistry::getInstance().registerFactory("nio+ssl", new SslTransportFactory());
     TransportRegistry::getInstance().registerFactory("mock", new MockTransportFactory());
     TransportRegistry::getInstance().registerFactory("failover", new FailoverTransportFactory());
@@ -0,0 +1,272 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PooledTaskRunner.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+using namespace activemq;
+using namespace activemq::threads;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace threads {
+
+    class PooledTaskRunnerState {
+    private:
+
+        PooledTaskRunnerState(const PooledTaskRunnerState&);
+        PooledTaskRunnerState& operator=(const PooledTaskRunnerState&);
+
+    public:
+
+        Mutex mutex;
+
+        Executor* executor;
+        Task* task;
+        int maxIterationsPerRun;
+
+        Thread* runningThread;
+        bool started;
+        bool pending;
+        bool scheduled;
+        bool iterating;
+        bool shutDown;
+
+        PooledTaskRunnerState(Executor* executor, Task* task, int maxIterationsPerRun) :
+            mutex(), executor(executor), task(task), maxIterationsPerRun(maxIterationsPerRun),
+            runningThread(NULL), started(false), pending(false), scheduled(false),
+            iterating(false), shutDown(false) {
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    void schedule(const Pointer<PooledTaskRunnerState>& state);
+
+    /**
+     * One run of the Task, owned by the Executor.  It holds its own reference to the
+     * runner's state so that it stays safe to run after the runner is gone.
+     */
+    class PooledTaskRun : public Runnable {
+    private:
+
+        Pointer<PooledTaskRunnerState> state;
+
+    private:
+
+        PooledTaskRun(const PooledTaskRun&);
+        PooledTaskRun& operator=(const PooledTaskRun&);
+
+    public:
+
+        PooledTaskRun(const Pointer<PooledTaskRunnerState>& state) : Runnable(), state(state) {}
+
+        virtual ~PooledTaskRun() {}
+
+        virtual void run() {
+
+            synchronized(&state->mutex) {
+                state->scheduled = false;
+
+                if (state->shutDown) {
+                    state->mutex.notifyAll();
+                    return;
+                }
+
+                state->pending = false;
+                state->iterating = true;
+                state->runningThread = Thread::currentThread();
+            }
+
+            bool done = false;
+
+            try {
+
+                int iterations = 0;
+                while (!done && iterations++ < state->maxIterationsPerRun) {
+                    done = !state->task->iterate();
+
+                    synchronized(&state->mutex) {
+                        if (state->shutDown) {
+                            done = true;
+                        }
+                    }
+                }
+            } catch (...) {
+                // The task gets another chance on the next wakeup.
+                done = true;
+            }
+
+            synchronized(&state->mutex) {
+                state->iterating = false;
+                state->runningThread = NULL;
+
+                if (!state->shutDown && (state->pending || !done)) {
+                    schedule(state);
+                }
+
+                state->mutex.notifyAll();
+            }
+        }
+    };
+
+    void schedule(const Pointer<PooledTaskRunnerState>& state) {
+
+        // Called with the mutex held.
+        state->scheduled = true;
+
+        try {
+            // The Executor deletes the run once it has finished, or when rejecting it.
+            state->executor->execute(new PooledTaskRun(state), true);
+        } catch (Exception& ex) {
+            // The Executor has been shut down, nothing will run the task again.
+            state->scheduled = false;
+            state->mutex.notifyAll();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PooledTaskRunner::PooledTaskRunner(Executor* executor, Task* task, int maxIterationsPerRun) :
+    TaskRunner(), state(new PooledTaskRunnerState(executor, task, maxIterationsPerRun)) {
+
+    if (executor == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Executor passed was null");
+    }
+
+    if (task == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Task passed was null");
+    }
+
+    if (maxIterationsPerRun < 1) {
+        throw IllegalArgumentException(__FILE__, __LINE__,
+            "Max iterations per run must be positive: %d", maxIterationsPerRun);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+PooledTaskRunner::~PooledTaskRunner() {
+    try {
+        this->shutdown();
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::start() {
+
+    synchronized(&state->mutex) {
+        if (!state->started && !state->shutDown) {
+            state->started = true;
+            state->pending = true;
+
+            if (!state->iterating && !state->scheduled) {
+                schedule(state);
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool PooledTaskRunner::isStarted() const {
+
+    bool result = false;
+
+    synchronized(&state->mutex) {
+        result = state->started;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::shutdown(long long timeout) {
+
+    synchronized(&state->mutex) {
+
+        state->shutDown = true;
+        state->mutex.notifyAll();
+
+        // No need to wait if shutdown is called from the task that is running.
+        if (state->runningThread == Thread::currentThread()) {
+            return;
+        }
+
+        // A run that is only queued may be waiting for the very thread calling this,
+        // so only an iteration in progress is waited for.
+        long long remaining = timeout;
+        long long deadline = System::currentTimeMillis() + timeout;
+
+        while (state->iterating && remaining > 0) {
+            state->mutex.wait(remaining);
+            remaining = deadline - System::currentTimeMillis();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::shutdown() {
+
+    synchronized(&state->mutex) {
+
+        state->shutDown = true;
+        state->mutex.notifyAll();
+
+        // No need to wait if shutdown is called from the task that is running.
+        if (state->runningThread == Thread::currentThread()) {
+            return;
+        }
+
+        // A run that is only queued may be waiting for the very thread calling this,
+        // so only an iteration in progress is waited for.
+        while (state->iterating) {
+            state->mutex.wait();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunner::wakeup() {
+
+    synchronized(&state->mutex) {
+        if (state->shutDown) {
+            return;
+        }
+
+        state->pending = true;
+
+        // A run in progress picks up the pending flag when it finishes.
+        if (state->started && !state->iterating && !state->scheduled) {
+            schedule(state);
+        }
+    }
+}
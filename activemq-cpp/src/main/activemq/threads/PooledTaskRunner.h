@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_THREADS_POOLEDTASKRUNNER_H_
+#define _ACTIVEMQ_THREADS_POOLEDTASKRUNNER_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/threads/TaskRunner.h>
+#include <activemq/threads/Task.h>
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/util/concurrent/Executor.h>
+
+namespace activemq {
+namespace threads {
+
+    class PooledTaskRunnerState;
+
+    /**
+     * A TaskRunner that runs its Task on a thread borrowed from an Executor that is
+     * shared with other runners, so that many mostly idle tasks don't each need a
+     * thread of their own.
+     *
+     * Each wakeup queues a run with the Executor unless one is already queued or
+     * running, so the Task is never iterated by more than one thread at a time.  A run
+     * stops after maxIterationsPerRun iterations and queues another, giving the other
+     * tasks sharing the Executor a turn.
+     *
+     * A queued run shares the runner's state rather than pointing at the runner, so
+     * the runner can be shut down and destroyed while a run is still waiting in the
+     * Executor's queue; that run then finds the runner shut down and does nothing.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API PooledTaskRunner : public TaskRunner {
+    private:
+
+        decaf::lang::Pointer<PooledTaskRunnerState> state;
+
+    private:
+
+        PooledTaskRunner(const PooledTaskRunner&);
+        PooledTaskRunner& operator=(const PooledTaskRunner&);
+
+    public:
+
+        /**
+         * Creates a new runner for the given Task.
+         *
+         * @param executor
+         *      The Executor that supplies the threads the Task runs on, not owned.
+         * @param task
+         *      The Task to run, not owned.
+         * @param maxIterationsPerRun
+         *      The number of times the Task is iterated before the thread is handed back.
+         *
+         * @throws NullPointerException if the executor or task is NULL.
+         * @throws IllegalArgumentException if maxIterationsPerRun is less than one.
+         */
+        PooledTaskRunner(decaf::util::concurrent::Executor* executor, Task* task, int maxIterationsPerRun);
+
+        virtual ~PooledTaskRunner();
+
+        virtual void start();
+
+        virtual bool isStarted() const;
+
+        /**
+         * Shutdown after a timeout, does not guarantee that the task's iterate
+         * method has completed.
+         *
+         * @param timeout - Time in Milliseconds to wait for the task to stop.
+         */
+        virtual void shutdown(long long timeout);
+
+        /**
+         * Shutdown once the task has returned from the iteration in progress, if any.
+         * A run that is only queued with the Executor is not waited for, it is
+         * discarded when the Executor gets to it.
+         */
+        virtual void shutdown();
+
+        /**
+         * Signal the TaskRunner to wakeup and execute another iteration cycle on
+         * the task, the Task instance will be run until its iterate method has
+         * returned false indicating it is done.
+         */
+        virtual void wakeup();
+
+    };
+
+}}
+
+#endif /*_ACTIVEMQ_THREADS_POOLEDTASKRUNNER_H_*/
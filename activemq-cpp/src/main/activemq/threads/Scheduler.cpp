@@ -19,14 +19,19 @@
 
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/threads/SchedulerTimerTask.h>
+#include <activemq/threads/SchedulerTimerPool.h>
 #include <activemq/util/ServiceStopper.h>
 
 #include <decaf/lang/Pointer.h>
+#include <decaf/lang/Thread.h>
 #include <decaf/util/Timer.h>
 #include <decaf/lang/Runnable.h>
 #include <decaf/lang/exceptions/IllegalArgumentException.h>
 #include <decaf/lang/exceptions/IllegalStateException.h>
 
+#include <algorithm>
+#include <vector>
+
 using namespace activemq;
 using namespace activemq::threads;
 using namespace activemq::util;
@@ -38,7 +43,132 @@ using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
-Scheduler::Scheduler(const std::string& name) : mutex(), name(name), timer(NULL), tasks() {
+namespace activemq {
+namespace threads {
+
+    /**
+     * The state shared between a Scheduler and the tasks it placed on the shared Timer.
+     * Tasks can outlive the Scheduler on the Timer until they are purged, so they only
+     * reach it through here and stop running once the group is stopped.
+     */
+    class SchedulerTaskGroup {
+    private:
+
+        SchedulerTaskGroup(const SchedulerTaskGroup&);
+        SchedulerTaskGroup& operator= (const SchedulerTaskGroup&);
+
+    public:
+
+        Mutex mutex;
+        bool stopped;
+
+        // Threads currently running one of this group's tasks.
+        std::vector<Thread*> running;
+
+        // One shot tasks that haven't run yet, the Timer owns them.
+        std::vector<TimerTask*> delayed;
+
+        SchedulerTaskGroup() : mutex(), stopped(false), running(), delayed() {}
+
+        bool beforeRun() {
+            synchronized(&mutex) {
+                if (stopped) {
+                    return false;
+                }
+                running.push_back(Thread::currentThread());
+            }
+
+            return true;
+        }
+
+        void afterRun(TimerTask* task, bool oneShot) {
+            synchronized(&mutex) {
+                std::vector<Thread*>::iterator thread =
+                    std::find(running.begin(), running.end(), Thread::currentThread());
+                if (thread != running.end()) {
+                    running.erase(thread);
+                }
+
+                if (oneShot) {
+                    std::vector<TimerTask*>::iterator pending = std::find(delayed.begin(), delayed.end(), task);
+                    if (pending != delayed.end()) {
+                        delayed.erase(pending);
+                    }
+                }
+
+                mutex.notifyAll();
+            }
+        }
+
+        bool addDelayed(TimerTask* task) {
+            synchronized(&mutex) {
+                if (stopped) {
+                    return false;
+                }
+                delayed.push_back(task);
+            }
+
+            return true;
+        }
+
+        void stop() {
+            synchronized(&mutex) {
+                stopped = true;
+
+                std::vector<TimerTask*>::iterator iter = delayed.begin();
+                for (; iter != delayed.end(); ++iter) {
+                    (*iter)->cancel();
+                }
+                delayed.clear();
+
+                // A task that stops its own Scheduler can't wait on itself.
+                Thread* current = Thread::currentThread();
+                while (!running.empty() && !(running.size() == 1 && running.front() == current)) {
+                    mutex.wait();
+                }
+            }
+        }
+    };
+
+    class GroupTimerTask : public SchedulerTimerTask {
+    private:
+
+        Pointer<SchedulerTaskGroup> group;
+        bool oneShot;
+
+    private:
+
+        GroupTimerTask(const GroupTimerTask&);
+        GroupTimerTask& operator= (const GroupTimerTask&);
+
+    public:
+
+        GroupTimerTask(Pointer<SchedulerTaskGroup> group, Runnable* task, bool ownsTask, bool oneShot) :
+            SchedulerTimerTask(task, ownsTask), group(group), oneShot(oneShot) {
+        }
+
+        virtual ~GroupTimerTask() {}
+
+        virtual void run() {
+
+            if (!group->beforeRun()) {
+                return;
+            }
+
+            // The Timer is shared, an escaping exception must not reach it.
+            try {
+                SchedulerTimerTask::run();
+            } catch (...) {
+            }
+
+            group->afterRun(this, oneShot);
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+Scheduler::Scheduler(const std::string& name) : mutex(), name(name), timer(), tasks(), group() {
 
     if (name.empty()) {
         throw IllegalArgumentException(__FILE__, __LINE__, "Scheduler name must not be empty.");
@@ -48,44 +178,24 @@ Scheduler::Scheduler(const std::string& name) : mutex(), name(name), timer(NULL)
 ////////////////////////////////////////////////////////////////////////////////
 Scheduler::~Scheduler() {
     try {
-
-        if (this->timer != NULL) {
-            this->timer->cancel();
-        }
-
-        this->tasks.clear();
-
-        delete this->timer;
+        this->cancelAll();
     }
     AMQ_CATCHALL_NOTHROW()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Scheduler::executePeriodically(Runnable* task, long long period, bool ownsTask) {
-
-    if (!isStarted()) {
-        throw IllegalStateException(__FILE__, __LINE__, "Scheduler is not started.");
-    }
-
-    synchronized(&mutex) {
-        TimerTask* timerTask = new SchedulerTimerTask(task, ownsTask);
-        this->timer->scheduleAtFixedRate(timerTask, period, period);
-        this->tasks.put(task, timerTask);
-    }
+    this->schedule(task, period, period, true, ownsTask);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Scheduler::schedualPeriodically(Runnable* task, long long period, bool ownsTask) {
+    this->schedule(task, period, period, false, ownsTask);
+}
 
-    if (!isStarted()) {
-        throw IllegalStateException(__FILE__, __LINE__, "Scheduler is not started.");
-    }
-
-    synchronized(&mutex) {
-        TimerTask* timerTask = new SchedulerTimerTask(task, ownsTask);
-        this->timer->schedule(timerTask, period, period);
-        this->tasks.put(task, timerTask);
-    }
+////////////////////////////////////////////////////////////////////////////////
+void Scheduler::scheduleAtFixedRate(Runnable* task, long long delay, long long period, bool ownsTask) {
+    this->schedule(task, delay, period, true, ownsTask);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -112,30 +222,88 @@ void Scheduler::executeAfterDelay(Runnable* task, long long delay, bool ownsTask
     }
 
     synchronized(&mutex) {
-        TimerTask* timerTask = new SchedulerTimerTask(task, ownsTask);
+        TimerTask* timerTask = new GroupTimerTask(this->group, task, ownsTask, true);
+        if (!this->group->addDelayed(timerTask)) {
+            delete timerTask;
+            throw IllegalStateException(__FILE__, __LINE__, "Scheduler has been shutdown.");
+        }
         this->timer->schedule(timerTask, delay);
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Scheduler::shutdown() {
-    if (this->timer != NULL) {
-        this->timer->cancel();
-    }
+    this->cancelAll();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Scheduler::doStart() {
     synchronized(&mutex) {
-        this->timer = new Timer(name);
+        this->timer = SchedulerTimerPool::getTimer();
+        this->group.reset(new SchedulerTaskGroup());
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void Scheduler::doStop(ServiceStopper* stopper AMQCPP_UNUSED) {
+    this->cancelAll();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Scheduler::schedule(Runnable* task, long long delay, long long period, bool fixedRate, bool ownsTask) {
+
+    if (!isStarted()) {
+        throw IllegalStateException(__FILE__, __LINE__, "Scheduler is not started.");
+    }
+
+    synchronized(&mutex) {
+        TimerTask* timerTask = new GroupTimerTask(this->group, task, ownsTask, false);
+
+        if (this->group->stopped) {
+            delete timerTask;
+            throw IllegalStateException(__FILE__, __LINE__, "Scheduler has been shutdown.");
+        }
+
+        if (fixedRate) {
+            this->timer->scheduleAtFixedRate(timerTask, delay, period);
+        } else {
+            this->timer->schedule(timerTask, delay, period);
+        }
+
+        this->tasks.put(task, timerTask);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Scheduler::cancelAll() {
+
+    Pointer<SchedulerTaskGroup> group;
+
+    synchronized(&mutex) {
+
+        if (this->timer == NULL) {
+            return;
+        }
+
+        std::vector<TimerTask*> values = this->tasks.values().toArray();
+        std::vector<TimerTask*>::iterator iter = values.begin();
+        for (; iter != values.end(); ++iter) {
+            (*iter)->cancel();
+        }
+        this->tasks.clear();
+
+        group = this->group;
+    }
+
+    // Waiting on running tasks while holding the mutex could deadlock a task that
+    // calls back into this Scheduler.
+    if (group != NULL) {
+        group->stop();
+    }
+
     synchronized(&mutex) {
         if (this->timer != NULL) {
-            this->timer->cancel();
+            this->timer->purge();
         }
     }
 }
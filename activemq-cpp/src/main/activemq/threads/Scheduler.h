@@ -22,6 +22,7 @@
 #include <activemq/util/ServiceSupport.h>
 
 #include <decaf/lang/Runnable.h>
+#include <decaf/lang/Pointer.h>
 #include <decaf/util/Timer.h>
 #include <decaf/util/StlMap.h>
 #include <decaf/util/concurrent/Mutex.h>
@@ -31,10 +32,17 @@
 namespace activemq {
 namespace threads {
 
+    class SchedulerTaskGroup;
+
     /**
      * Scheduler class for use in executing Runnable Tasks either periodically or
      * one time only with optional delay.
      *
+     * The tasks run on one of the Timers from the SchedulerTimerPool, which this
+     * Scheduler shares with the other Schedulers in the process.  Stopping or shutting
+     * down the Scheduler cancels only its own tasks and waits for any of them that
+     * are running on other threads to finish.
+     *
      * @since 3.3.0
      */
     class AMQCPP_API Scheduler : public activemq::util::ServiceSupport {
@@ -42,8 +50,9 @@ namespace threads {
 
         decaf::util::concurrent::Mutex mutex;
         std::string name;
-        decaf::util::Timer* timer;
+        decaf::lang::Pointer<decaf::util::Timer> timer;
         decaf::util::StlMap<decaf::lang::Runnable*, decaf::util::TimerTask*> tasks;
+        decaf::lang::Pointer<SchedulerTaskGroup> group;
 
     private:
 
@@ -64,6 +73,21 @@ namespace threads {
 
         void cancel(decaf::lang::Runnable* task);
 
+        /**
+         * Runs the task at a fixed rate, like executePeriodically, but with the first run
+         * after the given delay instead of after one period.
+         *
+         * @param task
+         *      The task to run, canceled with the cancel method.
+         * @param delay
+         *      The time in milliseconds before the first run.
+         * @param period
+         *      The time in milliseconds between the start of each run.
+         * @param ownsTask
+         *      True if the Scheduler deletes the task once it is canceled.
+         */
+        void scheduleAtFixedRate(decaf::lang::Runnable* task, long long delay, long long period, bool ownsTask = true);
+
         void executeAfterDelay(decaf::lang::Runnable* task, long long delay, bool ownsTask = true);
 
         void shutdown();
@@ -74,6 +98,12 @@ namespace threads {
 
         virtual void doStop(activemq::util::ServiceStopper* stopper);
 
+    private:
+
+        void schedule(decaf::lang::Runnable* task, long long delay, long long period, bool fixedRate, bool ownsTask);
+
+        void cancelAll();
+
     };
 
 }}
@@ -0,0 +1,163 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SchedulerTimerPool.h"
+
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Math.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/Concurrent.h>
+
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::threads;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+SchedulerTimerPoolKernel* SchedulerTimerPool::kernel = NULL;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace threads {
+
+    class SchedulerTimerPoolKernel {
+    private:
+
+        SchedulerTimerPoolKernel(const SchedulerTimerPoolKernel&);
+        SchedulerTimerPoolKernel& operator= (const SchedulerTimerPoolKernel&);
+
+    public:
+
+        Mutex mutex;
+        std::vector< Pointer<Timer> > timers;
+        int timerCount;
+        int next;
+        Timer::TaskQueueType queueType;
+
+        SchedulerTimerPoolKernel() : mutex(), timers(), timerCount(Math::max(1, System::availableProcessors())),
+                                     next(0), queueType(Timer::BINARY_HEAP) {
+        }
+
+        // Canceling a Timer here would free the tasks a running Scheduler still refers
+        // to, so each Timer is left to be canceled when its last holder lets it go.
+        ~SchedulerTimerPoolKernel() {}
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    SchedulerTimerPoolKernel* checkInitialized(SchedulerTimerPoolKernel* kernel) {
+        if (kernel == NULL) {
+            throw IllegalStateException(__FILE__, __LINE__, "Library is not initialized.");
+        }
+
+        return kernel;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SchedulerTimerPool::setTimerCount(int count) {
+
+    if (count < 1) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Timer count must be at least one: %d", count);
+    }
+
+    SchedulerTimerPoolKernel* pool = checkInitialized(SchedulerTimerPool::kernel);
+
+    synchronized(&pool->mutex) {
+        pool->timerCount = count;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int SchedulerTimerPool::getTimerCount() {
+
+    SchedulerTimerPoolKernel* pool = checkInitialized(SchedulerTimerPool::kernel);
+
+    int result = 0;
+    synchronized(&pool->mutex) {
+        result = pool->timerCount;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SchedulerTimerPool::setTimerTaskQueueType(Timer::TaskQueueType type) {
+
+    SchedulerTimerPoolKernel* pool = checkInitialized(SchedulerTimerPool::kernel);
+
+    synchronized(&pool->mutex) {
+        pool->queueType = type;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Timer::TaskQueueType SchedulerTimerPool::getTimerTaskQueueType() {
+
+    SchedulerTimerPoolKernel* pool = checkInitialized(SchedulerTimerPool::kernel);
+
+    Timer::TaskQueueType result = Timer::BINARY_HEAP;
+    synchronized(&pool->mutex) {
+        result = pool->queueType;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<Timer> SchedulerTimerPool::getTimer() {
+
+    SchedulerTimerPoolKernel* pool = checkInitialized(SchedulerTimerPool::kernel);
+
+    Pointer<Timer> result;
+
+    synchronized(&pool->mutex) {
+
+        if ((int) pool->timers.size() < pool->timerCount) {
+            result.reset(new Timer(std::string("ActiveMQ Scheduler Timer-") + Integer::toString((int) pool->timers.size() + 1),
+                                   pool->queueType));
+            pool->timers.push_back(result);
+        } else {
+            pool->next = pool->next % pool->timerCount;
+            result = pool->timers[pool->next++];
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SchedulerTimerPool::initialize() {
+    SchedulerTimerPool::kernel = new SchedulerTimerPoolKernel();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SchedulerTimerPool::shutdown() {
+    delete SchedulerTimerPool::kernel;
+    SchedulerTimerPool::kernel = NULL;
+}
@@ -0,0 +1,127 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_THREADS_SCHEDULERTIMERPOOL_H_
+#define _ACTIVEMQ_THREADS_SCHEDULERTIMERPOOL_H_
+
+#include <activemq/util/Config.h>
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/util/Timer.h>
+
+namespace activemq {
+namespace library {
+    class ActiveMQCPP;
+}
+namespace threads {
+
+    class SchedulerTimerPoolKernel;
+
+    /**
+     * The process wide set of Timers that every Scheduler runs its tasks on, so the
+     * number of timer threads doesn't grow with the number of Connections.
+     *
+     * Timers are started the first time they are needed.  Each Scheduler is given one
+     * of the Timers when it starts, taking them in turn once all of them are running.
+     * Tasks run on a shared Timer must not block for long since they hold up every other
+     * task on that Timer.
+     *
+     * By default there is one Timer per processor.  Fewer Timers mean fewer threads, but
+     * the inactivity checks and other tasks of every Connection given the same Timer run
+     * one after another, so a slow task delays all of them.
+     *
+     * The pool lets go of its Timers when the library is shut down, a Timer that a
+     * Scheduler still holds keeps running until the last such Scheduler is gone.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API SchedulerTimerPool {
+    private:
+
+        static SchedulerTimerPoolKernel* kernel;
+
+    private:
+
+        SchedulerTimerPool();
+        SchedulerTimerPool(const SchedulerTimerPool&);
+        SchedulerTimerPool& operator= (const SchedulerTimerPool&);
+
+    public:
+
+        /**
+         * Sets the number of Timer threads the Schedulers are spread over.  Timers that are
+         * already running are kept, so lowering the count only stops new Schedulers from
+         * being given the Timers beyond it.
+         *
+         * @param count
+         *      The number of shared Timers, must be at least one.
+         *
+         * @throws IllegalArgumentException if count is less than one.
+         * @throws IllegalStateException if the library is not initialized.
+         */
+        static void setTimerCount(int count);
+
+        /**
+         * @return the number of Timer threads the Schedulers are spread over.
+         *
+         * @throws IllegalStateException if the library is not initialized.
+         */
+        static int getTimerCount();
+
+        /**
+         * Sets the kind of queue the shared Timers keep their tasks in.  Only Timers started
+         * after the call are affected, so this is normally set right after the library is
+         * initialized.  A timing wheel suits applications with a great many consumers, each
+         * of which can have redelivery and expiration tasks pending.
+         *
+         * @param type
+         *      The queue type used by newly started Timers.
+         *
+         * @throws IllegalStateException if the library is not initialized.
+         */
+        static void setTimerTaskQueueType(decaf::util::Timer::TaskQueueType type);
+
+        /**
+         * @return the kind of queue newly started shared Timers keep their tasks in.
+         *
+         * @throws IllegalStateException if the library is not initialized.
+         */
+        static decaf::util::Timer::TaskQueueType getTimerTaskQueueType();
+
+        /**
+         * Returns the next shared Timer, starting it if it isn't running yet.  The Timer
+         * is shared with other Schedulers and must never be canceled by the caller, it
+         * is canceled once neither the pool nor any caller holds it.
+         *
+         * @return a shared Timer.
+         *
+         * @throws IllegalStateException if the library is not initialized.
+         */
+        static decaf::lang::Pointer<decaf::util::Timer> getTimer();
+
+    private:
+
+        static void initialize();
+        static void shutdown();
+
+        friend class activemq::library::ActiveMQCPP;
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_THREADS_SCHEDULERTIMERPOOL_H_ */
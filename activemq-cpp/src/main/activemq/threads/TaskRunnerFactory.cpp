@@ -0,0 +1,196 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TaskRunnerFactory.h"
+
+#include <activemq/threads/DedicatedTaskRunner.h>
+#include <activemq/threads/PooledTaskRunner.h>
+#include <activemq/exceptions/ActiveMQException.h>
+
+#include <decaf/lang/System.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/util/concurrent/ThreadFactory.h>
+#include <decaf/util/concurrent/ThreadPoolExecutor.h>
+#include <decaf/util/concurrent/LinkedBlockingQueue.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <memory>
+
+using namespace activemq;
+using namespace activemq::threads;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+const int TaskRunnerFactory::DEFAULT_MAX_ITERATIONS_PER_RUN = 1000;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    // How long an idle pool thread waits for work before exiting.
+    const long long KEEP_ALIVE_SECONDS = 30;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace threads {
+
+    class TaskRunnerThreadFactory : public ThreadFactory {
+    private:
+
+        std::string name;
+        AtomicInteger threadCount;
+
+    public:
+
+        TaskRunnerThreadFactory(const std::string& name) : ThreadFactory(), name(name), threadCount() {}
+
+        virtual ~TaskRunnerThreadFactory() {}
+
+        virtual Thread* newThread(decaf::lang::Runnable* runnable) {
+            return new Thread(runnable, name + " Thread-" + Integer::toString(threadCount.incrementAndGet()));
+        }
+    };
+
+    class TaskRunnerFactoryImpl {
+    private:
+
+        TaskRunnerFactoryImpl(const TaskRunnerFactoryImpl&);
+        TaskRunnerFactoryImpl& operator=(const TaskRunnerFactoryImpl&);
+
+    public:
+
+        std::string name;
+        bool dedicatedTaskRunner;
+        int maxThreads;
+        int maxIterationsPerRun;
+
+        Mutex mutex;
+        std::auto_ptr<ThreadPoolExecutor> executor;
+        bool shutDown;
+
+        TaskRunnerFactoryImpl(const std::string& name, bool dedicatedTaskRunner, int maxThreads, int maxIterationsPerRun) :
+            name(name), dedicatedTaskRunner(dedicatedTaskRunner), maxThreads(maxThreads),
+            maxIterationsPerRun(maxIterationsPerRun), mutex(), executor(), shutDown(false) {
+
+            if (this->maxThreads <= 0) {
+                this->maxThreads = System::availableProcessors();
+            }
+        }
+
+        ThreadPoolExecutor* getExecutor() {
+
+            if (executor.get() == NULL) {
+                executor.reset(new ThreadPoolExecutor(maxThreads, maxThreads, KEEP_ALIVE_SECONDS, TimeUnit::SECONDS,
+                    new LinkedBlockingQueue<Runnable*>(), new TaskRunnerThreadFactory(name)));
+                executor->allowCoreThreadTimeout(true);
+            }
+
+            return executor.get();
+        }
+    };
+
+}}
+
+////////////////////////////////////////////////////////////////////////////////
+TaskRunnerFactory::TaskRunnerFactory(const std::string& name, bool dedicatedTaskRunner, int maxThreads, int maxIterationsPerRun) :
+    impl(new TaskRunnerFactoryImpl(name, dedicatedTaskRunner, maxThreads, maxIterationsPerRun)) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TaskRunnerFactory::~TaskRunnerFactory() {
+    try {
+        shutdown();
+    }
+    AMQ_CATCHALL_NOTHROW()
+
+    try {
+        delete this->impl;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<TaskRunner> TaskRunnerFactory::createTaskRunner(Task* task) {
+
+    try {
+
+        synchronized(&impl->mutex) {
+
+            if (impl->shutDown) {
+                throw IllegalStateException(__FILE__, __LINE__, "TaskRunnerFactory has been shut down.");
+            }
+
+            if (impl->dedicatedTaskRunner) {
+                return Pointer<TaskRunner>(new DedicatedTaskRunner(task));
+            }
+
+            return Pointer<TaskRunner>(new PooledTaskRunner(impl->getExecutor(), task, impl->maxIterationsPerRun));
+        }
+
+        return Pointer<TaskRunner>();
+    }
+    AMQ_CATCH_RETHROW(IllegalStateException)
+    AMQ_CATCH_RETHROW(NullPointerException)
+    AMQ_CATCH_RETHROW(IllegalArgumentException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TaskRunnerFactory::shutdown() {
+
+    ThreadPoolExecutor* executor = NULL;
+
+    synchronized(&impl->mutex) {
+        if (impl->shutDown) {
+            return;
+        }
+
+        impl->shutDown = true;
+        executor = impl->executor.get();
+    }
+
+    if (executor != NULL) {
+        executor->shutdown();
+        executor->awaitTermination(1, TimeUnit::MINUTES);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TaskRunnerFactory::isDedicatedTaskRunner() const {
+    return impl->dedicatedTaskRunner;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int TaskRunnerFactory::getMaxThreads() const {
+    return impl->maxThreads;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int TaskRunnerFactory::getMaxIterationsPerRun() const {
+    return impl->maxIterationsPerRun;
+}
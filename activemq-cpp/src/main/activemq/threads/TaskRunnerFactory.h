@@ -0,0 +1,119 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_THREADS_TASKRUNNERFACTORY_H_
+#define _ACTIVEMQ_THREADS_TASKRUNNERFACTORY_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/threads/TaskRunner.h>
+#include <activemq/threads/Task.h>
+
+#include <decaf/lang/Pointer.h>
+
+#include <string>
+
+namespace activemq {
+namespace threads {
+
+    class TaskRunnerFactoryImpl;
+
+    /**
+     * Creates the TaskRunners for a group of Tasks, either a DedicatedTaskRunner with
+     * its own thread for each Task or a PooledTaskRunner for each Task that shares a
+     * pool of at most maxThreads threads owned by this factory.
+     *
+     * The pool is created the first time a pooled runner is requested and its threads
+     * exit when they have been idle for a while.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API TaskRunnerFactory {
+    private:
+
+        TaskRunnerFactoryImpl* impl;
+
+    private:
+
+        TaskRunnerFactory(const TaskRunnerFactory&);
+        TaskRunnerFactory& operator=(const TaskRunnerFactory&);
+
+    public:
+
+        /**
+         * The default number of times a pooled Task is iterated before its thread is
+         * handed to the next Task.
+         */
+        static const int DEFAULT_MAX_ITERATIONS_PER_RUN;
+
+    public:
+
+        /**
+         * Creates a new TaskRunnerFactory.
+         *
+         * @param name
+         *      The prefix for the names of the pool's threads.
+         * @param dedicatedTaskRunner
+         *      true to give each Task its own thread, false to share a pool.
+         * @param maxThreads
+         *      The size of the pool, zero or less sizes it to the number of processors.
+         * @param maxIterationsPerRun
+         *      How many times a pooled Task is iterated before its thread is handed back.
+         */
+        TaskRunnerFactory(const std::string& name, bool dedicatedTaskRunner, int maxThreads = 0,
+                          int maxIterationsPerRun = DEFAULT_MAX_ITERATIONS_PER_RUN);
+
+        virtual ~TaskRunnerFactory();
+
+        /**
+         * Creates a new TaskRunner for the given Task, the caller must start it.  Runners
+         * created by a pooling factory must be shut down before the factory is.
+         *
+         * @param task
+         *      The Task to run, must outlive the returned runner.
+         *
+         * @return a new, unstarted TaskRunner.
+         *
+         * @throws IllegalStateException if this factory has been shut down.
+         */
+        decaf::lang::Pointer<TaskRunner> createTaskRunner(Task* task);
+
+        /**
+         * Stops the pool's threads once the tasks they are running have finished their
+         * current run, after this no more runners can be created.
+         */
+        void shutdown();
+
+        /**
+         * @return true if each Task is given a thread of its own.
+         */
+        bool isDedicatedTaskRunner() const;
+
+        /**
+         * @return the maximum number of threads in the pool.
+         */
+        int getMaxThreads() const;
+
+        /**
+         * @return how many times a pooled Task is iterated before its thread is handed back.
+         */
+        int getMaxIterationsPerRun() const;
+
+    };
+
+}}
+
+#endif /*_ACTIVEMQ_THREADS_TASKRUNNERFACTORY_H_*/
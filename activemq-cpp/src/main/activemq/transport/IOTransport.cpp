@@ -18,12 +18,17 @@
 #include "IOTransport.h"
 
 #include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/Mutex.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+#include <decaf/lang/Integer.h>
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <activemq/wireformat/WireFormat.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <activemq/util/Config.h>
+#include <memory>
 #include <typeinfo>
+#include <deque>
+#include <vector>
 
 using namespace activemq;
 using namespace activemq::transport;
@@ -43,6 +48,37 @@ LOGDECAF_INITIALIZE( logger, IOTransport, "activemq.transport.IOTransport")
 namespace activemq {
 namespace transport {
 
+    /**
+     * A command queued by a caller of oneway, the caller waits on the write lock
+     * until the writer has flushed the command or failed to write it.
+     */
+    class PendingWrite {
+    private:
+
+        PendingWrite(const PendingWrite&);
+        PendingWrite& operator= (const PendingWrite&);
+
+    public:
+
+        enum Status {
+            QUEUED,
+            WRITTEN,
+            FAILED
+        };
+
+        Pointer<Command> command;
+        Status status;
+
+        // Set along with a FAILED status by the writer of the batch this command
+        // went out in, so each caller sees the failure of its own batch.
+        IOException error;
+
+        PendingWrite(const Pointer<Command> command) : command(command), status(QUEUED), error() {
+        }
+    };
+
+    class UnmarshalPipeline;
+
     class IOTransportImpl {
     private:
 
@@ -58,15 +94,384 @@ namespace transport {
         Pointer<decaf::lang::Thread> thread;
         AtomicBoolean closed;
         AtomicBoolean started;
-
-        IOTransportImpl() : wireFormat(), listener(NULL), inputStream(NULL), outputStream(NULL), thread(), closed(false) {
+        bool readingStarted;
+
+        // Commands waiting for whichever caller of oneway currently holds the
+        // writer role to write them.
+        Mutex writeLock;
+        std::vector<PendingWrite*> pendingWrites;
+        bool writing;
+
+        int maxWriteBatchSize;
+        long long maxWriteBatchDelay;
+
+        // Decodes incoming commands off the reader thread, created on start when
+        // unmarshalThreads is greater than zero.
+        int unmarshalThreads;
+        UnmarshalPipeline* pipeline;
+
+        IOTransportImpl() : wireFormat(), listener(NULL), inputStream(NULL), outputStream(NULL), thread(), closed(false),
+                            started(false), readingStarted(false),
+                            writeLock(), pendingWrites(), writing(false),
+                            maxWriteBatchSize(65536), maxWriteBatchDelay(0), unmarshalThreads(0), pipeline(NULL) {
         }
 
         IOTransportImpl(const Pointer<WireFormat> wireFormat) :
-            wireFormat(wireFormat), listener(NULL), inputStream(NULL), outputStream(NULL), thread(), closed(false) {
+            wireFormat(wireFormat), listener(NULL), inputStream(NULL), outputStream(NULL), thread(), closed(false),
+            started(false), readingStarted(false),
+            writeLock(), pendingWrites(), writing(false),
+            maxWriteBatchSize(65536), maxWriteBatchDelay(0), unmarshalThreads(0), pipeline(NULL) {
+        }
+
+        ~IOTransportImpl();
+
+        void deliver(decaf::lang::Exception& ex) {
+
+            if (listener != NULL && started.get() && !closed.get()) {
+                try {
+                    listener->onException(ex);
+                } catch (...) {
+                }
+            }
+        }
+
+        void deliver(const Pointer<Command> command) {
+
+            try {
+
+                // If we have been closed then we don't deliver any messages that
+                // might have sneaked in while we where closing.
+                if (listener == NULL || closed.get()) {
+                    return;
+                }
+
+                listener->onCommand(command);
+            }
+            AMQ_CATCHALL_NOTHROW()
+        }
+
+        /**
+         * Writes every queued command to the output stream and then flushes it once.
+         * Called by the thread holding the writer role, the flush is delayed for up
+         * to maxWriteBatchDelay microseconds waiting for more commands unless the
+         * unflushed data has already reached maxWriteBatchSize bytes.  The writes
+         * that make up the batch are moved into the given vector as they are taken
+         * from the queue.
+         */
+        void writeBatch(Transport* transport, std::vector<PendingWrite*>& batch) {
+
+            std::vector<PendingWrite*> next;
+            long long flushMark = outputStream->size();
+            bool delayed = false;
+
+            while (true) {
+
+                synchronized(&writeLock) {
+                    if (pendingWrites.empty() && !delayed && maxWriteBatchDelay > 0) {
+                        delayed = true;
+                        writeLock.wait(maxWriteBatchDelay / 1000, (int) (maxWriteBatchDelay % 1000) * 1000);
+                    }
+
+                    next.swap(pendingWrites);
+                    batch.insert(batch.end(), next.begin(), next.end());
+                }
+
+                if (next.empty()) {
+                    break;
+                }
+
+                synchronized(outputStream) {
+                    std::vector<PendingWrite*>::const_iterator iter = next.begin();
+                    for (; iter != next.end(); ++iter) {
+                        wireFormat->marshal((*iter)->command, transport, outputStream);
+                    }
+                }
+
+                next.clear();
+
+                if (outputStream->size() - flushMark >= maxWriteBatchSize) {
+                    break;
+                }
+            }
+
+            synchronized(outputStream) {
+                outputStream->flush();
+            }
+        }
+
+        /**
+         * Marks the writes in the batch as done and gives up the writer role, any
+         * commands queued since the last flush will be written by one of the callers
+         * that are now woken up.
+         */
+        void completeBatch(std::vector<PendingWrite*>& batch, PendingWrite::Status status,
+                           const IOException* error = NULL) {
+
+            synchronized(&writeLock) {
+                std::vector<PendingWrite*>::const_iterator iter = batch.begin();
+                for (; iter != batch.end(); ++iter) {
+                    if (error != NULL) {
+                        (*iter)->error = *error;
+                    }
+                    (*iter)->status = status;
+                }
+
+                writing = false;
+                writeLock.notifyAll();
+            }
+        }
+    };
+
+    /**
+     * The encoded bytes of a command read by the reader thread along with the result
+     * of decoding them.
+     */
+    class UnmarshalFrame {
+    private:
+
+        UnmarshalFrame(const UnmarshalFrame&);
+        UnmarshalFrame& operator= (const UnmarshalFrame&);
+
+    public:
+
+        std::vector<unsigned char> bytes;
+        Pointer<Command> command;
+        bool decoded;
+        bool failed;
+        IOException error;
+
+        UnmarshalFrame() : bytes(), command(), decoded(false), failed(false), error() {
+        }
+    };
+
+    /**
+     * Decodes the frames handed over by the reader thread on a fixed set of worker
+     * threads.  Frames are kept in the order they were read and whichever worker
+     * finds the oldest frame decoded takes over delivery until it reaches one that
+     * is still being decoded, so the listener never sees more than one command at
+     * a time and sees them in order.
+     */
+    class UnmarshalPipeline : public decaf::lang::Runnable {
+    private:
+
+        UnmarshalPipeline(const UnmarshalPipeline&);
+        UnmarshalPipeline& operator= (const UnmarshalPipeline&);
+
+        // Bounds how far the reader can get ahead of delivery.
+        static const std::size_t MAX_PENDING_FRAMES = 256;
+
+        IOTransport* transport;
+        IOTransportImpl* impl;
+
+        Mutex lock;
+        std::deque<UnmarshalFrame*> inOrder;
+        std::deque<UnmarshalFrame*> toDecode;
+        std::vector<Thread*> workers;
+        bool delivering;
+        bool stopped;
+        bool failed;
+
+    public:
+
+        UnmarshalPipeline(IOTransport* transport, IOTransportImpl* impl, int threads) :
+            transport(transport), impl(impl), lock(), inOrder(), toDecode(), workers(),
+            delivering(false), stopped(false), failed(false) {
+
+            for (int i = 0; i < threads; ++i) {
+                std::string name = "IOTransport unmarshal Thread-" + decaf::lang::Integer::toString(i + 1);
+                workers.push_back(new Thread(this, name));
+            }
+
+            std::vector<Thread*>::const_iterator iter = workers.begin();
+            for (; iter != workers.end(); ++iter) {
+                (*iter)->start();
+            }
+        }
+
+        virtual ~UnmarshalPipeline() {
+            shutdown();
+
+            std::vector<Thread*>::const_iterator thread = workers.begin();
+            for (; thread != workers.end(); ++thread) {
+                delete *thread;
+            }
+
+            std::deque<UnmarshalFrame*>::const_iterator frame = inOrder.begin();
+            for (; frame != inOrder.end(); ++frame) {
+                delete *frame;
+            }
+        }
+
+        /**
+         * Queues a frame to be decoded and delivered after all frames submitted before it,
+         * waits while the maximum number of frames are already pending.  Takes ownership
+         * of the frame.
+         *
+         * @return false if a frame failed to decode and nothing more should be read.
+         */
+        bool submit(UnmarshalFrame* frame) {
+
+            std::auto_ptr<UnmarshalFrame> owned(frame);
+
+            synchronized(&lock) {
+                while (inOrder.size() >= MAX_PENDING_FRAMES && !stopped && !failed) {
+                    lock.wait();
+                }
+
+                if (!stopped && !failed) {
+                    inOrder.push_back(owned.get());
+                    toDecode.push_back(owned.release());
+                    lock.notifyAll();
+                }
+
+                return !failed;
+            }
+
+            return false;
+        }
+
+        /**
+         * Waits until every submitted frame has been delivered, called by the reader
+         * before it delivers a command itself.
+         *
+         * @return false if a frame failed to decode and nothing more should be read.
+         */
+        bool drain() {
+
+            synchronized(&lock) {
+                while ((!inOrder.empty() || delivering) && !stopped && !failed) {
+                    lock.wait();
+                }
+
+                return !failed;
+            }
+
+            return false;
+        }
+
+        /**
+         * Stops the workers and waits for them to exit, frames that were not yet
+         * delivered are dropped.
+         */
+        void shutdown() {
+
+            synchronized(&lock) {
+                stopped = true;
+                lock.notifyAll();
+            }
+
+            // A worker that is closing the transport from inside the listener can't
+            // wait on itself, it exits once it returns from the listener.
+            std::vector<Thread*>::const_iterator iter = workers.begin();
+            for (; iter != workers.end(); ++iter) {
+                if (*iter != Thread::currentThread()) {
+                    (*iter)->join();
+                }
+            }
+        }
+
+        virtual void run() {
+
+            try {
+
+                while (true) {
+
+                    UnmarshalFrame* frame = NULL;
+
+                    synchronized(&lock) {
+                        while (toDecode.empty() && !stopped) {
+                            lock.wait();
+                        }
+
+                        if (!stopped) {
+                            frame = toDecode.front();
+                            toDecode.pop_front();
+                        }
+                    }
+
+                    if (frame == NULL) {
+                        break;
+                    }
+
+                    Pointer<Command> command;
+                    try {
+                        command = impl->wireFormat->unmarshalFrame(transport, frame->bytes);
+                    } catch (IOException& ex) {
+                        frame->error = ex;
+                        frame->failed = true;
+                    } catch (Exception& ex) {
+                        frame->error = IOException(ex);
+                        frame->failed = true;
+                    }
+
+                    synchronized(&lock) {
+                        frame->command = command;
+                        frame->decoded = true;
+                    }
+
+                    deliverReady();
+                }
+            }
+            AMQ_CATCHALL_NOTHROW()
+        }
+
+    private:
+
+        /**
+         * Delivers decoded frames from the head of the queue until it reaches one that
+         * has not been decoded yet, unless another worker is already delivering.
+         */
+        void deliverReady() {
+
+            synchronized(&lock) {
+                if (delivering) {
+                    return;
+                }
+
+                delivering = true;
+            }
+
+            while (true) {
+
+                UnmarshalFrame* frame = NULL;
+
+                synchronized(&lock) {
+                    if (!inOrder.empty() && inOrder.front()->decoded && !stopped && !failed) {
+                        frame = inOrder.front();
+                        inOrder.pop_front();
+                    } else {
+                        delivering = false;
+                    }
+
+                    lock.notifyAll();
+                }
+
+                if (frame == NULL) {
+                    return;
+                }
+
+                std::auto_ptr<UnmarshalFrame> done(frame);
+
+                if (frame->failed) {
+                    synchronized(&lock) {
+                        failed = true;
+                    }
+
+                    exceptions::ActiveMQException ex(frame->error);
+                    ex.setMark(__FILE__, __LINE__);
+                    impl->deliver(ex);
+                } else {
+                    impl->deliver(frame->command);
+                }
+            }
         }
     };
 
+    ////////////////////////////////////////////////////////////////////////////
+    IOTransportImpl::~IOTransportImpl() {
+        delete pipeline;
+    }
+
 }}
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -92,29 +497,12 @@ IOTransport::~IOTransport() {
 
 ////////////////////////////////////////////////////////////////////////////////
 void IOTransport::fire(decaf::lang::Exception& ex) {
-
-    if (this->impl->listener != NULL && this->impl->started.get() && !this->impl->closed.get()) {
-        try {
-            this->impl->listener->onException(ex);
-        } catch (...) {
-        }
-    }
+    this->impl->deliver(ex);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void IOTransport::fire(const Pointer<Command> command) {
-
-    try {
-
-        // If we have been closed then we don't deliver any messages that
-        // might have sneaked in while we where closing.
-        if (this->impl->listener == NULL || this->impl->closed.get()) {
-            return;
-        }
-
-        this->impl->listener->onCommand(command);
-    }
-    AMQ_CATCHALL_NOTHROW()
+    this->impl->deliver(command);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -126,8 +514,8 @@ void IOTransport::oneway(const Pointer<Command> command) {
             throw IOException(__FILE__, __LINE__, "IOTransport::oneway() - transport is closed!");
         }
 
-        // Make sure the thread has been started.
-        if (impl->thread == NULL) {
+        // Make sure the transport has been started.
+        if (!impl->readingStarted) {
             throw IOException(__FILE__, __LINE__, "IOTransport::oneway() - transport is not started");
         }
 
@@ -141,11 +529,44 @@ void IOTransport::oneway(const Pointer<Command> command) {
             throw IOException(__FILE__, __LINE__, "IOTransport::oneway() - invalid output stream");
         }
 
-        synchronized(impl->outputStream) {
-            // Write the command to the output stream.
-            this->impl->wireFormat->marshal(command, this, this->impl->outputStream);
-            this->impl->outputStream->flush();
+        // Queue the command, then either wait for the thread currently writing to
+        // flush it or take over as the writer and flush everything queued so far.
+        PendingWrite write(command);
+        synchronized(&impl->writeLock) {
+            impl->pendingWrites.push_back(&write);
+
+            while (impl->writing && write.status == PendingWrite::QUEUED) {
+                impl->writeLock.wait();
+            }
+
+            if (write.status == PendingWrite::WRITTEN) {
+                return;
+            } else if (write.status == PendingWrite::FAILED) {
+                throw IOException(write.error);
+            }
+
+            impl->writing = true;
+        }
+
+        std::vector<PendingWrite*> batch;
+        try {
+            impl->writeBatch(this, batch);
+        } catch (Exception& ex) {
+            // Whatever part of the batch made it into the stream can't be trusted,
+            // every caller in the batch gets the same error.
+            IOException error(ex);
+            error.setMark(__FILE__, __LINE__);
+
+            impl->completeBatch(batch, PendingWrite::FAILED, &error);
+            throw;
+        } catch (...) {
+            IOException error(__FILE__, __LINE__, "IOTransport::oneway() - caught unknown exception");
+
+            impl->completeBatch(batch, PendingWrite::FAILED, &error);
+            throw;
         }
+
+        impl->completeBatch(batch, PendingWrite::WRITTEN);
     }
     AMQ_CATCH_RETHROW(IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
@@ -169,9 +590,8 @@ void IOTransport::start() {
                         "IO streams and wireFormat instances must be set before calling start");
             }
 
-            // Start the polling thread.
-            impl->thread.reset(new Thread(this, "IOTransport reader Thread"));
-            impl->thread->start();
+            startReading();
+            impl->readingStarted = true;
         }
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -196,16 +616,18 @@ void IOTransport::close() {
     class Finalizer {
     private:
 
-        Pointer<Thread> target;
+        Finalizer(const Finalizer&);
+        Finalizer& operator= (const Finalizer&);
+
+        IOTransport* target;
 
     public:
 
-        Finalizer(Pointer<Thread> target) : target(target) {}
+        Finalizer(IOTransport* target) : target(target) {}
 
         ~Finalizer() {
             try {
-                target->join();
-                target.reset(NULL);
+                target->stopReading();
             }
             DECAF_CATCHALL_NOTHROW()
         }
@@ -216,7 +638,7 @@ void IOTransport::close() {
         // Mark this transport as closed.
         if (impl->closed.compareAndSet(false, true)) {
 
-            Finalizer finalize(impl->thread);
+            Finalizer finalize(this);
 
             // No need to fire anymore async events now.
             this->impl->listener = NULL;
@@ -260,13 +682,71 @@ void IOTransport::close() {
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::startReading() {
+
+    try {
+        if (impl->pipeline == NULL && impl->unmarshalThreads > 0) {
+            impl->pipeline = new UnmarshalPipeline(this, impl, impl->unmarshalThreads);
+        }
+
+        impl->thread.reset(new Thread(this, "IOTransport reader Thread"));
+        impl->thread->start();
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::stopReading() {
+
+    // Wakes the reader if it is waiting on the pipeline.
+    if (impl->pipeline != NULL) {
+        impl->pipeline->shutdown();
+    }
+
+    if (impl->thread != NULL) {
+        impl->thread->join();
+        impl->thread.reset(NULL);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void IOTransport::run() {
 
+    UnmarshalPipeline* pipeline = this->impl->pipeline;
+
     try {
 
         while (this->impl->started.get() && !this->impl->closed.get()) {
 
+            if (pipeline != NULL && impl->wireFormat->isFrameUnmarshalSupported()) {
+
+                std::auto_ptr<UnmarshalFrame> frame(new UnmarshalFrame());
+
+                // Independent frames are decoded by the pipeline, anything else might
+                // change how the frames after it are read so it waits for the ones
+                // already in the pipeline and is then decoded here before reading on.
+                if (impl->wireFormat->readFrame(this->impl->inputStream, frame->bytes)) {
+                    if (!pipeline->submit(frame.release())) {
+                        break;
+                    }
+                } else {
+                    if (!pipeline->drain()) {
+                        break;
+                    }
+
+                    fire(impl->wireFormat->unmarshalFrame(this, frame->bytes));
+                }
+
+                continue;
+            }
+
+            if (pipeline != NULL && !pipeline->drain()) {
+                break;
+            }
+
             // Read the next command from the input stream.
             Pointer<Command> command(impl->wireFormat->unmarshal(this, this->impl->inputStream));
 
@@ -275,15 +755,21 @@ void IOTransport::run() {
         }
     } catch (exceptions::ActiveMQException& ex) {
         ex.setMark(__FILE__, __LINE__);
-        fire(ex);
+        if (pipeline == NULL || pipeline->drain()) {
+            fire(ex);
+        }
     } catch (decaf::lang::Exception& ex) {
         exceptions::ActiveMQException exl(ex);
         exl.setMark(__FILE__, __LINE__);
-        fire(exl);
+        if (pipeline == NULL || pipeline->drain()) {
+            fire(exl);
+        }
     } catch (...) {
         exceptions::ActiveMQException ex(__FILE__, __LINE__, "IOTransport::run - caught unknown exception");
         LOGDECAF_WARN(logger, ex.getStackTraceString());
-        fire(ex);
+        if (pipeline == NULL || pipeline->drain()) {
+            fire(ex);
+        }
     }
 }
 
@@ -316,6 +802,36 @@ void IOTransport::setOutputStream(decaf::io::DataOutputStream* os) {
     this->impl->outputStream = os;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::setMaxWriteBatchSize(int maxWriteBatchSize) {
+    this->impl->maxWriteBatchSize = maxWriteBatchSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int IOTransport::getMaxWriteBatchSize() const {
+    return this->impl->maxWriteBatchSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::setMaxWriteBatchDelay(long long maxWriteBatchDelay) {
+    this->impl->maxWriteBatchDelay = maxWriteBatchDelay;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long IOTransport::getMaxWriteBatchDelay() const {
+    return this->impl->maxWriteBatchDelay;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransport::setUnmarshalThreads(int unmarshalThreads) {
+    this->impl->unmarshalThreads = unmarshalThreads;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int IOTransport::getUnmarshalThreads() const {
+    return this->impl->unmarshalThreads;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Pointer<wireformat::WireFormat> IOTransport::getWireFormat() const {
     return this->impl->wireFormat;
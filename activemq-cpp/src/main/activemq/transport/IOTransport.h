@@ -45,12 +45,27 @@ namespace transport {
      * to IO streams.
      *
      * This class does not implement the Transport::request method, it only handles
-     * oneway messages.  A thread polls on the input stream for in-coming commands.  When
+     * oneway messages.  A thread polls on the input stream for in-coming commands unless
+     * a subclass replaces it by overriding startReading and stopReading.  When
      * a command is received, the command listener is notified.  The polling thread is not
      * started until the start method is called.  Polling can be suspending by calling stop;
      * however, because the read operation is blocking the transport my still pull one command
      * off the wire even after the stop method has been called.
      *
+     * Concurrent calls to oneway are combined, the first caller to find no write in
+     * progress becomes the writer and marshals every command queued at that point
+     * before issuing a single flush, while the others wait for their command to be
+     * flushed.  The size of a batch and how long the writer waits for more commands
+     * before flushing are controlled by the maxWriteBatchSize and maxWriteBatchDelay
+     * settings.
+     *
+     * When the unmarshalThreads setting is greater than zero and the WireFormat supports
+     * reading frames, the reader thread only collects the bytes of each command and hands
+     * the ones the WireFormat reports as independent to a pool of threads that decode them
+     * in parallel.  Commands are still delivered to the listener one at a time and in the
+     * order they were read, any command that isn't independent is held back until those
+     * ahead of it have been delivered and is then decoded and delivered by the reader.
+     *
      * The close method will close the associated
      * streams.  Close can be called explicitly by the user, but is also called in the
      * destructor.  Once this object has been closed, it cannot be restarted.
@@ -69,7 +84,7 @@ namespace transport {
         IOTransport(const IOTransport&);
         IOTransport& operator=(const IOTransport&);
 
-    private:
+    protected:
 
         /**
          * Notify the exception listener
@@ -87,6 +102,22 @@ namespace transport {
          */
         void fire(const Pointer<Command> command);
 
+        /**
+         * Called from start once the streams and WireFormat have been checked to begin
+         * reading commands, the default creates the thread that polls the input stream.
+         * Subclasses that are handed their incoming data some other way override this
+         * and deliver each command they read with fire.
+         *
+         * @throw IOException if reading can't be started.
+         */
+        virtual void startReading();
+
+        /**
+         * Called from close after the streams have been closed to wait for reading to
+         * end, the default joins the thread created by startReading.
+         */
+        virtual void stopReading();
+
     public:
 
         /**
@@ -121,6 +152,49 @@ namespace transport {
          */
         virtual void setOutputStream(decaf::io::DataOutputStream* os);
 
+        /**
+         * Sets the number of unflushed bytes after which the writer stops adding queued
+         * commands to the current batch and flushes it, defaults to 64k.
+         *
+         * @param maxWriteBatchSize
+         *      The maximum number of bytes written between flushes.
+         */
+        void setMaxWriteBatchSize(int maxWriteBatchSize);
+
+        /**
+         * @return the maximum number of bytes written between flushes.
+         */
+        int getMaxWriteBatchSize() const;
+
+        /**
+         * Sets how long the writer waits for more commands once the queue has drained
+         * before it flushes, the default of zero flushes as soon as the queue is empty.
+         *
+         * @param maxWriteBatchDelay
+         *      The time in microseconds to wait for more commands before a flush.
+         */
+        void setMaxWriteBatchDelay(long long maxWriteBatchDelay);
+
+        /**
+         * @return the time in microseconds the writer waits for more commands before a flush.
+         */
+        long long getMaxWriteBatchDelay() const;
+
+        /**
+         * Sets the number of threads used to decode incoming commands in parallel with
+         * the thread reading them, the default of zero decodes every command on the reader
+         * thread.  Must be set before the transport is started.
+         *
+         * @param unmarshalThreads
+         *      The number of threads that decode incoming commands.
+         */
+        void setUnmarshalThreads(int unmarshalThreads);
+
+        /**
+         * @return the number of threads used to decode incoming commands.
+         */
+        int getUnmarshalThreads() const;
+
     public:  // Transport methods
 
         virtual void oneway(const Pointer<Command> command);
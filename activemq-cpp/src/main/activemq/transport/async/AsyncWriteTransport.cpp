@@ -0,0 +1,350 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncWriteTransport.h"
+
+#include <activemq/commands/Message.h>
+
+#include <decaf/lang/Boolean.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Long.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/io/IOException.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <deque>
+#include <utility>
+
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::transport::async;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace transport {
+namespace async {
+
+    class AsyncWriter : public Runnable {
+    private:
+
+        AsyncWriteTransport* parent;
+
+    private:
+
+        AsyncWriter(const AsyncWriter&);
+        AsyncWriter& operator= (const AsyncWriter&);
+
+    public:
+
+        AsyncWriter(AsyncWriteTransport* parent) : Runnable(), parent(parent) {
+        }
+
+        virtual ~AsyncWriter() {}
+
+        virtual void run() {
+            parent->writeQueuedCommands();
+        }
+    };
+
+    class AsyncWriteTransportImpl {
+    private:
+
+        AsyncWriteTransportImpl(const AsyncWriteTransportImpl&);
+        AsyncWriteTransportImpl& operator= (const AsyncWriteTransportImpl&);
+
+    public:
+
+        // What a command other than a Message is counted as against the byte capacity.
+        static const unsigned int COMMAND_SIZE_ESTIMATE;
+
+        int queueSize;
+        long long queueBytes;
+        bool blockWhenFull;
+        long long closeTimeout;
+
+        // The commands waiting for the writer thread with their estimated sizes, guarded
+        // by the lock which callers of oneway wait on while the queue is full and the
+        // writer waits on while it is empty.  The capacities are fixed on start so later
+        // changes to queueSize and queueBytes have no effect.
+        Mutex lock;
+        std::deque< std::pair<Pointer<Command>, unsigned int> > queue;
+        int capacity;
+        long long byteCapacity;
+        long long queuedBytes;
+
+        Pointer<AsyncWriter> writer;
+        Pointer<Thread> thread;
+        bool running;
+        bool failed;
+        IOException error;
+
+        AsyncWriteTransportImpl() : queueSize(1000), queueBytes(32 * 1024 * 1024), blockWhenFull(true),
+                                    closeTimeout(15000), lock(), queue(), capacity(1000),
+                                    byteCapacity(32 * 1024 * 1024), queuedBytes(0), writer(), thread(),
+                                    running(false), failed(false), error() {
+        }
+
+        static unsigned int estimateSize(const Pointer<Command>& command) {
+            const Message* message = dynamic_cast<const Message*>(command.get());
+            if (message != NULL) {
+                return message->getSize();
+            }
+
+            return COMMAND_SIZE_ESTIMATE;
+        }
+
+        // Called with the lock held, a command is always taken by an empty queue so one
+        // larger than the byte capacity can't wait forever.
+        bool isFull(unsigned int size) const {
+            return (int) queue.size() >= capacity ||
+                   (!queue.empty() && queuedBytes + size > byteCapacity);
+        }
+    };
+
+    const unsigned int AsyncWriteTransportImpl::COMMAND_SIZE_ESTIMATE = 64;
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncWriteTransport::AsyncWriteTransport(const Pointer<Transport> next) :
+    TransportFilter(next), impl(new AsyncWriteTransportImpl()) {
+
+    this->impl->writer.reset(new AsyncWriter(this));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncWriteTransport::AsyncWriteTransport(const Pointer<Transport> next, const decaf::util::Properties& properties) :
+    TransportFilter(next), impl(new AsyncWriteTransportImpl()) {
+
+    this->impl->writer.reset(new AsyncWriter(this));
+    this->impl->queueSize = Integer::parseInt(properties.getProperty("transport.asyncWriteQueueSize", "1000"));
+    this->impl->queueBytes = Long::parseLong(properties.getProperty("transport.asyncWriteQueueBytes", "33554432"));
+    this->impl->blockWhenFull = Boolean::parseBoolean(properties.getProperty("transport.asyncWriteBlockWhenFull", "true"));
+    this->impl->closeTimeout = Long::parseLong(properties.getProperty("transport.asyncWriteCloseTimeout", "15000"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncWriteTransport::~AsyncWriteTransport() {
+    try {
+        this->stopWriter(0);
+    }
+    AMQ_CATCHALL_NOTHROW()
+
+    try {
+        delete this->impl;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransport::oneway(const Pointer<Command> command) {
+
+    try {
+
+        checkClosed();
+
+        if (command == NULL) {
+            throw IOException(__FILE__, __LINE__, "AsyncWriteTransport::oneway() - attempting to write NULL command");
+        }
+
+        unsigned int size = AsyncWriteTransportImpl::estimateSize(command);
+
+        // The writer failing and the transport being stopped or closed all wake the
+        // callers waiting for room, so the state is checked again once there is room
+        // or this caller was woken, never enqueuing a command nobody will write.
+        synchronized(&this->impl->lock) {
+
+            while (this->impl->blockWhenFull && this->impl->running && !this->impl->failed &&
+                   this->impl->isFull(size)) {
+                this->impl->lock.wait();
+            }
+
+            if (this->impl->failed) {
+                throw IOException(this->impl->error);
+            }
+
+            if (!this->impl->running) {
+                throw IOException(__FILE__, __LINE__, "AsyncWriteTransport::oneway() - transport is not started");
+            }
+
+            if (this->impl->isFull(size)) {
+                throw IOException(__FILE__, __LINE__, "AsyncWriteTransport::oneway() - write queue is full");
+            }
+
+            this->impl->queue.push_back(std::make_pair(command, size));
+            this->impl->queuedBytes += size;
+            this->impl->lock.notifyAll();
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransport::afterNextIsStarted() {
+
+    synchronized(&this->impl->lock) {
+
+        if (this->impl->running) {
+            return;
+        }
+
+        this->impl->capacity = this->impl->queueSize;
+        this->impl->byteCapacity = this->impl->queueBytes;
+        this->impl->running = true;
+    }
+
+    this->impl->thread.reset(new Thread(this->impl->writer.get(), "AsyncWriteTransport writer Thread"));
+    this->impl->thread->start();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransport::beforeNextIsStopped() {
+    this->stopWriter(this->impl->closeTimeout);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransport::doClose() {
+    // The next transport is closed now so a writer that was stuck in a write
+    // will have failed and the thread can be waited on.
+    this->stopWriter(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransport::stopWriter(long long timeout) {
+
+    synchronized(&this->impl->lock) {
+        // Wakes the writer if it is waiting on an empty queue and fails any caller
+        // still waiting for room.
+        this->impl->running = false;
+        this->impl->lock.notifyAll();
+    }
+
+    if (this->impl->thread != NULL) {
+
+        if (timeout > 0) {
+            this->impl->thread->join(timeout);
+            if (this->impl->thread->isAlive()) {
+                return;
+            }
+        } else {
+            this->impl->thread->join();
+        }
+
+        this->impl->thread.reset(NULL);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransport::writeQueuedCommands() {
+
+    try {
+
+        while (true) {
+
+            Pointer<Command> command;
+
+            synchronized(&this->impl->lock) {
+
+                while (this->impl->running && this->impl->queue.empty()) {
+                    this->impl->lock.wait();
+                }
+
+                // Once stopped the commands already queued are still written.
+                if (!this->impl->queue.empty()) {
+                    command = this->impl->queue.front().first;
+                    this->impl->queuedBytes -= this->impl->queue.front().second;
+                    this->impl->queue.pop_front();
+                    this->impl->lock.notifyAll();
+                }
+            }
+
+            if (command == NULL) {
+                break;
+            }
+
+            this->next->oneway(command);
+        }
+
+    } catch (Exception& ex) {
+
+        IOException error(ex);
+        error.setMark(__FILE__, __LINE__);
+
+        synchronized(&this->impl->lock) {
+            this->impl->error = error;
+            this->impl->failed = true;
+
+            // Nothing more will be written, release any callers waiting for space
+            // so they see the failure.
+            this->impl->queue.clear();
+            this->impl->queuedBytes = 0;
+            this->impl->lock.notifyAll();
+        }
+
+        onException(error);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int AsyncWriteTransport::getQueueSize() const {
+    return this->impl->queueSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransport::setQueueSize(int queueSize) {
+    this->impl->queueSize = queueSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long AsyncWriteTransport::getQueueBytes() const {
+    return this->impl->queueBytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransport::setQueueBytes(long long queueBytes) {
+    this->impl->queueBytes = queueBytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool AsyncWriteTransport::isBlockWhenFull() const {
+    return this->impl->blockWhenFull;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransport::setBlockWhenFull(bool blockWhenFull) {
+    this->impl->blockWhenFull = blockWhenFull;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long AsyncWriteTransport::getCloseTimeout() const {
+    return this->impl->closeTimeout;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransport::setCloseTimeout(long long closeTimeout) {
+    this->impl->closeTimeout = closeTimeout;
+}
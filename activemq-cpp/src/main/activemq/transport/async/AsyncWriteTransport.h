@@ -0,0 +1,177 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_ASYNC_ASYNCWRITETRANSPORT_H_
+#define _ACTIVEMQ_TRANSPORT_ASYNC_ASYNCWRITETRANSPORT_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/transport/TransportFilter.h>
+#include <activemq/commands/Command.h>
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/util/Properties.h>
+
+namespace activemq {
+namespace transport {
+namespace async {
+
+    using decaf::lang::Pointer;
+
+    class AsyncWriter;
+    class AsyncWriteTransportImpl;
+
+    /**
+     * A TransportFilter that hands outgoing commands to a dedicated writer thread so
+     * that the threads calling oneway don't wait for the network write to complete.
+     *
+     * Commands are written in the order they were sent.  Both the number of commands
+     * and their estimated size in bytes that can be waiting to be written are bounded,
+     * when either limit is reached the caller either blocks until there is room or gets
+     * an IOException, depending on the value of the blockWhenFull setting.  A command
+     * larger than the byte limit on its own is still taken once the queue is empty.  An error from the writer thread is reported to the
+     * TransportListener in the same way as an error from the receiving side, and every
+     * later call to oneway fails with that error.  Commands still queued when the
+     * transport is stopped are written before the next transport is stopped, waiting
+     * at most closeTimeout milliseconds for that to happen.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API AsyncWriteTransport : public TransportFilter {
+    private:
+
+        AsyncWriteTransportImpl* impl;
+
+        friend class AsyncWriter;
+
+    private:
+
+        AsyncWriteTransport(const AsyncWriteTransport&);
+        AsyncWriteTransport& operator=(const AsyncWriteTransport&);
+
+    public:
+
+        /**
+         * Creates a new AsyncWriteTransport with the default settings.
+         *
+         * @param next
+         *      The next Transport in the chain.
+         */
+        AsyncWriteTransport(const Pointer<Transport> next);
+
+        /**
+         * Creates a new AsyncWriteTransport configured from the transport.asyncWrite*
+         * values in the given Properties.
+         *
+         * @param next
+         *      The next Transport in the chain.
+         * @param properties
+         *      The URI options given to the TransportFactory.
+         */
+        AsyncWriteTransport(const Pointer<Transport> next, const decaf::util::Properties& properties);
+
+        virtual ~AsyncWriteTransport();
+
+    public: // TransportFilter methods.
+
+        /**
+         * {@inheritDoc}
+         *
+         * Queues the command for the writer thread.  Errors that occur while writing
+         * are reported to the TransportListener rather than thrown from this method.
+         */
+        virtual void oneway(const Pointer<Command> command);
+
+    public:
+
+        /**
+         * @return the maximum number of commands that can be waiting to be written.
+         */
+        int getQueueSize() const;
+
+        /**
+         * Sets the maximum number of commands that can be waiting to be written, this
+         * has no effect once the transport has been created.
+         *
+         * @param queueSize
+         *      The capacity of the queue of outgoing commands.
+         */
+        void setQueueSize(int queueSize);
+
+        /**
+         * @return the maximum estimated size in bytes of the commands waiting to be written.
+         */
+        long long getQueueBytes() const;
+
+        /**
+         * Sets the maximum estimated size in bytes of the commands that can be waiting to
+         * be written, this has no effect once the transport has been created.  A Message
+         * is counted by its body and properties, other commands by a small fixed amount.
+         *
+         * @param queueBytes
+         *      The byte capacity of the queue of outgoing commands.
+         */
+        void setQueueBytes(long long queueBytes);
+
+        /**
+         * @return true if oneway blocks while the queue is full, false if it throws.
+         */
+        bool isBlockWhenFull() const;
+
+        /**
+         * Sets whether oneway blocks until there is room when the queue is full or fails
+         * with an IOException.
+         *
+         * @param blockWhenFull
+         *      True to block when the queue is full.
+         */
+        void setBlockWhenFull(bool blockWhenFull);
+
+        /**
+         * @return the time in milliseconds to wait for queued commands to be written on stop.
+         */
+        long long getCloseTimeout() const;
+
+        /**
+         * Sets the time in milliseconds that stop waits for the commands that are still
+         * queued to be written.
+         *
+         * @param closeTimeout
+         *      The time to wait for the queue to drain, in milliseconds.
+         */
+        void setCloseTimeout(long long closeTimeout);
+
+    protected:
+
+        virtual void afterNextIsStarted();
+
+        virtual void beforeNextIsStopped();
+
+        virtual void doClose();
+
+    private:
+
+        // Writes queued commands until the transport is stopped, runs on the writer thread.
+        void writeQueuedCommands();
+
+        // Stops the writer thread, waiting at most the given time for it to drain the queue.
+        void stopWriter(long long timeout);
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_ASYNC_ASYNCWRITETRANSPORT_H_ */
@@ -22,10 +22,10 @@
 
 #include <activemq/threads/CompositeTask.h>
 #include <activemq/threads/CompositeTaskRunner.h>
+#include <activemq/threads/Scheduler.h>
 #include <activemq/commands/WireFormatInfo.h>
 #include <activemq/commands/KeepAliveInfo.h>
 
-#include <decaf/util/Timer.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 #include <decaf/util/concurrent/atomic/AtomicInteger.h>
 #include <decaf/lang/Math.h>
@@ -72,8 +72,8 @@ namespace inactivity {
         Pointer<ReadChecker> readCheckerTask;
         Pointer<WriteChecker> writeCheckerTask;
 
-        Timer readCheckTimer;
-        Timer writeCheckTimer;
+        // Runs both checkers on one of the shared Scheduler Timers.
+        Scheduler checkScheduler;
 
         Pointer<CompositeTaskRunner> asyncTasks;
 
@@ -104,8 +104,7 @@ namespace inactivity {
             remoteWireFormatInfo(),
             readCheckerTask(),
             writeCheckerTask(),
-            readCheckTimer("InactivityMonitor Read Check Timer"),
-            writeCheckTimer("InactivityMonitor Write Check Timer"),
+            checkScheduler("InactivityMonitor Check Scheduler"),
             asyncTasks(),
             asyncReadTask(),
             asyncWriteTask(),
@@ -457,8 +456,9 @@ void InactivityMonitor::startMonitorThreads() {
             this->members->readCheckerTask.reset(new ReadChecker(this));
             this->members->writeCheckTime = this->members->readCheckTime > 3 ? this->members->readCheckTime / 3 : this->members->readCheckTime;
 
-            this->members->writeCheckTimer.scheduleAtFixedRate(this->members->writeCheckerTask, this->members->initialDelayTime, this->members->writeCheckTime);
-            this->members->readCheckTimer.scheduleAtFixedRate(this->members->readCheckerTask, this->members->initialDelayTime, this->members->readCheckTime);
+            this->members->checkScheduler.start();
+            this->members->checkScheduler.scheduleAtFixedRate(this->members->writeCheckerTask.get(), this->members->initialDelayTime, this->members->writeCheckTime, false);
+            this->members->checkScheduler.scheduleAtFixedRate(this->members->readCheckerTask.get(), this->members->initialDelayTime, this->members->readCheckTime, false);
         }
     }
 }
@@ -473,10 +473,7 @@ void InactivityMonitor::stopMonitorThreads() {
             this->members->readCheckerTask->cancel();
             this->members->writeCheckerTask->cancel();
 
-            this->members->readCheckTimer.purge();
-            this->members->readCheckTimer.cancel();
-            this->members->writeCheckTimer.purge();
-            this->members->writeCheckTimer.cancel();
+            this->members->checkScheduler.stop();
 
             this->members->asyncTasks->shutdown();
         }
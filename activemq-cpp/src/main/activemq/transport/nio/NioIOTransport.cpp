@@ -0,0 +1,449 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NioIOTransport.h"
+
+#include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/threads/Task.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/EOFException.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/nio/channels/SocketChannel.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <string.h>
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::exceptions;
+using namespace activemq::threads;
+using namespace activemq::transport;
+using namespace activemq::transport::nio;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::net;
+using namespace decaf::nio::channels;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace transport {
+namespace nio {
+
+    class NioIOTransportImpl {
+    private:
+
+        NioIOTransportImpl(const NioIOTransportImpl&);
+        NioIOTransportImpl& operator= (const NioIOTransportImpl&);
+
+    public:
+
+        static const int INITIAL_BUFFER_SIZE;
+        static const int MIN_READ_SIZE;
+        static const int MAX_RETAINED_BUFFER_SIZE;
+        static const int MAX_QUEUED_BYTES;
+
+        Pointer<NioReactor> reactor;
+        Socket* socket;
+        OpenWireFormat* wireFormat;
+        std::auto_ptr<SocketChannel> channel;
+
+        Mutex lock;
+        NioRegistration* registration;
+
+        // Bytes read from the socket, those between position and limit haven't been
+        // unmarshaled yet.
+        std::vector<unsigned char> buffer;
+        int position;
+        int limit;
+
+        // Commands waiting for the dispatch runner in the order they were read, with the
+        // size of their frames, and the error that ended reading if there was one.  The
+        // socket isn't read from while more than MAX_QUEUED_BYTES of frames are queued.
+        Mutex dispatchLock;
+        std::deque< std::pair<Pointer<Command>, int> > dispatchQueue;
+        long long queuedBytes;
+        bool readingPaused;
+        Pointer<ActiveMQException> readError;
+        std::auto_ptr<Task> dispatchTask;
+        Pointer<TaskRunner> dispatchRunner;
+
+        NioIOTransportImpl(const Pointer<NioReactor> reactor) :
+            reactor(reactor), socket(NULL), wireFormat(NULL), channel(), lock(), registration(NULL),
+            buffer(INITIAL_BUFFER_SIZE), position(0), limit(0), dispatchLock(), dispatchQueue(),
+            queuedBytes(0), readingPaused(false), readError(), dispatchTask(), dispatchRunner() {
+        }
+
+        /**
+         * Takes the transport out of the reactor, once this returns the reactor no longer
+         * calls processReadable.
+         */
+        void unregister() {
+
+            NioRegistration* current = NULL;
+            synchronized(&lock) {
+                current = registration;
+                registration = NULL;
+            }
+
+            if (current != NULL) {
+                reactor->unregisterTransport(current);
+            }
+        }
+
+        /**
+         * Moves the unread bytes to the front of the buffer if needed and grows it so that
+         * a frame of the given length fits from the first unread byte on, with room left
+         * to read at least MIN_READ_SIZE bytes past the data already buffered.
+         */
+        void makeRoom(int frameLength) {
+
+            int pending = limit - position;
+            int required = std::max(frameLength, pending + MIN_READ_SIZE);
+
+            if ((int) buffer.size() - position >= required) {
+                return;
+            }
+
+            if (position > 0) {
+                ::memmove(&buffer[0], &buffer[position], pending);
+                position = 0;
+                limit = pending;
+            }
+
+            if ((int) buffer.size() < required) {
+                buffer.resize(required);
+            }
+        }
+
+        /**
+         * Stops or resumes reading from the socket, called with the dispatchLock held so
+         * that pausing and resuming can't pass each other.
+         */
+        void setReading(bool reading) {
+            try {
+                synchronized(&lock) {
+                    reactor->setReading(registration, reading);
+                }
+            }
+            AMQ_CATCHALL_NOTHROW()
+        }
+
+        void enqueue(const Pointer<Command>& command, int size) {
+            synchronized(&dispatchLock) {
+                dispatchQueue.push_back(std::make_pair(command, size));
+                queuedBytes += size;
+
+                if (!readingPaused && queuedBytes >= MAX_QUEUED_BYTES) {
+                    readingPaused = true;
+                    setReading(false);
+                }
+            }
+        }
+
+        void fail(const ActiveMQException& error) {
+            synchronized(&dispatchLock) {
+                readError.reset(error.clone());
+            }
+
+            wakeupDispatcher();
+        }
+
+        void wakeupDispatcher() {
+            if (dispatchRunner != NULL) {
+                dispatchRunner->wakeup();
+            }
+        }
+
+        /**
+         * Stops delivering commands and drops those still queued, the reactor must no
+         * longer be calling processReadable.
+         */
+        void stopDispatching() {
+
+            if (dispatchRunner != NULL) {
+                dispatchRunner->shutdown();
+            }
+
+            synchronized(&dispatchLock) {
+                dispatchQueue.clear();
+                queuedBytes = 0;
+                readingPaused = false;
+                readError.reset(NULL);
+            }
+        }
+
+        void reset() {
+            position = 0;
+            limit = 0;
+
+            // Don't hang on to the memory of an unusually large frame.
+            if ((int) buffer.size() > MAX_RETAINED_BUFFER_SIZE) {
+                std::vector<unsigned char>(INITIAL_BUFFER_SIZE).swap(buffer);
+            }
+        }
+    };
+
+    const int NioIOTransportImpl::INITIAL_BUFFER_SIZE = 65536;
+    const int NioIOTransportImpl::MIN_READ_SIZE = 8192;
+    const int NioIOTransportImpl::MAX_RETAINED_BUFFER_SIZE = 1024 * 1024;
+    const int NioIOTransportImpl::MAX_QUEUED_BYTES = 4 * 1024 * 1024;
+
+    /**
+     * Hands a transport's queued commands to its listener one at a time, run on the
+     * reactor's dispatch threads.  Nothing of the transport is touched after a command
+     * is delivered since the listener may have closed and destroyed it.
+     */
+    class NioDispatchTask : public Task {
+    private:
+
+        NioIOTransport* transport;
+
+    private:
+
+        NioDispatchTask(const NioDispatchTask&);
+        NioDispatchTask& operator= (const NioDispatchTask&);
+
+    public:
+
+        NioDispatchTask(NioIOTransport* transport) : Task(), transport(transport) {}
+
+        virtual ~NioDispatchTask() {}
+
+        virtual bool iterate() {
+
+            NioIOTransportImpl* impl = transport->impl;
+
+            Pointer<Command> command;
+            Pointer<ActiveMQException> error;
+            bool more = false;
+
+            synchronized(&impl->dispatchLock) {
+
+                if (!impl->dispatchQueue.empty()) {
+                    command = impl->dispatchQueue.front().first;
+                    impl->queuedBytes -= impl->dispatchQueue.front().second;
+                    impl->dispatchQueue.pop_front();
+
+                    if (impl->readingPaused && impl->queuedBytes <= NioIOTransportImpl::MAX_QUEUED_BYTES / 2) {
+                        impl->readingPaused = false;
+                        impl->setReading(true);
+                    }
+                } else if (impl->readError != NULL) {
+                    error.swap(impl->readError);
+                }
+
+                more = !impl->dispatchQueue.empty() || impl->readError != NULL;
+            }
+
+            if (command != NULL) {
+                transport->fire(command);
+            } else if (error != NULL) {
+                transport->fire(*error);
+            }
+
+            return more;
+        }
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+NioIOTransport::NioIOTransport(const Pointer<WireFormat> wireFormat, const Pointer<NioReactor> reactor) :
+    IOTransport(wireFormat), impl(new NioIOTransportImpl(reactor)) {
+
+    this->impl->dispatchTask.reset(new NioDispatchTask(this));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+NioIOTransport::~NioIOTransport() {
+    try {
+        close();
+    }
+    AMQ_CATCHALL_NOTHROW()
+
+    try {
+        delete this->impl;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioIOTransport::setSocket(Socket* socket) {
+    this->impl->socket = socket;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioIOTransport::startReading() {
+
+    try {
+
+        // Without the size prefix the frame boundaries are only found by parsing, so
+        // that case keeps the blocking reader thread.
+        OpenWireFormat* openWire = dynamic_cast<OpenWireFormat*>(getWireFormat().get());
+        if (openWire == NULL || openWire->getPreferedWireFormatInfo() == NULL ||
+            openWire->getPreferedWireFormatInfo()->isSizePrefixDisabled()) {
+
+            IOTransport::startReading();
+            return;
+        }
+
+        if (impl->socket == NULL) {
+            throw IOException(__FILE__, __LINE__, "NioIOTransport::startReading() - Socket must be set before calling start");
+        }
+
+        impl->wireFormat = openWire;
+        impl->channel.reset(new SocketChannel(impl->socket));
+
+        if (impl->dispatchRunner == NULL) {
+            impl->dispatchRunner = impl->reactor->createDispatchRunner(impl->dispatchTask.get());
+            impl->dispatchRunner->start();
+        }
+
+        synchronized(&impl->lock) {
+            impl->registration = impl->reactor->registerTransport(impl->channel.get(), this);
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioIOTransport::stopReading() {
+
+    try {
+        impl->unregister();
+        impl->stopDispatching();
+    }
+    AMQ_CATCHALL_NOTHROW()
+
+    IOTransport::stopReading();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioIOTransport::stop() {
+
+    try {
+        // The socket is closed once the transports above are stopped so the reactor has
+        // to let go of it first.
+        impl->unregister();
+        impl->stopDispatching();
+
+        IOTransport::stop();
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioIOTransport::close() {
+
+    try {
+        impl->unregister();
+        impl->stopDispatching();
+
+        IOTransport::close();
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioIOTransport::processReadable() {
+
+    try {
+
+        if (isClosed()) {
+            return;
+        }
+
+        impl->makeRoom(0);
+
+        int count = impl->channel->read(&impl->buffer[0], (int) impl->buffer.size(),
+                                        impl->limit, (int) impl->buffer.size() - impl->limit);
+        if (count < 0) {
+            throw EOFException(__FILE__, __LINE__, "NioIOTransport::processReadable() - connection closed by the remote peer");
+        }
+
+        impl->limit += count;
+
+        while (!isClosed()) {
+
+            int available = impl->limit - impl->position;
+            if (available < 4) {
+                break;
+            }
+
+            const unsigned char* frame = &impl->buffer[impl->position];
+            int size = (int) (((unsigned int) frame[0] << 24) | ((unsigned int) frame[1] << 16) |
+                              ((unsigned int) frame[2] << 8) | (unsigned int) frame[3]);
+
+            // Checked before growing the buffer for it, a peer must not be able to make
+            // this allocate whatever the size prefix says.
+            impl->wireFormat->checkFrameSize(size);
+            if (size > Integer::MAX_VALUE - 4) {
+                throw IOException(__FILE__, __LINE__, "NioIOTransport::processReadable() - Invalid frame size: %d", size);
+            }
+
+            if (available - 4 < size) {
+                impl->makeRoom(size + 4);
+                break;
+            }
+
+            ByteArrayInputStream bytes(frame, size + 4);
+            DataInputStream input(&bytes);
+            Pointer<Command> command(getWireFormat()->unmarshal(this, &input));
+
+            impl->position += size + 4;
+
+            impl->enqueue(command, size + 4);
+        }
+
+        if (impl->position == impl->limit) {
+            impl->reset();
+        }
+
+        impl->wakeupDispatcher();
+
+    } catch (exceptions::ActiveMQException& ex) {
+        ex.setMark(__FILE__, __LINE__);
+        impl->unregister();
+        impl->fail(ex);
+    } catch (decaf::lang::Exception& ex) {
+        exceptions::ActiveMQException exl(ex);
+        exl.setMark(__FILE__, __LINE__);
+        impl->unregister();
+        impl->fail(exl);
+    } catch (...) {
+        exceptions::ActiveMQException ex(__FILE__, __LINE__, "NioIOTransport::processReadable - caught unknown exception");
+        impl->unregister();
+        impl->fail(ex);
+    }
+}
@@ -0,0 +1,122 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_NIO_NIOIOTRANSPORT_H_
+#define _ACTIVEMQ_TRANSPORT_NIO_NIOIOTRANSPORT_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/transport/IOTransport.h>
+#include <activemq/transport/nio/NioReactor.h>
+#include <activemq/wireformat/WireFormat.h>
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/net/Socket.h>
+
+namespace activemq {
+namespace transport {
+namespace nio {
+
+    using decaf::lang::Pointer;
+
+    class NioIOTransportImpl;
+    class NioDispatchTask;
+
+    /**
+     * An IOTransport that doesn't dedicate a thread to reading its socket, instead the
+     * socket is registered with a shared NioReactor which calls processReadable when data
+     * arrives.  Whatever is available is appended to a frame buffer and each complete
+     * size prefixed frame is unmarshaled from memory and queued for the listener.  The
+     * queued commands are passed to the listener in order by a runner on the reactor's
+     * dispatch threads, the transport stops reading while too much is queued.
+     *
+     * Reading from the reactor relies on the OpenWire size prefix to find the frame
+     * boundaries, when the WireFormat is not OpenWire or size prefixing was disabled the
+     * transport falls back to the blocking reader thread of the IOTransport.  Writes are
+     * made by the calling threads exactly as they are in the IOTransport.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API NioIOTransport : public IOTransport {
+    private:
+
+        NioIOTransportImpl* impl;
+
+    private:
+
+        friend class NioDispatchTask;
+
+    private:
+
+        NioIOTransport(const NioIOTransport&);
+        NioIOTransport& operator=(const NioIOTransport&);
+
+    public:
+
+        /**
+         * Creates a new instance that reads through the given reactor.
+         *
+         * @param wireFormat
+         *      Data encoder / decoder to use when reading and writing.
+         * @param reactor
+         *      The reactor whose threads read from this transport's socket.
+         */
+        NioIOTransport(const Pointer<wireformat::WireFormat> wireFormat, const Pointer<NioReactor> reactor);
+
+        virtual ~NioIOTransport();
+
+        /**
+         * Sets the connected Socket that the input stream reads from, this must be set
+         * before the transport is started.  The Socket is not owned by this object.
+         *
+         * @param socket
+         *      The Socket to register with the reactor.
+         */
+        void setSocket(decaf::net::Socket* socket);
+
+        /**
+         * Called from a reactor thread when the socket has data to read, reads what is
+         * available and queues every command that is now complete for the listener.
+         * Errors end reading from the socket and are passed to the exception listener
+         * once the commands queued before them have been delivered.
+         */
+        void processReadable();
+
+    public:  // Transport methods
+
+        virtual void stop();
+
+        virtual void close();
+
+        virtual Transport* narrow(const std::type_info& typeId) {
+            if (typeid(*this) == typeId || typeid(IOTransport) == typeId) {
+                return this;
+            }
+
+            return NULL;
+        }
+
+    protected:
+
+        virtual void startReading();
+
+        virtual void stopReading();
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_NIO_NIOIOTRANSPORT_H_ */
@@ -0,0 +1,293 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NioReactor.h"
+
+#include <activemq/transport/nio/NioIOTransport.h>
+#include <activemq/exceptions/ActiveMQException.h>
+#include <activemq/threads/TaskRunnerFactory.h>
+
+#include <decaf/nio/channels/Selector.h>
+#include <decaf/nio/channels/SelectionKey.h>
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::threads;
+using namespace activemq::transport;
+using namespace activemq::transport::nio;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::nio::channels;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace activemq {
+namespace transport {
+namespace nio {
+
+    class SelectorThread;
+
+    /**
+     * Ties a transport to its selection key.  The reactor thread holds the lock while
+     * it calls the transport so that unregistering can wait out a call in progress,
+     * the registration itself is only destroyed by the reactor thread once it can no
+     * longer be referenced by a selected key.
+     */
+    class NioRegistration {
+    private:
+
+        NioRegistration(const NioRegistration&);
+        NioRegistration& operator= (const NioRegistration&);
+
+    public:
+
+        Mutex lock;
+        NioIOTransport* transport;
+        SelectionKey* key;
+        SelectorThread* owner;
+
+        NioRegistration(NioIOTransport* transport, SelectorThread* owner) :
+            lock(), transport(transport), key(NULL), owner(owner) {
+        }
+
+        void dispatch() {
+            synchronized(&lock) {
+                if (transport != NULL) {
+                    transport->processReadable();
+                }
+            }
+        }
+    };
+
+    class SelectorThread : public Runnable {
+    private:
+
+        SelectorThread(const SelectorThread&);
+        SelectorThread& operator= (const SelectorThread&);
+
+    public:
+
+        Selector selector;
+        AtomicBoolean running;
+        Pointer<Thread> thread;
+
+        // Registrations that were removed, destroyed by this thread before its next
+        // select so that none of them can still be in the selected key list.
+        Mutex retiredLock;
+        std::vector<NioRegistration*> retired;
+
+        SelectorThread(const std::string& name) : selector(), running(true), thread(), retiredLock(), retired() {
+            thread.reset(new Thread(this, name));
+        }
+
+        virtual ~SelectorThread() {
+            releaseRetired();
+        }
+
+        void retire(NioRegistration* registration) {
+            synchronized(&retiredLock) {
+                retired.push_back(registration);
+            }
+        }
+
+        void releaseRetired() {
+            std::vector<NioRegistration*> released;
+            synchronized(&retiredLock) {
+                released.swap(retired);
+            }
+
+            std::vector<NioRegistration*>::const_iterator iter = released.begin();
+            for (; iter != released.end(); ++iter) {
+                delete *iter;
+            }
+        }
+
+        void shutdown() {
+            if (running.compareAndSet(true, false)) {
+                selector.wakeup();
+
+                if (Thread::currentThread() != thread.get()) {
+                    thread->join();
+                }
+            }
+        }
+
+        virtual void run() {
+
+            while (running.get()) {
+
+                releaseRetired();
+
+                try {
+                    if (selector.select() == 0) {
+                        continue;
+                    }
+                } catch (IllegalStateException&) {
+                    break;
+                } catch (Exception&) {
+                    continue;
+                }
+
+                const std::vector<SelectionKey*>& keys = selector.selectedKeys();
+                std::vector<SelectionKey*>::const_iterator iter = keys.begin();
+                for (; iter != keys.end() && running.get(); ++iter) {
+                    if ((*iter)->isValid()) {
+                        static_cast<NioRegistration*>((*iter)->attachment())->dispatch();
+                    }
+                }
+            }
+        }
+    };
+
+    class NioReactorImpl {
+    private:
+
+        NioReactorImpl(const NioReactorImpl&);
+        NioReactorImpl& operator= (const NioReactorImpl&);
+
+    public:
+
+        std::vector<SelectorThread*> threads;
+        AtomicInteger nextThread;
+        TaskRunnerFactory dispatchRunners;
+
+        NioReactorImpl(int dispatchThreadCount) :
+            threads(), nextThread(0), dispatchRunners("ActiveMQ NIO Dispatch", false, dispatchThreadCount) {
+        }
+
+        ~NioReactorImpl() {
+            std::vector<SelectorThread*>::const_iterator iter = threads.begin();
+            for (; iter != threads.end(); ++iter) {
+                try {
+                    (*iter)->shutdown();
+                    delete *iter;
+                }
+                AMQ_CATCHALL_NOTHROW()
+            }
+
+            try {
+                dispatchRunners.shutdown();
+            }
+            AMQ_CATCHALL_NOTHROW()
+        }
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+NioReactor::NioReactor(int threadCount, int dispatchThreadCount) : impl(new NioReactorImpl(dispatchThreadCount)) {
+
+    try {
+
+        if (threadCount < 1) {
+            threadCount = 1;
+        }
+
+        for (int i = 0; i < threadCount; ++i) {
+            impl->threads.push_back(new SelectorThread(
+                std::string("ActiveMQ NIO Reactor Thread-") + Integer::toString(i + 1)));
+        }
+
+        std::vector<SelectorThread*>::const_iterator iter = impl->threads.begin();
+        for (; iter != impl->threads.end(); ++iter) {
+            (*iter)->thread->start();
+        }
+    } catch (...) {
+        delete impl;
+        throw;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+NioReactor::~NioReactor() {
+    try {
+        delete this->impl;
+    }
+    AMQ_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int NioReactor::getThreadCount() const {
+    return (int) this->impl->threads.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+NioRegistration* NioReactor::registerTransport(SocketChannel* channel, NioIOTransport* transport) {
+
+    try {
+
+        unsigned int index = (unsigned int) impl->nextThread.getAndIncrement() % (unsigned int) impl->threads.size();
+        SelectorThread* owner = impl->threads[index];
+
+        std::auto_ptr<NioRegistration> registration(new NioRegistration(transport, owner));
+        registration->key = channel->registerWith(&owner->selector, SelectionKey::OP_READ, registration.get());
+
+        return registration.release();
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioReactor::unregisterTransport(NioRegistration* registration) {
+
+    if (registration == NULL) {
+        return;
+    }
+
+    registration->key->cancel();
+
+    // Waits for a call to the transport that is in progress on the reactor thread.
+    synchronized(&registration->lock) {
+        registration->transport = NULL;
+    }
+
+    registration->owner->retire(registration);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioReactor::setReading(NioRegistration* registration, bool reading) {
+
+    if (registration == NULL) {
+        return;
+    }
+
+    try {
+        registration->key->interestOps(reading ? SelectionKey::OP_READ : 0);
+    } catch (IllegalStateException& ex) {
+        // The key was cancelled, the transport is leaving the reactor anyway.
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<TaskRunner> NioReactor::createDispatchRunner(Task* task) {
+    return impl->dispatchRunners.createTaskRunner(task);
+}
@@ -0,0 +1,141 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_NIO_NIOREACTOR_H_
+#define _ACTIVEMQ_TRANSPORT_NIO_NIOREACTOR_H_
+
+#include <activemq/util/Config.h>
+#include <activemq/threads/Task.h>
+#include <activemq/threads/TaskRunner.h>
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/nio/channels/SocketChannel.h>
+#include <decaf/io/IOException.h>
+
+namespace activemq {
+namespace transport {
+namespace nio {
+
+    class NioIOTransport;
+    class NioReactorImpl;
+    class NioRegistration;
+
+    /**
+     * A fixed pool of threads that each wait on a Selector for any of the sockets
+     * registered with it to become readable, and then have the owning NioIOTransport
+     * read and dispatch whatever arrived.  This lets any number of connections share a
+     * handful of I/O threads instead of each one parking a reader thread in a blocking
+     * read.
+     *
+     * Transports are spread over the threads round robin as they register.  The reactor
+     * threads only read and frame, the commands are handed to the transport listener by
+     * a runner from a second, pooled set of dispatch threads so that a slow listener
+     * doesn't hold up reading for the other connections on the same reactor thread.  A
+     * listener that blocks still holds one of the dispatch threads while it does.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API NioReactor {
+    private:
+
+        NioReactorImpl* impl;
+
+    private:
+
+        NioReactor(const NioReactor&);
+        NioReactor& operator=(const NioReactor&);
+
+    public:
+
+        /**
+         * Creates the reactor and starts its threads.
+         *
+         * @param threadCount
+         *      The number of selector threads, values less than one are treated as one.
+         * @param dispatchThreadCount
+         *      The most threads that deliver commands to the transport listeners, zero or
+         *      less sizes it to the number of processors.
+         *
+         * @throw IOException if a Selector can't be created.
+         */
+        NioReactor(int threadCount, int dispatchThreadCount = 0);
+
+        /**
+         * Stops the reactor threads, any transports still registered are no longer
+         * read from.  Dispatch runners must have been shut down before this.
+         */
+        virtual ~NioReactor();
+
+        /**
+         * @return the number of selector threads this reactor runs.
+         */
+        int getThreadCount() const;
+
+        /**
+         * Registers the channel with one of the reactor's selectors, from then on the
+         * transport's processReadable method is called from that selector's thread
+         * whenever the channel has data to read.
+         *
+         * @param channel
+         *      The channel for the transport's socket.
+         * @param transport
+         *      The transport that reads from the channel.
+         *
+         * @return the registration, to be passed to unregisterTransport.
+         *
+         * @throw IOException if the channel can't be registered.
+         */
+        NioRegistration* registerTransport(decaf::nio::channels::SocketChannel* channel, NioIOTransport* transport);
+
+        /**
+         * Removes a registration made with registerTransport.  Once this returns the
+         * transport is not being called and won't be called again, so it may be closed
+         * and destroyed; this can be called from within processReadable.
+         *
+         * @param registration
+         *      The registration to remove, it must not be used again afterwards.
+         */
+        void unregisterTransport(NioRegistration* registration);
+
+        /**
+         * Stops or resumes selecting a registration's channel for reading, so a transport
+         * can stop reading while its listener has a backlog to catch up on.  The caller
+         * must make sure the registration isn't being removed at the same time.
+         *
+         * @param registration
+         *      The registration whose channel is to be read from or not.
+         * @param reading
+         *      true to read from the channel, false to leave it until resumed.
+         */
+        void setReading(NioRegistration* registration, bool reading);
+
+        /**
+         * Creates an unstarted runner for the given Task that shares the reactor's pool of
+         * dispatch threads, the runner must be shut down before the reactor is destroyed.
+         *
+         * @param task
+         *      The Task that delivers a transport's commands, must outlive the runner.
+         *
+         * @return a new, unstarted TaskRunner.
+         */
+        decaf::lang::Pointer<activemq::threads::TaskRunner> createDispatchRunner(activemq::threads::Task* task);
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_NIO_NIOREACTOR_H_ */
@@ -0,0 +1,58 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NioTransport.h"
+
+#include <activemq/transport/nio/NioIOTransport.h>
+#include <activemq/exceptions/ActiveMQException.h>
+
+using namespace activemq;
+using namespace activemq::transport;
+using namespace activemq::transport::nio;
+using namespace activemq::transport::tcp;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+NioTransport::NioTransport(const Pointer<Transport> next, const decaf::net::URI& location) :
+    TcpTransport(next, location) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+NioTransport::~NioTransport() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioTransport::beforeNextIsStarted() {
+
+    try {
+
+        TcpTransport::beforeNextIsStarted();
+
+        NioIOTransport* ioTransport = dynamic_cast<NioIOTransport*>(next.get());
+        if (ioTransport == NULL) {
+            throw IOException(__FILE__, __LINE__, "NioTransport::beforeNextIsStarted - "
+                    "transport must be of type NioIOTransport");
+        }
+
+        ioTransport->setSocket(getSocket());
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
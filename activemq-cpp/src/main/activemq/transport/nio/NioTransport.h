@@ -0,0 +1,67 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_NIO_NIOTRANSPORT_H_
+#define _ACTIVEMQ_TRANSPORT_NIO_NIOTRANSPORT_H_
+
+#include <activemq/util/Config.h>
+
+#include <activemq/transport/tcp/TcpTransport.h>
+
+namespace activemq {
+namespace transport {
+namespace nio {
+
+    using decaf::lang::Pointer;
+
+    /**
+     * A TcpTransport whose incoming data is read by a shared NioReactor, it connects the
+     * socket in the same way as the TcpTransport and then hands it to the NioIOTransport
+     * that it wraps so that it can be registered with the reactor.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API NioTransport : public tcp::TcpTransport {
+    private:
+
+        NioTransport(const NioTransport&);
+        NioTransport& operator=(const NioTransport&);
+
+    public:
+
+        /**
+         * Creates a new instance of a NioTransport, the transport is left unconnected
+         * until it is started.
+         *
+         * @param next
+         *      The next transport in the chain, must be a NioIOTransport.
+         * @param location
+         *      The URI of the host this transport is to connect to.
+         */
+        NioTransport(const Pointer<Transport> next, const decaf::net::URI& location);
+
+        virtual ~NioTransport();
+
+    protected:
+
+        virtual void beforeNextIsStarted();
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_NIO_NIOTRANSPORT_H_ */
@@ -0,0 +1,106 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NioTransportFactory.h"
+
+#include <activemq/transport/nio/NioIOTransport.h>
+#include <activemq/transport/nio/NioTransport.h>
+#include <activemq/transport/async/AsyncWriteTransport.h>
+#include <activemq/transport/inactivity/InactivityMonitor.h>
+#include <activemq/transport/logging/LoggingTransport.h>
+#include <activemq/wireformat/WireFormat.h>
+
+#include <decaf/lang/System.h>
+
+using namespace activemq;
+using namespace activemq::wireformat;
+using namespace activemq::transport;
+using namespace activemq::transport::nio;
+using namespace activemq::transport::async;
+using namespace activemq::transport::inactivity;
+using namespace activemq::transport::logging;
+using namespace activemq::exceptions;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+NioTransportFactory::NioTransportFactory() : TcpTransportFactory(), reactorLock(), reactor() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+NioTransportFactory::~NioTransportFactory() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<NioReactor> NioTransportFactory::getReactor() {
+
+    synchronized(&reactorLock) {
+        if (this->reactor == NULL) {
+            this->reactor.reset(new NioReactor(System::availableProcessors()));
+        }
+    }
+
+    return this->reactor;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<Transport> NioTransportFactory::doCreateComposite(const decaf::net::URI& location,
+                                                          const Pointer<wireformat::WireFormat> wireFormat,
+                                                          const decaf::util::Properties& properties) {
+
+    try {
+
+        Pointer<Transport> transport(new NioIOTransport(wireFormat, getReactor()));
+
+        transport.reset(new NioTransport(transport, location));
+
+        // Give this class and any derived classes a chance to apply value that
+        // are set in the properties object.
+        doConfigureTransport(transport, properties);
+
+        // Optionally move the socket writes onto their own thread, this sits below
+        // the InactivityMonitor so that its write checks still see every command.
+        if (properties.getProperty("transport.asyncWrite", "false") == "true") {
+            transport.reset(new AsyncWriteTransport(transport, properties));
+        }
+
+        if (properties.getProperty("transport.useInactivityMonitor", "true") == "true") {
+            transport.reset(new InactivityMonitor(transport, properties, wireFormat));
+        }
+
+        // If command tracing was enabled, wrap the transport with a logging transport.
+        // We support the old CMS value, the ActiveMQ trace value and the NMS useLogging
+        // value in order to be more friendly.
+        if (properties.getProperty("transport.commandTracingEnabled", "false") == "true" ||
+            properties.getProperty("transport.useLogging", "false") == "true" ||
+            properties.getProperty("transport.trace", "false") == "true") {
+
+            transport.reset(new LoggingTransport(transport));
+        }
+
+        if (wireFormat->hasNegotiator()) {
+            transport = wireFormat->createNegotiator(transport);
+        }
+
+        return transport;
+    }
+    AMQ_CATCH_RETHROW(ActiveMQException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
+    AMQ_CATCHALL_THROW(ActiveMQException)
+}
@@ -0,0 +1,74 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_NIO_NIOTRANSPORTFACTORY_H_
+#define _ACTIVEMQ_TRANSPORT_NIO_NIOTRANSPORTFACTORY_H_
+
+#include <activemq/util/Config.h>
+
+#include <activemq/transport/tcp/TcpTransportFactory.h>
+#include <activemq/transport/nio/NioReactor.h>
+
+#include <decaf/util/concurrent/Mutex.h>
+
+namespace activemq {
+namespace transport {
+namespace nio {
+
+    using decaf::lang::Pointer;
+
+    /**
+     * Factory for "nio" transports, these are TCP transports whose sockets are read by a
+     * NioReactor shared by every transport the factory creates.  The reactor is started
+     * when the first transport is created and runs one selector thread per available
+     * processor, it stops once the factory and all of its transports are gone.
+     *
+     * @since 3.10.0
+     */
+    class AMQCPP_API NioTransportFactory : public tcp::TcpTransportFactory {
+    private:
+
+        decaf::util::concurrent::Mutex reactorLock;
+        Pointer<NioReactor> reactor;
+
+    private:
+
+        NioTransportFactory(const NioTransportFactory&);
+        NioTransportFactory& operator=(const NioTransportFactory&);
+
+    public:
+
+        NioTransportFactory();
+
+        virtual ~NioTransportFactory();
+
+    protected:
+
+        virtual Pointer<Transport> doCreateComposite(const decaf::net::URI& location,
+                                                     const Pointer<wireformat::WireFormat> wireFormat,
+                                                     const decaf::util::Properties& properties);
+
+        /**
+         * @return the reactor shared by the transports of this factory, created on first use.
+         */
+        Pointer<NioReactor> getReactor();
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_NIO_NIOTRANSPORTFACTORY_H_ */
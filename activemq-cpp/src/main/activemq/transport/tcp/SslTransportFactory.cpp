@@ -20,6 +20,7 @@
 #include <activemq/transport/tcp/SslTransport.h>
 
 #include <activemq/transport/IOTransport.h>
+#include <activemq/transport/async/AsyncWriteTransport.h>
 #include <activemq/transport/inactivity/InactivityMonitor.h>
 #include <activemq/transport/logging/LoggingTransport.h>
 
@@ -30,6 +31,7 @@ using namespace activemq;
 using namespace activemq::io;
 using namespace activemq::transport;
 using namespace activemq::transport::logging;
+using namespace activemq::transport::async;
 using namespace activemq::transport::inactivity;
 using namespace activemq::transport::tcp;
 using namespace activemq::exceptions;
@@ -58,6 +60,12 @@ Pointer<Transport> SslTransportFactory::doCreateComposite(const decaf::net::URI&
         // are set in the properties object.
         doConfigureTransport(transport, properties);
 
+        // Optionally move the socket writes onto their own thread, this sits below
+        // the InactivityMonitor so that its write checks still see every command.
+        if (properties.getProperty("transport.asyncWrite", "false") == "true") {
+            transport.reset(new AsyncWriteTransport(transport, properties));
+        }
+
         if (properties.getProperty("transport.useInactivityMonitor", "true") == "true") {
             transport.reset(new InactivityMonitor(transport, properties, wireFormat));
         }
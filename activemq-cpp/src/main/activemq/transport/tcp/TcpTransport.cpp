@@ -72,6 +72,8 @@ namespace tcp {
         int soReceiveBufferSize;
         int soSendBufferSize;
         bool tcpNoDelay;
+        int soBusyPoll;
+        int receiveSpinTime;
 
         TcpTransportImpl(const decaf::net::URI& location) :
             connectTimeout(0),
@@ -86,7 +88,9 @@ namespace tcp {
             soKeepAlive(false),
             soReceiveBufferSize(-1),
             soSendBufferSize(-1),
-            tcpNoDelay(true) {
+            tcpNoDelay(true),
+            soBusyPoll(0),
+            receiveSpinTime(0) {
         }
     };
 }}}
@@ -256,6 +260,14 @@ void TcpTransport::configureSocket(Socket* socket) {
         if (soSendBufferSize > 0) {
             socket->setSendBufferSize(soSendBufferSize);
         }
+
+        if (this->impl->soBusyPoll > 0) {
+            socket->setBusyPoll(this->impl->soBusyPoll);
+        }
+
+        if (this->impl->receiveSpinTime > 0) {
+            socket->setReceiveSpinTime(this->impl->receiveSpinTime);
+        }
     }
     DECAF_CATCH_RETHROW(NullPointerException)
     DECAF_CATCH_RETHROW(IllegalArgumentException)
@@ -363,7 +375,32 @@ bool TcpTransport::isTcpNoDelay() const {
     return this->impl->tcpNoDelay;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void TcpTransport::setBusyPoll(int soBusyPoll) {
+    this->impl->soBusyPoll = soBusyPoll;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int TcpTransport::getBusyPoll() const {
+    return this->impl->soBusyPoll;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpTransport::setReceiveSpinTime(int receiveSpinTime) {
+    this->impl->receiveSpinTime = receiveSpinTime;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int TcpTransport::getReceiveSpinTime() const {
+    return this->impl->receiveSpinTime;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 decaf::net::URI TcpTransport::getLocation() const {
     return this->impl->location;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+Socket* TcpTransport::getSocket() const {
+    return this->impl->socket.get();
+}
@@ -97,6 +97,12 @@ namespace tcp {
         void setTcpNoDelay(bool tcpNoDelay);
         bool isTcpNoDelay() const;
 
+        void setBusyPoll(int soBusyPoll);
+        int getBusyPoll() const;
+
+        void setReceiveSpinTime(int receiveSpinTime);
+        int getReceiveSpinTime() const;
+
     public: // Transport Methods
 
         virtual bool isFaultTolerant() const {
@@ -109,6 +115,14 @@ namespace tcp {
 
         decaf::net::URI getLocation() const;
 
+        /**
+         * Gets the Socket this transport created when it connected, the Socket remains
+         * owned by this object.
+         *
+         * @return the connected Socket or NULL if this transport hasn't connected yet.
+         */
+        decaf::net::Socket* getSocket() const;
+
         virtual void beforeNextIsStarted();
 
         virtual void afterNextIsStopped();
@@ -21,12 +21,15 @@
 #include <activemq/transport/tcp/TcpTransport.h>
 #include <activemq/transport/correlator/ResponseCorrelator.h>
 #include <activemq/transport/logging/LoggingTransport.h>
+#include <activemq/transport/async/AsyncWriteTransport.h>
 #include <activemq/transport/inactivity/InactivityMonitor.h>
 #include <activemq/util/URISupport.h>
 #include <activemq/wireformat/WireFormat.h>
 #include <decaf/util/Properties.h>
 #include <decaf/lang/Integer.h>
 #include <decaf/lang/Boolean.h>
+#include <decaf/lang/Long.h>
+#include <typeinfo>
 
 using namespace activemq;
 using namespace activemq::util;
@@ -35,6 +38,7 @@ using namespace activemq::transport;
 using namespace activemq::transport::tcp;
 using namespace activemq::transport::correlator;
 using namespace activemq::transport::logging;
+using namespace activemq::transport::async;
 using namespace activemq::transport::inactivity;
 using namespace activemq::exceptions;
 using namespace decaf;
@@ -95,6 +99,12 @@ Pointer<Transport> TcpTransportFactory::doCreateComposite(const decaf::net::URI&
         // are set in the properties object.
         doConfigureTransport(transport, properties);
 
+        // Optionally move the socket writes onto their own thread, this sits below
+        // the InactivityMonitor so that its write checks still see every command.
+        if (properties.getProperty("transport.asyncWrite", "false") == "true") {
+            transport.reset(new AsyncWriteTransport(transport, properties));
+        }
+
         if (properties.getProperty("transport.useInactivityMonitor", "true") == "true") {
             transport.reset(new InactivityMonitor(transport, properties, wireFormat));
         }
@@ -137,6 +147,15 @@ void TcpTransportFactory::doConfigureTransport(Pointer<Transport> transport,
         tcp->setSendBufferSize(Integer::parseInt(properties.getProperty("soSendBufferSize", "-1")));
         tcp->setTcpNoDelay(Boolean::parseBoolean(properties.getProperty("tcpNoDelay", "true")));
         tcp->setConnectTimeout(Integer::parseInt(properties.getProperty("soConnectTimeout", "0")));
+        tcp->setBusyPoll(Integer::parseInt(properties.getProperty("soBusyPoll", "0")));
+        tcp->setReceiveSpinTime(Integer::parseInt(properties.getProperty("receiveSpinTime", "0")));
+
+        IOTransport* io = dynamic_cast<IOTransport*>(tcp->narrow(typeid(IOTransport)));
+        if (io != NULL) {
+            io->setMaxWriteBatchSize(Integer::parseInt(properties.getProperty("transport.maxWriteBatchSize", "65536")));
+            io->setMaxWriteBatchDelay(Long::parseLong(properties.getProperty("transport.maxWriteBatchDelay", "0")));
+            io->setUnmarshalThreads(Integer::parseInt(properties.getProperty("transport.unmarshalThreads", "0")));
+        }
     }
     AMQ_CATCH_RETHROW(ActiveMQException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, ActiveMQException)
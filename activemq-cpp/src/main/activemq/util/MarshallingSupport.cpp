@@ -21,12 +21,15 @@
 #include <activemq/exceptions/ExceptionDefines.h>
 #include <decaf/lang/Short.h>
 #include <decaf/lang/Integer.h>
+#include <decaf/lang/Long.h>
+#include <decaf/internal/util/StringUtils.h>
 
 using namespace activemq;
 using namespace activemq::util;
 using namespace decaf;
 using namespace decaf::io;
 using namespace decaf::lang;
+using namespace decaf::internal::util;
 using namespace std;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -101,14 +104,13 @@ void MarshallingSupport::writeString32(decaf::io::DataOutputStream& dataOut, con
 std::string MarshallingSupport::readString16(decaf::io::DataInputStream& dataIn) {
 
     try {
+        std::string value;
         int utfLength = dataIn.readShort();
         if (utfLength > 0) {
-
-            std::vector<unsigned char> buffer(utfLength);
-            dataIn.readFully(&buffer[0], utfLength);
-            return std::string((char*) (&buffer[0]), utfLength);
+            value.resize(utfLength);
+            dataIn.readFully((unsigned char*) &value[0], utfLength);
         }
-        return "";
+        return value;
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, decaf::io::IOException)
@@ -119,14 +121,13 @@ std::string MarshallingSupport::readString16(decaf::io::DataInputStream& dataIn)
 std::string MarshallingSupport::readString32(decaf::io::DataInputStream& dataIn) {
 
     try {
+        std::string value;
         int utfLength = dataIn.readInt();
         if (utfLength > 0) {
-
-            std::vector<unsigned char> buffer(utfLength);
-            dataIn.readFully(&buffer[0], utfLength);
-            return std::string((char*) (&buffer[0]), utfLength);
+            value.resize(utfLength);
+            dataIn.readFully((unsigned char*) &value[0], utfLength);
         }
-        return "";
+        return value;
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, decaf::io::IOException)
@@ -136,61 +137,78 @@ std::string MarshallingSupport::readString32(decaf::io::DataInputStream& dataIn)
 ////////////////////////////////////////////////////////////////////////////////
 std::string MarshallingSupport::asciiToModifiedUtf8(const std::string& asciiString) {
 
+    try {
+        std::string result;
+        MarshallingSupport::asciiToModifiedUtf8(asciiString, result);
+        return result;
+    }
+    AMQ_CATCH_RETHROW(decaf::io::UTFDataFormatException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, decaf::io::UTFDataFormatException)
+    AMQ_CATCHALL_THROW(decaf::io::UTFDataFormatException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarshallingSupport::asciiToModifiedUtf8(const std::string& asciiString, std::string& result) {
+
     try {
 
-        if (asciiString.length() > 0) {
+        std::size_t length = asciiString.length();
+        const unsigned char* bytes = (const unsigned char*) asciiString.data();
 
-            int utfLength = 0;
-            std::size_t length = asciiString.length();
+        // Values 1-127 encode as themselves, only the rest needs converting.
+        std::size_t asciiLength = StringUtils::utf8SingleByteLength(bytes, length);
 
-            for (std::size_t i = 0; i < length; ++i) {
+        if (asciiLength == length) {
+            result.assign(asciiString);
+            return;
+        }
 
-                unsigned int charValue = (unsigned char) asciiString.at(i);
+        long long utfLength = (long long) asciiLength;
 
-                // Written to allow for expansion to wide character strings at some
-                // point, as it stands now the value can never be > 255 since the
-                // string class returns a single byte char.
-                if (charValue > 0 && charValue <= 127) {
-                    utfLength++;
-                } else if (charValue <= 2047) {
-                    utfLength += 2;
-                } else {
-                    utfLength += 3;
-                }
-            }
+        for (std::size_t i = asciiLength; i < length; ++i) {
+
+            unsigned int charValue = bytes[i];
 
-            if (utfLength > Integer::MAX_VALUE) {
-                throw UTFDataFormatException(__FILE__, __LINE__,
-                        (std::string("MarshallingSupport::asciiToModifiedUtf8 - Cannot marshall ")
-                                + "string utf8 encoding longer than: 2^31 bytes, supplied string utf8 encoding was: " + Integer::toString((int) utfLength)
-                                + " bytes long.").c_str());
+            // Written to allow for expansion to wide character strings at some
+            // point, as it stands now the value can never be > 255 since the
+            // string class returns a single byte char.
+            if (charValue > 0 && charValue <= 127) {
+                utfLength++;
+            } else if (charValue <= 2047) {
+                utfLength += 2;
+            } else {
+                utfLength += 3;
             }
+        }
 
-            std::string utfBytes((std::size_t) utfLength, '\0');
-            unsigned int utfIndex = 0;
+        if (utfLength > Integer::MAX_VALUE) {
+            throw UTFDataFormatException(__FILE__, __LINE__,
+                    (std::string("MarshallingSupport::asciiToModifiedUtf8 - Cannot marshall ")
+                            + "string utf8 encoding longer than: 2^31 bytes, supplied string utf8 encoding was: " + Long::toString(utfLength)
+                            + " bytes long.").c_str());
+        }
 
-            for (std::size_t i = 0; i < length; i++) {
+        result.assign(asciiString, 0, asciiLength);
+        result.resize((std::size_t) utfLength);
+        std::size_t utfIndex = asciiLength;
 
-                unsigned int charValue = (unsigned char) asciiString.at(i);
+        for (std::size_t i = asciiLength; i < length; i++) {
 
-                // Written to allow for expansion to wide character strings at some
-                // point, as it stands now the value can never be > 255 since the
-                // string class returns a single byte char.
-                if (charValue > 0 && charValue <= 127) {
-                    utfBytes[utfIndex++] = (char) charValue;
-                } else if (charValue <= 2047) {
-                    utfBytes[utfIndex++] = (char) (0xc0 | (0x1f & (charValue >> 6)));
-                    utfBytes[utfIndex++] = (char) (0x80 | (0x3f & charValue));
-                } else {
-                    utfBytes[utfIndex++] = (char) (0xe0 | (0x0f & (charValue >> 12)));
-                    utfBytes[utfIndex++] = (char) (0x80 | (0x3f & (charValue >> 6)));
-                    utfBytes[utfIndex++] = (char) (0x80 | (0x3f & charValue));
-                }
-            }
+            unsigned int charValue = bytes[i];
 
-            return utfBytes;
-        } else {
-            return "";
+            // Written to allow for expansion to wide character strings at some
+            // point, as it stands now the value can never be > 255 since the
+            // string class returns a single byte char.
+            if (charValue > 0 && charValue <= 127) {
+                result[utfIndex++] = (char) charValue;
+            } else if (charValue <= 2047) {
+                result[utfIndex++] = (char) (0xc0 | (0x1f & (charValue >> 6)));
+                result[utfIndex++] = (char) (0x80 | (0x3f & charValue));
+            } else {
+                result[utfIndex++] = (char) (0xe0 | (0x0f & (charValue >> 12)));
+                result[utfIndex++] = (char) (0x80 | (0x3f & (charValue >> 6)));
+                result[utfIndex++] = (char) (0x80 | (0x3f & charValue));
+            }
         }
     }
     AMQ_CATCH_RETHROW(decaf::io::UTFDataFormatException)
@@ -201,29 +219,47 @@ std::string MarshallingSupport::asciiToModifiedUtf8(const std::string& asciiStri
 ////////////////////////////////////////////////////////////////////////////////
 std::string MarshallingSupport::modifiedUtf8ToAscii(const std::string modifiedUtf8String) {
 
+    try {
+        std::string result;
+        MarshallingSupport::modifiedUtf8ToAscii(modifiedUtf8String, result);
+        return result;
+    }
+    AMQ_CATCH_RETHROW(decaf::io::UTFDataFormatException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, decaf::io::UTFDataFormatException)
+    AMQ_CATCHALL_THROW(decaf::io::UTFDataFormatException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void MarshallingSupport::modifiedUtf8ToAscii(const std::string& modifiedUtf8String, std::string& result) {
+
     try {
 
         std::size_t utfLength = modifiedUtf8String.length();
+        const unsigned char* bytes = (const unsigned char*) modifiedUtf8String.data();
 
-        if (utfLength == 0) {
-            return "";
+        // The ASCII prefix is copied as is and only the remainder is decoded.
+        std::size_t count = StringUtils::asciiLength(bytes, utfLength);
+
+        if (count == utfLength) {
+            result.assign(modifiedUtf8String);
+            return;
         }
 
-        std::vector<unsigned char> result(utfLength);
+        result.assign(modifiedUtf8String, 0, count);
+        result.resize(utfLength);
 
-        std::size_t count = 0;
-        std::size_t index = 0;
+        std::size_t index = count;
         unsigned char a = 0;
 
         while (count < utfLength) {
-            if ((result[index] = modifiedUtf8String[count++]) < 0x80) {
-                index++;
-            } else if (((a = result[index]) & 0xE0) == 0xC0) {
+            if ((a = bytes[count++]) < 0x80) {
+                result[index++] = (char) a;
+            } else if ((a & 0xE0) == 0xC0) {
                 if (count >= utfLength) {
                     throw UTFDataFormatException(__FILE__, __LINE__, "Invalid UTF-8 encoding found, start of two byte char found at end.");
                 }
 
-                unsigned char b = modifiedUtf8String[count++];
+                unsigned char b = bytes[count++];
                 if ((b & 0xC0) != 0x80) {
                     throw UTFDataFormatException(__FILE__, __LINE__, "Invalid UTF-8 encoding found, byte two does not start with 0x80.");
                 }
@@ -236,7 +272,7 @@ std::string MarshallingSupport::modifiedUtf8ToAscii(const std::string modifiedUt
                             "This method only supports encoded ASCII values of (0-255).");
                 }
 
-                result[index++] = (unsigned char) (((a & 0x1F) << 6) | (b & 0x3F));
+                result[index++] = (char) (((a & 0x1F) << 6) | (b & 0x3F));
 
             } else if ((a & 0xF0) == 0xE0) {
 
@@ -247,26 +283,12 @@ std::string MarshallingSupport::modifiedUtf8ToAscii(const std::string modifiedUt
                             "This method only supports encoded ASCII values of (0-255).");
                 }
 
-                // If we were to support multibyte strings in the future this would be
-                // the remainder of this method decoding logic.
-                //
-                //int b = modifiedUtf8String[count++];
-                //int c = modifiedUtf8String[count++];
-                //if( ( ( b & 0xC0 ) != 0x80 ) || ( ( c & 0xC0 ) != 0x80 ) ) {
-                //    throw UTFDataFormatException(
-                //        __FILE__, __LINE__,
-                //        "Invalid UTF-8 encoding found, byte two does not start with 0x80." );
-                //}
-                //
-                //result[inde++] = ( ( a & 0x0F ) << 12 ) |
-                //                 ( ( b & 0x3F ) << 6 ) | ( c & 0x3F );
-
             } else {
                 throw UTFDataFormatException(__FILE__, __LINE__, "Invalid UTF-8 encoding found, aborting.");
             }
         }
 
-        return std::string((char*) (&result[0]), index);
+        result.resize(index);
     }
     AMQ_CATCH_RETHROW(decaf::io::UTFDataFormatException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, decaf::io::UTFDataFormatException)
@@ -136,6 +136,21 @@ namespace util {
          */
         static std::string asciiToModifiedUtf8(const std::string& asciiString);
 
+        /**
+         * Converts an ASCII String to its modified UTF-8 form in the same way as the
+         * version of this method that returns a new string, but assigns the result
+         * to the given string so that its memory can be reused.
+         *
+         * @param asciiString
+         *      The ASCII string to encode as Modified UTF-8
+         * @param result
+         *      The string that is assigned the Modified UTF-8 encoded form.
+         *
+         * @throws UTFDataFormatException if the length of the encoded string would exceed the
+         *         size of an signed integer.
+         */
+        static void asciiToModifiedUtf8(const std::string& asciiString, std::string& result);
+
         /**
          * Given a string that contains bytes in the Java Modified UTF-8 format convert
          * that string back into ASCII values from [0..255].  This will handle any string
@@ -153,6 +168,21 @@ namespace util {
          */
         static std::string modifiedUtf8ToAscii(const std::string modifiedUtf8String);
 
+        /**
+         * Converts a Modified UTF-8 string back to ASCII in the same way as the version
+         * of this method that returns a new string, but assigns the result to the given
+         * string so that its memory can be reused.
+         *
+         * @param modifiedUtf8String
+         *      The string to convert from Modified UTF-8 to ASCII.
+         * @param result
+         *      The string that is assigned the ASCII encoded version.
+         *
+         * @throws UTFDataFormatException if the provided string contains invalid data or the
+         *         character values encoded in the string exceed ASCII value 255.
+         */
+        static void modifiedUtf8ToAscii(const std::string& modifiedUtf8String, std::string& result);
+
     };
 
 }}
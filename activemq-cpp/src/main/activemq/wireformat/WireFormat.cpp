@@ -19,6 +19,23 @@
 
 using namespace activemq;
 using namespace activemq::wireformat;
+using namespace decaf::lang::exceptions;
 
 ////////////////////////////////////////////////////////////////////////////////
 WireFormat::~WireFormat() {}
+
+////////////////////////////////////////////////////////////////////////////////
+bool WireFormat::isFrameUnmarshalSupported() const {
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool WireFormat::readFrame(decaf::io::DataInputStream* in AMQCPP_UNUSED, std::vector<unsigned char>& frame AMQCPP_UNUSED) {
+    throw UnsupportedOperationException(__FILE__, __LINE__, "WireFormat::readFrame - unsupported operation");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<commands::Command> WireFormat::unmarshalFrame(const activemq::transport::Transport* transport AMQCPP_UNUSED,
+                                                      const std::vector<unsigned char>& frame AMQCPP_UNUSED) {
+    throw UnsupportedOperationException(__FILE__, __LINE__, "WireFormat::unmarshalFrame - unsupported operation");
+}
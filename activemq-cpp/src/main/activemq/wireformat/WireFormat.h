@@ -31,6 +31,8 @@
 
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
 
+#include <vector>
+
 namespace activemq {
 namespace wireformat {
 
@@ -126,6 +128,51 @@ namespace wireformat {
         virtual Pointer<transport::Transport> createNegotiator(
             const Pointer<transport::Transport> transport) = 0;
 
+        /**
+         * Indicates if reading a command can currently be split into readFrame, which only
+         * collects the bytes of the command, and unmarshalFrame, which decodes them.  The
+         * answer can change when the WireFormat is renegotiated.
+         *
+         * The default implementation returns false.
+         *
+         * @return true if readFrame and unmarshalFrame can be used in place of unmarshal.
+         */
+        virtual bool isFrameUnmarshalSupported() const;
+
+        /**
+         * Reads the encoded bytes of the next command from the stream without decoding them.
+         *
+         * @param in
+         *      The stream to read the frame from.
+         * @param frame
+         *      Resized to hold the bytes of the frame.
+         *
+         * @return true if the frame can be decoded by unmarshalFrame while other frames are
+         *         being decoded, false if it must only be decoded once every command that
+         *         came before it has been processed.
+         *
+         * @throws IOException if an error occurs while reading.
+         * @throws UnsupportedOperationException if this WireFormat can't read frames.
+         */
+        virtual bool readFrame(decaf::io::DataInputStream* in, std::vector<unsigned char>& frame);
+
+        /**
+         * Decodes a frame that was read by readFrame.  Frames that readFrame reported as
+         * independent may be decoded by several threads at once.
+         *
+         * @param transport
+         *      The transport the frame was read from.
+         * @param frame
+         *      The bytes of the frame.
+         *
+         * @return the decoded command.
+         *
+         * @throws IOException if the frame can't be decoded.
+         * @throws UnsupportedOperationException if this WireFormat can't decode frames.
+         */
+        virtual Pointer<commands::Command> unmarshalFrame(const activemq::transport::Transport* transport,
+                                                          const std::vector<unsigned char>& frame);
+
     };
 
 }}
@@ -22,12 +22,25 @@
 #include <decaf/lang/Long.h>
 #include <decaf/util/UUID.h>
 #include <decaf/lang/Math.h>
+#include <decaf/lang/Short.h>
 #include <decaf/io/ByteArrayOutputStream.h>
 #include <activemq/wireformat/openwire/OpenWireFormatNegotiator.h>
 #include <activemq/wireformat/openwire/utils/BooleanStream.h>
 #include <activemq/wireformat/MarshalAware.h>
 #include <activemq/commands/WireFormatInfo.h>
 #include <activemq/commands/DataStructure.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/ActiveMQDestination.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ActiveMQTopic.h>
+#include <activemq/commands/ActiveMQTempQueue.h>
+#include <activemq/commands/ActiveMQTempTopic.h>
+#include <activemq/commands/BrokerId.h>
+#include <activemq/commands/ConnectionId.h>
+#include <activemq/commands/ConsumerId.h>
+#include <activemq/commands/LocalTransactionId.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/commands/SessionId.h>
 #include <activemq/wireformat/openwire/marshal/DataStreamMarshaller.h>
 #include <activemq/wireformat/openwire/marshal/generated/MarshallerFactory.h>
 #include <activemq/exceptions/ActiveMQException.h>
@@ -51,13 +64,52 @@ using namespace decaf::lang::exceptions;
 const unsigned char OpenWireFormat::NULL_TYPE = 0;
 const int OpenWireFormat::DEFAULT_VERSION = 1;
 const int OpenWireFormat::MAX_SUPPORTED_VERSION = 11;
+const short OpenWireFormat::MARSHAL_CACHE_SIZE = Short::MAX_VALUE / 2;
+const int OpenWireFormat::MAX_RETAINED_FRAME_BUFFER_SIZE = 64 * 1024;
+const long long OpenWireFormat::DEFAULT_MAX_FRAME_SIZE = Long::MAX_VALUE;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int FRAME_BUFFER_SIZE = 1024;
+
+    /**
+     * Marks the wire format as receiving for as long as it is in scope.
+     */
+    class ReceivingGuard {
+    private:
+
+        decaf::util::concurrent::atomic::AtomicBoolean* state;
+
+    private:
+
+        ReceivingGuard(const ReceivingGuard&);
+        ReceivingGuard& operator=(const ReceivingGuard&);
+
+    public:
+
+        ReceivingGuard(decaf::util::concurrent::atomic::AtomicBoolean* state) : state(state) {
+            state->set(true);
+        }
+
+        ~ReceivingGuard() {
+            state->set(false);
+        }
+    };
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 OpenWireFormat::OpenWireFormat(const decaf::util::Properties& properties) :
     properties(properties), preferedWireFormatInfo(), dataMarshallers(256),
     id(UUID::randomUUID().toString()), receiving(), version(0), stackTraceEnabled(true),
-    tcpNoDelayEnabled(true), cacheEnabled(true), cacheSize(1024), tightEncodingEnabled(false),
-    sizePrefixDisabled(false), maxInactivityDuration(30000), maxInactivityDurationInitialDelay(10000) {
+    tcpNoDelayEnabled(true), cacheEnabled(false), cacheSize(1024), tightEncodingEnabled(false),
+    sizePrefixDisabled(false), maxFrameSize(DEFAULT_MAX_FRAME_SIZE), maxInactivityDuration(30000), maxInactivityDurationInitialDelay(10000),
+    marshalCache(), unmarshalCache(), marshalCacheMap(), nextMarshalCacheIndex(0),
+    frameBuffer(new ByteArrayOutputStream(FRAME_BUFFER_SIZE)), frameOut(),
+    frameInBuffer(FRAME_BUFFER_SIZE), frameInStream(new ByteArrayInputStream()), frameIn() {
+
+    this->frameOut.reset(new DataOutputStream(this->frameBuffer.get()));
+    this->frameIn.reset(new DataInputStream(this->frameInStream.get()));
 
     // initialize the universal marshalers, don't need to reset them again
     // after this so its safe to do this here.
@@ -159,9 +211,15 @@ void OpenWireFormat::marshal(const Pointer<commands::Command> command, const act
             }
 
             if (tightEncodingEnabled) {
+
+                // The body is staged while the boolean flags are collected in a
+                // single walk of the command, its size is then known up front.
                 BooleanStream bs;
-                size += dsm->tightMarshal1(this, dataStructure, &bs);
+                this->frameBuffer->reset();
+                dsm->tightMarshal(this, dataStructure, this->frameOut.get(), &bs);
+
                 size += bs.marshalledSize();
+                size += (int) this->frameBuffer->size();
 
                 if (!sizePrefixDisabled) {
                     dataOut->writeInt(size);
@@ -169,7 +227,9 @@ void OpenWireFormat::marshal(const Pointer<commands::Command> command, const act
 
                 dataOut->writeByte(type);
                 bs.marshal(dataOut);
-                dsm->tightMarshal2(this, dataStructure, dataOut, &bs);
+                this->frameBuffer->writeTo(dataOut);
+
+                releaseLargeFrameBuffer();
 
             } else {
 
@@ -178,28 +238,17 @@ void OpenWireFormat::marshal(const Pointer<commands::Command> command, const act
                     dsm->looseMarshal(this, dataStructure, dataOut);
                 } else {
 
-                    ByteArrayOutputStream* baos = new ByteArrayOutputStream();
-                    std::auto_ptr<DataOutputStream> looseOut(new DataOutputStream(baos, true));
+                    // Stage the frame in the reusable buffer so that its size is
+                    // known before anything is written to the transport.
+                    this->frameBuffer->reset();
 
-                    looseOut->writeByte(type);
-                    dsm->looseMarshal(this, dataStructure, looseOut.get());
-                    looseOut->close();
+                    this->frameOut->writeByte(type);
+                    dsm->looseMarshal(this, dataStructure, this->frameOut.get());
 
-                    // Now the data goes to the transport from out byte buffer.
-                    dataOut->writeInt((int) baos->size());
+                    dataOut->writeInt((int) this->frameBuffer->size());
+                    this->frameBuffer->writeTo(dataOut);
 
-                    if (baos->size() > 0) {
-                        std::pair<unsigned char*, int> array = baos->toByteArray();
-
-                        try {
-                            dataOut->write(array.first, array.second);
-                        } catch (Exception& ex) {
-                            delete[] array.first;
-                            throw;
-                        }
-
-                        delete[] array.first;
-                    }
+                    releaseLargeFrameBuffer();
                 }
             }
         } else {
@@ -222,12 +271,35 @@ Pointer<commands::Command> OpenWireFormat::unmarshal(const activemq::transport::
             throw decaf::io::IOException(__FILE__, __LINE__, "DataInputStream passed is NULL");
         }
 
+        Pointer<DataStructure> data;
+
         if (!sizePrefixDisabled) {
-            dis->readInt();
-        }
 
-        // Get the unmarshalled DataStructure
-        Pointer<DataStructure> data(doUnmarshal(dis));
+            int size = dis->readInt();
+            checkFrameSize(size);
+
+            // Pull in the whole frame at once, the fields are then read from memory
+            // instead of going back to the transport's stream for each one, and a
+            // frame whose fields overrun its size prefix can't read into the next one.
+            if ((int) this->frameInBuffer.size() < size) {
+                this->frameInBuffer.resize(size);
+            }
+
+            dis->readFully(&this->frameInBuffer[0], (int) this->frameInBuffer.size(), 0, size);
+            this->frameInStream->setByteArray(&this->frameInBuffer[0], (int) this->frameInBuffer.size(), 0, size);
+
+            try {
+                data.reset(doUnmarshal(this->frameIn.get()));
+            } catch (...) {
+                releaseLargeFrameInBuffer();
+                throw;
+            }
+
+            releaseLargeFrameInBuffer();
+
+        } else {
+            data.reset(doUnmarshal(dis));
+        }
 
         if (data == NULL) {
             throw IOException(__FILE__, __LINE__, "OpenWireFormat::doUnmarshal - "
@@ -252,28 +324,20 @@ commands::DataStructure* OpenWireFormat::doUnmarshal(DataInputStream* dis) {
 
     try {
 
-        class Finally {
-        private:
-
-            decaf::util::concurrent::atomic::AtomicBoolean* state;
-
-        private:
-
-            Finally(const Finally&);
-            Finally& operator=(const Finally&);
+        ReceivingGuard finalizer(&(this->receiving));
 
-        public:
-
-            Finally(decaf::util::concurrent::atomic::AtomicBoolean* state) : state(state) {
-                state->set(true);
-            }
+        return unmarshalDataStructure(dis);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
 
-            ~Finally() {
-                state->set(false);
-            }
-        }
+////////////////////////////////////////////////////////////////////////////////
+commands::DataStructure* OpenWireFormat::unmarshalDataStructure(DataInputStream* dis) {
 
-        finalizer(&(this->receiving));
+    try {
 
         unsigned char dataType = dis->readByte();
 
@@ -308,6 +372,67 @@ commands::DataStructure* OpenWireFormat::doUnmarshal(DataInputStream* dis) {
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool OpenWireFormat::readFrame(decaf::io::DataInputStream* in, std::vector<unsigned char>& frame) {
+
+    try {
+
+        if (in == NULL) {
+            throw decaf::io::IOException(__FILE__, __LINE__, "DataInputStream passed is NULL");
+        }
+
+        if (this->sizePrefixDisabled) {
+            throw IOException(__FILE__, __LINE__, "OpenWireFormat::readFrame - frames can't be read without the size prefix");
+        }
+
+        ReceivingGuard finalizer(&(this->receiving));
+
+        int size = in->readInt();
+
+        if (size == 0) {
+            throw IOException(__FILE__, __LINE__, "OpenWireFormat::readFrame - Invalid frame size: %d", size);
+        }
+
+        checkFrameSize(size);
+
+        frame.resize(size);
+        in->readFully(&frame[0], size, 0, size);
+
+        return !this->cacheEnabled && frame[0] == commands::MessageDispatch::ID_MESSAGEDISPATCH;
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<commands::Command> OpenWireFormat::unmarshalFrame(const activemq::transport::Transport* transport AMQCPP_UNUSED,
+                                                          const std::vector<unsigned char>& frame) {
+
+    try {
+
+        if (frame.empty()) {
+            throw IOException(__FILE__, __LINE__, "OpenWireFormat::unmarshalFrame - frame is empty");
+        }
+
+        ByteArrayInputStream bytes(&frame[0], (int) frame.size());
+        DataInputStream in(&bytes);
+
+        Pointer<DataStructure> data(unmarshalDataStructure(&in));
+
+        if (data == NULL) {
+            throw IOException(__FILE__, __LINE__, "OpenWireFormat::unmarshalFrame - "
+                    "Failed to unmarshal an Object");
+        }
+
+        return data.dynamicCast<Command>();
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 int OpenWireFormat::tightMarshalNestedObject1(commands::DataStructure* object, utils::BooleanStream* bs) {
 
@@ -382,6 +507,47 @@ void OpenWireFormat::tightMarshalNestedObject2(DataStructure* o, DataOutputStrea
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::tightMarshalNestedObject(DataStructure* object, DataOutputStream* ds, BooleanStream* bs) {
+
+    try {
+
+        bs->writeBoolean(object != NULL);
+        if (object == NULL) {
+            return;
+        }
+
+        unsigned char type = object->getDataStructureType();
+        if (type == 0) {
+            throw IOException(__FILE__, __LINE__, "No valid data structure type for object of this type");
+        }
+
+        ds->writeByte(type);
+
+        if (object->isMarshalAware()) {
+
+            std::vector<unsigned char> sequence = object->getMarshaledForm(this);
+            bs->writeBoolean(!sequence.empty());
+            if (!sequence.empty()) {
+                ds->write(&sequence[0], (int) sequence.size());
+                return;
+            }
+        }
+
+        DataStreamMarshaller* dsm = dataMarshallers[type & 0xFF];
+
+        if (dsm == NULL) {
+            throw IOException(__FILE__, __LINE__, (string("OpenWireFormat::marshal - Unknown data type: ") + Integer::toString(type)).c_str());
+        }
+
+        dsm->tightMarshal(this, object, ds, bs);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(ActiveMQException, IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 DataStructure* OpenWireFormat::tightUnmarshalNestedObject(DataInputStream* dis, BooleanStream* bs) {
 
@@ -494,4 +660,208 @@ void OpenWireFormat::renegotiateWireFormat(const WireFormatInfo& info) {
     this->cacheSize = min(info.getCacheSize(), preferedWireFormatInfo->getCacheSize());
     this->maxInactivityDuration = min(info.getMaxInactivityDuration(), preferedWireFormatInfo->getMaxInactivityDuration());
     this->maxInactivityDurationInitialDelay = min(info.getMaxInactivityDurationInitalDelay(), preferedWireFormatInfo->getMaxInactivityDurationInitalDelay());
+
+    this->resetMarshalCache();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::setCacheEnabled(bool cacheEnabled) {
+    this->cacheEnabled = cacheEnabled;
+    this->resetMarshalCache();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::setCacheSize(int value) {
+    this->cacheSize = value;
+    this->resetMarshalCache();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::resetMarshalCache() {
+
+    this->marshalCache.clear();
+    this->unmarshalCache.clear();
+    this->marshalCacheMap.clear();
+    this->nextMarshalCacheIndex = 0;
+
+    if (this->cacheEnabled) {
+
+        int size = this->cacheSize;
+        if (size <= 0 || size > Short::MAX_VALUE) {
+            size = MARSHAL_CACHE_SIZE;
+        }
+
+        this->marshalCache.resize(size);
+
+        // The indexes are picked by the remote side, which may fill its cache up to
+        // MARSHAL_CACHE_SIZE whatever size was negotiated, as the Java broker does.
+        this->unmarshalCache.resize(MARSHAL_CACHE_SIZE);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::checkFrameSize(int size) const {
+
+    if (size < 0) {
+        throw IOException(__FILE__, __LINE__, "OpenWireFormat::checkFrameSize - Invalid frame size: %d", size);
+    }
+
+    if ((long long) size > this->maxFrameSize) {
+        throw IOException(__FILE__, __LINE__,
+            "OpenWireFormat::checkFrameSize - Frame size of %d bytes is larger than the maximum of %s",
+            size, Long::toString(this->maxFrameSize).c_str());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::releaseLargeFrameBuffer() {
+
+    if (this->frameBuffer->size() > MAX_RETAINED_FRAME_BUFFER_SIZE) {
+        this->frameOut.reset(NULL);
+        this->frameBuffer.reset(new ByteArrayOutputStream(FRAME_BUFFER_SIZE));
+        this->frameOut.reset(new DataOutputStream(this->frameBuffer.get()));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::releaseLargeFrameInBuffer() {
+
+    if ((int) this->frameInBuffer.size() > MAX_RETAINED_FRAME_BUFFER_SIZE) {
+        std::vector<unsigned char>(FRAME_BUFFER_SIZE).swap(this->frameInBuffer);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int OpenWireFormat::MarshalCacheKeyHash::operator()(const MarshalCacheKey& key) const {
+
+    // The cached types are hashed from the same fields their equals compares, the
+    // generated getHashCode methods of the ids format the whole id as a string.
+    HashCode<std::string> stringHash;
+    const DataStructure* object = key.object;
+    unsigned char type = object->getDataStructureType();
+    long long hash = type;
+
+    switch (type) {
+        case ActiveMQQueue::ID_ACTIVEMQQUEUE:
+        case ActiveMQTopic::ID_ACTIVEMQTOPIC:
+        case ActiveMQTempQueue::ID_ACTIVEMQTEMPQUEUE:
+        case ActiveMQTempTopic::ID_ACTIVEMQTEMPTOPIC:
+            hash = 31 * hash + static_cast<const ActiveMQDestination*>(object)->getHashCode();
+            break;
+        case ConnectionId::ID_CONNECTIONID:
+            hash = 31 * hash + stringHash(static_cast<const ConnectionId*>(object)->getValue());
+            break;
+        case SessionId::ID_SESSIONID: {
+            const SessionId* id = static_cast<const SessionId*>(object);
+            hash = 31 * hash + stringHash(id->getConnectionId());
+            hash = 31 * hash + id->getValue();
+            break;
+        }
+        case ConsumerId::ID_CONSUMERID: {
+            const ConsumerId* id = static_cast<const ConsumerId*>(object);
+            hash = 31 * hash + stringHash(id->getConnectionId());
+            hash = 31 * hash + id->getSessionId();
+            hash = 31 * hash + id->getValue();
+            break;
+        }
+        case ProducerId::ID_PRODUCERID: {
+            const ProducerId* id = static_cast<const ProducerId*>(object);
+            hash = 31 * hash + stringHash(id->getConnectionId());
+            hash = 31 * hash + id->getSessionId();
+            hash = 31 * hash + id->getValue();
+            break;
+        }
+        case BrokerId::ID_BROKERID:
+            hash = 31 * hash + stringHash(static_cast<const BrokerId*>(object)->getValue());
+            break;
+        case LocalTransactionId::ID_LOCALTRANSACTIONID:
+            hash = 31 * hash + static_cast<const LocalTransactionId*>(object)->getValue();
+            break;
+        default:
+            hash = 31 * hash + stringHash(object->toString());
+            break;
+    }
+
+    return HashCode<long long>()(hash);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+short OpenWireFormat::getMarshalCacheIndex(const DataStructure* object) const {
+
+    if (object == NULL || this->marshalCacheMap.isEmpty()) {
+        return -1;
+    }
+
+    MarshalCacheKey key(object);
+    if (!this->marshalCacheMap.containsKey(key)) {
+        return -1;
+    }
+
+    return this->marshalCacheMap.get(key);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+short OpenWireFormat::addToMarshalCache(const DataStructure* object) {
+
+    if (object == NULL || this->marshalCache.empty()) {
+        return -1;
+    }
+
+    short index = this->nextMarshalCacheIndex++;
+    if (this->nextMarshalCacheIndex >= (short) this->marshalCache.size()) {
+        this->nextMarshalCacheIndex = 0;
+    }
+
+    // Evict whatever currently occupies the slot, the remote side will overwrite
+    // its copy of the slot when it reads the new value.
+    Pointer<DataStructure>& entry = this->marshalCache[index];
+    if (entry != NULL) {
+        MarshalCacheKey evicted(entry.get());
+        if (this->marshalCacheMap.containsKey(evicted) && this->marshalCacheMap.get(evicted) == index) {
+            this->marshalCacheMap.remove(evicted);
+        }
+    }
+
+    // Only a miss stores a copy, the map key refers to the copy so that it stays
+    // valid for as long as the object is cached.
+    entry.reset(object->cloneDataStructure());
+    this->marshalCacheMap.put(MarshalCacheKey(entry.get()), index);
+
+    return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormat::setInUnmarshalCache(short index, const DataStructure* object) {
+
+    // The sender didn't cache this value.
+    if (index == -1) {
+        return;
+    }
+
+    if (index < 0 || index >= (short) this->unmarshalCache.size()) {
+        throw IOException(__FILE__, __LINE__,
+            "OpenWireFormat::setInUnmarshalCache - Invalid cache index: %d", (int) index);
+    }
+
+    if (object == NULL) {
+        this->unmarshalCache[index].reset(NULL);
+    } else {
+        this->unmarshalCache[index].reset(object->cloneDataStructure());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+DataStructure* OpenWireFormat::getFromUnmarshalCache(short index) const {
+
+    if (index < 0 || index >= (short) this->unmarshalCache.size()) {
+        throw IOException(__FILE__, __LINE__,
+            "OpenWireFormat::getFromUnmarshalCache - Invalid cache index: %d", (int) index);
+    }
+
+    const Pointer<DataStructure>& entry = this->unmarshalCache[index];
+    if (entry == NULL) {
+        return NULL;
+    }
+
+    return entry->cloneDataStructure();
 }
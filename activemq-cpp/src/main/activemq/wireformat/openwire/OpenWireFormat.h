@@ -23,8 +23,14 @@
 #include <activemq/commands/DataStructure.h>
 #include <activemq/wireformat/WireFormat.h>
 #include <activemq/wireformat/openwire/utils/BooleanStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/DataInputStream.h>
 #include <decaf/lang/Pointer.h>
 #include <decaf/util/Properties.h>
+#include <decaf/util/HashMap.h>
+#include <decaf/util/HashCode.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 #include <decaf/lang/exceptions/IllegalStateException.h>
 #include <decaf/lang/exceptions/IllegalArgumentException.h>
@@ -52,6 +58,41 @@ namespace marshal {
         // Defines the maximum supported openwire version
         static const int MAX_SUPPORTED_VERSION;
 
+        // Size of the marshal cache used when the negotiated cache size is zero.
+        static const short MARSHAL_CACHE_SIZE;
+
+        // Largest frame buffer that is kept for reuse between frames.
+        static const int MAX_RETAINED_FRAME_BUFFER_SIZE;
+
+        // Largest incoming frame accepted unless configured otherwise, no limit.
+        static const long long DEFAULT_MAX_FRAME_SIZE;
+
+    private:
+
+        /**
+         * Key for the marshal cache index, two keys are the same when they refer to
+         * DataStructures of the same type that are equal by value.
+         */
+        class MarshalCacheKey {
+        public:
+
+            const commands::DataStructure* object;
+
+            MarshalCacheKey() : object(NULL) {}
+
+            MarshalCacheKey(const commands::DataStructure* object) : object(object) {}
+
+            bool operator==(const MarshalCacheKey& other) const {
+                return this->object == other.object ||
+                       (this->object->getDataStructureType() == other.object->getDataStructureType() &&
+                        this->object->equals(other.object));
+            }
+        };
+
+        struct MarshalCacheKeyHash : public decaf::util::HashCodeUnaryBase<const MarshalCacheKey&> {
+            int operator()(const MarshalCacheKey& key) const;
+        };
+
     private:
 
         // Configuration parameters
@@ -77,9 +118,25 @@ namespace marshal {
         int cacheSize;
         bool tightEncodingEnabled;
         bool sizePrefixDisabled;
+        long long maxFrameSize;
         long long maxInactivityDuration;
         long long maxInactivityDurationInitialDelay;
 
+        // Marshal Cache data, only used when caching is enabled.
+        std::vector< Pointer<commands::DataStructure> > marshalCache;
+        std::vector< Pointer<commands::DataStructure> > unmarshalCache;
+        decaf::util::HashMap<MarshalCacheKey, short, MarshalCacheKeyHash> marshalCacheMap;
+        short nextMarshalCacheIndex;
+
+        // Frame buffer reused to stage the body of a frame before its size prefix is written.
+        std::auto_ptr<decaf::io::ByteArrayOutputStream> frameBuffer;
+        std::auto_ptr<decaf::io::DataOutputStream> frameOut;
+
+        // Frame buffer reused to hold each incoming frame while it is unmarshaled.
+        std::vector<unsigned char> frameInBuffer;
+        std::auto_ptr<decaf::io::ByteArrayInputStream> frameInStream;
+        std::auto_ptr<decaf::io::DataInputStream> frameIn;
+
     public:
 
         /**
@@ -119,6 +176,31 @@ namespace marshal {
          */
         virtual Pointer<commands::Command> unmarshal(const activemq::transport::Transport* transport, decaf::io::DataInputStream* in);
 
+        /**
+         * {@inheritDoc}
+         *
+         * Frames can be read whenever the size prefix is enabled.
+         */
+        virtual bool isFrameUnmarshalSupported() const {
+            return !this->sizePrefixDisabled;
+        }
+
+        /**
+         * {@inheritDoc}
+         *
+         * Only MessageDispatch frames are reported as independent, and only when the
+         * marshal cache is disabled since decoding a cached frame depends on the ones
+         * before it.  Every other command is left to be decoded in order as it may
+         * change how the frames that follow are decoded.
+         */
+        virtual bool readFrame(decaf::io::DataInputStream* in, std::vector<unsigned char>& frame);
+
+        /**
+         * {@inheritDoc}
+         */
+        virtual Pointer<commands::Command> unmarshalFrame(const activemq::transport::Transport* transport,
+                                                          const std::vector<unsigned char>& frame);
+
     public:
 
         /**
@@ -141,6 +223,18 @@ namespace marshal {
          */
         void tightMarshalNestedObject2(commands::DataStructure* o, decaf::io::DataOutputStream* ds, utils::BooleanStream* bs);
 
+        /**
+         * Utility method that will Tight marshal some internally nested object
+         * that implements the DataStructure interface in a single pass, the
+         * boolean flags are written to the BooleanStream as the data is written
+         * to the Data Output Stream provided.
+         * @param object - DataStructure object
+         * @param ds - DataOuputStream for writing
+         * @param bs - BooleanStream
+         * @throws IOException if an error occurs.
+         */
+        void tightMarshalNestedObject(commands::DataStructure* object, decaf::io::DataOutputStream* ds, utils::BooleanStream* bs);
+
         /**
          * Utility method used to Unmarshal a Nested DataStructure type object
          * from the given DataInputStream.  The DataStructure instance that is
@@ -173,6 +267,56 @@ namespace marshal {
          */
         void looseMarshalNestedObject(commands::DataStructure* o, decaf::io::DataOutputStream* dataOut);
 
+        /**
+         * Looks up the index in the marshal cache of a DataStructure that is equal
+         * to the one given.
+         *
+         * @param object
+         *      The DataStructure to look for in the marshal cache.
+         *
+         * @return the cache index of the object or -1 if it is not currently cached.
+         */
+        short getMarshalCacheIndex(const commands::DataStructure* object) const;
+
+        /**
+         * Adds a copy of the given DataStructure to the marshal cache.  When the cache
+         * is full the entry in the next slot is evicted to make room, the receiver will
+         * replace its own copy of that slot when it reads the new value.
+         *
+         * @param object
+         *      The DataStructure to add to the marshal cache, NULL values are not cached.
+         *
+         * @return the cache index assigned to the object or -1 if it was not cached.
+         */
+        short addToMarshalCache(const commands::DataStructure* object);
+
+        /**
+         * Stores a copy of the given DataStructure in the unmarshal cache at the index
+         * that the remote peer assigned it, an index of -1 indicates the value was not
+         * cached by the sender and it is ignored.
+         *
+         * @param index
+         *      The cache index that the remote peer assigned to the object.
+         * @param object
+         *      The DataStructure that was just unmarshaled.
+         *
+         * @throws IOException if the index is outside the bounds of the cache.
+         */
+        void setInUnmarshalCache(short index, const commands::DataStructure* object);
+
+        /**
+         * Gets a copy of the DataStructure stored in the unmarshal cache at the given
+         * index, the returned object is the property of the caller.
+         *
+         * @param index
+         *      The cache index that the remote peer sent in place of the object.
+         *
+         * @return a new copy of the cached DataStructure.
+         *
+         * @throws IOException if there is no object cached at the given index.
+         */
+        commands::DataStructure* getFromUnmarshalCache(short index) const;
+
         /**
          * Called to re-negotiate the settings for the WireFormatInfo, these
          * determine how the client and broker communicate.
@@ -270,12 +414,11 @@ namespace marshal {
         }
 
         /**
-         * Sets if the cacheEnabled flag is on
+         * Sets if the cacheEnabled flag is on, changing this value clears
+         * the contents of the marshal and unmarshal caches.
          * @param cacheEnabled - true to turn flag is on
          */
-        void setCacheEnabled(bool cacheEnabled) {
-            this->cacheEnabled = cacheEnabled;
-        }
+        void setCacheEnabled(bool cacheEnabled);
 
         /**
          * Returns the currently set Cache size.
@@ -286,12 +429,11 @@ namespace marshal {
         }
 
         /**
-         * Sets the current Cache size.
+         * Sets the current Cache size, changing this value clears the contents
+         * of the marshal and unmarshal caches.
          * @param value - the value to send as the broker's cache size.
          */
-        void setCacheSize(int value) {
-            this->cacheSize = value;
-        }
+        void setCacheSize(int value);
 
         /**
          * Checks if the tightEncodingEnabled flag is on
@@ -325,6 +467,35 @@ namespace marshal {
             this->sizePrefixDisabled = sizePrefixDisabled;
         }
 
+        /**
+         * Gets the largest frame, in bytes, that will be accepted from the remote peer.
+         * @return the maximum frame size.
+         */
+        long long getMaxFrameSize() const {
+            return this->maxFrameSize;
+        }
+
+        /**
+         * Sets the largest frame, in bytes, that will be accepted from the remote peer.
+         * A frame whose size prefix is larger fails with an IOException before any
+         * memory is allocated for it.  There is no limit by default.
+         * @param value - the maximum frame size.
+         */
+        void setMaxFrameSize(long long value) {
+            this->maxFrameSize = value;
+        }
+
+        /**
+         * Checks the size prefix of an incoming frame before any memory is allocated
+         * to hold it.
+         *
+         * @param size
+         *      The frame size read from the size prefix.
+         *
+         * @throws IOException if the size is negative or larger than the maximum frame size.
+         */
+        void checkFrameSize(int size) const;
+
         /**
          * Gets the MaxInactivityDuration setting.
          * @return maximum inactivity duration value in milliseconds.
@@ -374,6 +545,19 @@ namespace marshal {
          */
         commands::DataStructure* doUnmarshal(decaf::io::DataInputStream* dis);
 
+        /**
+         * Decodes the next DataStructure from the stream without marking this object as
+         * receiving, safe to call from several threads when the cache is disabled.
+         *
+         * @param dis
+         *      The DataInputStream to read from.
+         *
+         * @return new DataStructure* that the caller owns, or NULL for the null type.
+         *
+         * @throws IOException if an error occurs during the unmarshal.
+         */
+        commands::DataStructure* unmarshalDataStructure(decaf::io::DataInputStream* dis);
+
         /**
          * Cleans up all registered Marshallers and empties the dataMarshallers
          * vector.  This should be called before a reconfiguration of the version
@@ -381,6 +565,26 @@ namespace marshal {
          */
         void destroyMarshalers();
 
+        /**
+         * Discards all entries in the marshal and unmarshal caches and sizes them
+         * based on the current cache configuration.  Both sides of the connection
+         * must reset their caches at the same time, which happens when the wire
+         * format is negotiated.
+         */
+        void resetMarshalCache();
+
+        /**
+         * Replaces the frame buffer used to stage outgoing frames if the last
+         * frame grew it beyond the size that is worth holding onto.
+         */
+        void releaseLargeFrameBuffer();
+
+        /**
+         * Replaces the frame buffer that holds incoming frames if the last frame
+         * grew it beyond the size that is worth holding onto.
+         */
+        void releaseLargeFrameInBuffer();
+
     };
 
 }}}
@@ -68,6 +68,9 @@ Pointer<WireFormat> OpenWireFormatFactory::createWireFormat(const decaf::util::P
         // give the format object the ownership
         wireFormat->setPreferedWireFormatInfo(info);
 
+        wireFormat->setMaxFrameSize(Long::parseLong(
+            properties.getProperty("wireFormat.maxFrameSize", Long::toString(OpenWireFormat::DEFAULT_MAX_FRAME_SIZE))));
+
         return wireFormat;
     }
     AMQ_CATCH_RETHROW(IllegalStateException)
@@ -27,6 +27,7 @@
 #include <decaf/lang/Long.h>
 #include <decaf/lang/Integer.h>
 #include <decaf/lang/Pointer.h>
+#include <decaf/internal/util/StringUtils.h>
 #include <activemq/util/Config.h>
 
 using namespace std;
@@ -48,6 +49,20 @@ utils::HexTable BaseDataStreamMarshaller::hexTable;
 ////////////////////////////////////////////////////////////////////////////////
 commands::DataStructure* BaseDataStreamMarshaller::tightUnmarshalCachedObject(OpenWireFormat* wireFormat, decaf::io::DataInputStream* dataIn,utils::BooleanStream* bs) {
     try {
+
+        if (wireFormat->isCacheEnabled()) {
+
+            if (bs->readBoolean()) {
+                short index = dataIn->readShort();
+                DataStructure* data = wireFormat->tightUnmarshalNestedObject(dataIn, bs);
+                wireFormat->setInUnmarshalCache(index, data);
+                return data;
+            } else {
+                short index = dataIn->readShort();
+                return wireFormat->getFromUnmarshalCache(index);
+            }
+        }
+
         return wireFormat->tightUnmarshalNestedObject(dataIn, bs);
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -58,6 +73,21 @@ commands::DataStructure* BaseDataStreamMarshaller::tightUnmarshalCachedObject(Op
 ////////////////////////////////////////////////////////////////////////////////
 int BaseDataStreamMarshaller::tightMarshalCachedObject1(OpenWireFormat* wireFormat, commands::DataStructure* data, utils::BooleanStream* bs) {
     try {
+
+        if (wireFormat->isCacheEnabled()) {
+
+            short index = wireFormat->getMarshalCacheIndex(data);
+            bs->writeBoolean(index == -1);
+
+            if (index == -1) {
+                int rc = wireFormat->tightMarshalNestedObject1(data, bs);
+                wireFormat->addToMarshalCache(data);
+                return 2 + rc;
+            }
+
+            return 2;
+        }
+
         return wireFormat->tightMarshalNestedObject1(data, bs);
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -68,6 +98,27 @@ int BaseDataStreamMarshaller::tightMarshalCachedObject1(OpenWireFormat* wireForm
 ////////////////////////////////////////////////////////////////////////////////
 void BaseDataStreamMarshaller::tightMarshalCachedObject2(OpenWireFormat* wireFormat, commands::DataStructure* data, decaf::io::DataOutputStream* dataOut,utils::BooleanStream* bs) {
     try {
+
+        if (wireFormat->isCacheEnabled()) {
+
+            // The object was added to the cache in the first pass, it is only missing
+            // now if later objects in the same command evicted it.
+            short index = wireFormat->getMarshalCacheIndex(data);
+            if (index == -1 && data != NULL) {
+                throw IOException(__FILE__, __LINE__,
+                    "BaseDataStreamMarshaller::tightMarshalCachedObject2 - Object was evicted from the marshal cache");
+            }
+
+            if (bs->readBoolean()) {
+                dataOut->writeShort(index);
+                wireFormat->tightMarshalNestedObject2(data, dataOut, bs);
+            } else {
+                dataOut->writeShort(index);
+            }
+
+            return;
+        }
+
         wireFormat->tightMarshalNestedObject2(data, dataOut, bs);
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -75,9 +126,52 @@ void BaseDataStreamMarshaller::tightMarshalCachedObject2(OpenWireFormat* wireFor
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::tightMarshalCachedObject(OpenWireFormat* wireFormat, commands::DataStructure* data, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs) {
+    try {
+
+        if (wireFormat->isCacheEnabled()) {
+
+            short index = wireFormat->getMarshalCacheIndex(data);
+            bs->writeBoolean(index == -1);
+
+            if (index == -1) {
+                dataOut->writeShort(wireFormat->addToMarshalCache(data));
+                wireFormat->tightMarshalNestedObject(data, dataOut, bs);
+            } else {
+                dataOut->writeShort(index);
+            }
+
+            return;
+        }
+
+        wireFormat->tightMarshalNestedObject(data, dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void BaseDataStreamMarshaller::looseMarshalCachedObject(OpenWireFormat* wireFormat, commands::DataStructure* data, decaf::io::DataOutputStream* dataOut) {
     try {
+
+        if (wireFormat->isCacheEnabled()) {
+
+            short index = wireFormat->getMarshalCacheIndex(data);
+            dataOut->writeBoolean(index == -1);
+
+            if (index == -1) {
+                index = wireFormat->addToMarshalCache(data);
+                dataOut->writeShort(index);
+                wireFormat->looseMarshalNestedObject(data, dataOut);
+            } else {
+                dataOut->writeShort(index);
+            }
+
+            return;
+        }
+
         wireFormat->looseMarshalNestedObject(data, dataOut);
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -88,6 +182,20 @@ void BaseDataStreamMarshaller::looseMarshalCachedObject(OpenWireFormat* wireForm
 ////////////////////////////////////////////////////////////////////////////////
 commands::DataStructure* BaseDataStreamMarshaller::looseUnmarshalCachedObject(OpenWireFormat* wireFormat, decaf::io::DataInputStream* dataIn) {
     try {
+
+        if (wireFormat->isCacheEnabled()) {
+
+            if (dataIn->readBoolean()) {
+                short index = dataIn->readShort();
+                DataStructure* data = wireFormat->looseUnmarshalNestedObject(dataIn);
+                wireFormat->setInUnmarshalCache(index, data);
+                return data;
+            } else {
+                short index = dataIn->readShort();
+                return wireFormat->getFromUnmarshalCache(index);
+            }
+        }
+
         return wireFormat->looseUnmarshalNestedObject(dataIn);
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -115,6 +223,16 @@ void BaseDataStreamMarshaller::tightMarshalNestedObject2(OpenWireFormat* wireFor
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::tightMarshalNestedObject(OpenWireFormat* wireFormat, commands::DataStructure* object, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs) {
+    try {
+        wireFormat->tightMarshalNestedObject(object, dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 commands::DataStructure* BaseDataStreamMarshaller::tightUnmarshalNestedObject(OpenWireFormat* wireFormat, decaf::io::DataInputStream* dataIn,utils::BooleanStream* bs) {
     try {
@@ -230,6 +348,48 @@ void BaseDataStreamMarshaller::tightMarshalString2(const std::string& value, dec
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::tightMarshalString(const std::string& value, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs) {
+
+    try {
+
+        bs->writeBoolean(value != "");
+        if (value != "") {
+
+            size_t strlen = value.length();
+            size_t utflen = strlen;
+
+            // Only the bytes after the leading run of plain ASCII need checking.
+            size_t start = decaf::internal::util::StringUtils::utf8SingleByteLength((const unsigned char*) value.data(), strlen);
+
+            for (size_t i = start; i < strlen; ++i) {
+                int c = value[i];
+                if (c < 0x0001 || c > 0x007F) {
+                    utflen++;
+                }
+            }
+
+            if (utflen >= 0x10000) {
+                throw IOException(__FILE__, __LINE__, "BaseDataStreamMarshaller::tightMarshalString - "
+                        "Encountered a String value that is too long to encode.");
+            }
+
+            bool isOnlyAscii = utflen == strlen;
+            bs->writeBoolean(isOnlyAscii);
+
+            if (isOnlyAscii) {
+                dataOut->writeShort((short) strlen);
+                dataOut->writeBytes(value);
+            } else {
+                dataOut->writeUTF(value);
+            }
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void BaseDataStreamMarshaller::looseMarshalString(const std::string value, decaf::io::DataOutputStream* dataOut) {
 
@@ -318,6 +478,35 @@ void BaseDataStreamMarshaller::tightMarshalLong2(OpenWireFormat* wireFormat AMQC
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::tightMarshalLong(OpenWireFormat* wireFormat AMQCPP_UNUSED, long long value, decaf::io::DataOutputStream* dataOut,
+        utils::BooleanStream* bs) {
+    try {
+
+        unsigned long long ul = (unsigned long long) value;
+
+        if (value == 0L) {
+            bs->writeBoolean(false);
+            bs->writeBoolean(false);
+        } else if ((ul & 0xFFFFFFFFFFFF0000ULL) == 0ULL) {
+            bs->writeBoolean(false);
+            bs->writeBoolean(true);
+            dataOut->writeShort((short) value);
+        } else if ((ul & 0xFFFFFFFF00000000ULL) == 0ULL) {
+            bs->writeBoolean(true);
+            bs->writeBoolean(false);
+            dataOut->writeInt((int) value);
+        } else {
+            bs->writeBoolean(true);
+            bs->writeBoolean(true);
+            dataOut->writeLong(value);
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 long long BaseDataStreamMarshaller::tightUnmarshalLong(OpenWireFormat* wireFormat AMQCPP_UNUSED, decaf::io::DataInputStream* dataIn, utils::BooleanStream* bs) {
 
@@ -487,6 +676,44 @@ void BaseDataStreamMarshaller::tightMarshalBrokerError2(OpenWireFormat* wireForm
     AMQ_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::tightMarshalBrokerError(OpenWireFormat* wireFormat, commands::DataStructure* data, decaf::io::DataOutputStream* dataOut,
+        utils::BooleanStream* bs) {
+
+    try {
+
+        BrokerError* error = dynamic_cast<BrokerError*>(data);
+
+        bs->writeBoolean(error != NULL);
+        if (error != NULL) {
+
+            tightMarshalString(error->getExceptionClass(), dataOut, bs);
+            tightMarshalString(error->getMessage(), dataOut, bs);
+
+            if (wireFormat->isStackTraceEnabled()) {
+
+                int length = (short) error->getStackTraceElements().size();
+                dataOut->writeShort((short) length);
+
+                for (int i = 0; i < length; ++i) {
+
+                    Pointer<BrokerError::StackTraceElement> element = error->getStackTraceElements()[i];
+
+                    tightMarshalString(element->ClassName, dataOut, bs);
+                    tightMarshalString(element->MethodName, dataOut, bs);
+                    tightMarshalString(element->FileName, dataOut, bs);
+                    dataOut->writeInt(element->LineNumber);
+                }
+
+                tightMarshalBrokerError(wireFormat, error->getCause().get(), dataOut, bs);
+            }
+        }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 commands::DataStructure* BaseDataStreamMarshaller::looseUnmarshalBrokerError(OpenWireFormat* wireFormat, decaf::io::DataInputStream* dataIn) {
 
@@ -575,6 +802,20 @@ std::vector<unsigned char> BaseDataStreamMarshaller::tightUnmarshalByteArray(dec
     try {
 
         std::vector<unsigned char> data;
+        tightUnmarshalByteArray(dataIn, bs, data);
+        return data;
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::tightUnmarshalByteArray(decaf::io::DataInputStream* dataIn, utils::BooleanStream* bs, std::vector<unsigned char>& data) {
+
+    try {
+
+        data.clear();
         if (bs->readBoolean()) {
             int size = dataIn->readInt();
             if (size > 0) {
@@ -582,7 +823,19 @@ std::vector<unsigned char> BaseDataStreamMarshaller::tightUnmarshalByteArray(dec
                 dataIn->readFully(&data[0], (int) data.size());
             }
         }
+    }
+    AMQ_CATCH_RETHROW(IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    AMQ_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<unsigned char> BaseDataStreamMarshaller::looseUnmarshalByteArray(decaf::io::DataInputStream* dataIn) {
+
+    try {
 
+        std::vector<unsigned char> data;
+        looseUnmarshalByteArray(dataIn, data);
         return data;
     }
     AMQ_CATCH_RETHROW(IOException)
@@ -591,21 +844,18 @@ std::vector<unsigned char> BaseDataStreamMarshaller::tightUnmarshalByteArray(dec
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-std::vector<unsigned char> BaseDataStreamMarshaller::looseUnmarshalByteArray(decaf::io::DataInputStream* dataIn) {
+void BaseDataStreamMarshaller::looseUnmarshalByteArray(decaf::io::DataInputStream* dataIn, std::vector<unsigned char>& data) {
 
     try {
 
+        data.clear();
         if (dataIn->readBoolean()) {
             int size = dataIn->readInt();
-            std::vector<unsigned char> data;
             if (size > 0) {
                 data.resize(size);
                 dataIn->readFully(&data[0], (int) data.size());
             }
-            return data;
         }
-
-        return std::vector<unsigned char>();
     }
     AMQ_CATCH_RETHROW(IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
@@ -696,12 +946,8 @@ std::string BaseDataStreamMarshaller::readAsciiString(decaf::io::DataInputStream
         int size = dataIn->readShort();
 
         if (size > 0) {
-
-            std::vector<char> data(size);
-            dataIn->readFully((unsigned char*) &data[0], size);
-
-            // Now build a string and copy data into it.
-            text.insert(text.begin(), data.begin(), data.end());
+            text.resize(size);
+            dataIn->readFully((unsigned char*) &text[0], size);
         }
 
         return text;
@@ -710,3 +956,13 @@ std::string BaseDataStreamMarshaller::readAsciiString(decaf::io::DataInputStream
     AMQ_CATCH_EXCEPTION_CONVERT(Exception, IOException)
     AMQ_CATCHALL_THROW(IOException)
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshaller::checkNestedIdType(unsigned char expected, unsigned char actual) {
+
+    if (expected != actual) {
+        throw IOException(__FILE__, __LINE__,
+            "BaseDataStreamMarshaller::checkNestedIdType - Expected type %d but read type %d",
+            (int) expected, (int) actual);
+    }
+}
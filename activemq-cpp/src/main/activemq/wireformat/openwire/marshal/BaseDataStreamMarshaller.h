@@ -24,6 +24,7 @@
 #include <activemq/commands/ProducerId.h>
 #include <activemq/commands/TransactionId.h>
 #include <activemq/util/Config.h>
+#include <memory>
 
 namespace activemq{
 namespace wireformat{
@@ -70,6 +71,19 @@ namespace marshal{
                                    decaf::io::DataOutputStream* ds AMQCPP_UNUSED,
                                    utils::BooleanStream* bs AMQCPP_UNUSED) {}
 
+        /**
+         * Tight Marshal to the given stream in a single pass
+         * @param format - The OpenwireFormat properties
+         * @param command -  the object to Marshal
+         * @param ds - the DataOutputStream to Marshal to
+         * @param bs - boolean stream to marshal to.
+         * @throws IOException if an error occurs.
+         */
+        virtual void tightMarshal(OpenWireFormat* format AMQCPP_UNUSED,
+                                  commands::DataStructure* command AMQCPP_UNUSED,
+                                  decaf::io::DataOutputStream* ds AMQCPP_UNUSED,
+                                  utils::BooleanStream* bs AMQCPP_UNUSED) {}
+
         /**
          * Tight Un-Marshal to the given stream
          * @param format - The OpenwireFormat properties
@@ -171,6 +185,17 @@ namespace marshal{
          */
         virtual void tightMarshalCachedObject2(OpenWireFormat* wireFormat, commands::DataStructure* data, decaf::io::DataOutputStream* dataOut,utils::BooleanStream* bs);
 
+        /**
+         * Tightly marshals the passed DataStructure based object to the passed
+         * streams in a single pass.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param data - DataStructure Object Pointer to marshal
+         * @param dataOut - stream to write marshaled data to
+         * @param bs - boolean stream to marshal to.
+         * @throws IOException if an error occurs.
+         */
+        virtual void tightMarshalCachedObject(OpenWireFormat* wireFormat, commands::DataStructure* data, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs);
+
         /**
          * Loosely marshals the passed DataStructure based object to the passed
          * stream returning nothing
@@ -213,6 +238,18 @@ namespace marshal{
         virtual void tightMarshalNestedObject2(OpenWireFormat* wireFormat, commands::DataStructure* object, decaf::io::DataOutputStream* dataOut,
                 utils::BooleanStream* bs);
 
+        /**
+         * Tightly marshals the passed DataStructure based object to the passed
+         * streams in a single pass.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param object - DataStructure Object Pointer to marshal
+         * @param dataOut - stream to write marshaled data to
+         * @param bs - boolean stream to marshal to.
+         * @throws IOException if an error occurs.
+         */
+        virtual void tightMarshalNestedObject(OpenWireFormat* wireFormat, commands::DataStructure* object, decaf::io::DataOutputStream* dataOut,
+                utils::BooleanStream* bs);
+
         /**
          * Tight Unmarshal the nested object
          * @param wireFormat - The OpenwireFormat properties
@@ -269,6 +306,15 @@ namespace marshal{
          */
         virtual void tightMarshalString2(const std::string& value, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs);
 
+        /**
+         * Tight Marshals the passed string to the streams passed in a single pass.
+         * @param value - string to marshal
+         * @param dataOut - the DataOutputStream to Marshal to
+         * @param bs - boolean stream to marshal to.
+         * @throws IOException if an error occurs.
+         */
+        virtual void tightMarshalString(const std::string& value, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs);
+
         /**
          * Loose Marshal the String to the DataOuputStream passed
          * @param value - string to marshal
@@ -305,6 +351,16 @@ namespace marshal{
          */
         virtual void tightMarshalLong2(OpenWireFormat* wireFormat, long long value, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs);
 
+        /**
+         * Tightly marshal the long long to the Streams passed in a single pass.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param value - long long to marshal
+         * @param dataOut - stream to write marshaled form to
+         * @param bs - boolean stream to marshal to.
+         * @throws IOException if an error occurs.
+         */
+        virtual void tightMarshalLong(OpenWireFormat* wireFormat, long long value, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs);
+
         /**
          * Tight marshal the long long type.
          * @param wireFormat - The OpenwireFormat properties
@@ -342,6 +398,17 @@ namespace marshal{
          */
         virtual std::vector<unsigned char> tightUnmarshalByteArray(decaf::io::DataInputStream* dataIn, utils::BooleanStream* bs);
 
+        /**
+         * Tight Unmarshal an array of char directly into the given vector, which
+         * saves the temporary vector and the copy a setter would make of it.  The
+         * chars are still copied once out of the stream into the vector.
+         * @param dataIn - the DataInputStream to Un-Marshal from
+         * @param bs - boolean stream to unmarshal from.
+         * @param data - the vector that receives the unmarshaled chars.
+         * @throws IOException if an error occurs.
+         */
+        virtual void tightUnmarshalByteArray(decaf::io::DataInputStream* dataIn, utils::BooleanStream* bs, std::vector<unsigned char>& data);
+
         /**
          * Loose Unmarshal an array of char
          * @param dataIn - the DataInputStream to Un-Marshal from
@@ -350,6 +417,16 @@ namespace marshal{
          */
         virtual std::vector<unsigned char> looseUnmarshalByteArray(decaf::io::DataInputStream* dataIn);
 
+        /**
+         * Loose Unmarshal an array of char directly into the given vector, which
+         * saves the temporary vector and the copy a setter would make of it.  The
+         * chars are still copied once out of the stream into the vector.
+         * @param dataIn - the DataInputStream to Un-Marshal from
+         * @param data - the vector that receives the unmarshaled chars.
+         * @throws IOException if an error occurs.
+         */
+        virtual void looseUnmarshalByteArray(decaf::io::DataInputStream* dataIn, std::vector<unsigned char>& data);
+
         /**
          * Tight Unmarshal a fixed size array from that data input stream
          * and return an stl vector of char as the resultant.
@@ -401,6 +478,16 @@ namespace marshal{
          */
         virtual void tightMarshalBrokerError2(OpenWireFormat* wireFormat, commands::DataStructure* data, decaf::io::DataOutputStream* dataOut,utils::BooleanStream* bs);
 
+        /**
+         * Tight Marshal the Error object in a single pass
+         * @param wireFormat - The OpenwireFormat properties
+         * @param data - Error to Marshal
+         * @param dataOut - stream to write marshalled data to
+         * @param bs - boolean stream to marshal to.
+         * @throws IOException if an error occurs.
+         */
+        virtual void tightMarshalBrokerError(OpenWireFormat* wireFormat, commands::DataStructure* data, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs);
+
         /**
          * Loose Unarshal the Error object
          * @param wireFormat - The OpenwireFormat properties
@@ -480,6 +567,34 @@ namespace marshal{
             AMQ_CATCHALL_THROW(decaf::io::IOException)
         }
 
+        /**
+         * Tightly Marshal an array of DataStructure objects to the provided
+         * boolean stream and data output stream in a single pass.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param objects - array of DataStructure object pointers.
+         * @param dataOut - stream to write marshalled data to
+         * @param bs - boolean stream to marshal to.
+         * @throws IOException if an error occurs.
+         */
+        template<typename T>
+        void tightMarshalObjectArray(OpenWireFormat* wireFormat, const std::vector<T>& objects, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs) {
+
+            try {
+
+                bs->writeBoolean(!objects.empty());
+                if (!objects.empty()) {
+
+                    dataOut->writeShort((short) objects.size());
+                    for (std::size_t i = 0; i < objects.size(); ++i) {
+                        tightMarshalNestedObject(wireFormat, objects[i].get(), dataOut, bs);
+                    }
+                }
+            }
+            AMQ_CATCH_RETHROW(decaf::io::IOException)
+            AMQ_CATCH_EXCEPTION_CONVERT(decaf::lang::Exception, decaf::io::IOException)
+            AMQ_CATCHALL_THROW(decaf::io::IOException)
+        }
+
         /**
          * Loosely Marshal an array of DataStructure objects to the provided
          * boolean stream and data output stream
@@ -508,6 +623,206 @@ namespace marshal{
             AMQ_CATCHALL_THROW(decaf::io::IOException)
         }
 
+        /**
+         * Tightly Unmarshal a nested object whose type has no subclasses, such as one
+         * of the command ids.  The object is created and read by the given marshaller
+         * type directly rather than through the OpenWireFormat's marshaller table.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param dataIn - stream to read marshalled data from
+         * @param bs - boolean stream to unmarshal from.
+         * @return a new object of type T owned by the caller, or NULL.
+         * @throws IOException if an error occurs.
+         */
+        template<typename T, typename M>
+        T* tightUnmarshalNestedId(OpenWireFormat* wireFormat, decaf::io::DataInputStream* dataIn, utils::BooleanStream* bs) {
+
+            if (!bs->readBoolean()) {
+                return NULL;
+            }
+
+            M marshaller;
+            checkNestedIdType(marshaller.M::getDataStructureType(), dataIn->readByte());
+
+            std::auto_ptr<T> data(new T());
+            marshaller.M::tightUnmarshal(wireFormat, data.get(), dataIn, bs);
+            return data.release();
+        }
+
+        /**
+         * Tightly Marshal a nested object whose type has no subclasses in a single
+         * pass using the given marshaller type directly.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param object - the object to marshal, can be NULL.
+         * @param dataOut - stream to write marshalled data to
+         * @param bs - boolean stream to marshal to.
+         * @throws IOException if an error occurs.
+         */
+        template<typename M>
+        void tightMarshalNestedId(OpenWireFormat* wireFormat, commands::DataStructure* object, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs) {
+
+            bs->writeBoolean(object != NULL);
+            if (object != NULL) {
+                M marshaller;
+                dataOut->writeByte(marshaller.M::getDataStructureType());
+                marshaller.M::tightMarshal(wireFormat, object, dataOut, bs);
+            }
+        }
+
+        /**
+         * Tightly Unmarshal a cached object whose type has no subclasses, when the
+         * object isn't in the cache it is read using the given marshaller type.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param dataIn - stream to read marshalled data from
+         * @param bs - boolean stream to unmarshal from.
+         * @return a new object of type T owned by the caller, or NULL.
+         * @throws IOException if an error occurs.
+         */
+        template<typename T, typename M>
+        T* tightUnmarshalCachedId(OpenWireFormat* wireFormat, decaf::io::DataInputStream* dataIn, utils::BooleanStream* bs) {
+
+            if (wireFormat->isCacheEnabled()) {
+
+                if (bs->readBoolean()) {
+                    short index = dataIn->readShort();
+                    T* data = tightUnmarshalNestedId<T, M>(wireFormat, dataIn, bs);
+                    wireFormat->setInUnmarshalCache(index, data);
+                    return data;
+                } else {
+                    return getCachedId<T>(wireFormat, dataIn->readShort());
+                }
+            }
+
+            return tightUnmarshalNestedId<T, M>(wireFormat, dataIn, bs);
+        }
+
+        /**
+         * Tightly Marshal a cached object whose type has no subclasses in a single
+         * pass, when the object isn't in the cache it is written using the given
+         * marshaller type.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param object - the object to marshal, can be NULL.
+         * @param dataOut - stream to write marshalled data to
+         * @param bs - boolean stream to marshal to.
+         * @throws IOException if an error occurs.
+         */
+        template<typename M>
+        void tightMarshalCachedId(OpenWireFormat* wireFormat, commands::DataStructure* object, decaf::io::DataOutputStream* dataOut, utils::BooleanStream* bs) {
+
+            if (wireFormat->isCacheEnabled()) {
+
+                short index = wireFormat->getMarshalCacheIndex(object);
+                bs->writeBoolean(index == -1);
+
+                if (index == -1) {
+                    dataOut->writeShort(wireFormat->addToMarshalCache(object));
+                    tightMarshalNestedId<M>(wireFormat, object, dataOut, bs);
+                } else {
+                    dataOut->writeShort(index);
+                }
+
+                return;
+            }
+
+            tightMarshalNestedId<M>(wireFormat, object, dataOut, bs);
+        }
+
+        /**
+         * Loosely Unmarshal a nested object whose type has no subclasses using the
+         * given marshaller type directly.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param dataIn - stream to read marshalled data from
+         * @return a new object of type T owned by the caller, or NULL.
+         * @throws IOException if an error occurs.
+         */
+        template<typename T, typename M>
+        T* looseUnmarshalNestedId(OpenWireFormat* wireFormat, decaf::io::DataInputStream* dataIn) {
+
+            if (!dataIn->readBoolean()) {
+                return NULL;
+            }
+
+            M marshaller;
+            checkNestedIdType(marshaller.M::getDataStructureType(), dataIn->readByte());
+
+            std::auto_ptr<T> data(new T());
+            marshaller.M::looseUnmarshal(wireFormat, data.get(), dataIn);
+            return data.release();
+        }
+
+        /**
+         * Loosely Marshal a nested object whose type has no subclasses using the
+         * given marshaller type directly.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param object - the object to marshal, can be NULL.
+         * @param dataOut - stream to write marshalled data to
+         * @throws IOException if an error occurs.
+         */
+        template<typename M>
+        void looseMarshalNestedId(OpenWireFormat* wireFormat, commands::DataStructure* object, decaf::io::DataOutputStream* dataOut) {
+
+            dataOut->writeBoolean(object != NULL);
+            if (object != NULL) {
+                M marshaller;
+                dataOut->writeByte(marshaller.M::getDataStructureType());
+                marshaller.M::looseMarshal(wireFormat, object, dataOut);
+            }
+        }
+
+        /**
+         * Loosely Unmarshal a cached object whose type has no subclasses, when the
+         * object isn't in the cache it is read using the given marshaller type.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param dataIn - stream to read marshalled data from
+         * @return a new object of type T owned by the caller, or NULL.
+         * @throws IOException if an error occurs.
+         */
+        template<typename T, typename M>
+        T* looseUnmarshalCachedId(OpenWireFormat* wireFormat, decaf::io::DataInputStream* dataIn) {
+
+            if (wireFormat->isCacheEnabled()) {
+
+                if (dataIn->readBoolean()) {
+                    short index = dataIn->readShort();
+                    T* data = looseUnmarshalNestedId<T, M>(wireFormat, dataIn);
+                    wireFormat->setInUnmarshalCache(index, data);
+                    return data;
+                } else {
+                    return getCachedId<T>(wireFormat, dataIn->readShort());
+                }
+            }
+
+            return looseUnmarshalNestedId<T, M>(wireFormat, dataIn);
+        }
+
+        /**
+         * Loosely Marshal a cached object whose type has no subclasses, when the
+         * object isn't in the cache it is written using the given marshaller type.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param object - the object to marshal, can be NULL.
+         * @param dataOut - stream to write marshalled data to
+         * @throws IOException if an error occurs.
+         */
+        template<typename M>
+        void looseMarshalCachedId(OpenWireFormat* wireFormat, commands::DataStructure* object, decaf::io::DataOutputStream* dataOut) {
+
+            if (wireFormat->isCacheEnabled()) {
+
+                short index = wireFormat->getMarshalCacheIndex(object);
+                dataOut->writeBoolean(index == -1);
+
+                if (index == -1) {
+                    dataOut->writeShort(wireFormat->addToMarshalCache(object));
+                    looseMarshalNestedId<M>(wireFormat, object, dataOut);
+                } else {
+                    dataOut->writeShort(index);
+                }
+
+                return;
+            }
+
+            looseMarshalNestedId<M>(wireFormat, object, dataOut);
+        }
+
     protected:
 
         /**
@@ -518,6 +833,37 @@ namespace marshal{
          */
         virtual std::string readAsciiString(decaf::io::DataInputStream* dataIn);
 
+        /**
+         * Checks the type read from the stream for a nested id against the type
+         * that the marshaller being used to read it handles.
+         * @param expected - the type handled by the marshaller.
+         * @param actual - the type that was read from the stream.
+         * @throws IOException if the types don't match.
+         */
+        void checkNestedIdType(unsigned char expected, unsigned char actual);
+
+        /**
+         * Gets a copy of the cached object at the given index, checking that it
+         * is of the expected type.
+         * @param wireFormat - The OpenwireFormat properties
+         * @param index - the cache index that was read from the stream.
+         * @return a new object of type T owned by the caller.
+         * @throws IOException if the cached object is not of type T.
+         */
+        template<typename T>
+        T* getCachedId(OpenWireFormat* wireFormat, short index) {
+
+            std::auto_ptr<commands::DataStructure> data(wireFormat->getFromUnmarshalCache(index));
+            T* result = dynamic_cast<T*>(data.get());
+            if (result == NULL && data.get() != NULL) {
+                throw decaf::io::IOException(__FILE__, __LINE__,
+                    "BaseDataStreamMarshaller::getCachedId - Unexpected type %d in cache index %d",
+                    (int) data->getDataStructureType(), (int) index);
+            }
+            data.release();
+            return result;
+        }
+
     };
 
 }}}}
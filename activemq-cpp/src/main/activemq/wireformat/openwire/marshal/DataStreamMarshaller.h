@@ -81,6 +81,22 @@ namespace marshal {
                                    decaf::io::DataOutputStream* ds,
                                    utils::BooleanStream* bs) = 0;
 
+        /**
+         * Tight Marshal to the given stream in a single pass, the boolean flags for
+         * each field are appended to the boolean stream as the field data is written,
+         * the output is the same as a call to tightMarshal1 followed by tightMarshal2.
+         *
+         * @param format - The OpenwireFormat properties
+         * @param command -  the object to Marshal
+         * @param ds - the DataOutputStream to Marshal to
+         * @param bs - boolean stream to marshal to.
+         * @throws IOException if an error occurs.
+         */
+        virtual void tightMarshal(OpenWireFormat* format,
+                                  commands::DataStructure* command,
+                                  decaf::io::DataOutputStream* ds,
+                                  utils::BooleanStream* bs) = 0;
+
         /**
          * Tight Un-marhsal to the given stream
          * @param format - The OpenwireFormat properties
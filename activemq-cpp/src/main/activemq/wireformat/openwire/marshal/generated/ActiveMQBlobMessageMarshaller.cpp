@@ -133,6 +133,33 @@ void ActiveMQBlobMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Da
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQBlobMessageMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ActiveMQBlobMessage* info =
+            dynamic_cast<ActiveMQBlobMessage*>(dataStructure);
+
+        MessageMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 3) {
+            tightMarshalString(info->getRemoteBlobUrl(), dataOut, bs);
+        }
+        if (wireVersion >= 3) {
+            tightMarshalString(info->getMimeType(), dataOut, bs);
+        }
+        if (wireVersion >= 3) {
+            bs->writeBoolean(info->isDeletedByBroker());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQBlobMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -103,6 +103,23 @@ void ActiveMQBytesMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, D
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQBytesMessageMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ActiveMQBytesMessage* info =
+            dynamic_cast<ActiveMQBytesMessage*>(dataStructure);
+
+        info->beforeMarshal(wireFormat);
+        MessageMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQBytesMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -90,6 +90,22 @@ void ActiveMQDestinationMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Da
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQDestinationMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ActiveMQDestination* info =
+            dynamic_cast<ActiveMQDestination*>(dataStructure);
+
+        BaseDataStreamMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        tightMarshalString(info->getPhysicalName(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQDestinationMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
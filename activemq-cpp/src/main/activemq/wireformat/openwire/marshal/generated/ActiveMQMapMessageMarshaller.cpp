@@ -103,6 +103,23 @@ void ActiveMQMapMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Dat
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQMapMessageMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ActiveMQMapMessage* info =
+            dynamic_cast<ActiveMQMapMessage*>(dataStructure);
+
+        info->beforeMarshal(wireFormat);
+        MessageMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQMapMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
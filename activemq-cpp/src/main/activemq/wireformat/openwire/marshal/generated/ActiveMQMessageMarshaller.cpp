@@ -103,6 +103,23 @@ void ActiveMQMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ActiveMQMessage* info =
+            dynamic_cast<ActiveMQMessage*>(dataStructure);
+
+        info->beforeMarshal(wireFormat);
+        MessageMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
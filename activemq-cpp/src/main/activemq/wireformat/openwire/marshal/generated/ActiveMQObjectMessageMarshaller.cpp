@@ -103,6 +103,23 @@ void ActiveMQObjectMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQObjectMessageMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ActiveMQObjectMessage* info =
+            dynamic_cast<ActiveMQObjectMessage*>(dataStructure);
+
+        info->beforeMarshal(wireFormat);
+        MessageMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQObjectMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -103,6 +103,23 @@ void ActiveMQStreamMessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ActiveMQStreamMessageMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ActiveMQStreamMessage* info =
+            dynamic_cast<ActiveMQStreamMessage*>(dataStructure);
+
+        info->beforeMarshal(wireFormat);
+        MessageMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ActiveMQStreamMessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
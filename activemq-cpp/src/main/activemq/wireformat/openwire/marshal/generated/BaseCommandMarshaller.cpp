@@ -92,6 +92,23 @@ void BaseCommandMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruct
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BaseCommandMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        BaseCommand* info =
+            dynamic_cast<BaseCommand*>(dataStructure);
+
+        BaseDataStreamMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        dataOut->writeInt(info->getCommandId());
+        bs->writeBoolean(info->isResponseRequired());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void BaseCommandMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
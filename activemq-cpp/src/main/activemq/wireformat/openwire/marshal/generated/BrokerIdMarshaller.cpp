@@ -100,6 +100,22 @@ void BrokerIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructure
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BrokerIdMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        BrokerId* info =
+            dynamic_cast<BrokerId*>(dataStructure);
+
+        BaseDataStreamMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        tightMarshalString(info->getValue(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void BrokerIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -183,6 +183,46 @@ void BrokerInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructu
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void BrokerInfoMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        BrokerInfo* info =
+            dynamic_cast<BrokerInfo*>(dataStructure);
+
+        BaseCommandMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedObject(wireFormat, info->getBrokerId().get(), dataOut, bs);
+        tightMarshalString(info->getBrokerURL(), dataOut, bs);
+        tightMarshalObjectArray(wireFormat, info->getPeerBrokerInfos(), dataOut, bs);
+        tightMarshalString(info->getBrokerName(), dataOut, bs);
+        bs->writeBoolean(info->isSlaveBroker());
+        bs->writeBoolean(info->isMasterBroker());
+        bs->writeBoolean(info->isFaultTolerantConfiguration());
+        if (wireVersion >= 2) {
+            bs->writeBoolean(info->isDuplexConnection());
+        }
+        if (wireVersion >= 2) {
+            bs->writeBoolean(info->isNetworkConnection());
+        }
+        if (wireVersion >= 2) {
+            tightMarshalLong(wireFormat, info->getConnectionId(), dataOut, bs);
+        }
+        if (wireVersion >= 3) {
+            tightMarshalString(info->getBrokerUploadUrl(), dataOut, bs);
+        }
+        if (wireVersion >= 3) {
+            tightMarshalString(info->getNetworkProperties(), dataOut, bs);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void BrokerInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -77,7 +77,7 @@ void ConnectionControlMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, Dat
             info->setRebalanceConnection(bs->readBoolean());
         }
         if (wireVersion >= 8) {
-            info->setToken(tightUnmarshalByteArray(dataIn, bs));
+            tightUnmarshalByteArray(dataIn, bs, info->getToken());
         }
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -161,6 +161,45 @@ void ConnectionControlMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Data
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionControlMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ConnectionControl* info =
+            dynamic_cast<ConnectionControl*>(dataStructure);
+
+        BaseCommandMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+
+        int wireVersion = wireFormat->getVersion();
+
+        bs->writeBoolean(info->isClose());
+        bs->writeBoolean(info->isExit());
+        bs->writeBoolean(info->isFaultTolerant());
+        bs->writeBoolean(info->isResume());
+        bs->writeBoolean(info->isSuspend());
+        if (wireVersion >= 6) {
+            tightMarshalString(info->getConnectedBrokers(), dataOut, bs);
+        }
+        if (wireVersion >= 6) {
+            tightMarshalString(info->getReconnectTo(), dataOut, bs);
+        }
+        if (wireVersion >= 6) {
+            bs->writeBoolean(info->isRebalanceConnection());
+        }
+        if (wireVersion >= 8) {
+            bs->writeBoolean(info->getToken().size() != 0);
+            if (info->getToken().size() != 0) {
+                dataOut->writeInt((int)info->getToken().size() );
+                dataOut->write((const unsigned char*)(&info->getToken()[0]), (int)info->getToken().size(), 0, (int)info->getToken().size());
+            }
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConnectionControlMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -187,7 +226,7 @@ void ConnectionControlMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, Dat
             info->setRebalanceConnection(dataIn->readBoolean());
         }
         if (wireVersion >= 8) {
-            info->setToken(looseUnmarshalByteArray(dataIn));
+            looseUnmarshalByteArray(dataIn, info->getToken());
         }
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -105,6 +105,23 @@ void ConnectionErrorMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionErrorMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ConnectionError* info =
+            dynamic_cast<ConnectionError*>(dataStructure);
+
+        BaseCommandMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        tightMarshalBrokerError(wireFormat, info->getException().get(), dataOut, bs);
+        tightMarshalNestedObject(wireFormat, info->getConnectionId().get(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConnectionErrorMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -100,6 +100,22 @@ void ConnectionIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruc
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionIdMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ConnectionId* info =
+            dynamic_cast<ConnectionId*>(dataStructure);
+
+        BaseDataStreamMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        tightMarshalString(info->getValue(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConnectionIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
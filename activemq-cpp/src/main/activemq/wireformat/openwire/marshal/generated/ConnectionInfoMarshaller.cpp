@@ -174,6 +174,43 @@ void ConnectionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStr
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConnectionInfoMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ConnectionInfo* info =
+            dynamic_cast<ConnectionInfo*>(dataStructure);
+
+        BaseCommandMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedObject(wireFormat, info->getConnectionId().get(), dataOut, bs);
+        tightMarshalString(info->getClientId(), dataOut, bs);
+        tightMarshalString(info->getPassword(), dataOut, bs);
+        tightMarshalString(info->getUserName(), dataOut, bs);
+        tightMarshalObjectArray(wireFormat, info->getBrokerPath(), dataOut, bs);
+        bs->writeBoolean(info->isBrokerMasterConnector());
+        bs->writeBoolean(info->isManageable());
+        if (wireVersion >= 2) {
+            bs->writeBoolean(info->isClientMaster());
+        }
+        if (wireVersion >= 6) {
+            bs->writeBoolean(info->isFaultTolerant());
+        }
+        if (wireVersion >= 6) {
+            bs->writeBoolean(info->isFailoverReconnect());
+        }
+        if (wireVersion >= 8) {
+            tightMarshalString(info->getClientIp(), dataOut, bs);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConnectionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
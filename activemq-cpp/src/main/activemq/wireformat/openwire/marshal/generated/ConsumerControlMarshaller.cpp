@@ -152,6 +152,39 @@ void ConsumerControlMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerControlMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ConsumerControl* info =
+            dynamic_cast<ConsumerControl*>(dataStructure);
+
+        BaseCommandMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 6) {
+            tightMarshalNestedObject(wireFormat, info->getDestination().get(), dataOut, bs);
+        }
+        bs->writeBoolean(info->isClose());
+        tightMarshalNestedObject(wireFormat, info->getConsumerId().get(), dataOut, bs);
+        dataOut->writeInt(info->getPrefetch());
+        if (wireVersion >= 2) {
+            bs->writeBoolean(info->isFlush());
+        }
+        if (wireVersion >= 2) {
+            bs->writeBoolean(info->isStart());
+        }
+        if (wireVersion >= 2) {
+            bs->writeBoolean(info->isStop());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConsumerControlMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
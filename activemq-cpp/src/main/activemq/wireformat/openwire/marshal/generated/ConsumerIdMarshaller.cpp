@@ -106,6 +106,24 @@ void ConsumerIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructu
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerIdMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ConsumerId* info =
+            dynamic_cast<ConsumerId*>(dataStructure);
+
+        BaseDataStreamMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        tightMarshalString(info->getConnectionId(), dataOut, bs);
+        tightMarshalLong(wireFormat, info->getSessionId(), dataOut, bs);
+        tightMarshalLong(wireFormat, info->getValue(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConsumerIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -195,6 +195,47 @@ void ConsumerInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruc
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ConsumerInfoMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ConsumerInfo* info =
+            dynamic_cast<ConsumerInfo*>(dataStructure);
+
+        BaseCommandMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedObject(wireFormat, info->getConsumerId().get(), dataOut, bs);
+        bs->writeBoolean(info->isBrowser());
+        tightMarshalCachedObject(wireFormat, info->getDestination().get(), dataOut, bs);
+        dataOut->writeInt(info->getPrefetchSize());
+        dataOut->writeInt(info->getMaximumPendingMessageLimit());
+        bs->writeBoolean(info->isDispatchAsync());
+        tightMarshalString(info->getSelector(), dataOut, bs);
+        if (wireVersion >= 10) {
+            tightMarshalString(info->getClientId(), dataOut, bs);
+        }
+        tightMarshalString(info->getSubscriptionName(), dataOut, bs);
+        bs->writeBoolean(info->isNoLocal());
+        bs->writeBoolean(info->isExclusive());
+        bs->writeBoolean(info->isRetroactive());
+        dataOut->write(info->getPriority());
+        tightMarshalObjectArray(wireFormat, info->getBrokerPath(), dataOut, bs);
+        tightMarshalNestedObject(wireFormat, info->getAdditionalPredicate().get(), dataOut, bs);
+        bs->writeBoolean(info->isNetworkSubscription());
+        bs->writeBoolean(info->isOptimizedAcknowledge());
+        bs->writeBoolean(info->isNoRangeAcks());
+        if (wireVersion >= 4) {
+            tightMarshalObjectArray(wireFormat, info->getNetworkConsumerPath(), dataOut, bs);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ConsumerInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -110,6 +110,22 @@ void DataArrayResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Data
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DataArrayResponseMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        DataArrayResponse* info =
+            dynamic_cast<DataArrayResponse*>(dataStructure);
+
+        ResponseMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        tightMarshalObjectArray(wireFormat, info->getData(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void DataArrayResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
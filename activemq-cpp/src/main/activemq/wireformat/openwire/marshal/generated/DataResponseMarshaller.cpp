@@ -101,6 +101,22 @@ void DataResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruc
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DataResponseMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        DataResponse* info =
+            dynamic_cast<DataResponse*>(dataStructure);
+
+        ResponseMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        tightMarshalNestedObject(wireFormat, info->getData().get(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void DataResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
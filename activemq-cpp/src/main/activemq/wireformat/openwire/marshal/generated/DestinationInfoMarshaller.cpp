@@ -123,6 +123,26 @@ void DestinationInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DestinationInfoMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        DestinationInfo* info =
+            dynamic_cast<DestinationInfo*>(dataStructure);
+
+        BaseCommandMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        tightMarshalCachedObject(wireFormat, info->getConnectionId().get(), dataOut, bs);
+        tightMarshalCachedObject(wireFormat, info->getDestination().get(), dataOut, bs);
+        dataOut->write(info->getOperationType());
+        tightMarshalLong(wireFormat, info->getTimeout(), dataOut, bs);
+        tightMarshalObjectArray(wireFormat, info->getBrokerPath(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void DestinationInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -101,6 +101,22 @@ void ExceptionResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Data
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ExceptionResponseMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ExceptionResponse* info =
+            dynamic_cast<ExceptionResponse*>(dataStructure);
+
+        ResponseMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        tightMarshalBrokerError(wireFormat, info->getException().get(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ExceptionResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
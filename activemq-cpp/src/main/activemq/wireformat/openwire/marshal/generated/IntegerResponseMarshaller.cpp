@@ -96,6 +96,22 @@ void IntegerResponseMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void IntegerResponseMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        IntegerResponse* info =
+            dynamic_cast<IntegerResponse*>(dataStructure);
+
+        ResponseMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        dataOut->writeInt(info->getResult());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void IntegerResponseMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
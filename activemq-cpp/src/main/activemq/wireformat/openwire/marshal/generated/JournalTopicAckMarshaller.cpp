@@ -118,6 +118,27 @@ void JournalTopicAckMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void JournalTopicAckMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        JournalTopicAck* info =
+            dynamic_cast<JournalTopicAck*>(dataStructure);
+
+        BaseDataStreamMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        tightMarshalNestedObject(wireFormat, info->getDestination().get(), dataOut, bs);
+        tightMarshalNestedObject(wireFormat, info->getMessageId().get(), dataOut, bs);
+        tightMarshalLong(wireFormat, info->getMessageSequenceId(), dataOut, bs);
+        tightMarshalString(info->getSubscritionName(), dataOut, bs);
+        tightMarshalString(info->getClientId(), dataOut, bs);
+        tightMarshalNestedObject(wireFormat, info->getTransactionId().get(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void JournalTopicAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -104,6 +104,23 @@ void LocalTransactionIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Dat
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void LocalTransactionIdMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        LocalTransactionId* info =
+            dynamic_cast<LocalTransactionId*>(dataStructure);
+
+        TransactionIdMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        tightMarshalLong(wireFormat, info->getValue(), dataOut, bs);
+        tightMarshalCachedObject(wireFormat, info->getConnectionId().get(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void LocalTransactionIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
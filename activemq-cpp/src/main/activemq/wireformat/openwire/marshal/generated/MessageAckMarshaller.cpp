@@ -18,6 +18,8 @@
 #include <activemq/wireformat/openwire/marshal/generated/MessageAckMarshaller.h>
 
 #include <activemq/commands/MessageAck.h>
+#include <activemq/wireformat/openwire/marshal/generated/ConsumerIdMarshaller.h>
+#include <activemq/wireformat/openwire/marshal/generated/MessageIdMarshaller.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <decaf/lang/Pointer.h>
 
@@ -66,13 +68,13 @@ void MessageAckMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStruct
             tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
         info->setTransactionId(Pointer<TransactionId>(dynamic_cast<TransactionId* >(
             tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
-        info->setConsumerId(Pointer<ConsumerId>(dynamic_cast<ConsumerId* >(
-            tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setConsumerId(Pointer<ConsumerId>(
+            tightUnmarshalCachedId<ConsumerId, ConsumerIdMarshaller>(wireFormat, dataIn, bs)));
         info->setAckType(dataIn->readByte());
-        info->setFirstMessageId(Pointer<MessageId>(dynamic_cast<MessageId* >(
-            tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
-        info->setLastMessageId(Pointer<MessageId>(dynamic_cast<MessageId* >(
-            tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        info->setFirstMessageId(Pointer<MessageId>(
+            tightUnmarshalNestedId<MessageId, MessageIdMarshaller>(wireFormat, dataIn, bs)));
+        info->setLastMessageId(Pointer<MessageId>(
+            tightUnmarshalNestedId<MessageId, MessageIdMarshaller>(wireFormat, dataIn, bs)));
         info->setMessageCount(dataIn->readInt());
         if (wireVersion >= 7) {
             info->setPoisonCause(Pointer<BrokerError>(dynamic_cast<BrokerError* >(
@@ -140,6 +142,34 @@ void MessageAckMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructu
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessageAckMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        MessageAck* info =
+            dynamic_cast<MessageAck*>(dataStructure);
+
+        BaseCommandMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedObject(wireFormat, info->getDestination().get(), dataOut, bs);
+        tightMarshalCachedObject(wireFormat, info->getTransactionId().get(), dataOut, bs);
+        tightMarshalCachedId<ConsumerIdMarshaller>(wireFormat, info->getConsumerId().get(), dataOut, bs);
+        dataOut->write(info->getAckType());
+        tightMarshalNestedId<MessageIdMarshaller>(wireFormat, info->getFirstMessageId().get(), dataOut, bs);
+        tightMarshalNestedId<MessageIdMarshaller>(wireFormat, info->getLastMessageId().get(), dataOut, bs);
+        dataOut->writeInt(info->getMessageCount());
+        if (wireVersion >= 7) {
+            tightMarshalBrokerError(wireFormat, info->getPoisonCause().get(), dataOut, bs);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessageAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -155,13 +185,13 @@ void MessageAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStruct
             looseUnmarshalCachedObject(wireFormat, dataIn))));
         info->setTransactionId(Pointer<TransactionId>(dynamic_cast<TransactionId*>(
             looseUnmarshalCachedObject(wireFormat, dataIn))));
-        info->setConsumerId(Pointer<ConsumerId>(dynamic_cast<ConsumerId*>(
-            looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setConsumerId(Pointer<ConsumerId>(
+            looseUnmarshalCachedId<ConsumerId, ConsumerIdMarshaller>(wireFormat, dataIn)));
         info->setAckType(dataIn->readByte());
-        info->setFirstMessageId(Pointer<MessageId>(dynamic_cast<MessageId*>(
-            looseUnmarshalNestedObject(wireFormat, dataIn))));
-        info->setLastMessageId(Pointer<MessageId>(dynamic_cast<MessageId*>(
-            looseUnmarshalNestedObject(wireFormat, dataIn))));
+        info->setFirstMessageId(Pointer<MessageId>(
+            looseUnmarshalNestedId<MessageId, MessageIdMarshaller>(wireFormat, dataIn)));
+        info->setLastMessageId(Pointer<MessageId>(
+            looseUnmarshalNestedId<MessageId, MessageIdMarshaller>(wireFormat, dataIn)));
         info->setMessageCount(dataIn->readInt());
         if (wireVersion >= 7) {
             info->setPoisonCause(Pointer<BrokerError>(dynamic_cast< BrokerError*>(
@@ -186,10 +216,10 @@ void MessageAckMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStructur
 
         looseMarshalCachedObject(wireFormat, info->getDestination().get(), dataOut);
         looseMarshalCachedObject(wireFormat, info->getTransactionId().get(), dataOut);
-        looseMarshalCachedObject(wireFormat, info->getConsumerId().get(), dataOut);
+        looseMarshalCachedId<ConsumerIdMarshaller>(wireFormat, info->getConsumerId().get(), dataOut);
         dataOut->write(info->getAckType());
-        looseMarshalNestedObject(wireFormat, info->getFirstMessageId().get(), dataOut);
-        looseMarshalNestedObject(wireFormat, info->getLastMessageId().get(), dataOut);
+        looseMarshalNestedId<MessageIdMarshaller>(wireFormat, info->getFirstMessageId().get(), dataOut);
+        looseMarshalNestedId<MessageIdMarshaller>(wireFormat, info->getLastMessageId().get(), dataOut);
         dataOut->writeInt(info->getMessageCount());
         if (wireVersion >= 7) {
             looseMarshalBrokerError(wireFormat, info->getPoisonCause().get(), dataOut);
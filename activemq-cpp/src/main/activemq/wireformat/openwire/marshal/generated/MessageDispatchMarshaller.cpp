@@ -18,6 +18,7 @@
 #include <activemq/wireformat/openwire/marshal/generated/MessageDispatchMarshaller.h>
 
 #include <activemq/commands/MessageDispatch.h>
+#include <activemq/wireformat/openwire/marshal/generated/ConsumerIdMarshaller.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <decaf/lang/Pointer.h>
 
@@ -59,8 +60,8 @@ void MessageDispatchMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataS
 
         MessageDispatch* info =
             dynamic_cast<MessageDispatch*>(dataStructure);
-        info->setConsumerId(Pointer<ConsumerId>(dynamic_cast<ConsumerId* >(
-            tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setConsumerId(Pointer<ConsumerId>(
+            tightUnmarshalCachedId<ConsumerId, ConsumerIdMarshaller>(wireFormat, dataIn, bs)));
         info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
             tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
         info->setMessage(Pointer<Message>(dynamic_cast<Message* >(
@@ -111,6 +112,25 @@ void MessageDispatchMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessageDispatchMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        MessageDispatch* info =
+            dynamic_cast<MessageDispatch*>(dataStructure);
+
+        BaseCommandMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        tightMarshalCachedId<ConsumerIdMarshaller>(wireFormat, info->getConsumerId().get(), dataOut, bs);
+        tightMarshalCachedObject(wireFormat, info->getDestination().get(), dataOut, bs);
+        tightMarshalNestedObject(wireFormat, info->getMessage().get(), dataOut, bs);
+        dataOut->writeInt(info->getRedeliveryCounter());
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessageDispatchMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -119,8 +139,8 @@ void MessageDispatchMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataS
         BaseCommandMarshaller::looseUnmarshal(wireFormat, dataStructure, dataIn);
         MessageDispatch* info =
             dynamic_cast<MessageDispatch*>(dataStructure);
-        info->setConsumerId(Pointer<ConsumerId>(dynamic_cast<ConsumerId*>(
-            looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setConsumerId(Pointer<ConsumerId>(
+            looseUnmarshalCachedId<ConsumerId, ConsumerIdMarshaller>(wireFormat, dataIn)));
         info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination*>(
             looseUnmarshalCachedObject(wireFormat, dataIn))));
         info->setMessage(Pointer<Message>(dynamic_cast<Message*>(
@@ -140,7 +160,7 @@ void MessageDispatchMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStr
         MessageDispatch* info =
             dynamic_cast<MessageDispatch*>(dataStructure);
         BaseCommandMarshaller::looseMarshal(wireFormat, dataStructure, dataOut);
-        looseMarshalCachedObject(wireFormat, info->getConsumerId().get(), dataOut);
+        looseMarshalCachedId<ConsumerIdMarshaller>(wireFormat, info->getConsumerId().get(), dataOut);
         looseMarshalCachedObject(wireFormat, info->getDestination().get(), dataOut);
         looseMarshalNestedObject(wireFormat, info->getMessage().get(), dataOut);
         dataOut->writeInt(info->getRedeliveryCounter());
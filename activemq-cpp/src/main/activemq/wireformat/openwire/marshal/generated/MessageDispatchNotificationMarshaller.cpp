@@ -112,6 +112,25 @@ void MessageDispatchNotificationMarshaller::tightMarshal2(OpenWireFormat* wireFo
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessageDispatchNotificationMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        MessageDispatchNotification* info =
+            dynamic_cast<MessageDispatchNotification*>(dataStructure);
+
+        BaseCommandMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        tightMarshalCachedObject(wireFormat, info->getConsumerId().get(), dataOut, bs);
+        tightMarshalCachedObject(wireFormat, info->getDestination().get(), dataOut, bs);
+        tightMarshalLong(wireFormat, info->getDeliverySequenceId(), dataOut, bs);
+        tightMarshalNestedObject(wireFormat, info->getMessageId().get(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessageDispatchNotificationMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -18,6 +18,7 @@
 #include <activemq/wireformat/openwire/marshal/generated/MessageIdMarshaller.h>
 
 #include <activemq/commands/MessageId.h>
+#include <activemq/wireformat/openwire/marshal/generated/ProducerIdMarshaller.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <decaf/lang/Pointer.h>
 
@@ -65,8 +66,8 @@ void MessageIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStructu
         if (wireVersion >= 10) {
             info->setTextView(tightUnmarshalString(dataIn, bs));
         }
-        info->setProducerId(Pointer<ProducerId>(dynamic_cast<ProducerId* >(
-            tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setProducerId(Pointer<ProducerId>(
+            tightUnmarshalCachedId<ProducerId, ProducerIdMarshaller>(wireFormat, dataIn, bs)));
         info->setProducerSequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
         info->setBrokerSequenceId(tightUnmarshalLong(wireFormat, dataIn, bs));
     }
@@ -125,6 +126,30 @@ void MessageIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructur
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessageIdMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        MessageId* info =
+            dynamic_cast<MessageId*>(dataStructure);
+
+        BaseDataStreamMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 10) {
+            tightMarshalString(info->getTextView(), dataOut, bs);
+        }
+        tightMarshalCachedId<ProducerIdMarshaller>(wireFormat, info->getProducerId().get(), dataOut, bs);
+        tightMarshalLong(wireFormat, info->getProducerSequenceId(), dataOut, bs);
+        tightMarshalLong(wireFormat, info->getBrokerSequenceId(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessageIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -139,8 +164,8 @@ void MessageIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructu
         if (wireVersion >= 10) {
             info->setTextView(looseUnmarshalString(dataIn));
         }
-        info->setProducerId(Pointer<ProducerId>(dynamic_cast<ProducerId*>(
-            looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setProducerId(Pointer<ProducerId>(
+            looseUnmarshalCachedId<ProducerId, ProducerIdMarshaller>(wireFormat, dataIn)));
         info->setProducerSequenceId(looseUnmarshalLong(wireFormat, dataIn));
         info->setBrokerSequenceId(looseUnmarshalLong(wireFormat, dataIn));
     }
@@ -163,7 +188,7 @@ void MessageIdMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStructure
         if (wireVersion >= 10) {
             looseMarshalString(info->getTextView(), dataOut);
         }
-        looseMarshalCachedObject(wireFormat, info->getProducerId().get(), dataOut);
+        looseMarshalCachedId<ProducerIdMarshaller>(wireFormat, info->getProducerId().get(), dataOut);
         looseMarshalLong(wireFormat, info->getProducerSequenceId(), dataOut);
         looseMarshalLong(wireFormat, info->getBrokerSequenceId(), dataOut);
     }
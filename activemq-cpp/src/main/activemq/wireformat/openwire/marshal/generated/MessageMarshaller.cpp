@@ -18,6 +18,9 @@
 #include <activemq/wireformat/openwire/marshal/generated/MessageMarshaller.h>
 
 #include <activemq/commands/Message.h>
+#include <activemq/wireformat/openwire/marshal/generated/ConsumerIdMarshaller.h>
+#include <activemq/wireformat/openwire/marshal/generated/MessageIdMarshaller.h>
+#include <activemq/wireformat/openwire/marshal/generated/ProducerIdMarshaller.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <decaf/lang/Pointer.h>
 
@@ -52,16 +55,16 @@ void MessageMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStructure
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setProducerId(Pointer<ProducerId>(dynamic_cast<ProducerId* >(
-            tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setProducerId(Pointer<ProducerId>(
+            tightUnmarshalCachedId<ProducerId, ProducerIdMarshaller>(wireFormat, dataIn, bs)));
         info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
             tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
         info->setTransactionId(Pointer<TransactionId>(dynamic_cast<TransactionId* >(
             tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
         info->setOriginalDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination* >(
             tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
-        info->setMessageId(Pointer<MessageId>(dynamic_cast<MessageId* >(
-            tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+        info->setMessageId(Pointer<MessageId>(
+            tightUnmarshalNestedId<MessageId, MessageIdMarshaller>(wireFormat, dataIn, bs)));
         info->setOriginalTransactionId(Pointer<TransactionId>(dynamic_cast<TransactionId* >(
             tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
         info->setGroupID(tightUnmarshalString(dataIn, bs));
@@ -74,12 +77,12 @@ void MessageMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStructure
             tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
         info->setTimestamp(tightUnmarshalLong(wireFormat, dataIn, bs));
         info->setType(tightUnmarshalString(dataIn, bs));
-        info->setContent(tightUnmarshalByteArray(dataIn, bs));
-        info->setMarshalledProperties(tightUnmarshalByteArray(dataIn, bs));
+        tightUnmarshalByteArray(dataIn, bs, info->getContent());
+        tightUnmarshalByteArray(dataIn, bs, info->getMarshalledProperties());
         info->setDataStructure(Pointer<DataStructure>(dynamic_cast<DataStructure* >(
             tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
-        info->setTargetConsumerId(Pointer<ConsumerId>(dynamic_cast<ConsumerId* >(
-            tightUnmarshalCachedObject(wireFormat, dataIn, bs))));
+        info->setTargetConsumerId(Pointer<ConsumerId>(
+            tightUnmarshalCachedId<ConsumerId, ConsumerIdMarshaller>(wireFormat, dataIn, bs)));
         info->setCompressed(bs->readBoolean());
         info->setRedeliveryCounter(dataIn->readInt());
 
@@ -250,6 +253,72 @@ void MessageMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStructure*
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessageMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        Message* info =
+            dynamic_cast<Message*>(dataStructure);
+
+        BaseCommandMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedId<ProducerIdMarshaller>(wireFormat, info->getProducerId().get(), dataOut, bs);
+        tightMarshalCachedObject(wireFormat, info->getDestination().get(), dataOut, bs);
+        tightMarshalCachedObject(wireFormat, info->getTransactionId().get(), dataOut, bs);
+        tightMarshalCachedObject(wireFormat, info->getOriginalDestination().get(), dataOut, bs);
+        tightMarshalNestedId<MessageIdMarshaller>(wireFormat, info->getMessageId().get(), dataOut, bs);
+        tightMarshalCachedObject(wireFormat, info->getOriginalTransactionId().get(), dataOut, bs);
+        tightMarshalString(info->getGroupID(), dataOut, bs);
+        dataOut->writeInt(info->getGroupSequence());
+        tightMarshalString(info->getCorrelationId(), dataOut, bs);
+        bs->writeBoolean(info->isPersistent());
+        tightMarshalLong(wireFormat, info->getExpiration(), dataOut, bs);
+        dataOut->write(info->getPriority());
+        tightMarshalNestedObject(wireFormat, info->getReplyTo().get(), dataOut, bs);
+        tightMarshalLong(wireFormat, info->getTimestamp(), dataOut, bs);
+        tightMarshalString(info->getType(), dataOut, bs);
+        bs->writeBoolean(info->getContent().size() != 0);
+        if (info->getContent().size() != 0) {
+            dataOut->writeInt((int)info->getContent().size() );
+            dataOut->write((const unsigned char*)(&info->getContent()[0]), (int)info->getContent().size(), 0, (int)info->getContent().size());
+        }
+        bs->writeBoolean(info->getMarshalledProperties().size() != 0);
+        if (info->getMarshalledProperties().size() != 0) {
+            dataOut->writeInt((int)info->getMarshalledProperties().size() );
+            dataOut->write((const unsigned char*)(&info->getMarshalledProperties()[0]), (int)info->getMarshalledProperties().size(), 0, (int)info->getMarshalledProperties().size());
+        }
+        tightMarshalNestedObject(wireFormat, info->getDataStructure().get(), dataOut, bs);
+        tightMarshalCachedId<ConsumerIdMarshaller>(wireFormat, info->getTargetConsumerId().get(), dataOut, bs);
+        bs->writeBoolean(info->isCompressed());
+        dataOut->writeInt(info->getRedeliveryCounter());
+        tightMarshalObjectArray(wireFormat, info->getBrokerPath(), dataOut, bs);
+        tightMarshalLong(wireFormat, info->getArrival(), dataOut, bs);
+        tightMarshalString(info->getUserID(), dataOut, bs);
+        bs->writeBoolean(info->isRecievedByDFBridge());
+        if (wireVersion >= 2) {
+            bs->writeBoolean(info->isDroppable());
+        }
+        if (wireVersion >= 3) {
+            tightMarshalObjectArray(wireFormat, info->getCluster(), dataOut, bs);
+        }
+        if (wireVersion >= 3) {
+            tightMarshalLong(wireFormat, info->getBrokerInTime(), dataOut, bs);
+        }
+        if (wireVersion >= 3) {
+            tightMarshalLong(wireFormat, info->getBrokerOutTime(), dataOut, bs);
+        }
+        if (wireVersion >= 10) {
+            bs->writeBoolean(info->isJMSXGroupFirstForConsumer());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -261,16 +330,16 @@ void MessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure
 
         int wireVersion = wireFormat->getVersion();
 
-        info->setProducerId(Pointer<ProducerId>(dynamic_cast<ProducerId*>(
-            looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setProducerId(Pointer<ProducerId>(
+            looseUnmarshalCachedId<ProducerId, ProducerIdMarshaller>(wireFormat, dataIn)));
         info->setDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination*>(
             looseUnmarshalCachedObject(wireFormat, dataIn))));
         info->setTransactionId(Pointer<TransactionId>(dynamic_cast<TransactionId*>(
             looseUnmarshalCachedObject(wireFormat, dataIn))));
         info->setOriginalDestination(Pointer<ActiveMQDestination>(dynamic_cast<ActiveMQDestination*>(
             looseUnmarshalCachedObject(wireFormat, dataIn))));
-        info->setMessageId(Pointer<MessageId>(dynamic_cast<MessageId*>(
-            looseUnmarshalNestedObject(wireFormat, dataIn))));
+        info->setMessageId(Pointer<MessageId>(
+            looseUnmarshalNestedId<MessageId, MessageIdMarshaller>(wireFormat, dataIn)));
         info->setOriginalTransactionId(Pointer<TransactionId>(dynamic_cast<TransactionId*>(
             looseUnmarshalCachedObject(wireFormat, dataIn))));
         info->setGroupID(looseUnmarshalString(dataIn));
@@ -283,12 +352,12 @@ void MessageMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure
             looseUnmarshalNestedObject(wireFormat, dataIn))));
         info->setTimestamp(looseUnmarshalLong(wireFormat, dataIn));
         info->setType(looseUnmarshalString(dataIn));
-        info->setContent(looseUnmarshalByteArray(dataIn));
-        info->setMarshalledProperties(looseUnmarshalByteArray(dataIn));
+        looseUnmarshalByteArray(dataIn, info->getContent());
+        looseUnmarshalByteArray(dataIn, info->getMarshalledProperties());
         info->setDataStructure(Pointer<DataStructure>(dynamic_cast<DataStructure*>(
             looseUnmarshalNestedObject(wireFormat, dataIn))));
-        info->setTargetConsumerId(Pointer<ConsumerId>(dynamic_cast<ConsumerId*>(
-            looseUnmarshalCachedObject(wireFormat, dataIn))));
+        info->setTargetConsumerId(Pointer<ConsumerId>(
+            looseUnmarshalCachedId<ConsumerId, ConsumerIdMarshaller>(wireFormat, dataIn)));
         info->setCompressed(dataIn->readBoolean());
         info->setRedeliveryCounter(dataIn->readInt());
 
@@ -347,11 +416,11 @@ void MessageMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStructure*
 
         int wireVersion = wireFormat->getVersion();
 
-        looseMarshalCachedObject(wireFormat, info->getProducerId().get(), dataOut);
+        looseMarshalCachedId<ProducerIdMarshaller>(wireFormat, info->getProducerId().get(), dataOut);
         looseMarshalCachedObject(wireFormat, info->getDestination().get(), dataOut);
         looseMarshalCachedObject(wireFormat, info->getTransactionId().get(), dataOut);
         looseMarshalCachedObject(wireFormat, info->getOriginalDestination().get(), dataOut);
-        looseMarshalNestedObject(wireFormat, info->getMessageId().get(), dataOut);
+        looseMarshalNestedId<MessageIdMarshaller>(wireFormat, info->getMessageId().get(), dataOut);
         looseMarshalCachedObject(wireFormat, info->getOriginalTransactionId().get(), dataOut);
         looseMarshalString(info->getGroupID(), dataOut);
         dataOut->writeInt(info->getGroupSequence());
@@ -373,7 +442,7 @@ void MessageMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStructure*
             dataOut->write((const unsigned char*)(&info->getMarshalledProperties()[0]), (int)info->getMarshalledProperties().size(), 0, (int)info->getMarshalledProperties().size());
         }
         looseMarshalNestedObject(wireFormat, info->getDataStructure().get(), dataOut);
-        looseMarshalCachedObject(wireFormat, info->getTargetConsumerId().get(), dataOut);
+        looseMarshalCachedId<ConsumerIdMarshaller>(wireFormat, info->getTargetConsumerId().get(), dataOut);
         dataOut->writeBoolean(info->isCompressed());
         dataOut->writeInt(info->getRedeliveryCounter());
         looseMarshalObjectArray(wireFormat, info->getBrokerPath(), dataOut);
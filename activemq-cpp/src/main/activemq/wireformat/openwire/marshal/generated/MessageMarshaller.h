@@ -66,6 +66,11 @@ namespace generated {
                                    decaf::io::DataOutputStream* dataOut,
                                    utils::BooleanStream* bs);
 
+        virtual void tightMarshal(OpenWireFormat* wireFormat,
+                                  commands::DataStructure* dataStructure,
+                                  decaf::io::DataOutputStream* dataOut,
+                                  utils::BooleanStream* bs);
+
         virtual void looseUnmarshal(OpenWireFormat* wireFormat,
                                     commands::DataStructure* dataStructure,
                                     decaf::io::DataInputStream* dataIn);
@@ -136,6 +136,33 @@ void MessagePullMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruct
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void MessagePullMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        MessagePull* info =
+            dynamic_cast<MessagePull*>(dataStructure);
+
+        BaseCommandMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedObject(wireFormat, info->getConsumerId().get(), dataOut, bs);
+        tightMarshalCachedObject(wireFormat, info->getDestination().get(), dataOut, bs);
+        tightMarshalLong(wireFormat, info->getTimeout(), dataOut, bs);
+        if (wireVersion >= 3) {
+            tightMarshalString(info->getCorrelationId(), dataOut, bs);
+        }
+        if (wireVersion >= 3) {
+            tightMarshalNestedObject(wireFormat, info->getMessageId().get(), dataOut, bs);
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void MessagePullMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -126,6 +126,31 @@ void NetworkBridgeFilterMarshaller::tightMarshal2(OpenWireFormat* wireFormat, Da
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void NetworkBridgeFilterMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        NetworkBridgeFilter* info =
+            dynamic_cast<NetworkBridgeFilter*>(dataStructure);
+
+        BaseDataStreamMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalCachedObject(wireFormat, info->getNetworkBrokerId().get(), dataOut, bs);
+        if (wireVersion >= 10) {
+            dataOut->writeInt(info->getMessageTTL());
+        }
+        if (wireVersion >= 10) {
+            dataOut->writeInt(info->getConsumerTTL());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void NetworkBridgeFilterMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
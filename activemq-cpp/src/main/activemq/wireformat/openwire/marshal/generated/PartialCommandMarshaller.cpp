@@ -60,7 +60,7 @@ void PartialCommandMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataSt
         PartialCommand* info =
             dynamic_cast<PartialCommand*>(dataStructure);
         info->setCommandId(dataIn->readInt());
-        info->setData(tightUnmarshalByteArray(dataIn, bs));
+        tightUnmarshalByteArray(dataIn, bs, info->getData());
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
@@ -106,6 +106,27 @@ void PartialCommandMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStr
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void PartialCommandMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        PartialCommand* info =
+            dynamic_cast<PartialCommand*>(dataStructure);
+
+        BaseDataStreamMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        dataOut->writeInt(info->getCommandId());
+        bs->writeBoolean(info->getData().size() != 0);
+        if (info->getData().size() != 0) {
+            dataOut->writeInt((int)info->getData().size() );
+            dataOut->write((const unsigned char*)(&info->getData()[0]), (int)info->getData().size(), 0, (int)info->getData().size());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void PartialCommandMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -115,7 +136,7 @@ void PartialCommandMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataSt
         PartialCommand* info =
             dynamic_cast<PartialCommand*>(dataStructure);
         info->setCommandId(dataIn->readInt());
-        info->setData(looseUnmarshalByteArray(dataIn));
+        looseUnmarshalByteArray(dataIn, info->getData());
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
@@ -18,6 +18,7 @@
 #include <activemq/wireformat/openwire/marshal/generated/ProducerAckMarshaller.h>
 
 #include <activemq/commands/ProducerAck.h>
+#include <activemq/wireformat/openwire/marshal/generated/ProducerIdMarshaller.h>
 #include <activemq/exceptions/ActiveMQException.h>
 #include <decaf/lang/Pointer.h>
 
@@ -63,8 +64,8 @@ void ProducerAckMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataStruc
         int wireVersion = wireFormat->getVersion();
 
         if (wireVersion >= 3) {
-            info->setProducerId(Pointer<ProducerId>(dynamic_cast<ProducerId* >(
-                tightUnmarshalNestedObject(wireFormat, dataIn, bs))));
+            info->setProducerId(Pointer<ProducerId>(
+                tightUnmarshalNestedId<ProducerId, ProducerIdMarshaller>(wireFormat, dataIn, bs)));
         }
         if (wireVersion >= 3) {
             info->setSize(dataIn->readInt());
@@ -124,6 +125,30 @@ void ProducerAckMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStruct
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void ProducerAckMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        ProducerAck* info =
+            dynamic_cast<ProducerAck*>(dataStructure);
+
+        BaseCommandMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+
+        int wireVersion = wireFormat->getVersion();
+
+        if (wireVersion >= 3) {
+            tightMarshalNestedId<ProducerIdMarshaller>(wireFormat, info->getProducerId().get(), dataOut, bs);
+        }
+        if (wireVersion >= 3) {
+            dataOut->writeInt(info->getSize());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void ProducerAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -136,8 +161,8 @@ void ProducerAckMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStruc
         int wireVersion = wireFormat->getVersion();
 
         if (wireVersion >= 3) {
-            info->setProducerId(Pointer<ProducerId>(dynamic_cast<ProducerId*>(
-                looseUnmarshalNestedObject(wireFormat, dataIn))));
+            info->setProducerId(Pointer<ProducerId>(
+                looseUnmarshalNestedId<ProducerId, ProducerIdMarshaller>(wireFormat, dataIn)));
         }
         if (wireVersion >= 3) {
             info->setSize(dataIn->readInt());
@@ -160,7 +185,7 @@ void ProducerAckMarshaller::looseMarshal(OpenWireFormat* wireFormat, DataStructu
         int wireVersion = wireFormat->getVersion();
 
         if (wireVersion >= 3) {
-            looseMarshalNestedObject(wireFormat, info->getProducerId().get(), dataOut);
+            looseMarshalNestedId<ProducerIdMarshaller>(wireFormat, info->getProducerId().get(), dataOut);
         }
         if (wireVersion >= 3) {
             dataOut->writeInt(info->getSize());
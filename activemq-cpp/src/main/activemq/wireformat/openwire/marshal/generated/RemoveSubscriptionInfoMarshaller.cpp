@@ -107,6 +107,24 @@ void RemoveSubscriptionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat,
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void RemoveSubscriptionInfoMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        RemoveSubscriptionInfo* info =
+            dynamic_cast<RemoveSubscriptionInfo*>(dataStructure);
+
+        BaseCommandMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        tightMarshalCachedObject(wireFormat, info->getConnectionId().get(), dataOut, bs);
+        tightMarshalString(info->getSubcriptionName(), dataOut, bs);
+        tightMarshalString(info->getClientId(), dataOut, bs);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void RemoveSubscriptionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
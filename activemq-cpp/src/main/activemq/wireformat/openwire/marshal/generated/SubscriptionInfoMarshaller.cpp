@@ -138,6 +138,34 @@ void SubscriptionInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataS
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void SubscriptionInfoMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        SubscriptionInfo* info =
+            dynamic_cast<SubscriptionInfo*>(dataStructure);
+
+        BaseDataStreamMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+
+        int wireVersion = wireFormat->getVersion();
+
+        tightMarshalString(info->getClientId(), dataOut, bs);
+        tightMarshalCachedObject(wireFormat, info->getDestination().get(), dataOut, bs);
+        tightMarshalString(info->getSelector(), dataOut, bs);
+        tightMarshalString(info->getSubcriptionName(), dataOut, bs);
+        if (wireVersion >= 3) {
+            tightMarshalNestedObject(wireFormat, info->getSubscribedDestination().get(), dataOut, bs);
+        }
+        if (wireVersion >= 11) {
+            bs->writeBoolean(info->isNoLocal());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void SubscriptionInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
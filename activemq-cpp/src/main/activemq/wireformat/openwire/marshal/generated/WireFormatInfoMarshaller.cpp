@@ -63,7 +63,7 @@ void WireFormatInfoMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataSt
 
         info->setMagic(tightUnmarshalConstByteArray(dataIn, bs, 8));
         info->setVersion(dataIn->readInt());
-        info->setMarshalledProperties(tightUnmarshalByteArray(dataIn, bs));
+        tightUnmarshalByteArray(dataIn, bs, info->getMarshalledProperties());
 
         info->afterUnmarshal( wireFormat );
     }
@@ -114,6 +114,30 @@ void WireFormatInfoMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataStr
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void WireFormatInfoMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        WireFormatInfo* info =
+            dynamic_cast<WireFormatInfo*>(dataStructure);
+
+        info->beforeMarshal(wireFormat);
+        BaseDataStreamMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        dataOut->write((const unsigned char*)(&info->getMagic()[0]), 8, 0, 8);
+        dataOut->writeInt(info->getVersion());
+        bs->writeBoolean(info->getMarshalledProperties().size() != 0);
+        if (info->getMarshalledProperties().size() != 0) {
+            dataOut->writeInt((int)info->getMarshalledProperties().size() );
+            dataOut->write((const unsigned char*)(&info->getMarshalledProperties()[0]), (int)info->getMarshalledProperties().size(), 0, (int)info->getMarshalledProperties().size());
+        }
+        info->afterMarshal(wireFormat);
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void WireFormatInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -125,7 +149,7 @@ void WireFormatInfoMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataSt
         info->beforeUnmarshal(wireFormat);
         info->setMagic(looseUnmarshalConstByteArray(dataIn, 8));
         info->setVersion(dataIn->readInt());
-        info->setMarshalledProperties(looseUnmarshalByteArray(dataIn));
+        looseUnmarshalByteArray(dataIn, info->getMarshalledProperties());
         info->afterUnmarshal(wireFormat);
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
@@ -60,8 +60,8 @@ void XATransactionIdMarshaller::tightUnmarshal(OpenWireFormat* wireFormat, DataS
         XATransactionId* info =
             dynamic_cast<XATransactionId*>(dataStructure);
         info->setFormatId(dataIn->readInt());
-        info->setGlobalTransactionId(tightUnmarshalByteArray(dataIn, bs));
-        info->setBranchQualifier(tightUnmarshalByteArray(dataIn, bs));
+        tightUnmarshalByteArray(dataIn, bs, info->getGlobalTransactionId());
+        tightUnmarshalByteArray(dataIn, bs, info->getBranchQualifier());
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
@@ -113,6 +113,32 @@ void XATransactionIdMarshaller::tightMarshal2(OpenWireFormat* wireFormat, DataSt
     AMQ_CATCHALL_THROW(decaf::io::IOException)
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void XATransactionIdMarshaller::tightMarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataOutputStream* dataOut, BooleanStream* bs) {
+
+    try {
+
+        XATransactionId* info =
+            dynamic_cast<XATransactionId*>(dataStructure);
+
+        TransactionIdMarshaller::tightMarshal(wireFormat, dataStructure, dataOut, bs);
+        dataOut->writeInt(info->getFormatId());
+        bs->writeBoolean(info->getGlobalTransactionId().size() != 0);
+        if (info->getGlobalTransactionId().size() != 0) {
+            dataOut->writeInt((int)info->getGlobalTransactionId().size() );
+            dataOut->write((const unsigned char*)(&info->getGlobalTransactionId()[0]), (int)info->getGlobalTransactionId().size(), 0, (int)info->getGlobalTransactionId().size());
+        }
+        bs->writeBoolean(info->getBranchQualifier().size() != 0);
+        if (info->getBranchQualifier().size() != 0) {
+            dataOut->writeInt((int)info->getBranchQualifier().size() );
+            dataOut->write((const unsigned char*)(&info->getBranchQualifier()[0]), (int)info->getBranchQualifier().size(), 0, (int)info->getBranchQualifier().size());
+        }
+    }
+    AMQ_CATCH_RETHROW(decaf::io::IOException)
+    AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
+    AMQ_CATCHALL_THROW(decaf::io::IOException)
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void XATransactionIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataStructure* dataStructure, DataInputStream* dataIn) {
 
@@ -122,8 +148,8 @@ void XATransactionIdMarshaller::looseUnmarshal(OpenWireFormat* wireFormat, DataS
         XATransactionId* info =
             dynamic_cast<XATransactionId*>(dataStructure);
         info->setFormatId(dataIn->readInt());
-        info->setGlobalTransactionId(looseUnmarshalByteArray(dataIn));
-        info->setBranchQualifier(looseUnmarshalByteArray(dataIn));
+        looseUnmarshalByteArray(dataIn, info->getGlobalTransactionId());
+        looseUnmarshalByteArray(dataIn, info->getBranchQualifier());
     }
     AMQ_CATCH_RETHROW(decaf::io::IOException)
     AMQ_CATCH_EXCEPTION_CONVERT(exceptions::ActiveMQException, decaf::io::IOException)
@@ -24,9 +24,11 @@
 #include <decaf/net/SocketError.h>
 #include <decaf/net/SocketOptions.h>
 #include <decaf/lang/Character.h>
+#include <decaf/lang/System.h>
 #include <decaf/lang/exceptions/UnsupportedOperationException.h>
 #include <decaf/util/concurrent/atomic/AtomicBoolean.h>
 #include <stdlib.h>
+#include <errno.h>
 #include <string>
 #include <stdio.h>
 #include <iostream>
@@ -85,6 +87,8 @@ namespace tcp {
         int trafficClass;
         int soTimeout;
         int soLinger;
+        int busyPoll;
+        int receiveSpinTime;
 
         TcpSocketImpl() : apr_pool(),
                           socketHandle(NULL),
@@ -99,7 +103,44 @@ namespace tcp {
                           connected(false),
                           trafficClass(0),
                           soTimeout(-1),
-                          soLinger(-1) {
+                          soLinger(-1),
+                          busyPoll(0),
+                          receiveSpinTime(0) {
+        }
+
+        /**
+         * Retries a non-blocking receive for up to receiveSpinTime microseconds.
+         *
+         * @return the number of bytes read, -1 at the end of the stream, or zero if nothing
+         *         arrived in time and the caller should block.
+         */
+        int spinReceive(unsigned char* buffer, int length) {
+
+#if defined(MSG_DONTWAIT) && !defined(HAVE_WINSOCK2_H)
+
+            apr_os_sock_t oss;
+            apr_os_sock_get((apr_os_sock_t*) &oss, socketHandle);
+
+            // The socket itself stays blocking so that writers on other threads
+            // are unaffected, only these receives don't wait.
+            long long deadline = System::nanoTime() + (long long) receiveSpinTime * 1000;
+
+            do {
+                ssize_t count = ::recv(oss, (char*) buffer, (size_t) length, MSG_DONTWAIT);
+
+                if (count > 0) {
+                    return (int) count;
+                } else if (count == 0) {
+                    return -1;
+                } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    // Let the blocking receive report the error.
+                    break;
+                }
+
+            } while (!closed.get() && System::nanoTime() < deadline);
+#endif
+
+            return 0;
         }
     };
 
@@ -552,6 +593,10 @@ int TcpSocket::getOption(int option) const {
             }
 
             return this->impl->soLinger;
+        } else if (option == SocketOptions::SOCKET_OPTION_BUSY_POLL) {
+            return this->impl->busyPoll;
+        } else if (option == SocketOptions::SOCKET_OPTION_RECEIVE_SPIN) {
+            return this->impl->receiveSpinTime;
         }
 
         if (option == SocketOptions::SOCKET_OPTION_REUSEADDR) {
@@ -602,6 +647,22 @@ void TcpSocket::setOption(int option, int value) {
             value = value <= 0 ? 0 : 1;
             checkResult(apr_socket_opt_set(impl->socketHandle, APR_SO_LINGER, (apr_int32_t) value));
             return;
+        } else if (option == SocketOptions::SOCKET_OPTION_BUSY_POLL) {
+
+#if defined(SO_BUSY_POLL)
+            apr_os_sock_t oss;
+            apr_os_sock_get((apr_os_sock_t*) &oss, impl->socketHandle);
+
+            if (::setsockopt(oss, SOL_SOCKET, SO_BUSY_POLL, (const char*) &value, sizeof(value)) != 0) {
+                throw SocketException(__FILE__, __LINE__, SocketError::getErrorString().c_str());
+            }
+#endif
+
+            this->impl->busyPoll = value;
+            return;
+        } else if (option == SocketOptions::SOCKET_OPTION_RECEIVE_SPIN) {
+            this->impl->receiveSpinTime = value;
+            return;
         }
 
         if (option == SocketOptions::SOCKET_OPTION_REUSEADDR) {
@@ -667,6 +728,19 @@ int TcpSocket::read(unsigned char* buffer, int size, int offset, int length) {
                 "length parameter out of Bounds: %d.", length);
         }
 
+        // Spin for data that arrives shortly before paying for a blocking wake-up.
+        if (this->impl->receiveSpinTime > 0) {
+
+            int count = this->impl->spinReceive(buffer + offset, length);
+
+            if (count > 0) {
+                return count;
+            } else if (count < 0 && !isClosed()) {
+                this->impl->inputShutdown = true;
+                return -1;
+            }
+        }
+
         apr_size_t aprSize = (apr_size_t) length;
         apr_status_t result = APR_SUCCESS;
 
@@ -760,6 +834,80 @@ void TcpSocket::write(const unsigned char* buffer, int size, int offset, int len
     DECAF_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void TcpSocket::writeGather(const unsigned char* first, int firstLength,
+                            const unsigned char* second, int secondLength) {
+
+    try {
+
+        if (firstLength < 0 || secondLength < 0) {
+            throw IndexOutOfBoundsException(__FILE__, __LINE__,
+                "length parameter out of Bounds: %d.", firstLength < 0 ? firstLength : secondLength);
+        }
+
+        if ((first == NULL && firstLength > 0) || (second == NULL && secondLength > 0)) {
+            throw NullPointerException(__FILE__, __LINE__,
+                "TcpSocket::writeGather - passed buffer is null");
+        }
+
+        if (isClosed()) {
+            throw IOException(__FILE__, __LINE__,
+                "TcpSocket::writeGather - This Stream has been closed.");
+        }
+
+        struct iovec vec[2];
+        apr_int32_t count = 0;
+
+        if (firstLength > 0) {
+            vec[count].iov_base = (char*) first;
+            vec[count].iov_len = (apr_size_t) firstLength;
+            count++;
+        }
+
+        if (secondLength > 0) {
+            vec[count].iov_base = (char*) second;
+            vec[count].iov_len = (apr_size_t) secondLength;
+            count++;
+        }
+
+        apr_int32_t index = 0;
+        apr_status_t result = APR_SUCCESS;
+
+        while (index < count && !isClosed()) {
+
+            // On return sent is the amount actually sent which can end anywhere
+            // in either buffer.
+            apr_size_t sent = 0;
+            result = apr_socket_sendv(this->impl->socketHandle, vec + index, count - index, &sent);
+
+            if (result != APR_SUCCESS || isClosed()) {
+                throw IOException(__FILE__, __LINE__,
+                    "TcpSocketOutputStream::write - %s", SocketError::getErrorString().c_str());
+            }
+
+            // Skip what was fully sent and move into a partially sent buffer.
+            while (index < count && sent >= (apr_size_t) vec[index].iov_len) {
+                sent -= vec[index].iov_len;
+                index++;
+            }
+
+            if (index < count) {
+                vec[index].iov_base = (char*) vec[index].iov_base + sent;
+                vec[index].iov_len -= sent;
+            }
+        }
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+apr_socket_t* TcpSocket::getSocketHandle() const {
+    return this->impl->socketHandle;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool TcpSocket::isConnected() const {
     return this->impl->connected;
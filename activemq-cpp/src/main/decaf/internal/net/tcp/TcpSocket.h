@@ -28,6 +28,8 @@
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
 
+#include <apr_network_io.h>
+
 namespace decaf {
 namespace internal {
 namespace net {
@@ -184,6 +186,34 @@ namespace tcp {
          */
         void write(const unsigned char* buffer, int size, int offset, int length);
 
+        /**
+         * Writes the contents of two buffers to the Socket using a gathering write, the
+         * data goes out as if the buffers had been concatenated but neither is copied.
+         *
+         * @param first
+         *      The buffer to write first, can be NULL if firstLength is zero.
+         * @param firstLength
+         *      The number of bytes from the first buffer to write.
+         * @param second
+         *      The buffer to write second, can be NULL if secondLength is zero.
+         * @param secondLength
+         *      The number of bytes from the second buffer to write.
+         *
+         * @throw IOException if an I/O error occurs during the write.
+         * @throw NullPointerException if a buffer with a non-zero length is Null.
+         * @throw IndexOutOfBoundsException if one of the lengths is negative.
+         */
+        void writeGather(const unsigned char* first, int firstLength,
+                         const unsigned char* second, int secondLength);
+
+        /**
+         * Gets the APR socket that this object wraps so that it can be added to a poll
+         * set, the handle remains owned by this object.
+         *
+         * @return the APR socket handle or NULL if the socket has not been created.
+         */
+        apr_socket_t* getSocketHandle() const;
+
     protected:
 
         void checkResult(apr_status_t value) const;
@@ -100,3 +100,22 @@ void TcpSocketOutputStream::doWriteArrayBounded(const unsigned char* buffer, int
     DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
     DECAF_CATCHALL_THROW(IOException)
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void TcpSocketOutputStream::doWriteGather(const unsigned char* first, int firstLength,
+                                          const unsigned char* second, int secondLength) {
+
+    try {
+
+        if (closed) {
+            throw IOException(__FILE__, __LINE__,
+                "TcpSocketOutputStream::write - This Stream has been closed.");
+        }
+
+        this->socket->writeGather(first, firstLength, second, secondLength);
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
+    DECAF_CATCHALL_THROW(IOException)
+}
@@ -65,6 +65,9 @@ namespace tcp {
 
         virtual void doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length);
 
+        virtual void doWriteGather(const unsigned char* first, int firstLength,
+                                   const unsigned char* second, int secondLength);
+
     };
 
 }}}}
@@ -23,6 +23,18 @@
 #include <decaf/lang/exceptions/RuntimeException.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
 
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define DECAF_STRINGUTILS_AVX2
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DECAF_STRINGUTILS_SSE2
+#endif
+
 using namespace decaf;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
@@ -168,3 +180,85 @@ int StringUtils::compareIgnoreCase(const char* left, const char* right) {
 int StringUtils::compare(const char* left, const char* right) {
     return doCompare(left, right, false);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t StringUtils::asciiLength(const unsigned char* bytes, std::size_t length) {
+
+    std::size_t i = 0;
+
+    // Skip ahead in blocks while no byte in the block has its high bit set, the
+    // exact position of a non-ASCII byte is found by the scalar loop at the end.
+#ifdef DECAF_STRINGUTILS_AVX2
+    for (; i + 32 <= length; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*) (bytes + i));
+        if (_mm256_movemask_epi8(block) != 0) {
+            break;
+        }
+    }
+#endif
+
+#ifdef DECAF_STRINGUTILS_SSE2
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*) (bytes + i));
+        if (_mm_movemask_epi8(block) != 0) {
+            break;
+        }
+    }
+#else
+    for (; i + 8 <= length; i += 8) {
+        unsigned long long block;
+        std::memcpy(&block, bytes + i, 8);
+        if ((block & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+    }
+#endif
+
+    while (i < length && bytes[i] < 0x80) {
+        i++;
+    }
+
+    return i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t StringUtils::utf8SingleByteLength(const unsigned char* bytes, std::size_t length) {
+
+    std::size_t i = 0;
+
+    // As above but a block also ends the fast path when it contains a NULL byte.
+#ifdef DECAF_STRINGUTILS_AVX2
+    const __m256i zeros256 = _mm256_setzero_si256();
+    for (; i + 32 <= length; i += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i*) (bytes + i));
+        if ((_mm256_movemask_epi8(block) | _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, zeros256))) != 0) {
+            break;
+        }
+    }
+#endif
+
+#ifdef DECAF_STRINGUTILS_SSE2
+    const __m128i zeros = _mm_setzero_si128();
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*) (bytes + i));
+        if ((_mm_movemask_epi8(block) | _mm_movemask_epi8(_mm_cmpeq_epi8(block, zeros))) != 0) {
+            break;
+        }
+    }
+#else
+    for (; i + 8 <= length; i += 8) {
+        unsigned long long block;
+        std::memcpy(&block, bytes + i, 8);
+        unsigned long long hasZero = (block - 0x0101010101010101ULL) & ~block & 0x8080808080808080ULL;
+        if (((block & 0x8080808080808080ULL) | hasZero) != 0) {
+            break;
+        }
+    }
+#endif
+
+    while (i < length && bytes[i] != 0 && bytes[i] < 0x80) {
+        i++;
+    }
+
+    return i;
+}
@@ -20,6 +20,8 @@
 
 #include <decaf/util/Config.h>
 
+#include <cstddef>
+
 namespace decaf {
 namespace internal {
 namespace util {
@@ -78,6 +80,37 @@ namespace util {
          */
         static int compare(const char* left, const char* right);
 
+
+        /**
+         * Returns the number of bytes at the start of the given array that hold 7-bit
+         * ASCII values (0-127).  The bytes are checked several at a time using SSE2 or
+         * AVX2 instructions when the library is built for a CPU that has them.
+         *
+         * @param bytes
+         *      The array of bytes to scan.
+         * @param length
+         *      The number of bytes in the array.
+         *
+         * @return the index of the first byte that is not ASCII, or length if all are.
+         */
+        static std::size_t asciiLength(const unsigned char* bytes, std::size_t length);
+
+        /**
+         * Returns the number of bytes at the start of the given array that are encoded as
+         * a single byte in modified UTF-8, these are the values 1-127 since the NULL value
+         * is encoded using two bytes.  The bytes are checked several at a time in the same
+         * way as asciiLength.
+         *
+         * @param bytes
+         *      The array of bytes to scan.
+         * @param length
+         *      The number of bytes in the array.
+         *
+         * @return the index of the first byte that is not encoded as itself, or length if
+         *         all of them are.
+         */
+        static std::size_t utf8SingleByteLength(const unsigned char* bytes, std::size_t length);
+
     };
 
 }}}
@@ -0,0 +1,418 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TimerTaskWheel.h"
+
+#include <decaf/lang/System.h>
+#include <decaf/lang/Long.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+using namespace decaf;
+using namespace decaf::internal;
+using namespace decaf::internal::util;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+const long long TimerTaskWheel::DEFAULT_TICK_MILLIS = 1;
+
+////////////////////////////////////////////////////////////////////////////////
+TimerTaskWheel::TimerTaskWheel() : mutex(),
+                                   tickMillis(DEFAULT_TICK_MILLIS),
+                                   currentTick(System::currentTimeMillis() / DEFAULT_TICK_MILLIS),
+                                   count(0),
+                                   buckets(BUCKETS),
+                                   due(),
+                                   cancelled() {
+
+    for (int i = 0; i < LEVELS; ++i) {
+        this->levelCounts[i] = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TimerTaskWheel::TimerTaskWheel(long long tickMillis) : mutex(),
+                                                       tickMillis(tickMillis),
+                                                       currentTick(0),
+                                                       count(0),
+                                                       buckets(BUCKETS),
+                                                       due(),
+                                                       cancelled() {
+
+    if (tickMillis < 1) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Tick duration must be at least one millisecond.");
+    }
+
+    this->currentTick = System::currentTimeMillis() / tickMillis;
+
+    for (int i = 0; i < LEVELS; ++i) {
+        this->levelCounts[i] = 0;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TimerTaskWheel::~TimerTaskWheel() {
+    try {
+        this->reset();
+    }
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TimerTaskWheel::isEmpty() const {
+
+    bool result = true;
+    synchronized(&mutex) {
+        result = this->count == 0 && this->due.empty();
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t TimerTaskWheel::size() const {
+
+    std::size_t result = 0;
+    synchronized(&mutex) {
+        result = this->count + this->due.size();
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerTaskWheel::insert(const Pointer<TimerTask>& task) {
+
+    // Released once the lock is dropped, destroying a task can run any user code.
+    Bucket released;
+
+    synchronized(&mutex) {
+        released.swap(this->cancelled);
+
+        // An empty wheel isn't advanced, catch it up so the task isn't placed relative
+        // to a time long past.
+        if (this->count == 0 && this->due.empty()) {
+            long long now = System::currentTimeMillis() / this->tickMillis;
+            if (now > this->currentTick) {
+                this->currentTick = now;
+            }
+        }
+
+        this->place(task);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool TimerTaskWheel::remove(TimerTask* task) {
+
+    bool result = false;
+
+    synchronized(&mutex) {
+        if (task->wheelBucket >= 0) {
+            this->cancelled.push_back(this->buckets[task->wheelBucket][task->wheelIndex]);
+            this->takeOut(task);
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Pointer<TimerTask> TimerTaskWheel::poll(long long now) {
+
+    Bucket released;
+    Pointer<TimerTask> result;
+
+    synchronized(&mutex) {
+        released.swap(this->cancelled);
+
+        this->advance(now / this->tickMillis);
+
+        if (!this->due.empty()) {
+            result = this->due.front();
+            this->due.pop_front();
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long TimerTaskWheel::nextExecutionTime() const {
+
+    long long result = -1;
+
+    synchronized(&mutex) {
+
+        if (!this->due.empty()) {
+            result = 0;
+        } else if (this->count > 0) {
+
+            long long nextTick = Long::MAX_VALUE;
+
+            if (this->levelCounts[0] > 0) {
+                int index = (int) (this->currentTick & ROOT_MASK);
+                for (int i = 0; i < ROOT_SIZE; ++i) {
+                    if (!this->buckets[(index + i) & ROOT_MASK].empty()) {
+                        nextTick = this->currentTick + i;
+                        break;
+                    }
+                }
+            }
+
+            // A slot in a higher level is emptied when the wheel reaches the start of the
+            // span it covers, the current slot of a level has only been emptied if the
+            // wheel is already past the start of its span.
+            for (int level = 1; level < LEVELS; ++level) {
+
+                if (this->levelCounts[level] == 0) {
+                    continue;
+                }
+
+                int shift = shiftOf(level);
+                long long span = this->currentTick >> shift;
+                int index = (int) (span & LEVEL_MASK);
+                int start = (this->currentTick & ((1LL << shift) - 1)) == 0 ? 0 : 1;
+                int offset = ROOT_SIZE + (level - 1) * LEVEL_SIZE;
+
+                for (int i = start; i < start + LEVEL_SIZE; ++i) {
+                    if (!this->buckets[offset + ((index + i) & LEVEL_MASK)].empty()) {
+                        long long cascadeTick = (span + i) << shift;
+                        if (cascadeTick < nextTick) {
+                            nextTick = cascadeTick;
+                        }
+                        break;
+                    }
+                }
+            }
+
+            result = nextTick * this->tickMillis;
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerTaskWheel::reset() {
+
+    std::vector<Bucket> releasedBuckets(BUCKETS);
+    std::deque< Pointer<TimerTask> > releasedDue;
+    Bucket released;
+
+    synchronized(&mutex) {
+
+        for (int i = 0; i < BUCKETS; ++i) {
+            Bucket::iterator iter = this->buckets[i].begin();
+            for (; iter != this->buckets[i].end(); ++iter) {
+                (*iter)->wheelBucket = -1;
+                (*iter)->wheelIndex = -1;
+            }
+
+            releasedBuckets[i].swap(this->buckets[i]);
+        }
+
+        for (int i = 0; i < LEVELS; ++i) {
+            this->levelCounts[i] = 0;
+        }
+
+        this->count = 0;
+        releasedDue.swap(this->due);
+        released.swap(this->cancelled);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t TimerTaskWheel::deleteIfCancelled() {
+
+    std::size_t result = 0;
+    Bucket released;
+
+    synchronized(&mutex) {
+
+        released.swap(this->cancelled);
+
+        std::deque< Pointer<TimerTask> >::iterator iter = this->due.begin();
+        while (iter != this->due.end()) {
+            if ((*iter)->cancelled) {
+                released.push_back(*iter);
+                iter = this->due.erase(iter);
+                result++;
+            } else {
+                ++iter;
+            }
+        }
+
+        // Normally cancel has already taken these out of their slots.
+        for (int i = 0; i < BUCKETS; ++i) {
+            for (std::size_t j = 0; j < this->buckets[i].size();) {
+                Pointer<TimerTask> task = this->buckets[i][j];
+                if (task->cancelled) {
+                    released.push_back(task);
+                    this->takeOut(task.get());
+                    result++;
+                } else {
+                    ++j;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerTaskWheel::place(const Pointer<TimerTask>& task) {
+
+    long long expires = (task->when + this->tickMillis - 1) / this->tickMillis;
+
+    // A task whose time has already passed goes in the slot that is processed next.
+    if (expires < this->currentTick) {
+        expires = this->currentTick;
+    }
+
+    long long delta = expires - this->currentTick;
+    int level = 0;
+    int bucket = 0;
+
+    if (delta < ROOT_SIZE) {
+        bucket = (int) (expires & ROOT_MASK);
+    } else {
+
+        level = 1;
+        while (level < LEVELS - 1 && delta >= (1LL << (shiftOf(level) + LEVEL_BITS))) {
+            level++;
+        }
+
+        // Anything beyond the top level is parked in its furthest slot, it is placed
+        // again using its real time once that slot is cascaded.
+        int shift = shiftOf(level);
+        if (delta >= (1LL << (shift + LEVEL_BITS))) {
+            expires = this->currentTick + (1LL << (shift + LEVEL_BITS)) - 1;
+        }
+
+        bucket = ROOT_SIZE + (level - 1) * LEVEL_SIZE + (int) ((expires >> shift) & LEVEL_MASK);
+    }
+
+    Bucket& target = this->buckets[bucket];
+    task->wheelBucket = bucket;
+    task->wheelIndex = (int) target.size();
+    target.push_back(task);
+
+    this->levelCounts[level]++;
+    this->count++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerTaskWheel::advance(long long targetTick) {
+
+    while (this->currentTick <= targetTick) {
+
+        if (this->count == 0) {
+            this->currentTick = targetTick + 1;
+            break;
+        }
+
+        int index = (int) (this->currentTick & ROOT_MASK);
+
+        if (index == 0) {
+            // A turn of the first level is done, refill it from the level above which
+            // in turn is refilled from its parent each time it completes a turn.
+            for (int level = 1; level < LEVELS; ++level) {
+                int levelIndex = (int) ((this->currentTick >> shiftOf(level)) & LEVEL_MASK);
+                this->cascade(level, levelIndex);
+                if (levelIndex != 0) {
+                    break;
+                }
+            }
+        } else if (this->levelCounts[0] == 0) {
+
+            // Nothing happens until the lowest level holding tasks is cascaded.
+            int level = 1;
+            while (this->levelCounts[level] == 0) {
+                level++;
+            }
+
+            long long next = ((this->currentTick >> shiftOf(level)) + 1) << shiftOf(level);
+            this->currentTick = next < targetTick + 1 ? next : targetTick + 1;
+            continue;
+        }
+
+        Bucket expired;
+        expired.swap(this->buckets[index]);
+
+        Bucket::iterator iter = expired.begin();
+        for (; iter != expired.end(); ++iter) {
+            (*iter)->wheelBucket = -1;
+            (*iter)->wheelIndex = -1;
+            this->due.push_back(*iter);
+        }
+
+        this->levelCounts[0] -= expired.size();
+        this->count -= expired.size();
+        this->currentTick++;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerTaskWheel::cascade(int level, int index) {
+
+    Bucket moving;
+    moving.swap(this->buckets[ROOT_SIZE + (level - 1) * LEVEL_SIZE + index]);
+
+    this->levelCounts[level] -= moving.size();
+    this->count -= moving.size();
+
+    Bucket::iterator iter = moving.begin();
+    for (; iter != moving.end(); ++iter) {
+        this->place(*iter);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerTaskWheel::takeOut(TimerTask* task) {
+
+    Bucket& bucket = this->buckets[task->wheelBucket];
+    int index = task->wheelIndex;
+
+    if (index != (int) bucket.size() - 1) {
+        bucket[index] = bucket.back();
+        bucket[index]->wheelIndex = index;
+    }
+
+    bucket.pop_back();
+
+    this->levelCounts[levelOf(task->wheelBucket)]--;
+    this->count--;
+
+    task->wheelBucket = -1;
+    task->wheelIndex = -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int TimerTaskWheel::levelOf(int bucket) {
+    return bucket < ROOT_SIZE ? 0 : 1 + (bucket - ROOT_SIZE) / LEVEL_SIZE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int TimerTaskWheel::shiftOf(int level) {
+    return ROOT_BITS + (level - 1) * LEVEL_BITS;
+}
@@ -0,0 +1,201 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_INTERNAL_UTIL_TIMERTASKWHEEL_H_
+#define _DECAF_INTERNAL_UTIL_TIMERTASKWHEEL_H_
+
+#include <decaf/util/Config.h>
+
+#include <decaf/util/TimerTask.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/lang/Pointer.h>
+
+#include <deque>
+#include <vector>
+
+namespace decaf {
+namespace internal {
+namespace util {
+
+    using decaf::lang::Pointer;
+    using decaf::util::TimerTask;
+
+    /**
+     * A hierarchical timing wheel implemented for the Timer class in Decaf Util as an
+     * alternative to the TimerTaskHeap when a Timer holds a very large number of tasks.
+     *
+     * Time is divided into ticks.  The first level of the wheel has a slot for each of the
+     * next 256 ticks and each of the four levels above it has 64 slots that each cover a
+     * whole turn of the level below, so a task can be placed up to 2^32 ticks out.  Adding
+     * and removing a task is a constant time operation, a task is moved down a level each
+     * time the level below it completes a turn until it lands in a slot of the first level.
+     *
+     * Tasks that are canceled are taken out of the wheel right away rather than being left
+     * in place until they come due or the Timer is purged.  Since the caller of cancel may
+     * still be using the task, the wheel only destroys its reference to it on the next call
+     * to poll, insert or reset.
+     *
+     * Unlike the TimerTaskHeap this class is thread safe, cancel calls into it directly.
+     *
+     * @since 3.10.0
+     */
+    class DECAF_API TimerTaskWheel {
+    public:
+
+        /**
+         * The default duration of a tick, tasks can run up to one tick later than scheduled.
+         */
+        static const long long DEFAULT_TICK_MILLIS;
+
+    private:
+
+        static const int ROOT_BITS = 8;
+        static const int ROOT_SIZE = 1 << ROOT_BITS;
+        static const int ROOT_MASK = ROOT_SIZE - 1;
+        static const int LEVEL_BITS = 6;
+        static const int LEVEL_SIZE = 1 << LEVEL_BITS;
+        static const int LEVEL_MASK = LEVEL_SIZE - 1;
+        static const int LEVELS = 5;
+        static const int BUCKETS = ROOT_SIZE + (LEVELS - 1) * LEVEL_SIZE;
+
+        typedef std::vector< Pointer<TimerTask> > Bucket;
+
+        mutable decaf::util::concurrent::Mutex mutex;
+
+        long long tickMillis;
+
+        // The next tick to be processed, every task in the wheel is due at or after it.
+        long long currentTick;
+
+        // Tasks in the wheel's slots and the number in each level.
+        std::size_t count;
+        std::size_t levelCounts[LEVELS];
+
+        std::vector<Bucket> buckets;
+
+        // Tasks whose time has come, in the order they came due.
+        std::deque< Pointer<TimerTask> > due;
+
+        // Tasks removed by cancel, released on the next call that doesn't come from cancel.
+        Bucket cancelled;
+
+    private:
+
+        TimerTaskWheel(const TimerTaskWheel&);
+        TimerTaskWheel& operator= (const TimerTaskWheel&);
+
+    public:
+
+        TimerTaskWheel();
+
+        /**
+         * Creates a wheel that advances once every tickMillis milliseconds.
+         *
+         * @param tickMillis
+         *      The duration of a tick in milliseconds.
+         *
+         * @throws IllegalArgumentException if tickMillis is less than one.
+         */
+        TimerTaskWheel(long long tickMillis);
+
+        virtual ~TimerTaskWheel();
+
+        /**
+         * @return true if there are no tasks in the wheel.
+         */
+        bool isEmpty() const;
+
+        /**
+         * @return the number of tasks in the wheel, including those that are due.
+         */
+        std::size_t size() const;
+
+        /**
+         * @return the duration of a tick in milliseconds.
+         */
+        long long getTickMillis() const {
+            return this->tickMillis;
+        }
+
+        /**
+         * Adds the task to the wheel based on its next execution time.
+         *
+         * @param task
+         *      The TimerTask to add to the wheel.
+         */
+        void insert(const Pointer<TimerTask>& task);
+
+        /**
+         * Takes the given task out of the wheel.
+         *
+         * @param task
+         *      The TimerTask to remove.
+         *
+         * @return true if the task was waiting in the wheel and has been removed, false if
+         *         it wasn't in the wheel or had already come due.
+         */
+        bool remove(TimerTask* task);
+
+        /**
+         * Advances the wheel to the given time and returns the task that has been due the
+         * longest, if any.
+         *
+         * @param now
+         *      The current time in milliseconds.
+         *
+         * @return the next task that is due, or a Null Pointer if none are.
+         */
+        Pointer<TimerTask> poll(long long now);
+
+        /**
+         * Returns the time at which poll should next be called.  The wheel may only need
+         * to move tasks down a level at that time, in which case poll returns nothing and
+         * this method gives a later time.
+         *
+         * @return the time in milliseconds of the next tick that holds work, or -1 if the
+         *         wheel is empty.
+         */
+        long long nextExecutionTime() const;
+
+        /**
+         * Clear all contents from the wheel.
+         */
+        void reset();
+
+        /**
+         * Removes any canceled tasks that are still in the wheel, which only happens when
+         * they were canceled after coming due, and releases those that cancel removed.
+         *
+         * @return the number of canceled tasks found in the wheel.
+         */
+        std::size_t deleteIfCancelled();
+
+    private:
+
+        void place(const Pointer<TimerTask>& task);
+        void advance(long long targetTick);
+        void cascade(int level, int index);
+        void takeOut(TimerTask* task);
+
+        static int levelOf(int bucket);
+        static int shiftOf(int level);
+
+    };
+
+}}}
+
+#endif /* _DECAF_INTERNAL_UTIL_TIMERTASKWHEEL_H_ */
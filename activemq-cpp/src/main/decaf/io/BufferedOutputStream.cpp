@@ -172,6 +172,15 @@ void BufferedOutputStream::doWriteArrayBounded(const unsigned char* buffer, int
             throw IndexOutOfBoundsException(__FILE__, __LINE__, "length parameter out of Bounds: %d.", length);
         }
 
+        // Data that doesn't fit in what is left of the buffer is handed to the
+        // underlying stream along with the buffered bytes in a single write,
+        // rather than being copied through the buffer a piece at a time.
+        if (length > bufferSize - tail) {
+            this->outputStream->writeGather(this->buffer + this->head, this->tail - this->head, buffer + offset, length);
+            this->head = this->tail = 0;
+            return;
+        }
+
         // Iterate until all the data is written.
         for (int pos = 0; pos < length;) {
 
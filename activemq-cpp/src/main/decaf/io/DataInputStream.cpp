@@ -18,6 +18,7 @@
 #include <decaf/io/DataInputStream.h>
 
 #include <decaf/io/PushbackInputStream.h>
+#include <decaf/internal/util/StringUtils.h>
 
 #ifdef HAVE_STRING_H
 #include <string.h>
@@ -29,6 +30,7 @@
 using namespace std;
 using namespace decaf;
 using namespace decaf::io;
+using namespace decaf::internal::util;
 using namespace decaf::util;
 using namespace decaf::lang;
 using namespace decaf::lang::exceptions;
@@ -228,6 +230,21 @@ std::string DataInputStream::readString() {
 ////////////////////////////////////////////////////////////////////////////////
 std::string DataInputStream::readUTF() {
 
+    try {
+
+        std::string result;
+        this->readUTF(result);
+        return result;
+    }
+    DECAF_CATCH_RETHROW(UTFDataFormatException)
+    DECAF_CATCH_RETHROW(EOFException)
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DataInputStream::readUTF(std::string& value) {
+
     try {
 
         if (inputStream == NULL) {
@@ -235,23 +252,25 @@ std::string DataInputStream::readUTF() {
         }
 
         unsigned short utfLength = readUnsignedShort();
+
+        value.resize(utfLength);
         if (utfLength == 0) {
-            return "";
+            return;
         }
 
-        std::vector<unsigned char> buffer(utfLength);
-        std::vector<unsigned char> result(utfLength);
-
-        this->readFully(&buffer[0], utfLength);
+        unsigned char* buffer = (unsigned char*) &value[0];
+        this->readFully(buffer, utfLength);
 
-        std::size_t count = 0;
-        std::size_t index = 0;
+        // The ASCII prefix is already decoded, anything after it is decoded in place
+        // since a decoded value never takes more bytes than its encoded form.
+        std::size_t count = StringUtils::asciiLength(buffer, utfLength);
+        std::size_t index = count;
         unsigned char a = 0;
 
         while (count < utfLength) {
-            if ((result[index] = buffer[count++]) < 0x80) {
+            if ((buffer[index] = buffer[count++]) < 0x80) {
                 index++;
-            } else if (((a = result[index]) & 0xE0) == 0xC0) {
+            } else if (((a = buffer[index]) & 0xE0) == 0xC0) {
                 if (count >= utfLength) {
                     throw UTFDataFormatException(__FILE__, __LINE__, "Invalid UTF-8 encoding found, start of two byte char found at end.");
                 }
@@ -269,7 +288,7 @@ std::string DataInputStream::readUTF() {
                             "This method only supports encoded ASCII values of (0-255).");
                 }
 
-                result[index++] = (unsigned char) (((a & 0x1F) << 6) | (b & 0x3F));
+                buffer[index++] = (unsigned char) (((a & 0x1F) << 6) | (b & 0x3F));
 
             } else if ((a & 0xF0) == 0xE0) {
 
@@ -280,26 +299,12 @@ std::string DataInputStream::readUTF() {
                             "This method only supports encoded ASCII values of (0-255).");
                 }
 
-                // If we were to support multibyte strings in the future this would be
-                // the remainder of this method decoding logic.
-                //
-                //int b = buffer[count++];
-                //int c = buffer[count++];
-                //if( ( ( b & 0xC0 ) != 0x80 ) || ( ( c & 0xC0 ) != 0x80 ) ) {
-                //    throw UTFDataFormatException(
-                //        __FILE__, __LINE__,
-                //        "Invalid UTF-8 encoding found, byte two does not start with 0x80." );
-                //}
-                //
-                //result[inde++] = ( ( a & 0x0F ) << 12 ) |
-                //                 ( ( b & 0x3F ) << 6 ) | ( c & 0x3F );
-
             } else {
                 throw UTFDataFormatException(__FILE__, __LINE__, "Invalid UTF-8 encoding found, aborting.");
             }
         }
 
-        return std::string((char*) (&result[0]), index);
+        value.resize(index);
     }
     DECAF_CATCH_RETHROW(UTFDataFormatException)
     DECAF_CATCH_RETHROW(EOFException)
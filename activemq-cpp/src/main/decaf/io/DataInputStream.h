@@ -256,6 +256,21 @@ namespace io{
          */
         virtual std::string readUTF();
 
+        /**
+         * Reads a modified UTF-8 encoded string in ASCII format into the given string,
+         * reusing the memory the string already holds.  The rules are the same as for
+         * the readUTF method that returns the decoded string.  If an exception is thrown
+         * the contents of the given string are undefined.
+         *
+         * @param value
+         *      The string that is assigned the decoded value read from the stream.
+         *
+         * @throws IOException if an I/O Error occurs.
+         * @throws EOFException if the end of input is reached.
+         * @throws UTFDataFormatException if the bytes are not valid modified UTF-8 values.
+         */
+        virtual void readUTF(std::string& value);
+
         /**
          * Reads some bytes from an input stream and stores them into the
          * buffer array buffer. The number of bytes read is equal to the length
@@ -17,12 +17,14 @@
 
 #include <decaf/io/DataOutputStream.h>
 #include <decaf/io/UTFDataFormatException.h>
+#include <decaf/internal/util/StringUtils.h>
 #include <decaf/util/Config.h>
 #include <string.h>
 #include <stdio.h>
 
 using namespace decaf;
 using namespace decaf::io;
+using namespace decaf::internal::util;
 using namespace decaf::util;
 using namespace decaf::lang::exceptions;
 
@@ -87,6 +89,24 @@ void DataOutputStream::doWriteArrayBounded(const unsigned char* buffer, int size
     DECAF_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void DataOutputStream::doWriteGather(const unsigned char* first, int firstLength,
+                                     const unsigned char* second, int secondLength) {
+
+    if (isClosed()) {
+        throw IOException(__FILE__, __LINE__, "DataOutputStream::write - Base stream is Null");
+    }
+
+    try {
+        outputStream->writeGather(first, firstLength, second, secondLength);
+        written += firstLength + secondLength;
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void DataOutputStream::writeBoolean(bool value) {
     try {
@@ -273,6 +293,28 @@ void DataOutputStream::writeUTF(const std::string& value) {
 
     try {
 
+        std::size_t length = value.length();
+        const unsigned char* bytes = (const unsigned char*) value.data();
+
+        // Values 1-127 are written as themselves, so a string made up of only those
+        // is written straight from its own buffer.
+        std::size_t asciiLength = StringUtils::utf8SingleByteLength(bytes, length);
+
+        if (asciiLength == length) {
+
+            if (length > 65535) {
+                throw UTFDataFormatException(__FILE__, __LINE__, "Attempted to write a string as UTF-8 whose length is longer "
+                        "than the supported 65535 bytes");
+            }
+
+            this->writeUnsignedShort((unsigned short) length);
+            if (length > 0) {
+                this->write(bytes, (int) length, 0, (int) length);
+            }
+
+            return;
+        }
+
         unsigned int utfLength = this->countUTFLength(value);
 
         if (utfLength > 65535) {
@@ -280,11 +322,14 @@ void DataOutputStream::writeUTF(const std::string& value) {
                     "than the supported 65535 bytes");
         }
 
-        std::size_t length = value.length();
         std::vector<unsigned char> utfBytes((std::size_t) utfLength);
-        unsigned int utfIndex = 0;
+        unsigned int utfIndex = (unsigned int) asciiLength;
 
-        for (std::size_t i = 0; i < length; i++) {
+        if (asciiLength > 0) {
+            memcpy(&utfBytes[0], bytes, asciiLength);
+        }
+
+        for (std::size_t i = asciiLength; i < length; i++) {
 
             unsigned int charValue = (unsigned char) value.at(i);
 
@@ -304,9 +349,7 @@ void DataOutputStream::writeUTF(const std::string& value) {
         }
 
         this->writeUnsignedShort((unsigned short) utfLength);
-        if (utfLength > 0) {
-            this->write(&utfBytes[0], utfIndex, 0, utfIndex);
-        }
+        this->write(&utfBytes[0], utfIndex, 0, utfIndex);
     }
     DECAF_CATCH_RETHROW(UTFDataFormatException)
     DECAF_CATCH_RETHROW(IOException)
@@ -316,10 +359,11 @@ void DataOutputStream::writeUTF(const std::string& value) {
 ////////////////////////////////////////////////////////////////////////////////
 unsigned int DataOutputStream::countUTFLength(const std::string& value) {
 
-    unsigned int utfCount = 0;
     std::size_t length = value.length();
+    std::size_t start = StringUtils::utf8SingleByteLength((const unsigned char*) value.data(), length);
+    unsigned int utfCount = (unsigned int) start;
 
-    for (std::size_t i = 0; i < length; ++i) {
+    for (std::size_t i = start; i < length; ++i) {
 
         unsigned int charValue = (unsigned char) value.at(i);
 
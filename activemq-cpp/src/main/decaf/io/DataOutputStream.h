@@ -134,6 +134,9 @@ namespace io{
 
         virtual void doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length);
 
+        virtual void doWriteGather(const unsigned char* first, int firstLength,
+                                   const unsigned char* second, int secondLength);
+
     private:
 
         // Determine the encoded length of a string when written as modified UTF-8
@@ -82,6 +82,31 @@ void OutputStream::write(const unsigned char* buffer, int size, int offset, int
     DECAF_CATCHALL_THROW(IOException)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void OutputStream::writeGather(const unsigned char* first, int firstLength,
+                               const unsigned char* second, int secondLength) {
+
+    if (firstLength < 0) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "firstLength parameter out of Bounds: %d.", firstLength);
+    }
+
+    if (secondLength < 0) {
+        throw IndexOutOfBoundsException(__FILE__, __LINE__, "secondLength parameter out of Bounds: %d.", secondLength);
+    }
+
+    if ((first == NULL && firstLength > 0) || (second == NULL && secondLength > 0)) {
+        throw NullPointerException(__FILE__, __LINE__, "Buffer pointer passed was NULL.");
+    }
+
+    try {
+        this->doWriteGather(first, firstLength, second, secondLength);
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void OutputStream::doWriteArray(const unsigned char* buffer, int size) {
 
@@ -121,3 +146,23 @@ void OutputStream::doWriteArrayBounded(const unsigned char* buffer, int size, in
     DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
     DECAF_CATCHALL_THROW(IOException)
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void OutputStream::doWriteGather(const unsigned char* first, int firstLength,
+                                 const unsigned char* second, int secondLength) {
+
+    try {
+
+        if (firstLength > 0) {
+            this->doWriteArrayBounded(first, firstLength, 0, firstLength);
+        }
+
+        if (secondLength > 0) {
+            this->doWriteArrayBounded(second, secondLength, 0, secondLength);
+        }
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
+    DECAF_CATCHALL_THROW(IOException)
+}
@@ -126,6 +126,31 @@ namespace io{
          */
         virtual void write(const unsigned char* buffer, int size, int offset, int length);
 
+        /**
+         * Writes the contents of two arrays to the output stream, the result is the same
+         * as writing the first array and then the second.
+         *
+         * The default implementation of this method calls doWriteGather which writes each
+         * array in turn using doWriteArrayBounded.  A stream whose sink can accept both
+         * arrays in one operation, such as a socket performing a gathering write, should
+         * override doWriteGather so that neither array needs to be copied first.
+         *
+         * @param first
+         *      The array of bytes to write first, can be NULL if firstLength is zero.
+         * @param firstLength
+         *      The number of bytes from the first array to write.
+         * @param second
+         *      The array of bytes to write second, can be NULL if secondLength is zero.
+         * @param secondLength
+         *      The number of bytes from the second array to write.
+         *
+         * @throws IOException if an I/O error occurs.
+         * @throws NullPointerException thrown if an array with a non-zero length is Null.
+         * @throws IndexOutOfBoundsException if one of the lengths is negative.
+         */
+        virtual void writeGather(const unsigned char* first, int firstLength,
+                                 const unsigned char* second, int secondLength);
+
         /**
          * Output a String representation of this object.
          *
@@ -143,6 +168,9 @@ namespace io{
 
         virtual void doWriteArrayBounded(const unsigned char* buffer, int size, int offset, int length);
 
+        virtual void doWriteGather(const unsigned char* first, int firstLength,
+                                   const unsigned char* second, int secondLength);
+
     public:
 
         virtual void lock() {
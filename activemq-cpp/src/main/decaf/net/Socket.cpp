@@ -624,6 +624,74 @@ void Socket::setTcpNoDelay( bool value ) {
     DECAF_CATCHALL_THROW( SocketException )
 }
 
+////////////////////////////////////////////////////////////////////////////////
+int Socket::getBusyPoll() const {
+
+    checkClosed();
+
+    try{
+        ensureCreated();
+        return this->impl->getOption( SocketOptions::SOCKET_OPTION_BUSY_POLL );
+    }
+    DECAF_CATCH_RETHROW( SocketException )
+    DECAF_CATCH_EXCEPTION_CONVERT( Exception, SocketException )
+    DECAF_CATCHALL_THROW( SocketException )
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Socket::setBusyPoll( int value ) {
+
+    checkClosed();
+
+    if( value < 0 ) {
+        throw IllegalArgumentException(
+            __FILE__, __LINE__, "Busy poll time given was invalid: %d", value );
+    }
+
+    try{
+        ensureCreated();
+        this->impl->setOption( SocketOptions::SOCKET_OPTION_BUSY_POLL, value );
+    }
+    DECAF_CATCH_RETHROW( SocketException )
+    DECAF_CATCH_RETHROW( IllegalArgumentException )
+    DECAF_CATCH_EXCEPTION_CONVERT( Exception, SocketException )
+    DECAF_CATCHALL_THROW( SocketException )
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int Socket::getReceiveSpinTime() const {
+
+    checkClosed();
+
+    try{
+        ensureCreated();
+        return this->impl->getOption( SocketOptions::SOCKET_OPTION_RECEIVE_SPIN );
+    }
+    DECAF_CATCH_RETHROW( SocketException )
+    DECAF_CATCH_EXCEPTION_CONVERT( Exception, SocketException )
+    DECAF_CATCHALL_THROW( SocketException )
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Socket::setReceiveSpinTime( int value ) {
+
+    checkClosed();
+
+    if( value < 0 ) {
+        throw IllegalArgumentException(
+            __FILE__, __LINE__, "Receive spin time given was invalid: %d", value );
+    }
+
+    try{
+        ensureCreated();
+        this->impl->setOption( SocketOptions::SOCKET_OPTION_RECEIVE_SPIN, value );
+    }
+    DECAF_CATCH_RETHROW( SocketException )
+    DECAF_CATCH_RETHROW( IllegalArgumentException )
+    DECAF_CATCH_EXCEPTION_CONVERT( Exception, SocketException )
+    DECAF_CATCHALL_THROW( SocketException )
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 int Socket::getTrafficClass() const {
 
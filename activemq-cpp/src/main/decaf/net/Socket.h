@@ -32,6 +32,10 @@
 #include <decaf/io/IOException.h>
 
 namespace decaf{
+namespace nio{
+namespace channels{
+    class SocketChannel;
+}}
 namespace net{
 
     class SocketImpl;
@@ -61,6 +65,7 @@ namespace net{
         bool outputShutdown;
 
         friend class ServerSocket;
+        friend class decaf::nio::channels::SocketChannel;
 
     private:
 
@@ -483,6 +488,50 @@ namespace net{
          */
         virtual void setTcpNoDelay(bool value);
 
+        /**
+         * Gets the SO_BUSY_POLL setting for this socket.
+         *
+         * @return the time in microseconds a blocking read busy polls for new packets.
+         *
+         * @throws SocketException Thrown if unable to retrieve the information.
+         */
+        virtual int getBusyPoll() const;
+
+        /**
+         * Sets the SO_BUSY_POLL setting for this socket, the time in microseconds a blocking
+         * read busy polls the device queue for new packets before sleeping.  This setting is
+         * ignored on platforms that don't support it.
+         *
+         * @param value
+         *      The busy poll time in microseconds, zero disables busy polling.
+         *
+         * @throws SocketException Thrown if unable to set the information.
+         * @throws IllegalArgumentException if the value is negative.
+         */
+        virtual void setBusyPoll(int value);
+
+        /**
+         * Gets the time reads on this socket spin waiting for data before they block.
+         *
+         * @return the receive spin time in microseconds.
+         *
+         * @throws SocketException Thrown if unable to retrieve the information.
+         */
+        virtual int getReceiveSpinTime() const;
+
+        /**
+         * Sets the time a read on this socket spins on non-blocking receives waiting for data
+         * before it blocks, lowering the latency of reads that are answered within that time at
+         * the cost of keeping a CPU busy.
+         *
+         * @param value
+         *      The spin time in microseconds, zero disables spinning.
+         *
+         * @throws SocketException Thrown if unable to set the information.
+         * @throws IllegalArgumentException if the value is negative.
+         */
+        virtual void setReceiveSpinTime(int value);
+
         /**
          * Gets the Traffic Class setting for this Socket, sometimes referred to as Type of
          * Service setting.  This setting is dependent on the underlying network implementation
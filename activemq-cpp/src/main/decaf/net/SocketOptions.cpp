@@ -35,6 +35,8 @@ const int SocketOptions::SOCKET_OPTION_SNDBUF = 11;
 const int SocketOptions::SOCKET_OPTION_RCVBUF = 12;
 const int SocketOptions::SOCKET_OPTION_KEEPALIVE = 13;
 const int SocketOptions::SOCKET_OPTION_OOBINLINE = 14;
+const int SocketOptions::SOCKET_OPTION_BUSY_POLL = 15;
+const int SocketOptions::SOCKET_OPTION_RECEIVE_SPIN = 16;
 
 ////////////////////////////////////////////////////////////////////////////////
 SocketOptions::~SocketOptions() {
@@ -148,6 +148,25 @@ namespace net {
          */
         static const int SOCKET_OPTION_OOBINLINE;
 
+        /**
+         * Sets SO_BUSY_POLL for a socket, the time in microseconds a blocking receive busy polls
+         * the device queue for new packets before sleeping.  Ignored on platforms that don't
+         * support it.
+         *
+         * Valid only for TCP socket: SocketImpl
+         */
+        static const int SOCKET_OPTION_BUSY_POLL;
+
+        /**
+         * The time in microseconds a read spins on non-blocking receives waiting for data before
+         * it blocks in the platform's receive, zero disables spinning.  Trades CPU time for a
+         * lower wake-up latency when data arrives within the spin time.  Ignored on platforms
+         * without per-call non-blocking receives.
+         *
+         * Valid only for TCP socket: SocketImpl
+         */
+        static const int SOCKET_OPTION_RECEIVE_SPIN;
+
     public:
 
         virtual ~SocketOptions();
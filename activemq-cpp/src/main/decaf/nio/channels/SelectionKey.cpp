@@ -0,0 +1,84 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SelectionKey.h"
+
+#include <decaf/nio/channels/Selector.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+
+using namespace decaf;
+using namespace decaf::nio;
+using namespace decaf::nio::channels;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+const int SelectionKey::OP_READ = 1;
+const int SelectionKey::OP_WRITE = 4;
+
+////////////////////////////////////////////////////////////////////////////////
+SelectionKey::SelectionKey(SocketChannel* channel, Selector* selector, int ops, void* attachment) :
+    socketChannel(channel), owner(selector), interest(ops), ready(0), attached(attachment), valid(true) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SelectionKey::~SelectionKey() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int SelectionKey::interestOps() const {
+
+    if (!isValid()) {
+        throw IllegalStateException(__FILE__, __LINE__, "SelectionKey has been cancelled.");
+    }
+
+    return this->interest;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectionKey::interestOps(int ops) {
+
+    if (!isValid()) {
+        throw IllegalStateException(__FILE__, __LINE__, "SelectionKey has been cancelled.");
+    }
+
+    this->owner->updateInterestOps(this, ops);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int SelectionKey::readyOps() const {
+
+    if (!isValid()) {
+        throw IllegalStateException(__FILE__, __LINE__, "SelectionKey has been cancelled.");
+    }
+
+    return this->ready;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void* SelectionKey::attach(void* attachment) {
+    void* previous = this->attached;
+    this->attached = attachment;
+    return previous;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectionKey::cancel() {
+    if (this->valid.compareAndSet(true, false)) {
+        this->owner->cancel(this);
+    }
+}
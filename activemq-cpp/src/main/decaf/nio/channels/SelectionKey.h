@@ -0,0 +1,175 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_NIO_CHANNELS_SELECTIONKEY_H_
+#define _DECAF_NIO_CHANNELS_SELECTIONKEY_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+
+namespace decaf {
+namespace nio {
+namespace channels {
+
+    class Selector;
+    class SocketChannel;
+
+    /**
+     * A token representing the registration of a SocketChannel with a Selector.
+     *
+     * A selection key is created each time a channel is registered with a selector.  The
+     * key remains valid until it is cancelled, either by calling its cancel method or by
+     * closing its selector, a channel should have its keys cancelled before it is closed.  Cancelling a key does not immediately remove it
+     * from its selector; it is instead removed during the next selection operation, so a key
+     * that was returned by the selector remains safe to inspect until the selector is next
+     * used.
+     *
+     * A key holds two operation sets, the interest set determines which operations will be
+     * tested for readiness the next time a selection method is invoked, and the ready set
+     * identifies the operations that the selector found the channel to be ready for.
+     *
+     * @since 3.10.0
+     */
+    class DECAF_API SelectionKey {
+    public:
+
+        /**
+         * Operation-set bit for read operations.
+         */
+        static const int OP_READ;
+
+        /**
+         * Operation-set bit for write operations.
+         */
+        static const int OP_WRITE;
+
+    private:
+
+        SocketChannel* socketChannel;
+        Selector* owner;
+        volatile int interest;
+        volatile int ready;
+        void* attached;
+        decaf::util::concurrent::atomic::AtomicBoolean valid;
+
+        friend class Selector;
+
+    private:
+
+        SelectionKey(const SelectionKey&);
+        SelectionKey& operator=(const SelectionKey&);
+
+        SelectionKey(SocketChannel* channel, Selector* selector, int ops, void* attachment);
+
+    public:
+
+        virtual ~SelectionKey();
+
+        /**
+         * @return the channel for which this key was created.
+         */
+        SocketChannel* channel() const {
+            return this->socketChannel;
+        }
+
+        /**
+         * @return the selector for which this key was created.
+         */
+        Selector* selector() const {
+            return this->owner;
+        }
+
+        /**
+         * @return this key's interest set.
+         *
+         * @throw IllegalStateException if this key has been cancelled.
+         */
+        int interestOps() const;
+
+        /**
+         * Sets this key's interest set, the change takes effect at the next selection
+         * operation or immediately if a selection is already in progress.
+         *
+         * @param ops
+         *      The new interest set, a combination of OP_READ and OP_WRITE.
+         *
+         * @throw IllegalArgumentException if ops contains an unsupported operation.
+         * @throw IllegalStateException if this key has been cancelled.
+         */
+        void interestOps(int ops);
+
+        /**
+         * @return the set of operations the channel was found ready for by the last
+         *         selection operation that included this key.
+         *
+         * @throw IllegalStateException if this key has been cancelled.
+         */
+        int readyOps() const;
+
+        /**
+         * @return true if this key's channel is ready for reading.
+         */
+        bool isReadable() const {
+            return (readyOps() & OP_READ) != 0;
+        }
+
+        /**
+         * @return true if this key's channel is ready for writing.
+         */
+        bool isWritable() const {
+            return (readyOps() & OP_WRITE) != 0;
+        }
+
+        /**
+         * @return true if this key has not been cancelled and its selector has not
+         *         been closed.
+         */
+        bool isValid() const {
+            return this->valid.get();
+        }
+
+        /**
+         * Attaches the given object to this key, replacing any previous attachment.  The
+         * key does not take ownership of the attached object.
+         *
+         * @param attachment
+         *      The object to attach, may be NULL.
+         *
+         * @return the previously attached object, or NULL if there was none.
+         */
+        void* attach(void* attachment);
+
+        /**
+         * @return the currently attached object, or NULL if there is none.
+         */
+        void* attachment() const {
+            return this->attached;
+        }
+
+        /**
+         * Requests that the registration of this key's channel with its selector be
+         * cancelled.  Upon return the key is invalid and its channel will not be included
+         * in the results of any selection operation that starts afterwards.  Calling this
+         * method on a key that is already cancelled has no effect.
+         */
+        void cancel();
+
+    };
+
+}}}
+
+#endif /* _DECAF_NIO_CHANNELS_SELECTIONKEY_H_ */
@@ -0,0 +1,374 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Selector.h"
+
+#include <decaf/nio/channels/SocketChannel.h>
+#include <decaf/internal/AprPool.h>
+#include <decaf/internal/net/tcp/TcpSocket.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
+
+#include <apr_poll.h>
+
+#include <map>
+#include <memory>
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::internal;
+using namespace decaf::internal::net::tcp;
+using namespace decaf::nio;
+using namespace decaf::nio::channels;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+const int Selector::DEFAULT_CAPACITY = 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf {
+namespace nio {
+namespace channels {
+
+    class SelectorImpl {
+    private:
+
+        SelectorImpl(const SelectorImpl&);
+        SelectorImpl& operator= (const SelectorImpl&);
+
+    public:
+
+        AprPool pool;
+        apr_pollset_t* pollset;
+        AtomicBoolean closed;
+
+        // Guards the registrations and the cancelled keys, the pollset itself is
+        // created thread safe so it's never held while polling.
+        Mutex lock;
+        std::map<SelectionKey*, apr_pollfd_t> registrations;
+
+        // Keys are only destroyed by the selecting thread at the start of a selection
+        // so that a key handed out by the previous selection stays usable until then.
+        std::vector<SelectionKey*> cancelledKeys;
+        std::vector<SelectionKey*> selectedKeys;
+
+        SelectorImpl(int capacity) : pool(), pollset(NULL), closed(false), lock(), registrations(),
+                                     cancelledKeys(), selectedKeys() {
+
+            apr_status_t result = apr_pollset_create(&pollset, (apr_uint32_t) capacity,
+                pool.getAprPool(), APR_POLLSET_THREADSAFE | APR_POLLSET_WAKEABLE);
+
+            if (result != APR_SUCCESS) {
+                throw IOException(__FILE__, __LINE__,
+                    "Failed to create the selector's poll set, error code: %d", (int) result);
+            }
+        }
+
+        static apr_int16_t toPollEvents(int ops) {
+            apr_int16_t events = 0;
+            if ((ops & SelectionKey::OP_READ) != 0) {
+                events |= APR_POLLIN;
+            }
+            if ((ops & SelectionKey::OP_WRITE) != 0) {
+                events |= APR_POLLOUT;
+            }
+            return events;
+        }
+
+        static int toReadyOps(apr_int16_t events, int ops) {
+            int ready = 0;
+
+            // An error or hang up is reported as readiness for whatever the channel is
+            // interested in so that the failure surfaces from the read or write.
+            bool failed = (events & (APR_POLLERR | APR_POLLHUP | APR_POLLNVAL)) != 0;
+
+            if ((events & APR_POLLIN) != 0 || failed) {
+                ready |= SelectionKey::OP_READ;
+            }
+            if ((events & APR_POLLOUT) != 0 || failed) {
+                ready |= SelectionKey::OP_WRITE;
+            }
+            return ready & ops;
+        }
+
+        void checkOpen() const {
+            if (closed.get()) {
+                throw IllegalStateException(__FILE__, __LINE__, "Selector is closed.");
+            }
+        }
+
+        void destroyCancelledKeys() {
+            std::vector<SelectionKey*> keys;
+            synchronized(&lock) {
+                keys.swap(cancelledKeys);
+            }
+
+            std::vector<SelectionKey*>::const_iterator iter = keys.begin();
+            for (; iter != keys.end(); ++iter) {
+                delete *iter;
+            }
+        }
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+Selector::Selector() : impl(new SelectorImpl(DEFAULT_CAPACITY)) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Selector::Selector(int capacity) : impl(NULL) {
+
+    if (capacity <= 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Selector capacity must be positive.");
+    }
+
+    this->impl = new SelectorImpl(capacity);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Selector::~Selector() {
+    try {
+        close();
+    }
+    DECAF_CATCHALL_NOTHROW()
+
+    try {
+        delete this->impl;
+    }
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool Selector::isOpen() const {
+    return !this->impl->closed.get();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int Selector::select() {
+    return doSelect(-1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int Selector::select(long long timeout) {
+
+    if (timeout < 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Timeout value cannot be negative.");
+    }
+
+    return doSelect(timeout == 0 ? -1 : timeout * 1000);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int Selector::selectNow() {
+    return doSelect(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int Selector::doSelect(long long timeout) {
+
+    try {
+
+        impl->checkOpen();
+
+        impl->selectedKeys.clear();
+        impl->destroyCancelledKeys();
+
+        apr_int32_t count = 0;
+        const apr_pollfd_t* results = NULL;
+
+        apr_status_t result = apr_pollset_poll(impl->pollset, (apr_interval_time_t) timeout, &count, &results);
+
+        if (APR_STATUS_IS_EINTR(result) || APR_STATUS_IS_TIMEUP(result)) {
+            return 0;
+        } else if (result != APR_SUCCESS) {
+            throw IOException(__FILE__, __LINE__, "Selector poll failed with error code: %d", (int) result);
+        }
+
+        for (apr_int32_t i = 0; i < count; ++i) {
+            SelectionKey* key = static_cast<SelectionKey*>(results[i].client_data);
+
+            // The key may have been cancelled while the poll was in progress.
+            if (!key->isValid()) {
+                continue;
+            }
+
+            int ready = SelectorImpl::toReadyOps(results[i].rtnevents, key->interest);
+            if (ready != 0) {
+                key->ready = ready;
+                impl->selectedKeys.push_back(key);
+            }
+        }
+
+        return (int) impl->selectedKeys.size();
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(IllegalStateException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const std::vector<SelectionKey*>& Selector::selectedKeys() const {
+    return this->impl->selectedKeys;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Selector* Selector::wakeup() {
+
+    if (isOpen()) {
+        apr_pollset_wakeup(this->impl->pollset);
+    }
+
+    return this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Selector::close() {
+
+    try {
+
+        if (impl->closed.compareAndSet(false, true)) {
+
+            synchronized(&impl->lock) {
+                std::map<SelectionKey*, apr_pollfd_t>::iterator iter = impl->registrations.begin();
+                for (; iter != impl->registrations.end(); ++iter) {
+                    iter->first->valid.set(false);
+                    if (iter->second.reqevents != 0) {
+                        apr_pollset_remove(impl->pollset, &iter->second);
+                    }
+                    impl->cancelledKeys.push_back(iter->first);
+                }
+
+                impl->registrations.clear();
+            }
+
+            impl->selectedKeys.clear();
+            impl->destroyCancelledKeys();
+
+            apr_pollset_destroy(impl->pollset);
+            impl->pollset = NULL;
+        }
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SelectionKey* Selector::registerChannel(SocketChannel* channel, int ops, void* attachment) {
+
+    if ((ops & ~(SelectionKey::OP_READ | SelectionKey::OP_WRITE)) != 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Unsupported interest set: %d", ops);
+    }
+
+    TcpSocket* socket = dynamic_cast<TcpSocket*>(channel->getSocketImpl());
+    if (socket == NULL || socket->getSocketHandle() == NULL) {
+        throw UnsupportedOperationException(__FILE__, __LINE__,
+            "Only connected plain TCP sockets can be registered with a Selector.");
+    }
+
+    std::auto_ptr<SelectionKey> key(new SelectionKey(channel, this, ops, attachment));
+
+    synchronized(&impl->lock) {
+
+        impl->checkOpen();
+
+        apr_pollfd_t descriptor;
+        descriptor.p = impl->pool.getAprPool();
+        descriptor.desc_type = APR_POLL_SOCKET;
+        descriptor.reqevents = SelectorImpl::toPollEvents(ops);
+        descriptor.rtnevents = 0;
+        descriptor.desc.s = socket->getSocketHandle();
+        descriptor.client_data = key.get();
+
+        if (descriptor.reqevents != 0) {
+            apr_status_t result = apr_pollset_add(impl->pollset, &descriptor);
+            if (result != APR_SUCCESS) {
+                throw IOException(__FILE__, __LINE__,
+                    "Failed to add the channel to the selector, error code: %d", (int) result);
+            }
+        }
+
+        impl->registrations[key.get()] = descriptor;
+    }
+
+    return key.release();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Selector::updateInterestOps(SelectionKey* key, int ops) {
+
+    if ((ops & ~(SelectionKey::OP_READ | SelectionKey::OP_WRITE)) != 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Unsupported interest set: %d", ops);
+    }
+
+    synchronized(&impl->lock) {
+
+        std::map<SelectionKey*, apr_pollfd_t>::iterator iter = impl->registrations.find(key);
+        if (iter == impl->registrations.end()) {
+            throw IllegalStateException(__FILE__, __LINE__, "SelectionKey has been cancelled.");
+        }
+
+        apr_pollfd_t& descriptor = iter->second;
+        apr_int16_t events = SelectorImpl::toPollEvents(ops);
+
+        if (events != descriptor.reqevents) {
+
+            if (descriptor.reqevents != 0) {
+                apr_pollset_remove(impl->pollset, &descriptor);
+            }
+
+            descriptor.reqevents = events;
+
+            if (events != 0) {
+                apr_status_t result = apr_pollset_add(impl->pollset, &descriptor);
+                if (result != APR_SUCCESS) {
+                    throw IOException(__FILE__, __LINE__,
+                        "Failed to update the channel's interest set, error code: %d", (int) result);
+                }
+            }
+        }
+
+        key->interest = ops;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void Selector::cancel(SelectionKey* key) {
+
+    synchronized(&impl->lock) {
+
+        std::map<SelectionKey*, apr_pollfd_t>::iterator iter = impl->registrations.find(key);
+        if (iter == impl->registrations.end()) {
+            return;
+        }
+
+        if (iter->second.reqevents != 0) {
+            apr_pollset_remove(impl->pollset, &iter->second);
+        }
+
+        impl->registrations.erase(iter);
+        impl->cancelledKeys.push_back(key);
+    }
+}
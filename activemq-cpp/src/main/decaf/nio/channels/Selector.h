@@ -0,0 +1,175 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_NIO_CHANNELS_SELECTOR_H_
+#define _DECAF_NIO_CHANNELS_SELECTOR_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/nio/channels/SelectionKey.h>
+#include <decaf/io/Closeable.h>
+#include <decaf/io/IOException.h>
+
+#include <vector>
+
+namespace decaf {
+namespace nio {
+namespace channels {
+
+    class SelectorImpl;
+
+    /**
+     * A multiplexor of SocketChannel objects.
+     *
+     * A channel is registered with a selector by way of its registerWith method, which
+     * yields a SelectionKey.  Each selection operation waits until at least one of the
+     * registered channels is ready for one of the operations in its key's interest set,
+     * the keys of the ready channels are then available from selectedKeys until the next
+     * selection operation begins.
+     *
+     * The selector is built on the APR pollset, on Linux this is an epoll instance and
+     * other platforms use the best mechanism APR has available for them, readiness is
+     * level triggered so a channel that is not drained is selected again.  Registration,
+     * cancellation, changes to a key's interest set, and wakeup may be called from any
+     * thread while another thread is blocked in a selection operation; only one thread
+     * should select at a time, and close must not be called while a selection is in
+     * progress.
+     *
+     * @since 3.10.0
+     */
+    class DECAF_API Selector : public decaf::io::Closeable {
+    public:
+
+        /**
+         * The number of channels a Selector created with the default constructor can
+         * hold, some platforms size the underlying poll set up front.
+         */
+        static const int DEFAULT_CAPACITY;
+
+    private:
+
+        SelectorImpl* impl;
+
+        friend class SelectionKey;
+        friend class SocketChannel;
+
+    private:
+
+        Selector(const Selector&);
+        Selector& operator=(const Selector&);
+
+    public:
+
+        /**
+         * Opens a selector able to hold DEFAULT_CAPACITY channels.
+         *
+         * @throw IOException if the underlying poll set cannot be created.
+         */
+        Selector();
+
+        /**
+         * Opens a selector able to hold the given number of channels.
+         *
+         * @param capacity
+         *      The maximum number of channels that will be registered at one time.
+         *
+         * @throw IOException if the underlying poll set cannot be created.
+         * @throw IllegalArgumentException if capacity is not positive.
+         */
+        Selector(int capacity);
+
+        virtual ~Selector();
+
+        /**
+         * @return true if this selector has not been closed.
+         */
+        bool isOpen() const;
+
+        /**
+         * Selects the channels that are ready for I/O, blocking until at least one is
+         * ready or until wakeup is called.
+         *
+         * @return the number of keys that were selected, possibly zero.
+         *
+         * @throw IOException if an I/O error occurs.
+         * @throw IllegalStateException if this selector is closed.
+         */
+        int select();
+
+        /**
+         * Selects the channels that are ready for I/O, blocking until at least one is
+         * ready, wakeup is called, or the timeout expires.
+         *
+         * @param timeout
+         *      The time in milliseconds to wait, zero waits indefinitely.
+         *
+         * @return the number of keys that were selected, possibly zero.
+         *
+         * @throw IOException if an I/O error occurs.
+         * @throw IllegalArgumentException if timeout is negative.
+         * @throw IllegalStateException if this selector is closed.
+         */
+        int select(long long timeout);
+
+        /**
+         * Selects the channels that are ready for I/O without blocking.
+         *
+         * @return the number of keys that were selected, possibly zero.
+         *
+         * @throw IOException if an I/O error occurs.
+         * @throw IllegalStateException if this selector is closed.
+         */
+        int selectNow();
+
+        /**
+         * Returns the keys selected by the last selection operation, the contents are
+         * replaced when the next selection operation begins.  Keys cancelled since the
+         * selection remain in the list but report isValid() as false.
+         *
+         * @return the selected-key list of this selector.
+         */
+        const std::vector<SelectionKey*>& selectedKeys() const;
+
+        /**
+         * Causes a selection operation that is blocked, or the next one to start if none
+         * is blocked, to return immediately.
+         *
+         * @return this selector.
+         */
+        Selector* wakeup();
+
+        /**
+         * Closes this selector, cancelling and destroying all of its keys.
+         *
+         * @throw IOException if an I/O error occurs.
+         */
+        virtual void close();
+
+    private:
+
+        SelectionKey* registerChannel(SocketChannel* channel, int ops, void* attachment);
+
+        void updateInterestOps(SelectionKey* key, int ops);
+
+        void cancel(SelectionKey* key);
+
+        int doSelect(long long timeout);
+
+    };
+
+}}}
+
+#endif /* _DECAF_NIO_CHANNELS_SELECTOR_H_ */
@@ -0,0 +1,131 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SocketChannel.h"
+
+#include <decaf/nio/channels/Selector.h>
+#include <decaf/io/InputStream.h>
+#include <decaf/io/OutputStream.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IndexOutOfBoundsException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::net;
+using namespace decaf::nio;
+using namespace decaf::nio::channels;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+SocketChannel::SocketChannel(Socket* socket, bool own) : sock(socket), own(own) {
+
+    if (socket == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Socket passed was NULL.");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SocketChannel::~SocketChannel() {
+    try {
+        if (this->own) {
+            delete this->sock;
+        }
+    }
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool SocketChannel::isOpen() const {
+    return !this->sock->isClosed();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool SocketChannel::isConnected() const {
+    return this->sock->isConnected();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SelectionKey* SocketChannel::registerWith(Selector* selector, int ops, void* attachment) {
+
+    try {
+
+        if (selector == NULL) {
+            throw NullPointerException(__FILE__, __LINE__, "Selector passed was NULL.");
+        }
+
+        if (!isOpen()) {
+            throw IOException(__FILE__, __LINE__, "SocketChannel is closed.");
+        }
+
+        return selector->registerChannel(this, ops, attachment);
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(UnsupportedOperationException)
+    DECAF_CATCH_RETHROW(IllegalArgumentException)
+    DECAF_CATCH_RETHROW(IllegalStateException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int SocketChannel::read(unsigned char* buffer, int size, int offset, int length) {
+
+    try {
+        // The socket input stream issues a single receive, which returns as soon as
+        // any data is available.
+        return this->sock->getInputStream()->read(buffer, size, offset, length);
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SocketChannel::write(const unsigned char* buffer, int size, int offset, int length) {
+
+    try {
+        this->sock->getOutputStream()->write(buffer, size, offset, length);
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IndexOutOfBoundsException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SocketChannel::close() {
+
+    try {
+        this->sock->close();
+    }
+    DECAF_CATCH_RETHROW(IOException)
+    DECAF_CATCH_EXCEPTION_CONVERT(Exception, IOException)
+    DECAF_CATCHALL_THROW(IOException)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SocketImpl* SocketChannel::getSocketImpl() const {
+    return this->sock->impl;
+}
@@ -0,0 +1,169 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_NIO_CHANNELS_SOCKETCHANNEL_H_
+#define _DECAF_NIO_CHANNELS_SOCKETCHANNEL_H_
+
+#include <decaf/util/Config.h>
+#include <decaf/nio/channels/SelectionKey.h>
+#include <decaf/net/Socket.h>
+#include <decaf/io/Closeable.h>
+#include <decaf/io/IOException.h>
+
+namespace decaf {
+namespace net {
+    class SocketImpl;
+}
+namespace nio {
+namespace channels {
+
+    class Selector;
+
+    /**
+     * A selectable channel for a connected stream Socket.
+     *
+     * The channel wraps a Socket that was created and connected through the usual Socket
+     * API so that it can be registered with a Selector.  The socket stays in blocking mode,
+     * a read made after the selector reported the channel readable returns whatever data
+     * has arrived without waiting for more, and writes block until all the data has been
+     * handed to the socket as they would through the socket's output stream.
+     *
+     * Only the plain TCP Socket implementation can be registered with a Selector.
+     *
+     * @since 3.10.0
+     */
+    class DECAF_API SocketChannel : public decaf::io::Closeable {
+    private:
+
+        decaf::net::Socket* sock;
+        bool own;
+
+        friend class Selector;
+
+    private:
+
+        SocketChannel(const SocketChannel&);
+        SocketChannel& operator=(const SocketChannel&);
+
+    public:
+
+        /**
+         * Creates a channel for the given connected Socket.
+         *
+         * @param socket
+         *      The Socket to wrap.
+         * @param own
+         *      If true the channel deletes the Socket when it is destroyed.
+         *
+         * @throw NullPointerException if the socket is NULL.
+         */
+        SocketChannel(decaf::net::Socket* socket, bool own = false);
+
+        virtual ~SocketChannel();
+
+        /**
+         * @return the Socket this channel wraps.
+         */
+        decaf::net::Socket* socket() const {
+            return this->sock;
+        }
+
+        /**
+         * @return true if the wrapped Socket has not been closed.
+         */
+        bool isOpen() const;
+
+        /**
+         * @return true if the wrapped Socket is connected.
+         */
+        bool isConnected() const;
+
+        /**
+         * Registers this channel with the given selector, returning the new key.
+         *
+         * @param selector
+         *      The Selector to register with.
+         * @param ops
+         *      The interest set for the new key.
+         * @param attachment
+         *      The object to attach to the new key, may be NULL.
+         *
+         * @return the key representing the registration, owned by the Selector.
+         *
+         * @throw IOException if the channel is closed or cannot be added to the selector.
+         * @throw UnsupportedOperationException if the Socket implementation can't be selected.
+         * @throw IllegalArgumentException if ops contains an unsupported operation.
+         * @throw IllegalStateException if the selector is closed.
+         */
+        SelectionKey* registerWith(Selector* selector, int ops, void* attachment = NULL);
+
+        /**
+         * Reads the data that is currently available from the Socket, up to the given
+         * length.  This only blocks when no data has arrived, which can't happen when the
+         * channel was just selected as readable.
+         *
+         * @param buffer
+         *      The buffer to read into.
+         * @param size
+         *      The size of the buffer.
+         * @param offset
+         *      The position in the buffer to start filling.
+         * @param length
+         *      The maximum number of bytes to read.
+         *
+         * @return the number of bytes read, or -1 if the end of the stream was reached.
+         *
+         * @throw IOException if an I/O error occurs.
+         * @throw NullPointerException if buffer is NULL.
+         * @throw IndexOutOfBoundsException if offset or length are out of bounds.
+         */
+        int read(unsigned char* buffer, int size, int offset, int length);
+
+        /**
+         * Writes the given data to the Socket, blocking until all of it has been written.
+         *
+         * @param buffer
+         *      The buffer holding the data.
+         * @param size
+         *      The size of the buffer.
+         * @param offset
+         *      The position in the buffer of the first byte to write.
+         * @param length
+         *      The number of bytes to write.
+         *
+         * @throw IOException if an I/O error occurs.
+         * @throw NullPointerException if buffer is NULL.
+         * @throw IndexOutOfBoundsException if offset or length are out of bounds.
+         */
+        void write(const unsigned char* buffer, int size, int offset, int length);
+
+        /**
+         * Closes the wrapped Socket, any keys for this channel should be cancelled first.
+         *
+         * @throw IOException if an I/O error occurs.
+         */
+        virtual void close();
+
+    private:
+
+        decaf::net::SocketImpl* getSocketImpl() const;
+
+    };
+
+}}}
+
+#endif /* _DECAF_NIO_CHANNELS_SOCKETCHANNEL_H_ */
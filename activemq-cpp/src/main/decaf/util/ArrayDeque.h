@@ -0,0 +1,627 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_ARRAYDEQUE_H_
+#define _DECAF_UTIL_ARRAYDEQUE_H_
+
+#include <memory>
+#include <decaf/util/NoSuchElementException.h>
+#include <decaf/util/ConcurrentModificationException.h>
+#include <decaf/lang/exceptions/UnsupportedOperationException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/util/Config.h>
+#include <decaf/util/Deque.h>
+#include <decaf/util/Iterator.h>
+#include <decaf/util/AbstractCollection.h>
+
+namespace decaf {
+namespace util {
+
+    /**
+     * A resizable array implementation of the Deque interface.  The elements are held in a
+     * circular array whose capacity is always a power of two, so adding or removing at either
+     * end is amortized constant time and does not allocate once the array has grown large
+     * enough.  This makes ArrayDeque faster than LinkedList when used as a stack or a queue.
+     *
+     * Removing an element from the middle of the deque, through removeFirstOccurrence,
+     * removeLastOccurrence or an Iterator, shifts the elements on the shorter side of it and
+     * so takes linear time.
+     *
+     * The iterators returned by this class are fail-fast: if the deque is modified at any time
+     * after an iterator is created, other than through the iterator's own remove method, the
+     * iterator throws a ConcurrentModificationException on its next use.  Fail-fast behavior
+     * is a best effort check for bugs, this class is not thread safe.
+     *
+     * @since 1.0
+     */
+    template< typename E >
+    class ArrayDeque : public AbstractCollection<E>, public Deque<E> {
+    private:
+
+        static const int MIN_INITIAL_CAPACITY = 8;
+        static const int DEFAULT_CAPACITY = 16;
+        static const int MAX_CAPACITY = 1 << 30;
+
+        E* elements;
+        int capacity;
+        int head;
+        int count;
+        int modCount;
+
+    public:
+
+        ArrayDeque() : AbstractCollection<E>(), Deque<E>(),
+                       elements(NULL), capacity(0), head(0), count(0), modCount(0) {
+            this->allocateElements(DEFAULT_CAPACITY);
+        }
+
+        /**
+         * Creates an empty deque with an initial capacity sufficient to hold the given
+         * number of elements.
+         *
+         * @param numElements
+         *      The expected number of elements the deque will hold.
+         *
+         * @throws IllegalArgumentException if numElements is negative.
+         */
+        ArrayDeque(int numElements) : AbstractCollection<E>(), Deque<E>(),
+                                      elements(NULL), capacity(0), head(0), count(0), modCount(0) {
+
+            if (numElements < 0) {
+                throw decaf::lang::exceptions::IllegalArgumentException(
+                    __FILE__, __LINE__, "Initial Capacity argument cannot be negative.");
+            }
+
+            this->allocateElements(numElements);
+        }
+
+        ArrayDeque(const Collection<E>& collection) : AbstractCollection<E>(), Deque<E>(),
+                                                      elements(NULL), capacity(0), head(0), count(0), modCount(0) {
+            this->allocateElements(collection.size());
+            this->addAllFrom(collection);
+        }
+
+        ArrayDeque(const ArrayDeque<E>& deque) : AbstractCollection<E>(), Deque<E>(),
+                                                 elements(NULL), capacity(0), head(0), count(0), modCount(0) {
+            this->allocateElements(deque.size());
+            this->addAllFrom(deque);
+        }
+
+        virtual ~ArrayDeque() {
+            try {
+                delete [] this->elements;
+            }
+            DECAF_CATCHALL_NOTHROW()
+        }
+
+    public:
+
+        ArrayDeque<E>& operator=(const ArrayDeque<E>& deque) {
+            this->copy(deque);
+            return *this;
+        }
+
+        ArrayDeque<E>& operator=(const Collection<E>& collection) {
+            this->copy(collection);
+            return *this;
+        }
+
+        bool operator==(const ArrayDeque<E>& other) const {
+            return this->equals(other);
+        }
+
+        bool operator!=(const ArrayDeque<E>& other) const {
+            return !this->equals(other);
+        }
+
+    public:
+
+        virtual bool add(const E& value) {
+            this->addLast(value);
+            return true;
+        }
+
+        virtual bool addAll(const Collection<E>& collection) {
+            if (collection.isEmpty()) {
+                return false;
+            }
+
+            if (this == &collection) {
+                ArrayDeque<E> snapshot(collection);
+                return this->addAllFrom(snapshot);
+            }
+
+            return this->addAllFrom(collection);
+        }
+
+        virtual void copy(const Collection<E>& collection) {
+            if (this == &collection) {
+                return;
+            }
+
+            this->clear();
+            this->addAllFrom(collection);
+        }
+
+        virtual bool remove(const E& value) {
+            return this->removeFirstOccurrence(value);
+        }
+
+        virtual bool contains(const E& value) const {
+            for (int i = 0; i < this->count; ++i) {
+                if (this->elements[this->physicalIndex(i)] == value) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        virtual bool isEmpty() const {
+            return this->count == 0;
+        }
+
+        virtual int size() const {
+            return this->count;
+        }
+
+        virtual void clear() {
+            for (int i = 0; i < this->count; ++i) {
+                this->elements[this->physicalIndex(i)] = E();
+            }
+
+            this->head = 0;
+            this->count = 0;
+            this->modCount++;
+        }
+
+        virtual std::vector<E> toArray() const {
+            std::vector<E> result;
+            result.reserve(this->count);
+            for (int i = 0; i < this->count; ++i) {
+                result.push_back(this->elements[this->physicalIndex(i)]);
+            }
+
+            return result;
+        }
+
+        virtual Iterator<E>* iterator() {
+            return new DequeIterator(this, false);
+        }
+
+        virtual Iterator<E>* iterator() const {
+            return new ConstDequeIterator(this, false);
+        }
+
+    public:  // Deque interface implementation.
+
+        virtual bool offer(const E& value) {
+            this->addLast(value);
+            return true;
+        }
+
+        virtual bool poll(E& result) {
+            return this->pollFirst(result);
+        }
+
+        virtual E remove() {
+            return this->removeFirst();
+        }
+
+        virtual bool peek(E& result) const {
+            return this->peekFirst(result);
+        }
+
+        virtual E element() const {
+            return this->getFirst();
+        }
+
+        virtual void addFirst(const E& value) {
+            this->ensureCapacity(this->count + 1);
+            this->head = (this->head - 1) & (this->capacity - 1);
+            this->elements[this->head] = value;
+            this->count++;
+            this->modCount++;
+        }
+
+        virtual void addLast(const E& value) {
+            this->ensureCapacity(this->count + 1);
+            this->elements[this->physicalIndex(this->count)] = value;
+            this->count++;
+            this->modCount++;
+        }
+
+        virtual bool offerFirst(const E& element) {
+            this->addFirst(element);
+            return true;
+        }
+
+        virtual bool offerLast(const E& element) {
+            this->addLast(element);
+            return true;
+        }
+
+        virtual E removeFirst() {
+            if (this->count == 0) {
+                throw NoSuchElementException(__FILE__, __LINE__, "The Deque is empty.");
+            }
+
+            E result = this->elements[this->head];
+            this->elements[this->head] = E();
+            this->head = (this->head + 1) & (this->capacity - 1);
+            this->count--;
+            this->modCount++;
+
+            return result;
+        }
+
+        virtual E removeLast() {
+            if (this->count == 0) {
+                throw NoSuchElementException(__FILE__, __LINE__, "The Deque is empty.");
+            }
+
+            int index = this->physicalIndex(this->count - 1);
+            E result = this->elements[index];
+            this->elements[index] = E();
+            this->count--;
+            this->modCount++;
+
+            return result;
+        }
+
+        virtual bool pollFirst(E& result) {
+            if (this->count == 0) {
+                return false;
+            }
+
+            result = this->removeFirst();
+            return true;
+        }
+
+        virtual bool pollLast(E& result) {
+            if (this->count == 0) {
+                return false;
+            }
+
+            result = this->removeLast();
+            return true;
+        }
+
+        virtual E& getFirst() {
+            if (this->count == 0) {
+                throw NoSuchElementException(__FILE__, __LINE__, "The Deque is empty.");
+            }
+
+            return this->elements[this->head];
+        }
+
+        virtual const E& getFirst() const {
+            if (this->count == 0) {
+                throw NoSuchElementException(__FILE__, __LINE__, "The Deque is empty.");
+            }
+
+            return this->elements[this->head];
+        }
+
+        virtual E& getLast() {
+            if (this->count == 0) {
+                throw NoSuchElementException(__FILE__, __LINE__, "The Deque is empty.");
+            }
+
+            return this->elements[this->physicalIndex(this->count - 1)];
+        }
+
+        virtual const E& getLast() const {
+            if (this->count == 0) {
+                throw NoSuchElementException(__FILE__, __LINE__, "The Deque is empty.");
+            }
+
+            return this->elements[this->physicalIndex(this->count - 1)];
+        }
+
+        virtual bool peekFirst(E& value) const {
+            if (this->count == 0) {
+                return false;
+            }
+
+            value = this->elements[this->head];
+            return true;
+        }
+
+        virtual bool peekLast(E& value) const {
+            if (this->count == 0) {
+                return false;
+            }
+
+            value = this->elements[this->physicalIndex(this->count - 1)];
+            return true;
+        }
+
+        virtual bool removeFirstOccurrence(const E& value) {
+            for (int i = 0; i < this->count; ++i) {
+                if (this->elements[this->physicalIndex(i)] == value) {
+                    this->removeAt(i);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        virtual bool removeLastOccurrence(const E& value) {
+            for (int i = this->count - 1; i >= 0; --i) {
+                if (this->elements[this->physicalIndex(i)] == value) {
+                    this->removeAt(i);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        virtual void push(const E& element) {
+            this->addFirst(element);
+        }
+
+        virtual E pop() {
+            return this->removeFirst();
+        }
+
+        virtual Iterator<E>* descendingIterator() {
+            return new DequeIterator(this, true);
+        }
+
+        virtual Iterator<E>* descendingIterator() const {
+            return new ConstDequeIterator(this, true);
+        }
+
+    private:
+
+        /**
+         * Iterates over the deque by logical position, which stays valid when a removal
+         * shifts elements around the array.
+         */
+        class DequeIterator : public Iterator<E> {
+        private:
+
+            ArrayDeque<E>* deque;
+            bool descending;
+            int position;
+            int lastReturned;
+            int expectedModCount;
+
+        private:
+
+            DequeIterator(const DequeIterator&);
+            DequeIterator operator=(const DequeIterator&);
+
+        public:
+
+            DequeIterator(ArrayDeque<E>* deque, bool descending) :
+                Iterator<E>(), deque(deque), descending(descending), position(0), lastReturned(-1), expectedModCount(0) {
+
+                if (deque == NULL) {
+                    throw decaf::lang::exceptions::NullPointerException(
+                        __FILE__, __LINE__, "Parent ArrayDeque pointer was Null." );
+                }
+
+                this->position = descending ? deque->count - 1 : 0;
+                this->expectedModCount = deque->modCount;
+            }
+
+            virtual ~DequeIterator() {}
+
+            virtual bool hasNext() const {
+                return this->descending ? this->position >= 0 : this->position < this->deque->count;
+            }
+
+            virtual E next() {
+
+                if (this->expectedModCount != this->deque->modCount) {
+                    throw ConcurrentModificationException(
+                        __FILE__, __LINE__, "Deque modified outside of this Iterator." );
+                }
+
+                if (!this->hasNext()) {
+                    throw NoSuchElementException(
+                        __FILE__, __LINE__, "No more elements to return from next()" );
+                }
+
+                this->lastReturned = this->position;
+                this->position += this->descending ? -1 : 1;
+
+                return this->deque->elements[this->deque->physicalIndex(this->lastReturned)];
+            }
+
+            virtual void remove() {
+
+                if (this->expectedModCount != this->deque->modCount) {
+                    throw ConcurrentModificationException(
+                        __FILE__, __LINE__, "Deque modified outside of this Iterator." );
+                }
+
+                if (this->lastReturned < 0) {
+                    throw decaf::lang::exceptions::IllegalStateException(
+                        __FILE__, __LINE__,
+                        "Invalid State to call remove, must call next() before remove()" );
+                }
+
+                this->deque->removeAt(this->lastReturned);
+
+                // Elements after the removed one moved down a position, a descending
+                // iterator has already passed them.
+                if (!this->descending) {
+                    this->position = this->lastReturned;
+                }
+
+                this->lastReturned = -1;
+                this->expectedModCount = this->deque->modCount;
+            }
+        };
+
+        class ConstDequeIterator : public Iterator<E> {
+        private:
+
+            const ArrayDeque<E>* deque;
+            bool descending;
+            int position;
+            int expectedModCount;
+
+        private:
+
+            ConstDequeIterator(const ConstDequeIterator&);
+            ConstDequeIterator operator=(const ConstDequeIterator&);
+
+        public:
+
+            ConstDequeIterator(const ArrayDeque<E>* deque, bool descending) :
+                Iterator<E>(), deque(deque), descending(descending), position(0), expectedModCount(0) {
+
+                if (deque == NULL) {
+                    throw decaf::lang::exceptions::NullPointerException(
+                        __FILE__, __LINE__, "Parent ArrayDeque pointer was Null." );
+                }
+
+                this->position = descending ? deque->count - 1 : 0;
+                this->expectedModCount = deque->modCount;
+            }
+
+            virtual ~ConstDequeIterator() {}
+
+            virtual bool hasNext() const {
+                return this->descending ? this->position >= 0 : this->position < this->deque->count;
+            }
+
+            virtual E next() {
+
+                if (this->expectedModCount != this->deque->modCount) {
+                    throw ConcurrentModificationException(
+                        __FILE__, __LINE__, "Deque modified outside of this Iterator." );
+                }
+
+                if (!this->hasNext()) {
+                    throw NoSuchElementException(
+                        __FILE__, __LINE__, "No more elements to return from next()" );
+                }
+
+                int index = this->position;
+                this->position += this->descending ? -1 : 1;
+
+                return this->deque->elements[this->deque->physicalIndex(index)];
+            }
+
+            virtual void remove() {
+                throw lang::exceptions::UnsupportedOperationException(
+                    __FILE__, __LINE__, "Cannot write to a const Iterator." );
+            }
+        };
+
+    private:
+
+        int physicalIndex(int logicalIndex) const {
+            return (this->head + logicalIndex) & (this->capacity - 1);
+        }
+
+        void allocateElements(int numElements) {
+
+            int initialCapacity = MIN_INITIAL_CAPACITY;
+            while (initialCapacity < numElements && initialCapacity < MAX_CAPACITY) {
+                initialCapacity <<= 1;
+            }
+
+            this->elements = new E[initialCapacity];
+            this->capacity = initialCapacity;
+        }
+
+        void ensureCapacity(int minimumCapacity) {
+
+            if (minimumCapacity <= this->capacity) {
+                return;
+            }
+
+            if (this->capacity >= MAX_CAPACITY) {
+                throw decaf::lang::exceptions::IllegalStateException(
+                    __FILE__, __LINE__, "Deque has reached its maximum capacity.");
+            }
+
+            int newCapacity = this->capacity << 1;
+            while (newCapacity < minimumCapacity && newCapacity < MAX_CAPACITY) {
+                newCapacity <<= 1;
+            }
+
+            E* newElements = new E[newCapacity];
+            for (int i = 0; i < this->count; ++i) {
+                newElements[i] = this->elements[this->physicalIndex(i)];
+            }
+
+            delete [] this->elements;
+            this->elements = newElements;
+            this->capacity = newCapacity;
+            this->head = 0;
+        }
+
+        bool addAllFrom(const Collection<E>& collection) {
+
+            int csize = collection.size();
+            if (csize == 0) {
+                return false;
+            }
+
+            this->ensureCapacity(this->count + csize);
+
+            std::auto_ptr<Iterator<E> > iter(collection.iterator());
+            while (iter->hasNext()) {
+                this->elements[this->physicalIndex(this->count)] = iter->next();
+                this->count++;
+            }
+
+            this->modCount++;
+            return true;
+        }
+
+        /**
+         * Removes the element at the given logical index, closing the gap by moving the
+         * elements on whichever side of it is shorter.
+         */
+        void removeAt(int index) {
+
+            if (index < this->count / 2) {
+                for (int i = index; i > 0; --i) {
+                    this->elements[this->physicalIndex(i)] = this->elements[this->physicalIndex(i - 1)];
+                }
+
+                this->elements[this->head] = E();
+                this->head = (this->head + 1) & (this->capacity - 1);
+            } else {
+                for (int i = index; i < this->count - 1; ++i) {
+                    this->elements[this->physicalIndex(i)] = this->elements[this->physicalIndex(i + 1)];
+                }
+
+                this->elements[this->physicalIndex(this->count - 1)] = E();
+            }
+
+            this->count--;
+            this->modCount++;
+        }
+
+    };
+
+}}
+
+#endif /* _DECAF_UTIL_ARRAYDEQUE_H_ */
@@ -22,6 +22,7 @@
 #include <decaf/lang/System.h>
 #include <decaf/util/concurrent/Mutex.h>
 #include <decaf/internal/util/TimerTaskHeap.h>
+#include <decaf/internal/util/TimerTaskWheel.h>
 #include <decaf/internal/util/concurrent/SynchronizableImpl.h>
 #include <decaf/lang/exceptions/InterruptedException.h>
 
@@ -42,13 +43,22 @@ namespace util {
     public:
 
         TimerTaskHeap heap;
+        Pointer<TimerTaskWheel> wheel;
         bool cancelled;
 
     public:
 
-        TimerImpl() : Thread(), heap(), cancelled(false) {}
+        TimerImpl() : Thread(), heap(), wheel(), cancelled(false) {}
 
-        TimerImpl(const std::string& name) : Thread(name), heap(), cancelled(false) {}
+        TimerImpl(const std::string& name) : Thread(name), heap(), wheel(), cancelled(false) {}
+
+        TimerImpl(const std::string& name, Timer::TaskQueueType type) :
+            Thread(name), heap(), wheel(), cancelled(false) {
+
+            if (type == Timer::TIMING_WHEEL) {
+                this->wheel.reset(new TimerTaskWheel());
+            }
+        }
 
         virtual ~TimerImpl() {
             try {
@@ -73,79 +83,58 @@ namespace util {
                         return;
                     }
 
-                    if (heap.isEmpty()) {
-                        // no tasks scheduled -- sleep until any task appear
-                        try {
-                            this->wait();
-                        } catch (InterruptedException& e) {}
-                        continue;
-                    }
-
                     long long currentTime = System::currentTimeMillis();
 
-                    task = heap.peek();
-                    long long timeToSleep = 0LL;
+                    task = nextDueTask(currentTime);
 
-                    synchronized(&(task->lock)) {
-                        if (task->cancelled) {
-                            heap.remove(0);
-                            continue;
-                        }
+                    if (task == NULL) {
 
-                        // check the time to sleep for the first task scheduled
-                        timeToSleep = task->when - currentTime;
-                    }
+                        // nothing to run yet -- sleep until the next task is due or a new
+                        // one is scheduled.
+                        long long nextTime = nextExecutionTime();
 
-                    if (timeToSleep > 0) {
-                        task.reset(NULL);
                         try {
-                            this->wait(timeToSleep);
+                            if (nextTime < 0) {
+                                this->wait();
+                            } else if (nextTime > currentTime) {
+                                this->wait(nextTime - currentTime);
+                            }
                         } catch (InterruptedException& e) {
                         }
-                        continue;
-                    }
-
-                    // Time to run the task, but first we need to check to see if any other
-                    // tasks where scheduled and caused this one to be moved someplace new on
-                    // the heap and find it new location.. We also need to check that the task
-                    // wasn't canceled while we were sleeping.
-                    synchronized(&(task->lock)) {
-                        std::size_t pos = 0;
-
-                        if (heap.peek()->when != task->when) {
-                            pos = heap.find(task);
-                        }
 
-                        if (task->cancelled) {
-                            heap.remove(heap.find(task));
-                            continue;
-                        }
-
-                        // set time to schedule
-                        task->setScheduledTime(task->when);
+                    } else {
 
-                        // remove task from queue
-                        heap.remove(pos);
+                        synchronized(&(task->lock)) {
 
-                        // set when the next task should be launched
-                        if (task->period >= 0) {
-
-                            // this is a repeating task,
-                            if (task->fixedRate) {
-                                // task is scheduled at fixed rate
-                                task->when = task->when + task->period;
+                            if (task->cancelled) {
+                                task.reset(NULL);
                             } else {
-                                // task is scheduled at fixed delay
-                                task->when = System::currentTimeMillis() + task->period;
-                            }
 
-                            // insert this task into queue, it will be ordered by the heap for
-                            // its next run time.
-                            insertTask(task);
-                        } else {
-                            // Task was a one-shot, setting when to zero indicates it
-                            // won't run anymore.
-                            task->when = 0;
+                                // set time to schedule
+                                task->setScheduledTime(task->when);
+
+                                // set when the next task should be launched
+                                if (task->period >= 0) {
+
+                                    // this is a repeating task,
+                                    if (task->fixedRate) {
+                                        // task is scheduled at fixed rate
+                                        task->when = task->when + task->period;
+                                    } else {
+                                        // task is scheduled at fixed delay
+                                        task->when = System::currentTimeMillis() + task->period;
+                                    }
+
+                                    // insert this task into queue, it will be ordered for its
+                                    // next run time.
+                                    insertTask(task);
+                                } else {
+                                    // Task was a one-shot, setting when to zero indicates it
+                                    // won't run anymore.
+                                    task->when = 0;
+                                    task->wheel.reset(NULL);
+                                }
+                            }
                         }
                     }
                 }
@@ -162,7 +151,12 @@ namespace util {
 
         void insertTask(const Pointer<TimerTask>& task) {
             // callers are synchronized
-            heap.insert(task);
+            if (wheel != NULL) {
+                wheel->insert(task);
+            } else {
+                heap.insert(task);
+            }
+
             this->notify();
         }
 
@@ -170,6 +164,9 @@ namespace util {
             synchronized(this) {
                 cancelled = true;
                 heap.reset();
+                if (wheel != NULL) {
+                    wheel->reset();
+                }
                 this->notify();
             }
         }
@@ -177,15 +174,63 @@ namespace util {
         int purge() {
             std::size_t result = 0;
             synchronized(this) {
-                if (heap.isEmpty()) {
-                    return 0;
+                if (wheel != NULL) {
+                    result = wheel->deleteIfCancelled();
+                } else if (!heap.isEmpty()) {
+                    result = heap.deleteIfCancelled();
                 }
-
-                result = heap.deleteIfCancelled();
             }
 
             return (int)result;
         }
+
+    private:
+
+        // Removes and returns the first task whose time has come, callers are synchronized.
+        Pointer<TimerTask> nextDueTask(long long currentTime) {
+
+            if (wheel != NULL) {
+                return wheel->poll(currentTime);
+            }
+
+            while (!heap.isEmpty()) {
+
+                Pointer<TimerTask> task = heap.peek();
+                bool discard = false;
+                bool ready = false;
+
+                synchronized(&(task->lock)) {
+                    discard = task->cancelled;
+                    ready = task->when <= currentTime;
+                }
+
+                if (!discard && !ready) {
+                    break;
+                }
+
+                heap.remove(0);
+
+                if (!discard) {
+                    return task;
+                }
+            }
+
+            return Pointer<TimerTask>();
+        }
+
+        // The time at which the Timer next has work to do or -1 if it has no tasks.
+        long long nextExecutionTime() {
+
+            if (wheel != NULL) {
+                return wheel->nextExecutionTime();
+            }
+
+            if (heap.isEmpty()) {
+                return -1;
+            }
+
+            return heap.peek()->getWhen();
+        }
     };
 
 }}
@@ -210,6 +255,16 @@ Timer::Timer(const std::string& name) : internal(new TimerImpl(name)) {
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+Timer::Timer(const std::string& name, TaskQueueType type) : internal(new TimerImpl(name, type)) {
+    try {
+        this->internal->start();
+    } catch(...) {
+        delete this->internal;
+        throw;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 Timer::~Timer() {
     try {
@@ -500,6 +555,7 @@ void Timer::scheduleTask(const Pointer<TimerTask>& task, long long delay, long l
             task->when = when;
             task->period = period;
             task->fixedRate = fixed;
+            task->wheel = this->internal->wheel;
         }
 
         // insert the new Task into priority queue
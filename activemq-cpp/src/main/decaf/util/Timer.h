@@ -51,9 +51,35 @@ namespace util {
      * This class does not offer real-time guarantees: it schedules tasks using the wait(long)
      * method.
      *
+     * By default the scheduled tasks are kept in a binary heap.  A Timer that holds a very
+     * large number of tasks, or whose tasks are often canceled, can instead be created with a
+     * hierarchical timing wheel which adds and cancels tasks in constant time and drops a
+     * canceled task from its queue as soon as it is canceled.
+     *
      * @since 1.0
      */
     class DECAF_API Timer {
+    public:
+
+        /**
+         * The structures a Timer can keep its scheduled tasks in.
+         */
+        enum TaskQueueType {
+
+            /**
+             * A binary heap, scheduling a task takes O(log n) time and canceled tasks stay
+             * in the heap until their time comes or the Timer is purged.
+             */
+            BINARY_HEAP,
+
+            /**
+             * A hierarchical timing wheel, scheduling and canceling a task take constant time
+             * and a canceled task is removed right away.  Tasks are run on a one millisecond
+             * tick.
+             */
+            TIMING_WHEEL
+        };
+
     private:
 
         TimerImpl* internal;
@@ -75,6 +101,17 @@ namespace util {
          */
         Timer(const std::string& name);
 
+        /**
+         * Create a new Timer whose associated thread is assigned the name given and that keeps
+         * its tasks in the given kind of queue.
+         *
+         * @param name
+         *      The name to assign to this Timer's Thread.
+         * @param type
+         *      The structure used to hold the scheduled tasks.
+         */
+        Timer(const std::string& name, TaskQueueType type);
+
         virtual ~Timer();
 
         /**
@@ -114,7 +151,8 @@ namespace util {
          * any references to TimerTasks that were previously scheduled.
          *
          * Most programs will have no need to call this method. It is designed for use by the rare application
-         * that cancels a large number of tasks. Calling this method trades time for space: the runtime of the
+         * that cancels a large number of tasks, a Timer using a TIMING_WHEEL already removes tasks as they are
+         * canceled. Calling this method trades time for space: the runtime of the
          * method may be proportional to n + c log n, where n is the number of tasks in the queue and c is the
          * number of canceled tasks.
          *
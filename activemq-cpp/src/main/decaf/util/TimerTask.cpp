@@ -18,22 +18,39 @@
 #include "TimerTask.h"
 
 #include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/internal/util/TimerTaskWheel.h>
 
 using namespace decaf;
 using namespace decaf::util;
 using namespace decaf::util::concurrent;
+using namespace decaf::internal::util;
+using namespace decaf::lang;
 
 ////////////////////////////////////////////////////////////////////////////////
-TimerTask::TimerTask() : lock(), fixedRate(false), cancelled(false), scheduledTime(0), when(0), period(-1) {
+TimerTask::TimerTask() : lock(), fixedRate(false), cancelled(false), scheduledTime(0), when(0), period(-1),
+                         wheel(), wheelBucket(-1), wheelIndex(-1) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TimerTask::~TimerTask() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool TimerTask::cancel() {
 
     bool result = false;
+    Pointer<TimerTaskWheel> owner;
+
     synchronized(&lock) {
         result = !cancelled && when > 0;
         cancelled = true;
+        owner.swap(this->wheel);
+    }
+
+    // The wheel is locked by the Timer while this task's lock is held, so it can only
+    // be entered once this task's lock is released.
+    if (owner != NULL) {
+        owner->remove(this);
     }
 
     return result;
@@ -20,12 +20,14 @@
 
 #include <decaf/util/Config.h>
 #include <decaf/lang/Runnable.h>
+#include <decaf/lang/Pointer.h>
 #include <decaf/util/concurrent/Mutex.h>
 
 namespace decaf {
 namespace internal{
     namespace util{
         class TimerTaskHeap;
+        class TimerTaskWheel;
     }
 }
 namespace util {
@@ -51,14 +53,21 @@ namespace util {
         long long when;
         long long period;
 
+        // The timing wheel this task was scheduled on, if any, so cancel can take the task
+        // out of it.  The bucket and index are guarded by the wheel's own lock.
+        decaf::lang::Pointer<decaf::internal::util::TimerTaskWheel> wheel;
+        int wheelBucket;
+        int wheelIndex;
+
         friend class Timer;
         friend class TimerImpl;
         friend class decaf::internal::util::TimerTaskHeap;
+        friend class decaf::internal::util::TimerTaskWheel;
 
     public:
 
         TimerTask();
-        virtual ~TimerTask() {}
+        virtual ~TimerTask();
 
         /**
          * Cancels this timer task. If the task has been scheduled for one-time execution and has
@@ -71,6 +80,9 @@ namespace util {
          *
          * This method may be called repeatedly; the second and subsequent calls have no effect.
          *
+         * When the task was scheduled on a Timer that uses a timing wheel it is taken out of the
+         * Timer's queue right away, the Timer destroys it the next time it checks for work.
+         *
          * @return true if this task is scheduled for one-time execution and has not yet run, or this
          * task is scheduled for repeated execution. Returns false if the task was scheduled for one-time
          * execution and has already run, or if the task was never scheduled, or if the task was already
@@ -20,9 +20,12 @@
 #include <decaf/lang/Exception.h>
 #include <decaf/lang/Pointer.h>
 #include <decaf/lang/Integer.h>
+#include <decaf/lang/System.h>
 #include <decaf/lang/exceptions/NullPointerException.h>
 #include <decaf/util/concurrent/atomic/AtomicInteger.h>
 #include <decaf/util/concurrent/ThreadPoolExecutor.h>
+#include <decaf/util/concurrent/ScheduledThreadPoolExecutor.h>
+#include <decaf/util/concurrent/WorkStealingExecutor.h>
 #include <decaf/util/concurrent/ThreadFactory.h>
 #include <decaf/util/concurrent/TimeUnit.h>
 #include <decaf/util/concurrent/LinkedBlockingQueue.h>
@@ -276,6 +279,62 @@ ExecutorService* Executors::newSingleThreadExecutor(ThreadFactory* threadFactory
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+ExecutorService* Executors::newWorkStealingPool() {
+    return Executors::newWorkStealingPool(System::availableProcessors());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ExecutorService* Executors::newWorkStealingPool(int parallelism) {
+
+    try{
+        return new WorkStealingExecutor(parallelism);
+    } catch(IllegalArgumentException& ex) {
+        ex.setMark(__FILE__, __LINE__);
+        throw ex;
+    } catch(Exception& ex) {
+        ex.setMark(__FILE__, __LINE__);
+        throw ex;
+    } catch(...) {
+        throw Exception();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ScheduledThreadPoolExecutor* Executors::newScheduledThreadPool(int corePoolSize) {
+
+    try{
+        return new ScheduledThreadPoolExecutor(corePoolSize);
+    } catch(IllegalArgumentException& ex) {
+        ex.setMark(__FILE__, __LINE__);
+        throw ex;
+    } catch(Exception& ex) {
+        ex.setMark(__FILE__, __LINE__);
+        throw ex;
+    } catch(...) {
+        throw Exception();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ScheduledThreadPoolExecutor* Executors::newScheduledThreadPool(int corePoolSize, ThreadFactory* threadFactory) {
+
+    try{
+        return new ScheduledThreadPoolExecutor(corePoolSize, threadFactory);
+    } catch(NullPointerException& ex) {
+        ex.setMark(__FILE__, __LINE__);
+        throw ex;
+    } catch(IllegalArgumentException& ex) {
+        ex.setMark(__FILE__, __LINE__);
+        throw ex;
+    } catch(Exception& ex) {
+        ex.setMark(__FILE__, __LINE__);
+        throw ex;
+    } catch(...) {
+        throw Exception();
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ExecutorService* Executors::unconfigurableExecutorService(ExecutorService* executor) {
 
@@ -32,6 +32,7 @@ namespace concurrent {
 
     class ThreadFactory;
     class ExecutorService;
+    class ScheduledThreadPoolExecutor;
 
     /**
      * Implements a set of utilities for use with Executors, ExecutorService, ThreadFactory,
@@ -172,6 +173,60 @@ namespace concurrent {
          */
         static ExecutorService* newSingleThreadExecutor(ThreadFactory* threadFactory);
 
+        /**
+         * Creates a new WorkStealingExecutor that uses as many worker threads as there are
+         * processors available.  Each worker keeps its own queue of tasks and idle workers
+         * steal tasks from the busy ones, so submitting tasks doesn't contend on a single
+         * shared queue.
+         *
+         * @return pointer to a new ExecutorService that is owned by the caller.
+         */
+        static ExecutorService* newWorkStealingPool();
+
+        /**
+         * Creates a new WorkStealingExecutor with the given number of worker threads.  Each
+         * worker keeps its own queue of tasks and idle workers steal tasks from the busy ones,
+         * so submitting tasks doesn't contend on a single shared queue.
+         *
+         * @param parallelism
+         *      The number of worker threads.
+         *
+         * @return pointer to a new ExecutorService that is owned by the caller.
+         *
+         * @throws IllegalArgumentException if parallelism is less than or equal to zero.
+         */
+        static ExecutorService* newWorkStealingPool(int parallelism);
+
+        /**
+         * Creates a new ScheduledThreadPoolExecutor with the given number of threads, which
+         * can run tasks after a delay or periodically.
+         *
+         * @param corePoolSize
+         *      The number of threads in the pool.
+         *
+         * @return pointer to a new ScheduledThreadPoolExecutor that is owned by the caller.
+         *
+         * @throws IllegalArgumentException if corePoolSize is less than one.
+         */
+        static ScheduledThreadPoolExecutor* newScheduledThreadPool(int corePoolSize);
+
+        /**
+         * Creates a new ScheduledThreadPoolExecutor with the given number of threads, which
+         * can run tasks after a delay or periodically.
+         *
+         * @param corePoolSize
+         *      The number of threads in the pool.
+         * @param threadFactory
+         *      Instance of a ThreadFactory that will be used by the Executor to spawn new
+         *      worker threads.  This parameter cannot be NULL.
+         *
+         * @return pointer to a new ScheduledThreadPoolExecutor that is owned by the caller.
+         *
+         * @throws IllegalArgumentException if corePoolSize is less than one.
+         * @throws NullPointerException if threadFactory is NULL.
+         */
+        static ScheduledThreadPoolExecutor* newScheduledThreadPool(int corePoolSize, ThreadFactory* threadFactory);
+
         /**
          * Returns a new ExecutorService derived instance that wraps and takes ownership of the given
          * ExecutorService pointer.  The returned ExecutorService delegates all calls to the wrapped
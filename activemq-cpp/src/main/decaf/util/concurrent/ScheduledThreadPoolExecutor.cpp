@@ -0,0 +1,884 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ScheduledThreadPoolExecutor.h"
+
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Long.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/ClassCastException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+#include <decaf/util/NoSuchElementException.h>
+#include <decaf/util/concurrent/BlockingQueue.h>
+#include <decaf/util/concurrent/locks/Condition.h>
+#include <decaf/util/concurrent/locks/ReentrantLock.h>
+
+#include <vector>
+
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::locks;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf {
+namespace util {
+namespace concurrent {
+
+    /**
+     * The work queue of the ScheduledThreadPoolExecutor, a binary heap of tasks ordered by
+     * the time they are due to run.  Each task keeps its own index in the heap so that a
+     * canceled task can be removed without searching the queue.
+     *
+     * Only one taker at a time waits for the task at the head of the queue to become due,
+     * the others wait until they are signaled, so they don't all wake up each time a delay
+     * elapses.  Tasks whose delay hasn't elapsed are never handed out by poll or drainTo.
+     */
+    class DelayedWorkQueue : public BlockingQueue<Runnable*> {
+    private:
+
+        typedef ScheduledThreadPoolExecutor::ScheduledTask ScheduledTask;
+
+        class SnapshotIterator : public Iterator<Runnable*> {
+        private:
+
+            DelayedWorkQueue* queue;
+            std::vector<Runnable*> snapshot;
+            std::size_t cursor;
+            int lastReturned;
+
+        private:
+
+            SnapshotIterator(const SnapshotIterator&);
+            SnapshotIterator& operator= (const SnapshotIterator&);
+
+        public:
+
+            SnapshotIterator(DelayedWorkQueue* queue, const std::vector<Runnable*>& snapshot) :
+                Iterator<Runnable*>(), queue(queue), snapshot(snapshot), cursor(0), lastReturned(-1) {
+            }
+
+            virtual ~SnapshotIterator() {}
+
+            virtual bool hasNext() const {
+                return this->cursor < this->snapshot.size();
+            }
+
+            virtual Runnable* next() {
+                if (this->cursor >= this->snapshot.size()) {
+                    throw NoSuchElementException(__FILE__, __LINE__, "No more elements in the Queue.");
+                }
+
+                this->lastReturned = (int) this->cursor;
+                return this->snapshot[this->cursor++];
+            }
+
+            virtual void remove() {
+                if (this->lastReturned < 0) {
+                    throw IllegalStateException(__FILE__, __LINE__, "next has not been called.");
+                }
+
+                this->queue->remove(this->snapshot[this->lastReturned]);
+                this->lastReturned = -1;
+            }
+        };
+
+    private:
+
+        mutable ReentrantLock lock;
+        Pointer<Condition> available;
+        std::vector<ScheduledTask*> heap;
+
+        // The thread waiting for the task at the head of the queue, if any.
+        Thread* leader;
+
+    private:
+
+        DelayedWorkQueue(const DelayedWorkQueue&);
+        DelayedWorkQueue& operator= (const DelayedWorkQueue&);
+
+    public:
+
+        DelayedWorkQueue() : BlockingQueue<Runnable*>(), lock(), available(), heap(), leader(NULL) {
+            this->available.reset(this->lock.newCondition());
+        }
+
+        virtual ~DelayedWorkQueue() {}
+
+        using AbstractQueue<Runnable*>::remove;
+
+        virtual bool offer(Runnable* const& value) {
+
+            ScheduledTask* task = checkTask(value);
+
+            this->lock.lock();
+            try {
+                this->heap.push_back(task);
+                siftUp((int) this->heap.size() - 1, task);
+
+                // A new head changes how long the leader has to wait.
+                if (this->heap[0] == task) {
+                    this->leader = NULL;
+                    this->available->signal();
+                }
+            } catch (Exception& ex) {
+                this->lock.unlock();
+                throw;
+            }
+            this->lock.unlock();
+
+            return true;
+        }
+
+        virtual bool offer(Runnable* const& value, long long timeout DECAF_UNUSED, const TimeUnit& unit DECAF_UNUSED) {
+            return this->offer(value);
+        }
+
+        virtual void put(Runnable* const& value) {
+            this->offer(value);
+        }
+
+        virtual Runnable* take() {
+
+            Runnable* result = NULL;
+
+            this->lock.lockInterruptibly();
+            try {
+                while (result == NULL) {
+
+                    if (this->heap.empty()) {
+                        this->available->await();
+                        continue;
+                    }
+
+                    long long delay = this->heap[0]->getDelayNanos();
+                    if (delay <= 0) {
+                        result = finishPoll();
+                    } else if (this->leader != NULL) {
+                        this->available->await();
+                    } else {
+                        awaitAsLeader(delay);
+                    }
+                }
+            } catch (Exception& ex) {
+                signalNextLeader();
+                this->lock.unlock();
+                throw;
+            }
+
+            signalNextLeader();
+            this->lock.unlock();
+
+            return result;
+        }
+
+        virtual bool poll(Runnable*& result, long long timeout, const TimeUnit& unit) {
+
+            long long nanos = unit.toNanos(timeout);
+            bool found = false;
+
+            this->lock.lockInterruptibly();
+            try {
+                while (!found) {
+
+                    if (this->heap.empty()) {
+                        if (nanos <= 0) {
+                            break;
+                        }
+                        nanos = this->available->awaitNanos(nanos);
+                        continue;
+                    }
+
+                    long long delay = this->heap[0]->getDelayNanos();
+                    if (delay <= 0) {
+                        result = finishPoll();
+                        found = true;
+                    } else if (nanos <= 0) {
+                        break;
+                    } else if (nanos < delay || this->leader != NULL) {
+                        nanos = this->available->awaitNanos(nanos);
+                    } else {
+                        nanos -= delay - awaitAsLeader(delay);
+                    }
+                }
+            } catch (Exception& ex) {
+                signalNextLeader();
+                this->lock.unlock();
+                throw;
+            }
+
+            signalNextLeader();
+            this->lock.unlock();
+
+            return found;
+        }
+
+        virtual bool poll(Runnable*& result) {
+
+            bool found = false;
+
+            this->lock.lock();
+            if (!this->heap.empty() && this->heap[0]->getDelayNanos() <= 0) {
+                result = finishPoll();
+                found = true;
+            }
+            this->lock.unlock();
+
+            return found;
+        }
+
+        virtual bool peek(Runnable*& result) const {
+
+            bool found = false;
+
+            this->lock.lock();
+            if (!this->heap.empty()) {
+                result = this->heap[0];
+                found = true;
+            }
+            this->lock.unlock();
+
+            return found;
+        }
+
+        virtual int size() const {
+            this->lock.lock();
+            int result = (int) this->heap.size();
+            this->lock.unlock();
+            return result;
+        }
+
+        virtual bool isEmpty() const {
+            return this->size() == 0;
+        }
+
+        virtual int remainingCapacity() const {
+            return Integer::MAX_VALUE;
+        }
+
+        virtual void clear() {
+            this->lock.lock();
+            std::vector<ScheduledTask*>::iterator iter = this->heap.begin();
+            for (; iter != this->heap.end(); ++iter) {
+                (*iter)->setHeapIndex(-1);
+            }
+            this->heap.clear();
+            this->lock.unlock();
+        }
+
+        virtual bool contains(Runnable* const& value) const {
+            this->lock.lock();
+            bool result = indexOf(value) >= 0;
+            this->lock.unlock();
+            return result;
+        }
+
+        virtual bool remove(Runnable* const& value) {
+
+            bool removed = false;
+
+            this->lock.lock();
+            int index = indexOf(value);
+            if (index >= 0) {
+                removeAt(index);
+                removed = true;
+            }
+            this->lock.unlock();
+
+            return removed;
+        }
+
+        /**
+         * Removes the queued copy of the given task, which may be a different object that
+         * shares the task's schedule.
+         *
+         * @return the queued copy, or NULL if the task isn't in the queue.
+         */
+        ScheduledTask* removeTask(ScheduledTask* task) {
+
+            ScheduledTask* result = NULL;
+
+            this->lock.lock();
+            int index = task->getHeapIndex();
+            if (index >= 0 && index < (int) this->heap.size() && this->heap[index]->getHeapIndex() == index &&
+                this->heap[index]->compareSchedule(*task) == 0) {
+
+                result = this->heap[index];
+                removeAt(index);
+            }
+            this->lock.unlock();
+
+            return result;
+        }
+
+        virtual int drainTo(Collection<Runnable*>& c) {
+            return this->drainTo(c, Integer::MAX_VALUE);
+        }
+
+        virtual int drainTo(Collection<Runnable*>& c, int maxElements) {
+
+            if (&c == this) {
+                throw IllegalArgumentException(__FILE__, __LINE__, "Cannot drain a Queue into itself.");
+            }
+
+            int count = 0;
+
+            this->lock.lock();
+            try {
+                while (count < maxElements && !this->heap.empty() && this->heap[0]->getDelayNanos() <= 0) {
+                    c.add(finishPoll());
+                    count++;
+                }
+            } catch (Exception& ex) {
+                this->lock.unlock();
+                throw;
+            }
+            this->lock.unlock();
+
+            return count;
+        }
+
+        virtual std::vector<Runnable*> toArray() const {
+            this->lock.lock();
+            std::vector<Runnable*> result(this->heap.begin(), this->heap.end());
+            this->lock.unlock();
+            return result;
+        }
+
+        virtual Iterator<Runnable*>* iterator() {
+            return new SnapshotIterator(this, this->toArray());
+        }
+
+        virtual Iterator<Runnable*>* iterator() const {
+            return new SnapshotIterator(const_cast<DelayedWorkQueue*>(this), this->toArray());
+        }
+
+    private:
+
+        static ScheduledTask* checkTask(Runnable* value) {
+
+            if (value == NULL) {
+                throw NullPointerException(__FILE__, __LINE__, "Cannot add a NULL task to the Queue.");
+            }
+
+            ScheduledTask* task = dynamic_cast<ScheduledTask*>(value);
+            if (task == NULL) {
+                throw ClassCastException(__FILE__, __LINE__, "Only scheduled tasks can be added to the Queue.");
+            }
+
+            return task;
+        }
+
+        // Waits for the head of the queue to become due, returns the time left.
+        long long awaitAsLeader(long long delay) {
+
+            Thread* thisThread = Thread::currentThread();
+            this->leader = thisThread;
+
+            long long remaining = 0;
+            try {
+                remaining = this->available->awaitNanos(delay);
+            } catch (Exception& ex) {
+                if (this->leader == thisThread) {
+                    this->leader = NULL;
+                }
+                throw;
+            }
+
+            if (this->leader == thisThread) {
+                this->leader = NULL;
+            }
+
+            return remaining;
+        }
+
+        // Called with the lock held before returning from a blocking take.
+        void signalNextLeader() {
+            if (this->leader == NULL && !this->heap.empty()) {
+                this->available->signal();
+            }
+        }
+
+        int indexOf(Runnable* value) const {
+
+            ScheduledTask* task = dynamic_cast<ScheduledTask*>(value);
+            if (task == NULL) {
+                return -1;
+            }
+
+            int index = task->getHeapIndex();
+            if (index >= 0 && index < (int) this->heap.size() && this->heap[index] == task) {
+                return index;
+            }
+
+            return -1;
+        }
+
+        ScheduledTask* finishPoll() {
+
+            ScheduledTask* first = this->heap[0];
+            ScheduledTask* last = this->heap.back();
+            this->heap.pop_back();
+
+            if (!this->heap.empty()) {
+                siftDown(0, last);
+            }
+
+            first->setHeapIndex(-1);
+            return first;
+        }
+
+        void removeAt(int index) {
+
+            ScheduledTask* removed = this->heap[index];
+            ScheduledTask* last = this->heap.back();
+            this->heap.pop_back();
+
+            if (index != (int) this->heap.size()) {
+                siftDown(index, last);
+                if (this->heap[index] == last) {
+                    siftUp(index, last);
+                }
+            }
+
+            removed->setHeapIndex(-1);
+        }
+
+        void siftUp(int index, ScheduledTask* task) {
+
+            while (index > 0) {
+                int parent = (index - 1) >> 1;
+                ScheduledTask* next = this->heap[parent];
+                if (task->compareSchedule(*next) >= 0) {
+                    break;
+                }
+                this->heap[index] = next;
+                next->setHeapIndex(index);
+                index = parent;
+            }
+
+            this->heap[index] = task;
+            task->setHeapIndex(index);
+        }
+
+        void siftDown(int index, ScheduledTask* task) {
+
+            int size = (int) this->heap.size();
+            int half = size >> 1;
+
+            while (index < half) {
+                int child = (index << 1) + 1;
+                ScheduledTask* next = this->heap[child];
+                int right = child + 1;
+                if (right < size && next->compareSchedule(*this->heap[right]) > 0) {
+                    next = this->heap[child = right];
+                }
+                if (task->compareSchedule(*next) <= 0) {
+                    break;
+                }
+                this->heap[index] = next;
+                next->setHeapIndex(index);
+                index = child;
+            }
+
+            this->heap[index] = task;
+            task->setHeapIndex(index);
+        }
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+ScheduledThreadPoolExecutor::ScheduledTask::ScheduledTask(ScheduledThreadPoolExecutor* executor, long long time, long long period) :
+    Runnable(), schedule(new Schedule(time, period, executor->sequencer.getAndIncrement())), executor(executor) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ScheduledThreadPoolExecutor::ScheduledTask::ScheduledTask(const ScheduledTask& source) :
+    Runnable(), schedule(source.schedule), executor(source.executor) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ScheduledThreadPoolExecutor::ScheduledTask::~ScheduledTask() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutor::ScheduledTask::run() {
+
+    bool periodic = this->isPeriodic();
+
+    if (!this->executor->canRunInCurrentRunState(periodic)) {
+        this->cancel(false);
+    } else if (!periodic) {
+        this->runOnce();
+    } else if (this->runAndReset()) {
+
+        long long period = this->schedule->period;
+        if (period > 0) {
+            this->schedule->time += period;
+        } else {
+            this->schedule->time = this->executor->triggerTime(-period, TimeUnit::NANOSECONDS);
+        }
+
+        this->executor->reExecutePeriodic(this->duplicate());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ScheduledThreadPoolExecutor::ScheduledTask::isPeriodic() const {
+    return this->schedule->period != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ScheduledThreadPoolExecutor::ScheduledTask::getDelayNanos() const {
+    return this->schedule->time - System::nanoTime();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ScheduledThreadPoolExecutor::ScheduledTask::getHeapIndex() const {
+    return this->schedule->heapIndex;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutor::ScheduledTask::setHeapIndex(int index) {
+    this->schedule->heapIndex = index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int ScheduledThreadPoolExecutor::ScheduledTask::compareSchedule(const ScheduledTask& other) const {
+
+    if (this->schedule == other.schedule) {
+        return 0;
+    }
+
+    // Differences rather than the values are compared so the order holds if the
+    // clock or the sequence numbers wrap.
+    long long diff = this->schedule->time - other.schedule->time;
+    if (diff != 0) {
+        return diff < 0 ? -1 : 1;
+    }
+
+    return (this->schedule->sequenceNumber - other.schedule->sequenceNumber) < 0 ? -1 : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutor::ScheduledTask::onCancelled() {
+
+    // Once the task has left the queue the executor may be gone, so it's only
+    // touched while the task is still queued.
+    if (this->schedule->heapIndex >= 0 && this->executor->removeOnCancel) {
+        this->executor->removeCancelled(this);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ScheduledThreadPoolExecutor::ScheduledThreadPoolExecutor(int corePoolSize) :
+    ThreadPoolExecutor(corePoolSize, Integer::MAX_VALUE, 0, TimeUnit::NANOSECONDS, new DelayedWorkQueue()),
+    delayedQueue(NULL),
+    sequencer(),
+    continueExistingPeriodicTasksAfterShutdown(false),
+    executeExistingDelayedTasksAfterShutdown(true),
+    removeOnCancel(true) {
+
+    if (corePoolSize < 1) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Core pool size must be at least one.");
+    }
+
+    this->delayedQueue = dynamic_cast<DelayedWorkQueue*>(this->getQueue());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ScheduledThreadPoolExecutor::ScheduledThreadPoolExecutor(int corePoolSize, ThreadFactory* threadFactory) :
+    ThreadPoolExecutor(corePoolSize, Integer::MAX_VALUE, 0, TimeUnit::NANOSECONDS, new DelayedWorkQueue(), threadFactory),
+    delayedQueue(NULL),
+    sequencer(),
+    continueExistingPeriodicTasksAfterShutdown(false),
+    executeExistingDelayedTasksAfterShutdown(true),
+    removeOnCancel(true) {
+
+    if (corePoolSize < 1) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Core pool size must be at least one.");
+    }
+
+    this->delayedQueue = dynamic_cast<DelayedWorkQueue*>(this->getQueue());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ScheduledThreadPoolExecutor::ScheduledThreadPoolExecutor(int corePoolSize, RejectedExecutionHandler* handler) :
+    ThreadPoolExecutor(corePoolSize, Integer::MAX_VALUE, 0, TimeUnit::NANOSECONDS, new DelayedWorkQueue(), handler),
+    delayedQueue(NULL),
+    sequencer(),
+    continueExistingPeriodicTasksAfterShutdown(false),
+    executeExistingDelayedTasksAfterShutdown(true),
+    removeOnCancel(true) {
+
+    if (corePoolSize < 1) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Core pool size must be at least one.");
+    }
+
+    this->delayedQueue = dynamic_cast<DelayedWorkQueue*>(this->getQueue());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ScheduledThreadPoolExecutor::ScheduledThreadPoolExecutor(int corePoolSize, ThreadFactory* threadFactory,
+                                                         RejectedExecutionHandler* handler) :
+    ThreadPoolExecutor(corePoolSize, Integer::MAX_VALUE, 0, TimeUnit::NANOSECONDS, new DelayedWorkQueue(), threadFactory, handler),
+    delayedQueue(NULL),
+    sequencer(),
+    continueExistingPeriodicTasksAfterShutdown(false),
+    executeExistingDelayedTasksAfterShutdown(true),
+    removeOnCancel(true) {
+
+    if (corePoolSize < 1) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Core pool size must be at least one.");
+    }
+
+    this->delayedQueue = dynamic_cast<DelayedWorkQueue*>(this->getQueue());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ScheduledThreadPoolExecutor::~ScheduledThreadPoolExecutor() {
+
+    try {
+        // Cancel everything still waiting in the queue and let the running tasks finish
+        // while this object is still whole, they call back into it when done.
+        this->executeExistingDelayedTasksAfterShutdown = false;
+        this->continueExistingPeriodicTasksAfterShutdown = false;
+        this->shutdown();
+        this->awaitTermination(10, TimeUnit::MINUTES);
+    }
+    DECAF_CATCH_NOTHROW(Exception)
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutor::execute(Runnable* task) {
+    this->execute(task, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutor::execute(Runnable* task, bool takeOwnership) {
+
+    try {
+
+        if (task == NULL) {
+            throw NullPointerException(__FILE__, __LINE__, "Runnable task cannot be NULL");
+        }
+
+        this->enqueue(new ScheduledFutureTask<bool>(
+            this, new FutureTask<bool>(task, false, takeOwnership), this->triggerTime(0, TimeUnit::NANOSECONDS), 0));
+    }
+    DECAF_CATCH_RETHROW(RejectedExecutionException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ScheduledFuture<bool>* ScheduledThreadPoolExecutor::schedule(Runnable* task, long long delay,
+                                                             const TimeUnit& unit, bool takeOwnership) {
+
+    if (task == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Runnable pointer passed to schedule was NULL");
+    }
+
+    return this->delayedExecute(new ScheduledFutureTask<bool>(
+        this, new FutureTask<bool>(task, false, takeOwnership), this->triggerTime(delay, unit), 0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ScheduledFuture<bool>* ScheduledThreadPoolExecutor::scheduleAtFixedRate(Runnable* task, long long initialDelay,
+                                                                        long long period, const TimeUnit& unit,
+                                                                        bool takeOwnership) {
+
+    if (task == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Runnable pointer passed to scheduleAtFixedRate was NULL");
+    }
+
+    if (period <= 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Period must be greater than zero.");
+    }
+
+    return this->delayedExecute(new ScheduledFutureTask<bool>(
+        this, new FutureTask<bool>(task, false, takeOwnership), this->triggerTime(initialDelay, unit), unit.toNanos(period)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ScheduledFuture<bool>* ScheduledThreadPoolExecutor::scheduleWithFixedDelay(Runnable* task, long long initialDelay,
+                                                                           long long delay, const TimeUnit& unit,
+                                                                           bool takeOwnership) {
+
+    if (task == NULL) {
+        throw NullPointerException(__FILE__, __LINE__, "Runnable pointer passed to scheduleWithFixedDelay was NULL");
+    }
+
+    if (delay <= 0) {
+        throw IllegalArgumentException(__FILE__, __LINE__, "Delay must be greater than zero.");
+    }
+
+    return this->delayedExecute(new ScheduledFutureTask<bool>(
+        this, new FutureTask<bool>(task, false, takeOwnership), this->triggerTime(initialDelay, unit), -unit.toNanos(delay)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutor::setContinueExistingPeriodicTasksAfterShutdownPolicy(bool value) {
+    this->continueExistingPeriodicTasksAfterShutdown = value;
+    if (!value && this->isShutdown()) {
+        this->onShutdown();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ScheduledThreadPoolExecutor::getContinueExistingPeriodicTasksAfterShutdownPolicy() const {
+    return this->continueExistingPeriodicTasksAfterShutdown;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutor::setExecuteExistingDelayedTasksAfterShutdownPolicy(bool value) {
+    this->executeExistingDelayedTasksAfterShutdown = value;
+    if (!value && this->isShutdown()) {
+        this->onShutdown();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ScheduledThreadPoolExecutor::getExecuteExistingDelayedTasksAfterShutdownPolicy() const {
+    return this->executeExistingDelayedTasksAfterShutdown;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutor::setRemoveOnCancelPolicy(bool value) {
+    this->removeOnCancel = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ScheduledThreadPoolExecutor::getRemoveOnCancelPolicy() const {
+    return this->removeOnCancel;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutor::onShutdown() {
+
+    bool keepDelayed = this->executeExistingDelayedTasksAfterShutdown;
+    bool keepPeriodic = this->continueExistingPeriodicTasksAfterShutdown;
+
+    std::vector<Runnable*> tasks = this->delayedQueue->toArray();
+    std::vector<Runnable*>::iterator iter = tasks.begin();
+
+    for (; iter != tasks.end(); ++iter) {
+
+        ScheduledTask* task = dynamic_cast<ScheduledTask*>(*iter);
+        bool keep = task->isPeriodic() ? keepPeriodic : keepDelayed;
+
+        if ((!keep || task->isCancelled()) && this->delayedQueue->remove(task)) {
+            task->cancel(false);
+            delete task;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long ScheduledThreadPoolExecutor::triggerTime(long long delay, const TimeUnit& unit) {
+
+    long long nanos = delay < 0 ? 0 : unit.toNanos(delay);
+
+    // Keeps the differences between run times from overflowing.
+    if (nanos > (Long::MAX_VALUE >> 1)) {
+        nanos = Long::MAX_VALUE >> 1;
+    }
+
+    return System::nanoTime() + nanos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutor::enqueue(ScheduledTask* task) {
+
+    if (this->isShutdown()) {
+        // The caller never sees the queued copy so it can't be left to them to clean up.
+        try {
+            this->getRejectedExecutionHandler()->rejectedExecution(task, this);
+        } catch (...) {
+            delete task;
+            throw;
+        }
+        delete task;
+        return;
+    }
+
+    bool periodic = task->isPeriodic();
+    this->delayedQueue->add(task);
+
+    // Recheck in case shutdown was called while the task was being added.
+    if (this->isShutdown() && !this->canRunInCurrentRunState(periodic) && this->remove(task)) {
+        task->cancel(false);
+        delete task;
+    } else {
+        this->prestartCoreThread();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutor::reExecutePeriodic(ScheduledTask* task) {
+
+    if (this->canRunInCurrentRunState(true) && !task->isCancelled()) {
+
+        this->delayedQueue->add(task);
+
+        if (!this->canRunInCurrentRunState(true) && this->remove(task)) {
+            task->cancel(false);
+            delete task;
+        } else {
+            this->prestartCoreThread();
+        }
+
+    } else {
+        task->cancel(false);
+        delete task;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool ScheduledThreadPoolExecutor::canRunInCurrentRunState(bool periodic) const {
+
+    if (!this->isShutdown()) {
+        return true;
+    }
+
+    bool keep = periodic ? this->continueExistingPeriodicTasksAfterShutdown :
+                           this->executeExistingDelayedTasksAfterShutdown;
+
+    return keep && !this->isTerminated();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutor::removeCancelled(ScheduledTask* task) {
+
+    ScheduledTask* queued = this->delayedQueue->removeTask(task);
+
+    if (queued != NULL && queued != task) {
+        delete queued;
+    }
+
+    // Removing the last task may be what a shutdown is waiting for.
+    if (queued != NULL && this->isShutdown()) {
+        this->purge();
+    }
+}
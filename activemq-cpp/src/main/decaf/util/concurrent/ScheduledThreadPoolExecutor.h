@@ -0,0 +1,514 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_SCHEDULEDTHREADPOOLEXECUTOR_H_
+#define _DECAF_UTIL_CONCURRENT_SCHEDULEDTHREADPOOLEXECUTOR_H_
+
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/util/concurrent/Callable.h>
+#include <decaf/util/concurrent/FutureTask.h>
+#include <decaf/util/concurrent/ScheduledFuture.h>
+#include <decaf/util/concurrent/ThreadFactory.h>
+#include <decaf/util/concurrent/ThreadPoolExecutor.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+#include <decaf/util/concurrent/RejectedExecutionHandler.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/util/Config.h>
+
+namespace decaf {
+namespace util {
+namespace concurrent {
+
+    using decaf::lang::Pointer;
+
+    class DelayedWorkQueue;
+
+    /**
+     * A ThreadPoolExecutor that can run tasks after a given delay, or periodically, on a
+     * fixed number of threads.  This is a replacement for a Timer when several threads are
+     * wanted, or when the Future based control of the tasks is needed, and lets many
+     * periodic tasks share a small pool instead of each holding a Timer thread.
+     *
+     * Tasks that are due at the same time are run in the order they were scheduled.  A
+     * canceled task is removed from the work queue right away unless the remove on cancel
+     * policy has been turned off, in which case it stays queued until its delay elapses.
+     *
+     * A periodic task is run again only once the previous run has finished, a run that
+     * throws an exception stops the task and the exception is reported by the get method
+     * of the task's ScheduledFuture.
+     *
+     * Because the pool has a fixed number of threads and an unbounded queue, the maximum
+     * pool size has no effect.  Tasks passed to execute or submit are run as if scheduled
+     * with a zero delay.
+     *
+     * @since 1.0
+     */
+    class DECAF_API ScheduledThreadPoolExecutor : public ThreadPoolExecutor {
+    private:
+
+        ScheduledThreadPoolExecutor(const ScheduledThreadPoolExecutor&);
+        ScheduledThreadPoolExecutor& operator= (const ScheduledThreadPoolExecutor&);
+
+    protected:
+
+        /**
+         * The part of a scheduled task that doesn't depend on its result type, these are
+         * the elements of the work queue.  The task's run time and queue position are kept
+         * in state that is shared with every copy of the task, so the ScheduledFuture held
+         * by the caller always reflects the copy that is in the queue.
+         */
+        class ScheduledTask : public decaf::lang::Runnable {
+        private:
+
+            class Schedule {
+            private:
+
+                Schedule(const Schedule&);
+                Schedule& operator= (const Schedule&);
+
+            public:
+
+                // The time the task is due to run, from System::nanoTime.
+                long long time;
+
+                // Positive for fixed rate, negative for fixed delay and zero for one shot.
+                long long period;
+
+                // Breaks ties between tasks due at the same time.
+                int sequenceNumber;
+
+                // Position in the work queue heap or -1 when not queued.
+                int heapIndex;
+
+                Schedule(long long time, long long period, int sequenceNumber) :
+                    time(time), period(period), sequenceNumber(sequenceNumber), heapIndex(-1) {
+                }
+            };
+
+            Pointer<Schedule> schedule;
+            ScheduledThreadPoolExecutor* executor;
+
+        private:
+
+            ScheduledTask& operator= (const ScheduledTask&);
+
+        protected:
+
+            ScheduledTask(ScheduledThreadPoolExecutor* executor, long long time, long long period);
+
+            ScheduledTask(const ScheduledTask& source);
+
+        public:
+
+            virtual ~ScheduledTask();
+
+            /**
+             * Runs the task if the executor's state allows it, and when the task is periodic
+             * queues a copy of it for its next run.
+             */
+            virtual void run();
+
+            bool isPeriodic() const;
+
+            long long getDelayNanos() const;
+
+            int getHeapIndex() const;
+
+            void setHeapIndex(int index);
+
+            /**
+             * Orders this task against the other by run time and then by the order in
+             * which they were scheduled.
+             */
+            int compareSchedule(const ScheduledTask& other) const;
+
+            virtual bool isCancelled() const = 0;
+
+            virtual bool cancel(bool mayInterruptIfRunning) = 0;
+
+            /**
+             * @return a new copy of this task sharing its schedule and result.
+             */
+            virtual ScheduledTask* duplicate() const = 0;
+
+        protected:
+
+            virtual void runOnce() = 0;
+
+            virtual bool runAndReset() = 0;
+
+            /**
+             * Called once the task has been canceled to take it out of the work queue.
+             */
+            void onCancelled();
+
+        };
+
+        template<typename T>
+        class ScheduledFutureTask : public ScheduledFuture<T>, public ScheduledTask {
+        private:
+
+            Pointer< FutureTask<T> > future;
+
+        private:
+
+            ScheduledFutureTask& operator= (const ScheduledFutureTask&);
+
+        public:
+
+            ScheduledFutureTask(ScheduledThreadPoolExecutor* executor, FutureTask<T>* future, long long time, long long period) :
+                ScheduledFuture<T>(), ScheduledTask(executor, time, period), future(future) {
+            }
+
+            ScheduledFutureTask(const ScheduledFutureTask& source) :
+                ScheduledFuture<T>(), ScheduledTask(source), future(source.future) {
+            }
+
+            virtual ~ScheduledFutureTask() {}
+
+            virtual long long getDelay(const TimeUnit& unit) {
+                return unit.convert(this->getDelayNanos(), TimeUnit::NANOSECONDS);
+            }
+
+            virtual int compareTo(const Delayed& other) const {
+
+                if (&other == static_cast<const Delayed*>(this)) {
+                    return 0;
+                }
+
+                const ScheduledTask* task = dynamic_cast<const ScheduledTask*>(&other);
+                if (task != NULL) {
+                    return this->compareSchedule(*task);
+                }
+
+                long long diff = this->getDelayNanos() - const_cast<Delayed&>(other).getDelay(TimeUnit::NANOSECONDS);
+                return diff < 0 ? -1 : (diff > 0 ? 1 : 0);
+            }
+
+            virtual bool equals(const Delayed& other) const {
+                return this->compareTo(other) == 0;
+            }
+
+            virtual bool operator==(const Delayed& other) const {
+                return this->equals(other);
+            }
+
+            virtual bool operator<(const Delayed& other) const {
+                return this->compareTo(other) < 0;
+            }
+
+            virtual bool isCancelled() const {
+                return this->future->isCancelled();
+            }
+
+            virtual bool isDone() const {
+                return this->future->isDone();
+            }
+
+            virtual bool cancel(bool mayInterruptIfRunning) {
+                bool cancelled = this->future->cancel(mayInterruptIfRunning);
+                if (cancelled) {
+                    this->onCancelled();
+                }
+                return cancelled;
+            }
+
+            virtual T get() {
+                return this->future->get();
+            }
+
+            virtual T get(long long timeout, const TimeUnit& unit) {
+                return this->future->get(timeout, unit);
+            }
+
+            virtual ScheduledTask* duplicate() const {
+                return new ScheduledFutureTask<T>(*this);
+            }
+
+        protected:
+
+            virtual void runOnce() {
+                this->future->run();
+            }
+
+            virtual bool runAndReset() {
+                return this->future->runAndReset();
+            }
+
+        };
+
+    private:
+
+        friend class DelayedWorkQueue;
+
+        DelayedWorkQueue* delayedQueue;
+        atomic::AtomicInteger sequencer;
+
+        volatile bool continueExistingPeriodicTasksAfterShutdown;
+        volatile bool executeExistingDelayedTasksAfterShutdown;
+        volatile bool removeOnCancel;
+
+    public:
+
+        /**
+         * Creates a new ScheduledThreadPoolExecutor with the given number of threads, the
+         * default ThreadFactory and the AbortPolicy for rejected tasks.
+         *
+         * @param corePoolSize
+         *      The number of threads in the pool.
+         *
+         * @throws IllegalArgumentException if corePoolSize is less than one.
+         */
+        ScheduledThreadPoolExecutor(int corePoolSize);
+
+        /**
+         * Creates a new ScheduledThreadPoolExecutor with the given number of threads and
+         * ThreadFactory.
+         *
+         * @param corePoolSize
+         *      The number of threads in the pool.
+         * @param threadFactory
+         *      The ThreadFactory used to create the threads, the executor takes ownership.
+         *
+         * @throws IllegalArgumentException if corePoolSize is less than one.
+         * @throws NullPointerException if threadFactory is NULL.
+         */
+        ScheduledThreadPoolExecutor(int corePoolSize, ThreadFactory* threadFactory);
+
+        /**
+         * Creates a new ScheduledThreadPoolExecutor with the given number of threads and
+         * handler for rejected tasks.
+         *
+         * @param corePoolSize
+         *      The number of threads in the pool.
+         * @param handler
+         *      The handler for tasks that can't be run, the executor takes ownership.
+         *
+         * @throws IllegalArgumentException if corePoolSize is less than one.
+         * @throws NullPointerException if handler is NULL.
+         */
+        ScheduledThreadPoolExecutor(int corePoolSize, RejectedExecutionHandler* handler);
+
+        /**
+         * Creates a new ScheduledThreadPoolExecutor with the given number of threads,
+         * ThreadFactory and handler for rejected tasks.
+         *
+         * @param corePoolSize
+         *      The number of threads in the pool.
+         * @param threadFactory
+         *      The ThreadFactory used to create the threads, the executor takes ownership.
+         * @param handler
+         *      The handler for tasks that can't be run, the executor takes ownership.
+         *
+         * @throws IllegalArgumentException if corePoolSize is less than one.
+         * @throws NullPointerException if threadFactory or handler is NULL.
+         */
+        ScheduledThreadPoolExecutor(int corePoolSize, ThreadFactory* threadFactory, RejectedExecutionHandler* handler);
+
+        virtual ~ScheduledThreadPoolExecutor();
+
+    public:
+
+        virtual void execute(decaf::lang::Runnable* task);
+
+        virtual void execute(decaf::lang::Runnable* task, bool takeOwnership);
+
+        /**
+         * Runs the Callable once after the given delay.
+         *
+         * @param callable
+         *      The task to run.
+         * @param delay
+         *      The time from now until the task runs.
+         * @param unit
+         *      The unit of the delay.
+         * @param takeOwnership
+         *      True if the executor deletes the callable once it is done with it.
+         *
+         * @return a new ScheduledFuture that gives the Callable's result, owned by the caller.
+         *
+         * @throws NullPointerException if the callable is NULL.
+         * @throws RejectedExecutionException if the task can't be scheduled.
+         */
+        template<typename E>
+        ScheduledFuture<E>* schedule(Callable<E>* callable, long long delay, const TimeUnit& unit, bool takeOwnership = true) {
+
+            if (callable == NULL) {
+                throw decaf::lang::exceptions::NullPointerException(
+                    __FILE__, __LINE__, "Callable pointer passed to schedule was NULL");
+            }
+
+            return this->delayedExecute(new ScheduledFutureTask<E>(
+                this, new FutureTask<E>(callable, takeOwnership), this->triggerTime(delay, unit), 0));
+        }
+
+        /**
+         * Runs the task once after the given delay.
+         *
+         * @param task
+         *      The task to run.
+         * @param delay
+         *      The time from now until the task runs.
+         * @param unit
+         *      The unit of the delay.
+         * @param takeOwnership
+         *      True if the executor deletes the task once it is done with it.
+         *
+         * @return a new ScheduledFuture whose get method returns false once the task has
+         *         completed, owned by the caller.
+         *
+         * @throws NullPointerException if the task is NULL.
+         * @throws RejectedExecutionException if the task can't be scheduled.
+         */
+        ScheduledFuture<bool>* schedule(decaf::lang::Runnable* task, long long delay, const TimeUnit& unit, bool takeOwnership = true);
+
+        /**
+         * Runs the task first after the initial delay and then once every period, so the
+         * runs start at initialDelay, initialDelay + period, initialDelay + 2 * period and
+         * so on.  A run that starts late doesn't shift the runs after it, if a run takes
+         * longer than the period the next one starts late but the task is never run
+         * concurrently with itself.
+         *
+         * The task runs until its ScheduledFuture is canceled, a run throws an exception or
+         * the executor is shut down.
+         *
+         * @param task
+         *      The task to run.
+         * @param initialDelay
+         *      The time from now until the first run.
+         * @param period
+         *      The time between the start of successive runs.
+         * @param unit
+         *      The unit of the initialDelay and period.
+         * @param takeOwnership
+         *      True if the executor deletes the task once it is done with it.
+         *
+         * @return a new ScheduledFuture for the task, owned by the caller.
+         *
+         * @throws NullPointerException if the task is NULL.
+         * @throws IllegalArgumentException if the period is less than or equal to zero.
+         * @throws RejectedExecutionException if the task can't be scheduled.
+         */
+        ScheduledFuture<bool>* scheduleAtFixedRate(decaf::lang::Runnable* task, long long initialDelay,
+                                                   long long period, const TimeUnit& unit, bool takeOwnership = true);
+
+        /**
+         * Runs the task first after the initial delay and then again each time the given
+         * delay has passed since the end of the previous run.
+         *
+         * The task runs until its ScheduledFuture is canceled, a run throws an exception or
+         * the executor is shut down.
+         *
+         * @param task
+         *      The task to run.
+         * @param initialDelay
+         *      The time from now until the first run.
+         * @param delay
+         *      The time between the end of one run and the start of the next.
+         * @param unit
+         *      The unit of the initialDelay and delay.
+         * @param takeOwnership
+         *      True if the executor deletes the task once it is done with it.
+         *
+         * @return a new ScheduledFuture for the task, owned by the caller.
+         *
+         * @throws NullPointerException if the task is NULL.
+         * @throws IllegalArgumentException if the delay is less than or equal to zero.
+         * @throws RejectedExecutionException if the task can't be scheduled.
+         */
+        ScheduledFuture<bool>* scheduleWithFixedDelay(decaf::lang::Runnable* task, long long initialDelay,
+                                                      long long delay, const TimeUnit& unit, bool takeOwnership = true);
+
+        /**
+         * Sets whether periodic tasks keep running after shutdown has been called, by
+         * default they are canceled.  They are always canceled by shutdownNow.
+         *
+         * @param value
+         *      True if periodic tasks should continue after shutdown.
+         */
+        void setContinueExistingPeriodicTasksAfterShutdownPolicy(bool value);
+
+        /**
+         * @return true if periodic tasks keep running after shutdown has been called.
+         */
+        bool getContinueExistingPeriodicTasksAfterShutdownPolicy() const;
+
+        /**
+         * Sets whether one shot tasks that are waiting for their delay still run after
+         * shutdown has been called, by default they do.  They are always canceled by
+         * shutdownNow.
+         *
+         * @param value
+         *      True if delayed tasks should still run after shutdown.
+         */
+        void setExecuteExistingDelayedTasksAfterShutdownPolicy(bool value);
+
+        /**
+         * @return true if delayed tasks still run after shutdown has been called.
+         */
+        bool getExecuteExistingDelayedTasksAfterShutdownPolicy() const;
+
+        /**
+         * Sets whether a task is taken out of the work queue as soon as it is canceled,
+         * which is the default.  When false a canceled task stays queued until its delay
+         * elapses.
+         *
+         * @param value
+         *      True if canceled tasks should be removed from the work queue.
+         */
+        void setRemoveOnCancelPolicy(bool value);
+
+        /**
+         * @return true if canceled tasks are removed from the work queue right away.
+         */
+        bool getRemoveOnCancelPolicy() const;
+
+    protected:
+
+        virtual void onShutdown();
+
+    private:
+
+        template<typename E>
+        ScheduledFuture<E>* delayedExecute(ScheduledFutureTask<E>* task) {
+
+            // The caller gets its own copy of the task since the executor deletes the one
+            // it queued once it is done with it, the two share the result and schedule.
+            Pointer< ScheduledFutureTask<E> > handle(new ScheduledFutureTask<E>(*task));
+
+            this->enqueue(task);
+
+            return handle.release();
+        }
+
+        long long triggerTime(long long delay, const TimeUnit& unit);
+
+        void enqueue(ScheduledTask* task);
+
+        void reExecutePeriodic(ScheduledTask* task);
+
+        bool canRunInCurrentRunState(bool periodic) const;
+
+        void removeCancelled(ScheduledTask* task);
+
+    };
+
+}}}
+
+#endif /* _DECAF_UTIL_CONCURRENT_SCHEDULEDTHREADPOOLEXECUTOR_H_ */
@@ -0,0 +1,792 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WorkStealingExecutor.h"
+
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/util/LinkedList.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/Executors.h>
+#include <decaf/util/concurrent/Concurrent.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/util/concurrent/atomic/AtomicReference.h>
+#include <decaf/internal/util/concurrent/Atomics.h>
+
+#include <vector>
+
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+using namespace decaf::internal::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    /**
+     * Wraps the tasks we don't own so that every queued task can be deleted once run.
+     */
+    class UnownedTask : public Runnable {
+    private:
+
+        Runnable* task;
+
+    private:
+
+        UnownedTask(const UnownedTask&);
+        UnownedTask& operator=(const UnownedTask&);
+
+    public:
+
+        UnownedTask(Runnable* task) : Runnable(), task(task) {
+        }
+
+        virtual ~UnownedTask() {
+        }
+
+        virtual void run() {
+            this->task->run();
+        }
+    };
+
+    /**
+     * Queue indices are allowed to wrap, so they are only ever compared by distance.
+     */
+    inline int distance(int from, int to) {
+        return (int)((unsigned int)to - (unsigned int)from);
+    }
+
+    inline int advance(int index) {
+        return (int)((unsigned int)index + 1);
+    }
+
+    class TaskArray {
+    private:
+
+        TaskArray(const TaskArray&);
+        TaskArray& operator=(const TaskArray&);
+
+    public:
+
+        const int capacity;
+        const unsigned int mask;
+        decaf::lang::Runnable* volatile* slots;
+
+        TaskArray(int capacity) : capacity(capacity), mask((unsigned int)capacity - 1),
+                                  slots(new decaf::lang::Runnable* volatile[capacity]) {
+        }
+
+        ~TaskArray() {
+            delete [] slots;
+        }
+
+        Runnable* get(int index) const {
+            return this->slots[(unsigned int)index & mask];
+        }
+
+        void set(int index, Runnable* task) {
+            this->slots[(unsigned int)index & mask] = task;
+        }
+    };
+
+    /**
+     * A growable circular array of tasks, based on the Chase-Lev deque, that only its
+     * owning worker pushes onto but that any thread can poll.  Tasks are always polled
+     * from the top, so everyone sees them in the order they were pushed and a poll only
+     * ever races other polls, which the CAS on top resolves.
+     */
+    class WorkQueue {
+    private:
+
+        static const int INITIAL_CAPACITY = 256;
+
+        volatile int top;
+        volatile int bottom;
+        AtomicReference<TaskArray> array;
+
+        // Arrays replaced by a bigger one, thieves may still be reading them.
+        std::vector<TaskArray*> retired;
+
+    private:
+
+        WorkQueue(const WorkQueue&);
+        WorkQueue& operator=(const WorkQueue&);
+
+    public:
+
+        WorkQueue() : top(0), bottom(0), array(new TaskArray(INITIAL_CAPACITY)), retired() {
+        }
+
+        ~WorkQueue() {
+            delete array.get();
+
+            std::vector<TaskArray*>::iterator iter = retired.begin();
+            for (; iter != retired.end(); ++iter) {
+                delete *iter;
+            }
+        }
+
+        /**
+         * Adds a task at the bottom, must only be called by the owning worker.
+         */
+        void push(Runnable* task) {
+            int b = this->bottom;
+            TaskArray* current = this->array.get();
+
+            if (distance(this->top, b) >= current->capacity - 1) {
+                current = grow(current, b);
+            }
+
+            current->set(b, task);
+
+            // The barrier ahead of the swap makes the slot visible before the new bottom.
+            Atomics::getAndSet(&this->bottom, advance(b));
+        }
+
+        /**
+         * Removes the task at the top, may be called from any thread.
+         *
+         * @return the oldest task in the queue or NULL if it is empty.
+         */
+        Runnable* poll() {
+            for (;;) {
+                int t = Atomics::getAndAdd(&this->top, 0);
+                int b = Atomics::getAndAdd(&this->bottom, 0);
+
+                if (distance(t, b) <= 0) {
+                    return NULL;
+                }
+
+                // If the slot was reused after we read top then the CAS fails.
+                Runnable* task = this->array.get()->get(t);
+                if (Atomics::compareAndSet32(&this->top, t, advance(t))) {
+                    return task;
+                }
+            }
+        }
+
+        int size() const {
+            int result = distance(this->top, this->bottom);
+            return result > 0 ? result : 0;
+        }
+
+    private:
+
+        TaskArray* grow(TaskArray* current, int b) {
+            TaskArray* grown = new TaskArray(current->capacity * 2);
+
+            for (int i = this->top; i != b; i = advance(i)) {
+                grown->set(i, current->get(i));
+            }
+
+            this->array.set(grown);
+            this->retired.push_back(current);
+
+            return grown;
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace decaf {
+namespace util {
+namespace concurrent {
+
+    class WorkStealingExecutorKernel {
+    private:
+
+        WorkStealingExecutorKernel(const WorkStealingExecutorKernel&);
+        WorkStealingExecutorKernel& operator= (const WorkStealingExecutorKernel&);
+
+    public:
+
+        class Worker : public Runnable {
+        private:
+
+            Worker(const Worker&);
+            Worker& operator= (const Worker&);
+
+        public:
+
+            WorkStealingExecutorKernel* kernel;
+
+            // Tasks submitted by this worker's own thread.
+            WorkQueue queue;
+
+            // Tasks submitted from threads outside the pool.
+            Mutex inboxLock;
+            LinkedList<Runnable*> inbox;
+            AtomicInteger inboxSize;
+
+            Thread* thread;
+            unsigned int seed;
+            volatile long long steals;
+
+            Worker(WorkStealingExecutorKernel* kernel, int index) :
+                Runnable(), kernel(kernel), queue(), inboxLock(), inbox(), inboxSize(),
+                thread(NULL), seed((unsigned int)(index + 1) * 0x9E3779B9U), steals(0) {
+            }
+
+            virtual ~Worker() {
+                delete thread;
+            }
+
+            virtual void run() {
+                this->kernel->runWorker(this);
+            }
+
+            int nextRandom() {
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed << 5;
+                return (int)(seed & 0x7FFFFFFF);
+            }
+        };
+
+    public:
+
+        static const int RUNNING = 0;
+        static const int SHUTDOWN = 1;
+        static const int STOP = 2;
+
+        WorkStealingExecutor* parent;
+        int parallelism;
+        Pointer<ThreadFactory> threadFactory;
+        std::vector<Worker*> workers;
+
+        AtomicInteger runState;
+
+        // Tasks that have been submitted but not yet taken by a worker.
+        AtomicInteger pending;
+
+        // Workers with nothing to do block on the idle lock.
+        Mutex idleLock;
+        AtomicInteger idleCount;
+
+        Mutex terminationLock;
+        int liveWorkers;
+
+    public:
+
+        WorkStealingExecutorKernel(WorkStealingExecutor* parent, int parallelism, ThreadFactory* threadFactory) :
+            parent(parent), parallelism(parallelism), threadFactory(threadFactory), workers(),
+            runState(RUNNING), pending(), idleLock(), idleCount(), terminationLock(), liveWorkers(0) {
+
+            if (parallelism <= 0) {
+                throw IllegalArgumentException(__FILE__, __LINE__, "Parallelism must be greater than zero");
+            }
+
+            if (threadFactory == NULL) {
+                throw NullPointerException(__FILE__, __LINE__, "ThreadFactory cannot be NULL");
+            }
+
+            try {
+
+                for (int i = 0; i < parallelism; ++i) {
+                    Worker* worker = new Worker(this, i);
+                    workers.push_back(worker);
+                    worker->thread = this->threadFactory->newThread(worker);
+                }
+
+            } catch (...) {
+                std::vector<Worker*>::iterator iter = workers.begin();
+                for (; iter != workers.end(); ++iter) {
+                    delete *iter;
+                }
+                throw;
+            }
+
+            // All threads must be known before any can run, see currentWorker.
+            this->liveWorkers = parallelism;
+            std::vector<Worker*>::iterator iter = workers.begin();
+            for (; iter != workers.end(); ++iter) {
+                (*iter)->thread->start();
+            }
+        }
+
+        ~WorkStealingExecutorKernel() {
+            try {
+
+                std::vector<Worker*>::iterator iter = workers.begin();
+                for (; iter != workers.end(); ++iter) {
+                    (*iter)->thread->join();
+                }
+
+                // Anything left over was submitted while shutdownNow was draining.
+                ArrayList<Runnable*> leftovers;
+                drainQueues(leftovers);
+                Pointer< Iterator<Runnable*> > tasks(leftovers.iterator());
+                while (tasks->hasNext()) {
+                    delete tasks->next();
+                }
+
+                for (iter = workers.begin(); iter != workers.end(); ++iter) {
+                    delete *iter;
+                }
+            }
+            DECAF_CATCHALL_NOTHROW()
+        }
+
+        void execute(Runnable* task, bool takeOwnership) {
+
+            if (task == NULL) {
+                throw NullPointerException(__FILE__, __LINE__, "Runnable task cannot be NULL");
+            }
+
+            Runnable* target = task;
+            if (!takeOwnership) {
+                target = new UnownedTask(task);
+            }
+
+            // Counted before the state check so shutdown can't terminate the
+            // workers while this task is on its way into a queue.
+            pending.incrementAndGet();
+
+            if (runState.get() != RUNNING) {
+                pending.decrementAndGet();
+                signalWork(true);
+                delete target;
+                throw RejectedExecutionException(__FILE__, __LINE__, "Executor has been shut down.");
+            }
+
+            Worker* current = currentWorker();
+            if (current != NULL) {
+                current->queue.push(target);
+            } else {
+                Worker* worker = workers[submitterIndex()];
+                synchronized(&worker->inboxLock) {
+                    worker->inbox.addLast(target);
+                    worker->inboxSize.incrementAndGet();
+                }
+            }
+
+            signalWork(false);
+        }
+
+        void shutdown() {
+            int state = runState.get();
+            while (state < SHUTDOWN && !runState.compareAndSet(state, SHUTDOWN)) {
+                state = runState.get();
+            }
+
+            signalWork(true);
+        }
+
+        void shutdownNow(ArrayList<Runnable*>& unexecutedTasks) {
+            runState.set(STOP);
+            signalWork(true);
+            drainQueues(unexecutedTasks);
+        }
+
+        bool isShutdown() {
+            return runState.get() != RUNNING;
+        }
+
+        bool isTerminated() {
+            if (runState.get() == RUNNING) {
+                return false;
+            }
+
+            bool result = false;
+            synchronized(&terminationLock) {
+                result = liveWorkers == 0;
+            }
+
+            return result;
+        }
+
+        bool awaitTermination() {
+            synchronized(&terminationLock) {
+                while (liveWorkers > 0) {
+                    terminationLock.wait();
+                }
+            }
+
+            return true;
+        }
+
+        bool awaitTermination(long long timeout, const TimeUnit& unit) {
+            long long deadline = System::currentTimeMillis() + unit.toMillis(timeout);
+
+            synchronized(&terminationLock) {
+                while (liveWorkers > 0) {
+                    long long remaining = deadline - System::currentTimeMillis();
+                    if (remaining <= 0) {
+                        return false;
+                    }
+
+                    terminationLock.wait(remaining);
+                }
+            }
+
+            return true;
+        }
+
+        int getQueuedTaskCount() const {
+            int result = pending.get();
+            return result > 0 ? result : 0;
+        }
+
+        long long getStealCount() const {
+            long long result = 0;
+
+            std::vector<Worker*>::const_iterator iter = workers.begin();
+            for (; iter != workers.end(); ++iter) {
+                result += (*iter)->steals;
+            }
+
+            return result;
+        }
+
+        void runWorker(Worker* worker) {
+
+            try {
+
+                while (runState.get() < STOP) {
+
+                    Runnable* task = findTask(worker);
+
+                    if (task == NULL) {
+                        if (!awaitWork()) {
+                            break;
+                        }
+
+                        continue;
+                    }
+
+                    try {
+                        task->run();
+                    } catch (...) {
+                    }
+
+                    try {
+                        delete task;
+                    } catch (...) {
+                    }
+                }
+            } catch (...) {
+            }
+
+            synchronized(&terminationLock) {
+                if (--liveWorkers == 0) {
+                    terminationLock.notifyAll();
+                }
+            }
+        }
+
+    private:
+
+        Worker* currentWorker() const {
+            Thread* current = Thread::currentThread();
+
+            std::vector<Worker*>::const_iterator iter = workers.begin();
+            for (; iter != workers.end(); ++iter) {
+                if ((*iter)->thread == current) {
+                    return *iter;
+                }
+            }
+
+            return NULL;
+        }
+
+        /**
+         * Spreads outside submitters over the workers by thread, so a thread keeps using
+         * the same inbox and different threads rarely share one.
+         */
+        int submitterIndex() const {
+            unsigned long long hash = (unsigned long long)(std::size_t)Thread::currentThread();
+            hash ^= hash >> 17;
+            hash *= 0x9E3779B97F4A7C15ULL;
+            return (int)((hash >> 32) % (unsigned long long)parallelism);
+        }
+
+        void signalWork(bool all) {
+            if (all) {
+                synchronized(&idleLock) {
+                    idleLock.notifyAll();
+                }
+            } else if (idleCount.get() > 0) {
+                synchronized(&idleLock) {
+                    idleLock.notify();
+                }
+            }
+        }
+
+        Runnable* findTask(Worker* worker) {
+
+            Runnable* task = worker->queue.poll();
+
+            if (task == NULL && worker->inboxSize.get() > 0) {
+                // Moving the inbox onto our own queue lets the other workers steal from it.
+                synchronized(&worker->inboxLock) {
+                    while (!worker->inbox.isEmpty()) {
+                        worker->queue.push(worker->inbox.removeFirst());
+                    }
+                    worker->inboxSize.set(0);
+                }
+
+                task = worker->queue.poll();
+            }
+
+            if (task == NULL && parallelism > 1) {
+                task = steal(worker);
+            }
+
+            if (task != NULL) {
+                pending.decrementAndGet();
+            }
+
+            return task;
+        }
+
+        Runnable* steal(Worker* thief) {
+
+            int start = thief->nextRandom() % parallelism;
+
+            for (int i = 0; i < parallelism; ++i) {
+                Worker* victim = workers[(start + i) % parallelism];
+                if (victim == thief) {
+                    continue;
+                }
+
+                Runnable* task = victim->queue.poll();
+
+                if (task == NULL && victim->inboxSize.get() > 0) {
+                    task = pollInbox(victim);
+                }
+
+                if (task != NULL) {
+                    thief->steals++;
+                    return task;
+                }
+            }
+
+            return NULL;
+        }
+
+        Runnable* pollInbox(Worker* worker) {
+            Runnable* task = NULL;
+
+            synchronized(&worker->inboxLock) {
+                if (!worker->inbox.isEmpty()) {
+                    task = worker->inbox.removeFirst();
+                    worker->inboxSize.decrementAndGet();
+                }
+            }
+
+            return task;
+        }
+
+        /**
+         * Blocks until there may be a task to take or the worker should exit.
+         *
+         * @return false if the calling worker should exit.
+         */
+        bool awaitWork() {
+
+            bool result = true;
+            bool retry = false;
+
+            synchronized(&idleLock) {
+
+                // Submitters increment pending before they read idleCount, and we increment
+                // idleCount before we read pending, so one of us always sees the other.
+                idleCount.incrementAndGet();
+
+                for (;;) {
+                    int state = runState.get();
+
+                    if (state >= STOP) {
+                        result = false;
+                        break;
+                    }
+
+                    if (pending.get() > 0) {
+                        // Either another worker is about to take it or the submitter is
+                        // still placing it, look again shortly.
+                        retry = true;
+                        break;
+                    }
+
+                    if (state == SHUTDOWN) {
+                        result = false;
+                        break;
+                    }
+
+                    idleLock.wait();
+                }
+
+                idleCount.decrementAndGet();
+            }
+
+            if (retry) {
+                Thread::yield();
+            }
+
+            return result;
+        }
+
+        void drainQueues(ArrayList<Runnable*>& unexecutedTasks) {
+
+            std::vector<Worker*>::iterator iter = workers.begin();
+            for (; iter != workers.end(); ++iter) {
+                Worker* worker = *iter;
+
+                Runnable* task = NULL;
+                while ((task = worker->queue.poll()) != NULL) {
+                    pending.decrementAndGet();
+                    unexecutedTasks.add(task);
+                }
+
+                while ((task = pollInbox(worker)) != NULL) {
+                    pending.decrementAndGet();
+                    unexecutedTasks.add(task);
+                }
+            }
+        }
+    };
+
+}}}
+
+////////////////////////////////////////////////////////////////////////////////
+WorkStealingExecutor::WorkStealingExecutor(int parallelism) :
+    AbstractExecutorService(), kernel(NULL) {
+
+    try {
+        this->kernel = new WorkStealingExecutorKernel(this, parallelism, Executors::getDefaultThreadFactory());
+    }
+    DECAF_CATCH_RETHROW(IllegalArgumentException)
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WorkStealingExecutor::WorkStealingExecutor(int parallelism, ThreadFactory* threadFactory) :
+    AbstractExecutorService(), kernel(NULL) {
+
+    try {
+
+        if (threadFactory == NULL) {
+            throw NullPointerException(__FILE__, __LINE__, "ThreadFactory cannot be NULL");
+        }
+
+        this->kernel = new WorkStealingExecutorKernel(this, parallelism, threadFactory);
+    }
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(IllegalArgumentException)
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WorkStealingExecutor::~WorkStealingExecutor() {
+
+    try {
+        this->kernel->shutdown();
+        this->kernel->awaitTermination();
+        delete this->kernel;
+    }
+    DECAF_CATCHALL_NOTHROW()
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutor::execute(Runnable* task) {
+
+    try {
+        this->kernel->execute(task, true);
+    }
+    DECAF_CATCH_RETHROW(RejectedExecutionException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutor::execute(Runnable* task, bool takeOwnership) {
+
+    try {
+        this->kernel->execute(task, takeOwnership);
+    }
+    DECAF_CATCH_RETHROW(RejectedExecutionException)
+    DECAF_CATCH_RETHROW(NullPointerException)
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutor::shutdown() {
+
+    try {
+        this->kernel->shutdown();
+    }
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ArrayList<Runnable*> WorkStealingExecutor::shutdownNow() {
+
+    ArrayList<Runnable*> result;
+
+    try {
+        this->kernel->shutdownNow(result);
+        return result;
+    }
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool WorkStealingExecutor::awaitTermination(long long timeout, const TimeUnit& unit) {
+
+    try {
+        return this->kernel->awaitTermination(timeout, unit);
+    }
+    DECAF_CATCH_RETHROW(Exception)
+    DECAF_CATCHALL_THROW(Exception)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool WorkStealingExecutor::isShutdown() const {
+    return this->kernel->isShutdown();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool WorkStealingExecutor::isTerminated() const {
+    return this->kernel->isTerminated();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int WorkStealingExecutor::getParallelism() const {
+    return this->kernel->parallelism;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int WorkStealingExecutor::getQueuedTaskCount() const {
+    return this->kernel->getQueuedTaskCount();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long WorkStealingExecutor::getStealCount() const {
+    return this->kernel->getStealCount();
+}
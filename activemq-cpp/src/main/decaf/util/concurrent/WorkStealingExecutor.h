@@ -0,0 +1,131 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_WORKSTEALINGEXECUTOR_H_
+#define _DECAF_UTIL_CONCURRENT_WORKSTEALINGEXECUTOR_H_
+
+#include <decaf/lang/Runnable.h>
+#include <decaf/util/concurrent/ThreadFactory.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+#include <decaf/util/concurrent/AbstractExecutorService.h>
+#include <decaf/util/concurrent/RejectedExecutionException.h>
+#include <decaf/util/ArrayList.h>
+#include <decaf/util/Config.h>
+
+namespace decaf {
+namespace util {
+namespace concurrent {
+
+    class WorkStealingExecutorKernel;
+
+    /**
+     * An ExecutorService that runs its tasks on a fixed set of worker threads which each
+     * keep their own queue of tasks, in the style of the Java ForkJoinPool in async mode.
+     *
+     * A task submitted from one of the pool's own threads is pushed onto that worker's
+     * queue without taking any lock.  A task submitted from any other thread is handed to
+     * one of the workers picked from the submitting thread, so unrelated submitters don't
+     * contend with each other.  A worker that runs out of tasks steals from the other
+     * workers, starting at a random one, before it goes idle.  Tasks are taken from a
+     * queue in the order they were added, whether by the owner or by a thief.
+     *
+     * Unlike the ThreadPoolExecutor all worker threads are started when the executor is
+     * created and remain until it is shut down.
+     *
+     * @since 1.0
+     */
+    class DECAF_API WorkStealingExecutor : public AbstractExecutorService {
+    private:
+
+        WorkStealingExecutor(const WorkStealingExecutor&);
+        WorkStealingExecutor& operator= (const WorkStealingExecutor&);
+
+    private:
+
+        friend class WorkStealingExecutorKernel;
+        WorkStealingExecutorKernel* kernel;
+
+    public:
+
+        /**
+         * Creates a new WorkStealingExecutor with the given number of worker threads which
+         * are created by the default ThreadFactory.
+         *
+         * @param parallelism
+         *      The number of worker threads.
+         *
+         * @throws IllegalArgumentException if parallelism is less than or equal to zero.
+         */
+        WorkStealingExecutor(int parallelism);
+
+        /**
+         * Creates a new WorkStealingExecutor with the given number of worker threads.
+         *
+         * @param parallelism
+         *      The number of worker threads.
+         * @param threadFactory
+         *      A ThreadFactory implementation that will be used to create the worker
+         *      threads.  The Executor takes ownership of the ThreadFactory instance
+         *      passed once this method returns.
+         *
+         * @throws IllegalArgumentException if parallelism is less than or equal to zero.
+         * @throws NullPointerException if the threadFactory pointer is NULL.
+         */
+        WorkStealingExecutor(int parallelism, ThreadFactory* threadFactory);
+
+        virtual ~WorkStealingExecutor();
+
+        virtual void execute(decaf::lang::Runnable* task);
+
+        virtual void execute(decaf::lang::Runnable* task, bool takeOwnership);
+
+        virtual void shutdown();
+
+        virtual ArrayList<decaf::lang::Runnable*> shutdownNow();
+
+        virtual bool awaitTermination(long long timeout, const decaf::util::concurrent::TimeUnit& unit);
+
+        virtual bool isShutdown() const;
+
+        virtual bool isTerminated() const;
+
+        /**
+         * @return the number of worker threads in this executor.
+         */
+        int getParallelism() const;
+
+        /**
+         * Returns an estimate of the number of tasks that have been submitted but not yet
+         * started by one of the worker threads.
+         *
+         * @return the approximate number of queued tasks.
+         */
+        int getQueuedTaskCount() const;
+
+        /**
+         * Returns an estimate of the number of tasks that were run by a worker other than
+         * the one whose queue they were placed on.
+         *
+         * @return the approximate number of stolen tasks.
+         */
+        long long getStealCount() const;
+
+    };
+
+}}}
+
+#endif /* _DECAF_UTIL_CONCURRENT_WORKSTEALINGEXECUTOR_H_ */
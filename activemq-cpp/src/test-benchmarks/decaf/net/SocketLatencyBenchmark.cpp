@@ -0,0 +1,158 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SocketLatencyBenchmark.h"
+
+#include <decaf/lang/System.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/io/IOException.h>
+
+#include <iostream>
+
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::net;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    const int ROUND_TRIPS = 1000;
+
+    // The spin time given to the spinning client, in microseconds.
+    const int RECEIVE_SPIN_TIME = 200;
+
+    class EchoRunnable : public Runnable {
+    private:
+
+        Socket* socket;
+
+    private:
+
+        EchoRunnable(const EchoRunnable&);
+        EchoRunnable& operator= (const EchoRunnable&);
+
+    public:
+
+        EchoRunnable(Socket* socket) : Runnable(), socket(socket) {}
+        virtual ~EchoRunnable() {}
+
+        virtual void run() {
+            try {
+                InputStream* in = socket->getInputStream();
+                OutputStream* out = socket->getOutputStream();
+
+                int value = 0;
+                while ((value = in->read()) != -1) {
+                    out->write((unsigned char) value);
+                }
+            } catch (IOException& ex) {
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SocketLatencyBenchmark::SocketLatencyBenchmark() :
+    server(NULL), blockingClient(NULL), spinningClient(NULL), echoSockets(), echoRunnables(), echoThreads(),
+    blockingTime(0), spinningTime(0), roundTrips(0) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+SocketLatencyBenchmark::~SocketLatencyBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SocketLatencyBenchmark::setUp() {
+
+    server = new ServerSocket(0);
+
+    blockingClient = connect();
+    spinningClient = connect();
+    spinningClient->setReceiveSpinTime(RECEIVE_SPIN_TIME);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SocketLatencyBenchmark::tearDown() {
+
+    if (roundTrips > 0) {
+        std::cout << "Loopback round trip, blocking read = "
+                  << (double) blockingTime / roundTrips / 1000 << " Microsecs, spinning read = "
+                  << (double) spinningTime / roundTrips / 1000 << " Microsecs"
+                  << std::endl;
+    }
+
+    blockingClient->close();
+    spinningClient->close();
+
+    for (std::size_t i = 0; i < echoThreads.size(); ++i) {
+        echoThreads[i]->join();
+        delete echoThreads[i];
+        delete echoRunnables[i];
+        delete echoSockets[i];
+    }
+
+    delete blockingClient;
+    delete spinningClient;
+
+    server->close();
+    delete server;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+Socket* SocketLatencyBenchmark::connect() {
+
+    Socket* client = new Socket("127.0.0.1", server->getLocalPort());
+    client->setTcpNoDelay(true);
+
+    Socket* echo = server->accept();
+    echo->setTcpNoDelay(true);
+
+    Runnable* runnable = new EchoRunnable(echo);
+    Thread* thread = new Thread(runnable);
+    thread->start();
+
+    echoSockets.push_back(echo);
+    echoRunnables.push_back(runnable);
+    echoThreads.push_back(thread);
+
+    return client;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long SocketLatencyBenchmark::pingPong(Socket* socket, int count) {
+
+    InputStream* in = socket->getInputStream();
+    OutputStream* out = socket->getOutputStream();
+
+    long long start = System::nanoTime();
+
+    for (int i = 0; i < count; ++i) {
+        out->write((unsigned char) i);
+        in->read();
+    }
+
+    return System::nanoTime() - start;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SocketLatencyBenchmark::run() {
+
+    blockingTime += pingPong(blockingClient, ROUND_TRIPS);
+    spinningTime += pingPong(spinningClient, ROUND_TRIPS);
+    roundTrips += ROUND_TRIPS;
+}
@@ -0,0 +1,77 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_NET_SOCKETLATENCYBENCHMARK_H_
+#define _DECAF_NET_SOCKETLATENCYBENCHMARK_H_
+
+#include <benchmark/BenchmarkBase.h>
+#include <decaf/net/Socket.h>
+#include <decaf/net/ServerSocket.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/Thread.h>
+
+#include <vector>
+
+namespace decaf {
+namespace net {
+
+    /**
+     * Measures the round trip time of a one byte ping pong over loopback for a
+     * socket that blocks in its reads and one that spins before blocking.
+     */
+    class SocketLatencyBenchmark :
+        public benchmark::BenchmarkBase<
+            decaf::net::SocketLatencyBenchmark, Socket, 10 > {
+    private:
+
+        ServerSocket* server;
+        Socket* blockingClient;
+        Socket* spinningClient;
+        std::vector<Socket*> echoSockets;
+        std::vector<decaf::lang::Runnable*> echoRunnables;
+        std::vector<decaf::lang::Thread*> echoThreads;
+
+        long long blockingTime;
+        long long spinningTime;
+        long long roundTrips;
+
+    private:
+
+        SocketLatencyBenchmark(const SocketLatencyBenchmark&);
+        SocketLatencyBenchmark& operator= (const SocketLatencyBenchmark&);
+
+    public:
+
+        SocketLatencyBenchmark();
+        virtual ~SocketLatencyBenchmark();
+
+        virtual void setUp();
+        virtual void tearDown();
+
+        virtual void run();
+
+    private:
+
+        Socket* connect();
+
+        long long pingPong(Socket* socket, int count);
+
+    };
+
+}}
+
+#endif /* _DECAF_NET_SOCKETLATENCYBENCHMARK_H_ */
@@ -0,0 +1,122 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ArrayDequeBenchmark.h"
+
+#include <decaf/lang/Integer.h>
+#include <decaf/util/Iterator.h>
+
+using namespace decaf;
+using namespace decaf::util;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+ArrayDequeBenchmark::ArrayDequeBenchmark() : intDeque(), stringDeque() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ArrayDequeBenchmark::~ArrayDequeBenchmark() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeBenchmark::run(){
+
+    int numRuns = 500;
+    std::string test = "test";
+    std::string tempStr = "";
+    int tempInt = 0;
+    ArrayDeque<std::string> stringCopy;
+    ArrayDeque<int> intCopy;
+
+    // FIFO use, the way a dispatch queue drains, keeping a short backlog so the
+    // head wraps around the array many times.
+    for( int i = 0; i < numRuns * 10; ++i ) {
+        stringDeque.offer( test + Integer::toString(i) );
+        intDeque.offer( 100 + i );
+
+        if( i % 4 != 0 ) {
+            stringDeque.poll( tempStr );
+            intDeque.poll( tempInt );
+        }
+    }
+
+    while( stringDeque.poll( tempStr ) ) {}
+    while( intDeque.poll( tempInt ) ) {}
+
+    // LIFO use.
+    for( int i = 0; i < numRuns; ++i ) {
+        stringDeque.push( test + Integer::toString(i) );
+        intDeque.push( 100 + i );
+    }
+
+    for( int i = 0; i < numRuns; ++i ) {
+        tempStr = stringDeque.pop();
+        tempInt = intDeque.pop();
+    }
+
+    for( int i = 0; i < numRuns; ++i ) {
+        stringDeque.add( test + Integer::toString(i) );
+        intDeque.add( 100 + i );
+        stringDeque.contains( test + Integer::toString(i) );
+        intDeque.contains( 100 + i );
+    }
+
+    for( int i = 0; i < numRuns; ++i ) {
+        stringDeque.remove( test + Integer::toString(i) );
+        intDeque.remove( 100 + i );
+    }
+
+    for( int i = 0; i < numRuns; ++i ) {
+        stringDeque.addLast( test + Integer::toString(i) );
+        intDeque.addFirst( 100 + i );
+    }
+
+    std::vector<std::string> stringVec;
+    std::vector<int> intVec;
+
+    for( int i = 0; i < numRuns / 2; ++i ) {
+        stringVec = stringDeque.toArray();
+        intVec = intDeque.toArray();
+    }
+
+    for( int i = 0; i < numRuns / 2; ++i ) {
+
+        Iterator<std::string>* strIter = stringDeque.iterator();
+        Iterator<int>* intIter = intDeque.descendingIterator();
+
+        while( strIter->hasNext() ){
+            tempStr = strIter->next();
+        }
+
+        while( intIter->hasNext() ){
+            intIter->next();
+        }
+
+        delete strIter;
+        delete intIter;
+    }
+
+    for( int i = 0; i < numRuns / 2; ++i ) {
+        stringCopy.copy( stringDeque );
+        stringCopy.clear();
+        intCopy.copy( intDeque );
+        intCopy.clear();
+    }
+
+    stringDeque.clear();
+    intDeque.clear();
+}
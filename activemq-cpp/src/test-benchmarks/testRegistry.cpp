@@ -23,6 +23,9 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::lang::BooleanBenchmark );
 #include <decaf/lang/ThreadBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::lang::ThreadBenchmark );
 
+#include <decaf/net/SocketLatencyBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::net::SocketLatencyBenchmark );
+
 #include <decaf/util/PropertiesBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::PropertiesBenchmark );
 #include <decaf/util/QueueBenchmark.h>
@@ -35,6 +38,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::StlMapBenchmark );
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::HashMapBenchmark );
 #include <decaf/util/StlListBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::StlListBenchmark );
+#include <decaf/util/ArrayDequeBenchmark.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::ArrayDequeBenchmark );
 #include <decaf/util/LinkedListBenchmark.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::LinkedListBenchmark );
 
@@ -818,3 +818,45 @@ void ActiveMQMessageTest::testIsExpired() {
     msg.setCMSExpiration( System::currentTimeMillis() + 10000 );
     CPPUNIT_ASSERT( !msg.isExpired() );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQMessageTest::testLazyPropertyUnmarshal() {
+
+    ActiveMQMessage msg;
+    msg.setStringProperty( "name", "value" );
+    msg.setIntProperty( "count", 42 );
+    msg.beforeMarshal( NULL );
+
+    std::vector<unsigned char> marshalled = msg.getMarshalledProperties();
+    CPPUNIT_ASSERT( !marshalled.empty() );
+
+    // Simulate a received message, the properties stay marshaled until used.
+    ActiveMQMessage received;
+    received.setMarshalledProperties( marshalled );
+    received.afterUnmarshal( NULL );
+
+    // Sending it on again doesn't need the properties to be unmarshaled.
+    received.beforeMarshal( NULL );
+    CPPUNIT_ASSERT( marshalled == received.getMarshalledProperties() );
+
+    // A copy made before the properties were read can still read them.
+    Pointer<Message> copy = received.copy();
+
+    CPPUNIT_ASSERT( received.propertyExists( "name" ) );
+    CPPUNIT_ASSERT_EQUAL( std::string( "value" ), received.getStringProperty( "name" ) );
+    CPPUNIT_ASSERT_EQUAL( 42, received.getIntProperty( "count" ) );
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 2, received.getPropertyNames().size() );
+
+    CPPUNIT_ASSERT_EQUAL( 42, copy->getMessageProperties().getInt( "count" ) );
+    CPPUNIT_ASSERT_EQUAL( std::string( "value" ), copy->getMessageProperties().getString( "name" ) );
+
+    // Once unmarshaled, changes are marshaled again before sending.
+    received.setReadOnlyProperties( false );
+    received.setIntProperty( "count", 43 );
+    received.beforeMarshal( NULL );
+
+    ActiveMQMessage resent;
+    resent.setMarshalledProperties( received.getMarshalledProperties() );
+    resent.afterUnmarshal( NULL );
+    CPPUNIT_ASSERT_EQUAL( 43, resent.getIntProperty( "count" ) );
+}
@@ -21,6 +21,7 @@
 #include <activemq/transport/mock/MockTransportFactory.h>
 #include <activemq/transport/TransportRegistry.h>
 #include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/ActiveMQTopic.h>
 #include <activemq/commands/ConsumerId.h>
 #include <activemq/commands/MessageDispatch.h>
 #include <activemq/core/ActiveMQConnectionFactory.h>
@@ -33,6 +34,8 @@
 #include <decaf/lang/Thread.h>
 #include <decaf/net/Socket.h>
 #include <decaf/net/ServerSocket.h>
+#include <decaf/util/concurrent/atomic/AtomicBoolean.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
 
 using namespace std;
 using namespace activemq;
@@ -658,6 +661,135 @@ void ActiveMQSessionTest::testTransactionCommitAfterConsumerClosed() {
     msgListener1.clear();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    /**
+     * Counts its own destruction so a test can tell whether the Session still holds a
+     * reference to it after it was closed.
+     */
+    class CountingConsumerKernel : public kernels::ActiveMQConsumerKernel {
+    private:
+
+        decaf::util::concurrent::atomic::AtomicInteger* destroyed;
+
+        CountingConsumerKernel(const CountingConsumerKernel&);
+        CountingConsumerKernel& operator= (const CountingConsumerKernel&);
+
+    public:
+
+        CountingConsumerKernel(kernels::ActiveMQSessionKernel* session,
+                               decaf::util::concurrent::atomic::AtomicInteger* destroyed) :
+            kernels::ActiveMQConsumerKernel(session, session->getNextConsumerId(),
+                                            Pointer<ActiveMQDestination>(new ActiveMQTopic("TestTopic2")),
+                                            "", "", 1000, 0, false, false, false, NULL),
+            destroyed(destroyed) {
+        }
+
+        virtual ~CountingConsumerKernel() {
+            destroyed->incrementAndGet();
+        }
+    };
+
+    /**
+     * Adds and closes a consumer on the Session for every message it is given.
+     */
+    class ChurningListener : public cms::MessageListener {
+    private:
+
+        kernels::ActiveMQSessionKernel* session;
+
+        ChurningListener(const ChurningListener&);
+        ChurningListener& operator= (const ChurningListener&);
+
+    public:
+
+        decaf::util::concurrent::atomic::AtomicInteger received;
+        decaf::util::concurrent::atomic::AtomicInteger destroyed;
+
+        ChurningListener(kernels::ActiveMQSessionKernel* session) :
+            session(session), received(), destroyed() {}
+
+        virtual ~ChurningListener() {}
+
+        virtual void onMessage(const cms::Message* message AMQCPP_UNUSED) {
+            Pointer<kernels::ActiveMQConsumerKernel> consumer(new CountingConsumerKernel(session, &destroyed));
+            session->addConsumer(consumer);
+            consumer->close();
+            received.incrementAndGet();
+        }
+    };
+
+    /**
+     * Keeps reading the Session's consumers from another thread the way its executor
+     * does so that a snapshot is almost always held while consumers change.
+     */
+    class ConsumerIterator : public Thread {
+    private:
+
+        kernels::ActiveMQSessionKernel* session;
+
+        ConsumerIterator(const ConsumerIterator&);
+        ConsumerIterator& operator= (const ConsumerIterator&);
+
+    public:
+
+        decaf::util::concurrent::atomic::AtomicBoolean done;
+
+        ConsumerIterator(kernels::ActiveMQSessionKernel* session) : Thread(), session(session), done(false) {}
+
+        virtual ~ConsumerIterator() {}
+
+        virtual void run() {
+            while (!done.get()) {
+                session->iterateConsumers();
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ActiveMQSessionTest::testConsumerChurnDuringDispatch() {
+
+    static const int MSG_COUNT = 100;
+
+    CPPUNIT_ASSERT(connection.get() != NULL);
+
+    std::auto_ptr<cms::Session> session(connection->createSession());
+    std::auto_ptr<cms::Topic> topic1(session->createTopic("TestTopic1"));
+
+    decaf::util::ArrayList< Pointer<kernels::ActiveMQSessionKernel> > sessions = connection->getSessions();
+    CPPUNIT_ASSERT_EQUAL(1, sessions.size());
+    Pointer<kernels::ActiveMQSessionKernel> kernel = sessions.get(0);
+
+    ChurningListener listener(kernel.get());
+    std::auto_ptr<ActiveMQConsumer> consumer(
+        dynamic_cast<ActiveMQConsumer*>(session->createConsumer(topic1.get())));
+    consumer->setMessageListener(&listener);
+
+    ConsumerIterator iterator(kernel.get());
+    iterator.start();
+
+    for (int i = 0; i < MSG_COUNT; ++i) {
+        injectTextMessage("This is a Test 1", *topic1, *(consumer->getConsumerId()));
+    }
+
+    for (int i = 0; i < 100 && listener.received.get() < MSG_COUNT; ++i) {
+        Thread::sleep(50);
+    }
+
+    iterator.done.set(true);
+    iterator.join();
+
+    CPPUNIT_ASSERT_EQUAL(MSG_COUNT, listener.received.get());
+
+    // Only the snapshot published last is still around and it no longer holds any of
+    // the closed consumers.
+    CPPUNIT_ASSERT_EQUAL(MSG_COUNT, listener.destroyed.get());
+
+    consumer->close();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void ActiveMQSessionTest::testCreateTempQueueByName() {
 
@@ -51,6 +51,7 @@ namespace core{
         CPPUNIT_TEST( testCreateManyConsumersAndSetListeners );
         CPPUNIT_TEST( testCreateTempQueueByName );
         CPPUNIT_TEST( testCreateTempTopicByName );
+        CPPUNIT_TEST( testConsumerChurnDuringDispatch );
         CPPUNIT_TEST_SUITE_END();
 
     private:
@@ -98,6 +99,7 @@ namespace core{
         void testAutoAcking();
         void testClientAck();
         void testCreateManyConsumersAndSetListeners();
+        void testConsumerChurnDuringDispatch();
         void testTransactionCommitOneConsumer();
         void testTransactionCommitTwoConsumer();
         void testTransactionRollbackOneConsumer();
@@ -0,0 +1,257 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DeliveredMessageListTest.h"
+
+#include <activemq/core/DeliveredMessageList.h>
+#include <activemq/commands/Message.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/ProducerId.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/util/ArrayList.h>
+#include <decaf/util/NoSuchElementException.h>
+
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    Pointer<MessageId> createMessageId(long long sequenceId) {
+        Pointer<ProducerId> producerId(new ProducerId);
+        producerId->setConnectionId("test");
+        producerId->setSessionId(1);
+        producerId->setValue(1);
+
+        Pointer<MessageId> id(new MessageId);
+        id->setProducerId(producerId);
+        id->setProducerSequenceId(sequenceId);
+        return id;
+    }
+
+    Pointer<MessageDispatch> createDispatch(long long sequenceId) {
+        Pointer<Message> message(new Message);
+        message->setMessageId(createMessageId(sequenceId));
+
+        Pointer<MessageDispatch> dispatch(new MessageDispatch);
+        dispatch->setMessage(message);
+        return dispatch;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DeliveredMessageListTest::testCtor() {
+
+    DeliveredMessageList list;
+    CPPUNIT_ASSERT(list.isEmpty());
+    CPPUNIT_ASSERT_EQUAL(0, list.size());
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NoSuchElementException",
+        list.getFirst(),
+        NoSuchElementException);
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NoSuchElementException",
+        list.removeLast(),
+        NoSuchElementException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DeliveredMessageListTest::testAddFirstOrdering() {
+
+    DeliveredMessageList list;
+    Pointer<MessageDispatch> dispatch1 = createDispatch(1);
+    Pointer<MessageDispatch> dispatch2 = createDispatch(2);
+    Pointer<MessageDispatch> dispatch3 = createDispatch(3);
+
+    list.addFirst(dispatch1);
+    list.addFirst(dispatch2);
+    list.addFirst(dispatch3);
+
+    CPPUNIT_ASSERT_EQUAL(3, list.size());
+    CPPUNIT_ASSERT(list.getFirst() == dispatch3);
+    CPPUNIT_ASSERT(list.getLast() == dispatch1);
+
+    Pointer< Iterator< Pointer<MessageDispatch> > > iter(list.iterator());
+    CPPUNIT_ASSERT(iter->next() == dispatch3);
+    CPPUNIT_ASSERT(iter->next() == dispatch2);
+    CPPUNIT_ASSERT(iter->next() == dispatch1);
+    CPPUNIT_ASSERT(!iter->hasNext());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DeliveredMessageListTest::testContains() {
+
+    DeliveredMessageList list;
+    Pointer<MessageDispatch> dispatch1 = createDispatch(1);
+    Pointer<MessageDispatch> dispatch2 = createDispatch(2);
+
+    list.addFirst(dispatch1);
+
+    CPPUNIT_ASSERT(list.contains(dispatch1));
+    CPPUNIT_ASSERT(!list.contains(dispatch2));
+
+    // A different dispatch of a message with the same id is not the same entry.
+    CPPUNIT_ASSERT(!list.contains(createDispatch(1)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DeliveredMessageListTest::testRemove() {
+
+    DeliveredMessageList list;
+    Pointer<MessageDispatch> dispatch1 = createDispatch(1);
+    Pointer<MessageDispatch> dispatch2 = createDispatch(2);
+    Pointer<MessageDispatch> dispatch3 = createDispatch(3);
+
+    list.addFirst(dispatch1);
+    list.addFirst(dispatch2);
+    list.addFirst(dispatch3);
+
+    CPPUNIT_ASSERT(list.remove(dispatch2));
+    CPPUNIT_ASSERT(!list.remove(dispatch2));
+    CPPUNIT_ASSERT(!list.contains(dispatch2));
+    CPPUNIT_ASSERT_EQUAL(2, list.size());
+    CPPUNIT_ASSERT(list.getFirst() == dispatch3);
+    CPPUNIT_ASSERT(list.getLast() == dispatch1);
+
+    CPPUNIT_ASSERT(list.remove(dispatch3));
+    CPPUNIT_ASSERT(list.remove(dispatch1));
+    CPPUNIT_ASSERT(list.isEmpty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DeliveredMessageListTest::testRemoveLast() {
+
+    DeliveredMessageList list;
+    Pointer<MessageDispatch> dispatch1 = createDispatch(1);
+    Pointer<MessageDispatch> dispatch2 = createDispatch(2);
+
+    list.addFirst(dispatch1);
+    list.addFirst(dispatch2);
+
+    CPPUNIT_ASSERT(list.removeLast() == dispatch1);
+    CPPUNIT_ASSERT(!list.contains(dispatch1));
+    CPPUNIT_ASSERT(list.removeLast() == dispatch2);
+    CPPUNIT_ASSERT(list.isEmpty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DeliveredMessageListTest::testRemoveByMessageId() {
+
+    DeliveredMessageList list;
+    Pointer<MessageDispatch> dispatch1 = createDispatch(1);
+    Pointer<MessageDispatch> dispatch2 = createDispatch(2);
+
+    list.addFirst(dispatch1);
+    list.addFirst(dispatch2);
+
+    // Looked up by value, not by the MessageId instance held in the message.
+    CPPUNIT_ASSERT(list.removeByMessageId(*createMessageId(1)) == dispatch1);
+    CPPUNIT_ASSERT(list.removeByMessageId(*createMessageId(1)) == NULL);
+    CPPUNIT_ASSERT(list.removeByMessageId(*createMessageId(3)) == NULL);
+    CPPUNIT_ASSERT_EQUAL(1, list.size());
+    CPPUNIT_ASSERT(list.getFirst() == dispatch2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DeliveredMessageListTest::testIteratorRemove() {
+
+    DeliveredMessageList list;
+    for (int i = 0; i < 10; ++i) {
+        list.addLast(createDispatch(i));
+    }
+
+    Pointer< Iterator< Pointer<MessageDispatch> > > iter(list.iterator());
+    while (iter->hasNext()) {
+        Pointer<MessageDispatch> dispatch = iter->next();
+        if (dispatch->getMessage()->getMessageId()->getProducerSequenceId() % 2 == 0) {
+            iter->remove();
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(5, list.size());
+    CPPUNIT_ASSERT(list.removeByMessageId(*createMessageId(4)) == NULL);
+    CPPUNIT_ASSERT(list.removeByMessageId(*createMessageId(5)) != NULL);
+    CPPUNIT_ASSERT_EQUAL(1LL, list.getFirst()->getMessage()->getMessageId()->getProducerSequenceId());
+    CPPUNIT_ASSERT_EQUAL(9LL, list.getLast()->getMessage()->getMessageId()->getProducerSequenceId());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DeliveredMessageListTest::testDuplicateMessageIds() {
+
+    DeliveredMessageList list;
+    Pointer<MessageDispatch> dispatch1 = createDispatch(1);
+    Pointer<MessageDispatch> duplicate = createDispatch(1);
+
+    list.addFirst(dispatch1);
+    list.addFirst(duplicate);
+
+    CPPUNIT_ASSERT_EQUAL(2, list.size());
+    CPPUNIT_ASSERT(list.contains(dispatch1));
+    CPPUNIT_ASSERT(list.contains(duplicate));
+
+    CPPUNIT_ASSERT(list.remove(dispatch1));
+    CPPUNIT_ASSERT(!list.contains(dispatch1));
+    CPPUNIT_ASSERT(list.contains(duplicate));
+
+    CPPUNIT_ASSERT(list.removeByMessageId(*createMessageId(1)) == duplicate);
+    CPPUNIT_ASSERT(list.isEmpty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DeliveredMessageListTest::testDispatchWithoutMessage() {
+
+    DeliveredMessageList list;
+    Pointer<MessageDispatch> empty(new MessageDispatch);
+    Pointer<MessageDispatch> dispatch1 = createDispatch(1);
+
+    list.addFirst(empty);
+    list.addFirst(dispatch1);
+
+    CPPUNIT_ASSERT(list.contains(empty));
+    CPPUNIT_ASSERT(list.remove(empty));
+    CPPUNIT_ASSERT(!list.contains(empty));
+    CPPUNIT_ASSERT_EQUAL(1, list.size());
+    CPPUNIT_ASSERT(list.getLast() == dispatch1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void DeliveredMessageListTest::testCopy() {
+
+    DeliveredMessageList list;
+    Pointer<MessageDispatch> dispatch1 = createDispatch(1);
+    Pointer<MessageDispatch> dispatch2 = createDispatch(2);
+
+    list.addFirst(dispatch1);
+    list.addFirst(dispatch2);
+
+    ArrayList< Pointer<MessageDispatch> > copy;
+    copy.copy(list);
+
+    CPPUNIT_ASSERT_EQUAL(2, copy.size());
+    CPPUNIT_ASSERT(copy.get(0) == dispatch2);
+    CPPUNIT_ASSERT(copy.get(1) == dispatch1);
+
+    list.clear();
+    CPPUNIT_ASSERT(list.isEmpty());
+    CPPUNIT_ASSERT(!list.contains(dispatch1));
+    CPPUNIT_ASSERT(list.removeByMessageId(*createMessageId(2)) == NULL);
+}
@@ -0,0 +1,410 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "IndexedPriorityMessageDispatchChannelTest.h"
+
+#include <activemq/core/IndexedPriorityMessageDispatchChannel.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/System.h>
+
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    Pointer<MessageDispatch> createDispatch(unsigned char priority, int sequence) {
+        Pointer<Message> message(new Message());
+        message->setPriority(priority);
+
+        Pointer<MessageDispatch> dispatch(new MessageDispatch());
+        dispatch->setMessage(message);
+        dispatch->setRedeliveryCounter(sequence);
+        return dispatch;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannelTest::testCtor() {
+
+    IndexedPriorityMessageDispatchChannel channel;
+    CPPUNIT_ASSERT( channel.isRunning() == false );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+    CPPUNIT_ASSERT( channel.size() == 0 );
+    CPPUNIT_ASSERT( channel.isClosed() == false );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannelTest::testStart() {
+
+    IndexedPriorityMessageDispatchChannel channel;
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannelTest::testStop() {
+
+    IndexedPriorityMessageDispatchChannel channel;
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+    channel.stop();
+    CPPUNIT_ASSERT( channel.isRunning() == false );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannelTest::testClose() {
+
+    IndexedPriorityMessageDispatchChannel channel;
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+    CPPUNIT_ASSERT( channel.isClosed() == false );
+    channel.close();
+    CPPUNIT_ASSERT( channel.isRunning() == false );
+    CPPUNIT_ASSERT( channel.isClosed() == true );
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == false );
+    CPPUNIT_ASSERT( channel.isClosed() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannelTest::testEnqueue() {
+
+    IndexedPriorityMessageDispatchChannel channel;
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+    CPPUNIT_ASSERT( channel.size() == 0 );
+
+    channel.enqueue( dispatch1 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 1 );
+
+    channel.enqueue( dispatch2 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 2 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannelTest::testEnqueueFront() {
+
+    IndexedPriorityMessageDispatchChannel channel;
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+
+    Pointer<Message> message1( new Message() );
+    Pointer<Message> message2( new Message() );
+
+    message1->setPriority( 2 );
+    message2->setPriority( 1 );
+
+    dispatch1->setMessage( message1 );
+    dispatch2->setMessage( message2 );
+
+    channel.start();
+
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+    CPPUNIT_ASSERT( channel.size() == 0 );
+
+    channel.enqueueFirst( dispatch1 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 1 );
+
+    channel.enqueueFirst( dispatch2 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 2 );
+
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch1 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch2 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannelTest::testPeek() {
+
+    IndexedPriorityMessageDispatchChannel channel;
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+
+    Pointer<Message> message1( new Message() );
+    Pointer<Message> message2( new Message() );
+
+    message1->setPriority( 2 );
+    message2->setPriority( 1 );
+
+    dispatch1->setMessage( message1 );
+    dispatch2->setMessage( message2 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+    CPPUNIT_ASSERT( channel.size() == 0 );
+
+    channel.enqueueFirst( dispatch1 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 1 );
+
+    channel.enqueueFirst( dispatch2 );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 2 );
+
+    CPPUNIT_ASSERT( channel.peek() == NULL );
+
+    channel.start();
+
+    CPPUNIT_ASSERT( channel.peek() == dispatch1 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch1 );
+    CPPUNIT_ASSERT( channel.peek() == dispatch2 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch2 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannelTest::testDequeueNoWait() {
+
+    IndexedPriorityMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    Pointer<Message> message1( new Message() );
+    Pointer<Message> message2( new Message() );
+    Pointer<Message> message3( new Message() );
+
+    message1->setPriority( 2 );
+    message2->setPriority( 3 );
+    message3->setPriority( 1 );
+
+    dispatch1->setMessage( message1 );
+    dispatch2->setMessage( message2 );
+    dispatch3->setMessage( message3 );
+
+    CPPUNIT_ASSERT( channel.isRunning() == false );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == NULL );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == NULL );
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 3 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch2 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch1 );
+    CPPUNIT_ASSERT( channel.dequeueNoWait() == dispatch3 );
+
+    CPPUNIT_ASSERT( channel.size() == 0 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannelTest::testDequeue() {
+
+    IndexedPriorityMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    Pointer<Message> message1( new Message() );
+    Pointer<Message> message2( new Message() );
+    Pointer<Message> message3( new Message() );
+
+    message1->setPriority( 2 );
+    message2->setPriority( 3 );
+    message3->setPriority( 1 );
+
+    dispatch1->setMessage( message1 );
+    dispatch2->setMessage( message2 );
+    dispatch3->setMessage( message3 );
+
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+
+    long long timeStarted = System::currentTimeMillis();
+
+    CPPUNIT_ASSERT( channel.dequeue( 1000 ) == NULL );
+
+    CPPUNIT_ASSERT( System::currentTimeMillis() - timeStarted >= 999 );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 3 );
+    CPPUNIT_ASSERT( channel.dequeue( -1 ) == dispatch2 );
+    CPPUNIT_ASSERT( channel.dequeue( 0 ) == dispatch1 );
+    CPPUNIT_ASSERT( channel.dequeue( 1000 ) == dispatch3 );
+
+    CPPUNIT_ASSERT( channel.size() == 0 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannelTest::testRemoveAll() {
+
+    IndexedPriorityMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> dispatch1( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch2( new MessageDispatch() );
+    Pointer<MessageDispatch> dispatch3( new MessageDispatch() );
+
+    Pointer<Message> message1( new Message() );
+    Pointer<Message> message2( new Message() );
+    Pointer<Message> message3( new Message() );
+
+    message1->setPriority( 2 );
+    message2->setPriority( 3 );
+    message3->setPriority( 1 );
+
+    dispatch1->setMessage( message1 );
+    dispatch2->setMessage( message2 );
+    dispatch3->setMessage( message3 );
+
+    channel.enqueue( dispatch1 );
+    channel.enqueue( dispatch2 );
+    channel.enqueue( dispatch3 );
+
+    channel.start();
+    CPPUNIT_ASSERT( channel.isRunning() == true );
+    CPPUNIT_ASSERT( channel.isEmpty() == false );
+    CPPUNIT_ASSERT( channel.size() == 3 );
+    CPPUNIT_ASSERT( channel.removeAll().size() == 3 );
+    CPPUNIT_ASSERT( channel.size() == 0 );
+    CPPUNIT_ASSERT( channel.isEmpty() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannelTest::testFifoWithinPriority() {
+
+    IndexedPriorityMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> low1 = createDispatch(1, 1);
+    Pointer<MessageDispatch> high1 = createDispatch(7, 2);
+    Pointer<MessageDispatch> low2 = createDispatch(1, 3);
+    Pointer<MessageDispatch> high2 = createDispatch(7, 4);
+    Pointer<MessageDispatch> redelivered = createDispatch(1, 5);
+
+    channel.enqueue(low1);
+    channel.enqueue(high1);
+    channel.enqueue(low2);
+    channel.enqueue(high2);
+    channel.enqueueFirst(redelivered);
+
+    channel.start();
+
+    CPPUNIT_ASSERT(channel.peek() == high1);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == high1);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == high2);
+    CPPUNIT_ASSERT(channel.peek() == redelivered);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == redelivered);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == low1);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == low2);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == NULL);
+    CPPUNIT_ASSERT(channel.isEmpty() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannelTest::testPriorityAboveMaximum() {
+
+    IndexedPriorityMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> highest = createDispatch(9, 1);
+    Pointer<MessageDispatch> outOfRange = createDispatch(200, 2);
+    Pointer<MessageDispatch> noMessage(new MessageDispatch());
+
+    channel.enqueue(noMessage);
+    channel.enqueue(highest);
+    channel.enqueue(outOfRange);
+
+    channel.start();
+
+    // Priorities above nine are treated as nine, a dispatch without a message as the default.
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == highest);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == outOfRange);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == noMessage);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannelTest::testClear() {
+
+    IndexedPriorityMessageDispatchChannel channel;
+
+    channel.enqueue(createDispatch(2, 1));
+    channel.enqueue(createDispatch(5, 2));
+    CPPUNIT_ASSERT(channel.size() == 2);
+
+    channel.clear();
+    CPPUNIT_ASSERT(channel.size() == 0);
+    CPPUNIT_ASSERT(channel.isEmpty() == true);
+
+    Pointer<MessageDispatch> dispatch = createDispatch(3, 3);
+    channel.enqueue(dispatch);
+    channel.start();
+
+    CPPUNIT_ASSERT(channel.size() == 1);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == dispatch);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IndexedPriorityMessageDispatchChannelTest::testManyMessages() {
+
+    static const int COUNT = 1000;
+
+    IndexedPriorityMessageDispatchChannel channel;
+    channel.start();
+
+    // Enough messages per level to make each ring buffer grow several times while wrapped.
+    for (int i = 0; i < COUNT; ++i) {
+        channel.enqueue(createDispatch((unsigned char) (i % 10), i));
+        if (i % 3 == 0) {
+            CPPUNIT_ASSERT(channel.dequeueNoWait() != NULL);
+        }
+    }
+
+    std::vector< Pointer<MessageDispatch> > remaining = channel.removeAll();
+    CPPUNIT_ASSERT(channel.isEmpty() == true);
+
+    int lastPriority = 10;
+    int lastSequence = -1;
+    for (std::size_t i = 0; i < remaining.size(); ++i) {
+        int priority = remaining[i]->getMessage()->getPriority();
+        int sequence = remaining[i]->getRedeliveryCounter();
+        CPPUNIT_ASSERT(priority <= lastPriority);
+        if (priority == lastPriority) {
+            CPPUNIT_ASSERT(sequence > lastSequence);
+        }
+        lastPriority = priority;
+        lastSequence = sequence;
+    }
+
+    CPPUNIT_ASSERT_EQUAL(COUNT - (COUNT + 2) / 3, (int) remaining.size());
+}
@@ -0,0 +1,382 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LockFreeMessageDispatchChannelTest.h"
+
+#include <activemq/core/LockFreeMessageDispatchChannel.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::core;
+using namespace activemq::commands;
+using namespace decaf;
+using namespace decaf::lang;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class DelayedAction : public Runnable {
+    private:
+
+        LockFreeMessageDispatchChannel* channel;
+        Pointer<MessageDispatch> dispatch;
+
+    private:
+
+        DelayedAction(const DelayedAction&);
+        DelayedAction& operator=(const DelayedAction&);
+
+    public:
+
+        DelayedAction(LockFreeMessageDispatchChannel* channel, Pointer<MessageDispatch> dispatch) :
+            Runnable(), channel(channel), dispatch(dispatch) {
+        }
+
+        virtual ~DelayedAction() {}
+
+        virtual void run() {
+            Thread::sleep(200);
+            if (dispatch != NULL) {
+                channel->enqueue(dispatch);
+            } else {
+                channel->close();
+            }
+        }
+    };
+
+    class Producer : public Runnable {
+    private:
+
+        LockFreeMessageDispatchChannel* channel;
+        int id;
+        int count;
+
+    private:
+
+        Producer(const Producer&);
+        Producer& operator=(const Producer&);
+
+    public:
+
+        Producer(LockFreeMessageDispatchChannel* channel, int id, int count) :
+            Runnable(), channel(channel), id(id), count(count) {
+        }
+
+        virtual ~Producer() {}
+
+        virtual void run() {
+            for (int i = 0; i < count; ++i) {
+                Pointer<MessageDispatch> dispatch(new MessageDispatch());
+                dispatch->setRedeliveryCounter(id * count + i);
+                channel->enqueue(dispatch);
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannelTest::testCtor() {
+
+    LockFreeMessageDispatchChannel channel;
+    CPPUNIT_ASSERT(channel.isRunning() == false);
+    CPPUNIT_ASSERT(channel.isEmpty() == true);
+    CPPUNIT_ASSERT(channel.size() == 0);
+    CPPUNIT_ASSERT(channel.isClosed() == false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannelTest::testStart() {
+
+    LockFreeMessageDispatchChannel channel;
+    channel.start();
+    CPPUNIT_ASSERT(channel.isRunning() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannelTest::testStop() {
+
+    LockFreeMessageDispatchChannel channel;
+    channel.start();
+    CPPUNIT_ASSERT(channel.isRunning() == true);
+    channel.stop();
+    CPPUNIT_ASSERT(channel.isRunning() == false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannelTest::testClose() {
+
+    LockFreeMessageDispatchChannel channel;
+    channel.start();
+    CPPUNIT_ASSERT(channel.isRunning() == true);
+    CPPUNIT_ASSERT(channel.isClosed() == false);
+    channel.close();
+    CPPUNIT_ASSERT(channel.isRunning() == false);
+    CPPUNIT_ASSERT(channel.isClosed() == true);
+    channel.start();
+    CPPUNIT_ASSERT(channel.isRunning() == false);
+    CPPUNIT_ASSERT(channel.isClosed() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannelTest::testEnqueue() {
+
+    LockFreeMessageDispatchChannel channel;
+    Pointer<MessageDispatch> dispatch1(new MessageDispatch());
+    Pointer<MessageDispatch> dispatch2(new MessageDispatch());
+
+    CPPUNIT_ASSERT(channel.isEmpty() == true);
+    CPPUNIT_ASSERT(channel.size() == 0);
+
+    channel.enqueue(dispatch1);
+
+    CPPUNIT_ASSERT(channel.isEmpty() == false);
+    CPPUNIT_ASSERT(channel.size() == 1);
+
+    channel.enqueue(dispatch2);
+
+    CPPUNIT_ASSERT(channel.isEmpty() == false);
+    CPPUNIT_ASSERT(channel.size() == 2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannelTest::testEnqueueFront() {
+
+    LockFreeMessageDispatchChannel channel;
+    Pointer<MessageDispatch> dispatch1(new MessageDispatch());
+    Pointer<MessageDispatch> dispatch2(new MessageDispatch());
+
+    channel.start();
+
+    channel.enqueueFirst(dispatch1);
+
+    CPPUNIT_ASSERT(channel.isEmpty() == false);
+    CPPUNIT_ASSERT(channel.size() == 1);
+
+    channel.enqueueFirst(dispatch2);
+
+    CPPUNIT_ASSERT(channel.size() == 2);
+
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == dispatch2);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == dispatch1);
+    CPPUNIT_ASSERT(channel.isEmpty() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannelTest::testEnqueueFrontAfterEnqueue() {
+
+    LockFreeMessageDispatchChannel channel;
+    Pointer<MessageDispatch> dispatch1(new MessageDispatch());
+    Pointer<MessageDispatch> dispatch2(new MessageDispatch());
+    Pointer<MessageDispatch> redelivered(new MessageDispatch());
+
+    // Messages enqueued by producers but not yet seen by the consumer must still come
+    // after a message put back at the front.
+    channel.enqueue(dispatch1);
+    channel.enqueue(dispatch2);
+    channel.enqueueFirst(redelivered);
+    channel.start();
+
+    CPPUNIT_ASSERT(channel.size() == 3);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == redelivered);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == dispatch1);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == dispatch2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannelTest::testPeek() {
+
+    LockFreeMessageDispatchChannel channel;
+    Pointer<MessageDispatch> dispatch1(new MessageDispatch());
+    Pointer<MessageDispatch> dispatch2(new MessageDispatch());
+
+    channel.enqueue(dispatch1);
+    channel.enqueue(dispatch2);
+
+    CPPUNIT_ASSERT(channel.peek() == NULL);
+
+    channel.start();
+
+    CPPUNIT_ASSERT(channel.peek() == dispatch1);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == dispatch1);
+    CPPUNIT_ASSERT(channel.peek() == dispatch2);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == dispatch2);
+    CPPUNIT_ASSERT(channel.peek() == NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannelTest::testDequeueNoWait() {
+
+    LockFreeMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> dispatch1(new MessageDispatch());
+    Pointer<MessageDispatch> dispatch2(new MessageDispatch());
+    Pointer<MessageDispatch> dispatch3(new MessageDispatch());
+
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == NULL);
+
+    channel.enqueue(dispatch1);
+    channel.enqueue(dispatch2);
+    channel.enqueue(dispatch3);
+
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == NULL);
+    channel.start();
+
+    CPPUNIT_ASSERT(channel.size() == 3);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == dispatch1);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == dispatch2);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == dispatch3);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == NULL);
+
+    CPPUNIT_ASSERT(channel.size() == 0);
+    CPPUNIT_ASSERT(channel.isEmpty() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannelTest::testDequeue() {
+
+    LockFreeMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> dispatch1(new MessageDispatch());
+    Pointer<MessageDispatch> dispatch2(new MessageDispatch());
+    Pointer<MessageDispatch> dispatch3(new MessageDispatch());
+
+    channel.start();
+
+    long long timeStarted = System::currentTimeMillis();
+
+    CPPUNIT_ASSERT(channel.dequeue(1000) == NULL);
+
+    CPPUNIT_ASSERT(System::currentTimeMillis() - timeStarted >= 999);
+
+    channel.enqueue(dispatch1);
+    channel.enqueue(dispatch2);
+    channel.enqueue(dispatch3);
+    CPPUNIT_ASSERT(channel.size() == 3);
+    CPPUNIT_ASSERT(channel.dequeue(-1) == dispatch1);
+    CPPUNIT_ASSERT(channel.dequeue(0) == dispatch2);
+    CPPUNIT_ASSERT(channel.dequeue(1000) == dispatch3);
+
+    CPPUNIT_ASSERT(channel.size() == 0);
+    CPPUNIT_ASSERT(channel.isEmpty() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannelTest::testDequeueWokenByEnqueue() {
+
+    LockFreeMessageDispatchChannel channel;
+    Pointer<MessageDispatch> dispatch(new MessageDispatch());
+
+    channel.start();
+
+    DelayedAction action(&channel, dispatch);
+    Thread thread(&action);
+    thread.start();
+
+    long long timeStarted = System::currentTimeMillis();
+    CPPUNIT_ASSERT(channel.dequeue(-1) == dispatch);
+    CPPUNIT_ASSERT(System::currentTimeMillis() - timeStarted < 5000);
+
+    thread.join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannelTest::testDequeueWokenByClose() {
+
+    LockFreeMessageDispatchChannel channel;
+
+    channel.start();
+
+    DelayedAction action(&channel, Pointer<MessageDispatch>());
+    Thread thread(&action);
+    thread.start();
+
+    long long timeStarted = System::currentTimeMillis();
+    CPPUNIT_ASSERT(channel.dequeue(10000) == NULL);
+    CPPUNIT_ASSERT(System::currentTimeMillis() - timeStarted < 5000);
+    CPPUNIT_ASSERT(channel.isClosed() == true);
+
+    thread.join();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannelTest::testRemoveAll() {
+
+    LockFreeMessageDispatchChannel channel;
+
+    Pointer<MessageDispatch> dispatch1(new MessageDispatch());
+    Pointer<MessageDispatch> dispatch2(new MessageDispatch());
+    Pointer<MessageDispatch> dispatch3(new MessageDispatch());
+
+    channel.enqueue(dispatch1);
+    channel.enqueue(dispatch2);
+    channel.enqueueFirst(dispatch3);
+
+    std::vector< Pointer<MessageDispatch> > result = channel.removeAll();
+    CPPUNIT_ASSERT(result.size() == 3);
+    CPPUNIT_ASSERT(result[0] == dispatch3);
+    CPPUNIT_ASSERT(result[1] == dispatch1);
+    CPPUNIT_ASSERT(result[2] == dispatch2);
+    CPPUNIT_ASSERT(channel.size() == 0);
+    CPPUNIT_ASSERT(channel.isEmpty() == true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LockFreeMessageDispatchChannelTest::testMultipleProducers() {
+
+    static const int PRODUCERS = 4;
+    static const int COUNT = 2000;
+
+    LockFreeMessageDispatchChannel channel;
+    channel.start();
+
+    std::vector<Producer*> producers;
+    std::vector<Thread*> threads;
+    for (int i = 0; i < PRODUCERS; ++i) {
+        producers.push_back(new Producer(&channel, i, COUNT));
+        threads.push_back(new Thread(producers[i]));
+        threads[i]->start();
+    }
+
+    // Each producer's messages must arrive in the order that producer sent them.
+    std::vector<int> expected(PRODUCERS, 0);
+    int received = 0;
+    while (received < PRODUCERS * COUNT) {
+        Pointer<MessageDispatch> dispatch = channel.dequeue(5000);
+        CPPUNIT_ASSERT_MESSAGE("Timed out waiting for a message", dispatch != NULL);
+
+        int producer = dispatch->getRedeliveryCounter() / COUNT;
+        int sequence = dispatch->getRedeliveryCounter() % COUNT;
+        CPPUNIT_ASSERT_EQUAL(expected[producer], sequence);
+        expected[producer]++;
+        received++;
+    }
+
+    for (int i = 0; i < PRODUCERS; ++i) {
+        threads[i]->join();
+        delete threads[i];
+        delete producers[i];
+    }
+
+    CPPUNIT_ASSERT(channel.isEmpty() == true);
+    CPPUNIT_ASSERT(channel.dequeueNoWait() == NULL);
+}
@@ -0,0 +1,352 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PooledTaskRunnerTest.h"
+
+#include <memory>
+#include <vector>
+
+#include <activemq/threads/Task.h>
+#include <activemq/threads/PooledTaskRunner.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/ThreadPoolExecutor.h>
+#include <decaf/util/concurrent/LinkedBlockingQueue.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+using namespace activemq;
+using namespace activemq::threads;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class SimpleCountingTask : public Task {
+    private:
+
+        AtomicInteger count;
+
+    public:
+
+        SimpleCountingTask() : count(0) {}
+        virtual ~SimpleCountingTask() {}
+
+        virtual bool iterate() {
+            count.incrementAndGet();
+            return false;
+        }
+
+        int getCount() const { return count.get(); }
+    };
+
+    class InfiniteCountingTask : public Task {
+    private:
+
+        AtomicInteger count;
+
+    public:
+
+        InfiniteCountingTask() : count(0) {}
+        virtual ~InfiniteCountingTask() {}
+
+        virtual bool iterate() {
+            count.incrementAndGet();
+            return true;
+        }
+
+        int getCount() const { return count.get(); }
+    };
+
+    class SerialCheckingTask : public Task {
+    private:
+
+        AtomicInteger active;
+        AtomicInteger count;
+        AtomicInteger overlaps;
+        int remaining;
+
+    public:
+
+        SerialCheckingTask(int remaining) : active(0), count(0), overlaps(0), remaining(remaining) {}
+        virtual ~SerialCheckingTask() {}
+
+        virtual bool iterate() {
+
+            if (active.incrementAndGet() != 1) {
+                overlaps.incrementAndGet();
+            }
+
+            Thread::yield();
+            count.incrementAndGet();
+            bool more = --remaining > 0;
+
+            active.decrementAndGet();
+            return more;
+        }
+
+        int getCount() const { return count.get(); }
+        int getOverlaps() const { return overlaps.get(); }
+    };
+
+    class ShutdownOnIterateTask : public Task {
+    public:
+
+        TaskRunner* runner;
+        AtomicInteger count;
+
+        ShutdownOnIterateTask() : runner(NULL), count(0) {}
+        virtual ~ShutdownOnIterateTask() {}
+
+        virtual bool iterate() {
+            count.incrementAndGet();
+            runner->shutdown();
+            return true;
+        }
+    };
+
+    class CloseOtherRunnerTask : public Task {
+    private:
+
+        CountDownLatch* started;
+        CountDownLatch* otherQueued;
+        CountDownLatch* closed;
+        std::auto_ptr<PooledTaskRunner>* other;
+
+    private:
+
+        CloseOtherRunnerTask(const CloseOtherRunnerTask&);
+        CloseOtherRunnerTask& operator=(const CloseOtherRunnerTask&);
+
+    public:
+
+        CloseOtherRunnerTask(CountDownLatch* started, CountDownLatch* otherQueued,
+                             CountDownLatch* closed, std::auto_ptr<PooledTaskRunner>* other) :
+            started(started), otherQueued(otherQueued), closed(closed), other(other) {}
+        virtual ~CloseOtherRunnerTask() {}
+
+        virtual bool iterate() {
+            started->countDown();
+            otherQueued->await();
+
+            // Like a listener closing another Session, destroying the other runner
+            // shuts it down while its run waits in the queue for this thread.
+            other->reset(NULL);
+            closed->countDown();
+            return false;
+        }
+    };
+
+    ThreadPoolExecutor* createExecutor(int threads) {
+        return new ThreadPoolExecutor(threads, threads, 5, TimeUnit::SECONDS, new LinkedBlockingQueue<decaf::lang::Runnable*>());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunnerTest::testConstructor() {
+
+    std::auto_ptr<ThreadPoolExecutor> executor(createExecutor(1));
+    SimpleCountingTask task;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NullPointerException",
+        std::auto_ptr<TaskRunner>(new PooledTaskRunner(NULL, &task, 10)),
+        NullPointerException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NullPointerException",
+        std::auto_ptr<TaskRunner>(new PooledTaskRunner(executor.get(), NULL, 10)),
+        NullPointerException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a IllegalArgumentException",
+        std::auto_ptr<TaskRunner>(new PooledTaskRunner(executor.get(), &task, 0)),
+        IllegalArgumentException);
+
+    executor->shutdown();
+    executor->awaitTermination(5, TimeUnit::SECONDS);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunnerTest::testSimple() {
+
+    std::auto_ptr<ThreadPoolExecutor> executor(createExecutor(2));
+
+    SimpleCountingTask simpleTask;
+    PooledTaskRunner simpleTaskRunner(executor.get(), &simpleTask, 10);
+    CPPUNIT_ASSERT(!simpleTaskRunner.isStarted());
+
+    simpleTaskRunner.start();
+    CPPUNIT_ASSERT(simpleTaskRunner.isStarted());
+
+    simpleTaskRunner.wakeup();
+    Thread::sleep(250);
+    CPPUNIT_ASSERT(simpleTask.getCount() >= 1);
+    simpleTaskRunner.wakeup();
+    Thread::sleep(250);
+    CPPUNIT_ASSERT(simpleTask.getCount() >= 2);
+
+    InfiniteCountingTask infiniteTask;
+    PooledTaskRunner infiniteTaskRunner(executor.get(), &infiniteTask, 10);
+    infiniteTaskRunner.start();
+    Thread::sleep(500);
+    CPPUNIT_ASSERT(infiniteTask.getCount() != 0);
+    infiniteTaskRunner.shutdown();
+    int count = infiniteTask.getCount();
+    Thread::sleep(250);
+    CPPUNIT_ASSERT(infiniteTask.getCount() == count);
+
+    simpleTaskRunner.shutdown();
+    count = simpleTask.getCount();
+    simpleTaskRunner.wakeup();
+    Thread::sleep(100);
+    CPPUNIT_ASSERT(simpleTask.getCount() == count);
+
+    executor->shutdown();
+    CPPUNIT_ASSERT(executor->awaitTermination(5, TimeUnit::SECONDS));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunnerTest::testManyTasksSharePool() {
+
+    static const int NUM_TASKS = 50;
+    static const int ITERATIONS = 40;
+
+    std::auto_ptr<ThreadPoolExecutor> executor(createExecutor(3));
+
+    std::vector<SerialCheckingTask*> tasks;
+    std::vector<PooledTaskRunner*> runners;
+
+    for (int i = 0; i < NUM_TASKS; ++i) {
+        tasks.push_back(new SerialCheckingTask(ITERATIONS));
+        runners.push_back(new PooledTaskRunner(executor.get(), tasks.back(), 5));
+        runners.back()->start();
+    }
+
+    // Extra wakeups while the tasks run must not cause concurrent iterations.
+    for (int i = 0; i < NUM_TASKS; ++i) {
+        runners[i]->wakeup();
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        bool finished = true;
+        for (int j = 0; j < NUM_TASKS; ++j) {
+            finished &= tasks[j]->getCount() >= ITERATIONS;
+        }
+        if (finished) {
+            break;
+        }
+        Thread::sleep(50);
+    }
+
+    for (int i = 0; i < NUM_TASKS; ++i) {
+        runners[i]->shutdown();
+        CPPUNIT_ASSERT(tasks[i]->getCount() >= ITERATIONS);
+        CPPUNIT_ASSERT_EQUAL(0, tasks[i]->getOverlaps());
+        delete runners[i];
+        delete tasks[i];
+    }
+
+    CPPUNIT_ASSERT(executor->getLargestPoolSize() <= 3);
+
+    executor->shutdown();
+    CPPUNIT_ASSERT(executor->awaitTermination(5, TimeUnit::SECONDS));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunnerTest::testMaxIterationsPerRun() {
+
+    // With a single thread the busy tasks can only both make progress if
+    // each one hands the thread back after its quota of iterations.
+    std::auto_ptr<ThreadPoolExecutor> executor(createExecutor(1));
+
+    InfiniteCountingTask task1;
+    InfiniteCountingTask task2;
+    PooledTaskRunner runner1(executor.get(), &task1, 10);
+    PooledTaskRunner runner2(executor.get(), &task2, 10);
+
+    runner1.start();
+    runner2.start();
+
+    Thread::sleep(250);
+
+    runner1.shutdown();
+    runner2.shutdown();
+
+    CPPUNIT_ASSERT(task1.getCount() > 0);
+    CPPUNIT_ASSERT(task2.getCount() > 0);
+
+    executor->shutdown();
+    CPPUNIT_ASSERT(executor->awaitTermination(5, TimeUnit::SECONDS));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunnerTest::testShutdownFromTask() {
+
+    std::auto_ptr<ThreadPoolExecutor> executor(createExecutor(1));
+
+    ShutdownOnIterateTask task;
+    PooledTaskRunner runner(executor.get(), &task, 10);
+    task.runner = &runner;
+
+    runner.start();
+    Thread::sleep(100);
+    runner.shutdown();
+
+    CPPUNIT_ASSERT_EQUAL(1, task.count.get());
+
+    executor->shutdown();
+    CPPUNIT_ASSERT(executor->awaitTermination(5, TimeUnit::SECONDS));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void PooledTaskRunnerTest::testShutdownQueuedRunnerFromTask() {
+
+    std::auto_ptr<ThreadPoolExecutor> executor(createExecutor(1));
+
+    CountDownLatch started(1);
+    CountDownLatch otherQueued(1);
+    CountDownLatch closed(1);
+
+    SimpleCountingTask otherTask;
+    std::auto_ptr<PooledTaskRunner> other(new PooledTaskRunner(executor.get(), &otherTask, 10));
+
+    CloseOtherRunnerTask task(&started, &otherQueued, &closed, &other);
+    PooledTaskRunner runner(executor.get(), &task, 10);
+
+    runner.start();
+    CPPUNIT_ASSERT(started.await(5000));
+
+    // The only thread is busy so this run can do nothing but wait in the queue.
+    other->start();
+    otherQueued.countDown();
+
+    CPPUNIT_ASSERT_MESSAGE("Shutting down a queued runner should not wait for its run",
+                           closed.await(5000));
+
+    runner.shutdown();
+
+    executor->shutdown();
+    CPPUNIT_ASSERT(executor->awaitTermination(5, TimeUnit::SECONDS));
+    CPPUNIT_ASSERT_EQUAL(0, otherTask.getCount());
+}
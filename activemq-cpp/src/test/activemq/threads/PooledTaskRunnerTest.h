@@ -0,0 +1,54 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_THREADS_POOLEDTASKRUNNERTEST_H_
+#define _ACTIVEMQ_THREADS_POOLEDTASKRUNNERTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace activemq {
+namespace threads {
+
+    class PooledTaskRunnerTest : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( PooledTaskRunnerTest );
+        CPPUNIT_TEST( testConstructor );
+        CPPUNIT_TEST( testSimple );
+        CPPUNIT_TEST( testManyTasksSharePool );
+        CPPUNIT_TEST( testMaxIterationsPerRun );
+        CPPUNIT_TEST( testShutdownFromTask );
+        CPPUNIT_TEST( testShutdownQueuedRunnerFromTask );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        PooledTaskRunnerTest() {}
+        virtual ~PooledTaskRunnerTest() {}
+
+        void testConstructor();
+        void testSimple();
+        void testManyTasksSharePool();
+        void testMaxIterationsPerRun();
+        void testShutdownFromTask();
+        void testShutdownQueuedRunnerFromTask();
+
+    };
+
+}}
+
+#endif /* _ACTIVEMQ_THREADS_POOLEDTASKRUNNERTEST_H_ */
@@ -261,3 +261,32 @@ void SchedulerTest::testShutdown() {
         CPPUNIT_ASSERT(scheduler.isStopped());
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void SchedulerTest::testSharedTimer() {
+
+    Scheduler scheduler1("testSharedTimer-1");
+    Scheduler scheduler2("testSharedTimer-2");
+    scheduler1.start();
+    scheduler2.start();
+
+    CounterTask task1;
+    CounterTask task2;
+    scheduler1.executePeriodically(&task1, 100, false);
+    scheduler2.executePeriodically(&task2, 100, false);
+
+    Thread::sleep(350);
+    CPPUNIT_ASSERT(task1.getCount() >= 1);
+    CPPUNIT_ASSERT(task2.getCount() >= 1);
+
+    // Stopping one Scheduler leaves the tasks of the other on the shared Timer.
+    scheduler1.stop();
+    int count1 = task1.getCount();
+    int count2 = task2.getCount();
+
+    Thread::sleep(350);
+    CPPUNIT_ASSERT_EQUAL(count1, task1.getCount());
+    CPPUNIT_ASSERT(task2.getCount() > count2);
+
+    scheduler2.stop();
+}
@@ -34,6 +34,7 @@ namespace threads {
         CPPUNIT_TEST( testExecuteAfterDelay );
         CPPUNIT_TEST( testCancel );
         CPPUNIT_TEST( testShutdown );
+        CPPUNIT_TEST( testSharedTimer );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -48,6 +49,7 @@ namespace threads {
         void testExecuteAfterDelay();
         void testCancel();
         void testShutdown();
+        void testSharedTimer();
 
     };
 
@@ -0,0 +1,92 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SchedulerTimerPoolTest.h"
+
+#include <activemq/threads/SchedulerTimerPool.h>
+#include <decaf/util/Timer.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+using namespace activemq;
+using namespace activemq::threads;
+using namespace decaf;
+using namespace decaf::util;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+void SchedulerTimerPoolTest::testTimerCount() {
+
+    // One Timer per processor unless configured otherwise.
+    int defaultCount = SchedulerTimerPool::getTimerCount();
+    CPPUNIT_ASSERT_EQUAL(System::availableProcessors() > 1 ? System::availableProcessors() : 1, defaultCount);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalArgumentException",
+        SchedulerTimerPool::setTimerCount(0),
+        IllegalArgumentException);
+
+    SchedulerTimerPool::setTimerCount(3);
+    CPPUNIT_ASSERT_EQUAL(3, SchedulerTimerPool::getTimerCount());
+    SchedulerTimerPool::setTimerCount(defaultCount);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SchedulerTimerPoolTest::testGetTimer() {
+
+    int defaultCount = SchedulerTimerPool::getTimerCount();
+
+    SchedulerTimerPool::setTimerCount(1);
+
+    Pointer<Timer> timer = SchedulerTimerPool::getTimer();
+    CPPUNIT_ASSERT(timer != NULL);
+    CPPUNIT_ASSERT(timer == SchedulerTimerPool::getTimer());
+
+    SchedulerTimerPool::setTimerCount(2);
+
+    Pointer<Timer> first = SchedulerTimerPool::getTimer();
+    Pointer<Timer> second = SchedulerTimerPool::getTimer();
+    CPPUNIT_ASSERT(first != second);
+
+    // Once both are running they are handed out in turn.
+    Pointer<Timer> third = SchedulerTimerPool::getTimer();
+    Pointer<Timer> fourth = SchedulerTimerPool::getTimer();
+    CPPUNIT_ASSERT(third != fourth);
+    CPPUNIT_ASSERT(third == first || third == second);
+    CPPUNIT_ASSERT(fourth == first || fourth == second);
+
+    SchedulerTimerPool::setTimerCount(1);
+    CPPUNIT_ASSERT(SchedulerTimerPool::getTimer() == SchedulerTimerPool::getTimer());
+
+    SchedulerTimerPool::setTimerCount(defaultCount);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SchedulerTimerPoolTest::testTimerTaskQueueType() {
+
+    CPPUNIT_ASSERT_EQUAL(Timer::BINARY_HEAP, SchedulerTimerPool::getTimerTaskQueueType());
+
+    SchedulerTimerPool::setTimerTaskQueueType(Timer::TIMING_WHEEL);
+    CPPUNIT_ASSERT_EQUAL(Timer::TIMING_WHEEL, SchedulerTimerPool::getTimerTaskQueueType());
+
+    // Timers that are already running are left as they are.
+    CPPUNIT_ASSERT(SchedulerTimerPool::getTimer() != NULL);
+
+    SchedulerTimerPool::setTimerTaskQueueType(Timer::BINARY_HEAP);
+}
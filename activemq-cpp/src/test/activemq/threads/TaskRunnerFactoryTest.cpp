@@ -0,0 +1,118 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TaskRunnerFactoryTest.h"
+
+#include <activemq/threads/Task.h>
+#include <activemq/threads/TaskRunnerFactory.h>
+#include <activemq/threads/DedicatedTaskRunner.h>
+#include <activemq/threads/PooledTaskRunner.h>
+
+#include <decaf/lang/Thread.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+
+using namespace activemq;
+using namespace activemq::threads;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class SimpleCountingTask : public Task {
+    private:
+
+        AtomicInteger count;
+
+    public:
+
+        SimpleCountingTask() : count(0) {}
+        virtual ~SimpleCountingTask() {}
+
+        virtual bool iterate() {
+            count.incrementAndGet();
+            return false;
+        }
+
+        int getCount() const { return count.get(); }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TaskRunnerFactoryTest::testDedicated() {
+
+    TaskRunnerFactory factory("Test", true);
+    CPPUNIT_ASSERT(factory.isDedicatedTaskRunner());
+
+    SimpleCountingTask task;
+    Pointer<TaskRunner> runner = factory.createTaskRunner(&task);
+    CPPUNIT_ASSERT(runner.dynamicCast<DedicatedTaskRunner>() != NULL);
+
+    runner->start();
+    runner->wakeup();
+    Thread::sleep(250);
+    CPPUNIT_ASSERT(task.getCount() >= 1);
+
+    runner->shutdown();
+    factory.shutdown();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TaskRunnerFactoryTest::testPooled() {
+
+    TaskRunnerFactory factory("Test", false, 2, 10);
+    CPPUNIT_ASSERT(!factory.isDedicatedTaskRunner());
+    CPPUNIT_ASSERT_EQUAL(2, factory.getMaxThreads());
+    CPPUNIT_ASSERT_EQUAL(10, factory.getMaxIterationsPerRun());
+
+    SimpleCountingTask task1;
+    SimpleCountingTask task2;
+    Pointer<TaskRunner> runner1 = factory.createTaskRunner(&task1);
+    Pointer<TaskRunner> runner2 = factory.createTaskRunner(&task2);
+    CPPUNIT_ASSERT(runner1.dynamicCast<PooledTaskRunner>() != NULL);
+
+    runner1->start();
+    runner2->start();
+    runner1->wakeup();
+    runner2->wakeup();
+    Thread::sleep(250);
+    CPPUNIT_ASSERT(task1.getCount() >= 1);
+    CPPUNIT_ASSERT(task2.getCount() >= 1);
+
+    runner1->shutdown();
+    runner2->shutdown();
+    factory.shutdown();
+
+    TaskRunnerFactory defaulted("Test", false);
+    CPPUNIT_ASSERT(defaulted.getMaxThreads() > 0);
+    CPPUNIT_ASSERT_EQUAL(TaskRunnerFactory::DEFAULT_MAX_ITERATIONS_PER_RUN, defaulted.getMaxIterationsPerRun());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TaskRunnerFactoryTest::testCreateAfterShutdown() {
+
+    TaskRunnerFactory factory("Test", false, 1);
+    factory.shutdown();
+
+    SimpleCountingTask task;
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a IllegalStateException",
+        factory.createTaskRunner(&task),
+        IllegalStateException);
+}
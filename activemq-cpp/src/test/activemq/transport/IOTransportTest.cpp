@@ -32,6 +32,7 @@
 #include <decaf/lang/Thread.h>
 #include <decaf/lang/Exception.h>
 #include <decaf/util/Random.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
 
 using namespace activemq;
 using namespace activemq::transport;
@@ -394,3 +395,240 @@ void IOTransportTest::testNarrow(){
     CPPUNIT_ASSERT( narrowed == &transport );
 
 }
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class CountingOutputStream : public decaf::io::ByteArrayOutputStream {
+    public:
+
+        decaf::util::concurrent::atomic::AtomicInteger flushes;
+
+        CountingOutputStream() : decaf::io::ByteArrayOutputStream(), flushes() {}
+        virtual ~CountingOutputStream() {}
+
+        virtual void flush() {
+            flushes.incrementAndGet();
+        }
+    };
+
+    class OnewayWriter : public decaf::lang::Thread {
+    private:
+
+        IOTransport* transport;
+        decaf::util::concurrent::CountDownLatch* startSignal;
+        char value;
+        int count;
+
+        OnewayWriter(const OnewayWriter&);
+        OnewayWriter& operator= (const OnewayWriter&);
+
+    public:
+
+        bool failed;
+
+        OnewayWriter(IOTransport* transport, decaf::util::concurrent::CountDownLatch* startSignal, char value, int count) :
+            Thread(), transport(transport), startSignal(startSignal), value(value), count(count), failed(false) {}
+        virtual ~OnewayWriter() {}
+
+        virtual void run() {
+            try {
+                startSignal->await();
+                for( int i = 0; i < count; ++i ) {
+                    Pointer<MyCommand> cmd( new MyCommand() );
+                    cmd->c = value;
+                    transport->oneway( cmd );
+                }
+            } catch( decaf::lang::Exception& ex ) {
+                failed = true;
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransportTest::testConcurrentWrites(){
+
+    static const int NUM_WRITERS = 8;
+    static const int NUM_WRITES = 200;
+
+    decaf::io::BlockingByteArrayInputStream is;
+    CountingOutputStream os;
+    decaf::io::DataInputStream input( &is );
+    decaf::io::DataOutputStream output( &os );
+
+    Pointer<MyWireFormat> wireFormat( new MyWireFormat() );
+    MyTransportListener listener;
+    IOTransport transport;
+    transport.setInputStream( &input );
+    transport.setOutputStream( &output );
+    transport.setTransportListener( &listener );
+    transport.setWireFormat( wireFormat );
+    transport.setMaxWriteBatchDelay( 100 );
+
+    CPPUNIT_ASSERT_EQUAL( 100LL, transport.getMaxWriteBatchDelay() );
+    CPPUNIT_ASSERT_EQUAL( 65536, transport.getMaxWriteBatchSize() );
+
+    transport.start();
+
+    // Hold the writers until all of them are running so they actually contend
+    // for the writer role.
+    decaf::util::concurrent::CountDownLatch startSignal( 1 );
+
+    std::vector<OnewayWriter*> writers;
+    for( int i = 0; i < NUM_WRITERS; ++i ) {
+        writers.push_back( new OnewayWriter( &transport, &startSignal, (char)( 'a' + i ), NUM_WRITES ) );
+    }
+
+    for( int i = 0; i < NUM_WRITERS; ++i ) {
+        writers[i]->start();
+    }
+
+    startSignal.countDown();
+
+    for( int i = 0; i < NUM_WRITERS; ++i ) {
+        writers[i]->join();
+        CPPUNIT_ASSERT( !writers[i]->failed );
+        delete writers[i];
+    }
+
+    std::pair<unsigned char*, int> array = os.toByteArray();
+    CPPUNIT_ASSERT_EQUAL( NUM_WRITERS * NUM_WRITES, array.second );
+
+    int counts[NUM_WRITERS] = { 0 };
+    for( int i = 0; i < array.second; ++i ) {
+        counts[array.first[i] - 'a']++;
+    }
+    delete [] array.first;
+
+    for( int i = 0; i < NUM_WRITERS; ++i ) {
+        CPPUNIT_ASSERT_EQUAL( NUM_WRITES, counts[i] );
+    }
+
+    // Commands queued while another writer was flushing went out in its next batch
+    // instead of getting a flush of their own.
+    CPPUNIT_ASSERT( os.flushes.get() < NUM_WRITERS * NUM_WRITES );
+
+    transport.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    /**
+     * Reads one byte per frame, lower case letters are independent and are decoded
+     * after a random delay so that the workers finish out of order, a '!' fails to
+     * decode.
+     */
+    class MyFrameWireFormat : public MyWireFormat {
+    public:
+
+        decaf::util::concurrent::atomic::AtomicInteger frameDecodes;
+
+        MyFrameWireFormat() : MyWireFormat(), frameDecodes() {}
+        virtual ~MyFrameWireFormat() {}
+
+        virtual bool isFrameUnmarshalSupported() const {
+            return true;
+        }
+
+        virtual bool readFrame( decaf::io::DataInputStream* in, std::vector<unsigned char>& frame ) {
+            frame.resize( 1 );
+            frame[0] = in->readByte();
+            return frame[0] >= 'a' && frame[0] <= 'z';
+        }
+
+        virtual Pointer<commands::Command> unmarshalFrame( const activemq::transport::Transport* transport AMQCPP_UNUSED,
+                                                           const std::vector<unsigned char>& frame ) {
+
+            if( frame[0] == '!' ) {
+                throw IOException( __FILE__, __LINE__, "Bad frame" );
+            }
+
+            if( frame[0] >= 'a' && frame[0] <= 'z' ) {
+                decaf::util::Random randGen;
+                decaf::lang::Thread::sleep( randGen.nextInt( 5 ) );
+            }
+
+            frameDecodes.incrementAndGet();
+
+            Pointer<MyCommand> command( new MyCommand() );
+            command->c = (char) frame[0];
+            return command;
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransportTest::testParallelUnmarshal(){
+
+    static const int NUM_FRAMES = 200;
+
+    std::string expected;
+    for( int i = 0; i < NUM_FRAMES; ++i ) {
+        expected += (char)( i % 20 == 19 ? 'A' + ( i / 20 ) : 'a' + ( i % 20 ) );
+    }
+
+    decaf::io::BlockingByteArrayInputStream is;
+    decaf::io::ByteArrayOutputStream os;
+    decaf::io::DataInputStream input( &is );
+    decaf::io::DataOutputStream output( &os );
+
+    Pointer<MyFrameWireFormat> wireFormat( new MyFrameWireFormat() );
+    MyTransportListener listener( NUM_FRAMES );
+    IOTransport transport;
+    transport.setInputStream( &input );
+    transport.setOutputStream( &output );
+    transport.setTransportListener( &listener );
+    transport.setWireFormat( wireFormat );
+    transport.setUnmarshalThreads( 4 );
+
+    CPPUNIT_ASSERT_EQUAL( 4, transport.getUnmarshalThreads() );
+
+    transport.start();
+
+    is.setByteArray( (const unsigned char*) expected.c_str(), NUM_FRAMES );
+
+    listener.await();
+
+    CPPUNIT_ASSERT_EQUAL( expected, listener.str );
+    CPPUNIT_ASSERT_EQUAL( NUM_FRAMES, wireFormat->frameDecodes.get() );
+
+    transport.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void IOTransportTest::testParallelUnmarshalException(){
+
+    decaf::io::BlockingByteArrayInputStream is;
+    decaf::io::ByteArrayOutputStream os;
+    decaf::io::DataInputStream input( &is );
+    decaf::io::DataOutputStream output( &os );
+
+    Pointer<MyFrameWireFormat> wireFormat( new MyFrameWireFormat() );
+    MyTransportListener listener( 4 );
+    IOTransport transport;
+    transport.setInputStream( &input );
+    transport.setOutputStream( &output );
+    transport.setTransportListener( &listener );
+    transport.setWireFormat( wireFormat );
+    transport.setUnmarshalThreads( 2 );
+
+    transport.start();
+
+    unsigned char buffer[6] = { 'a', 'b', 'c', 'd', '!', 'e' };
+    is.setByteArray( buffer, 6 );
+
+    listener.await();
+
+    for( int i = 0; i < 100 && !listener.caughtOne; ++i ) {
+        decaf::lang::Thread::sleep( 10 );
+    }
+
+    // Everything read before the bad frame is delivered, nothing after it.
+    CPPUNIT_ASSERT( listener.caughtOne );
+    decaf::lang::Thread::sleep( 20 );
+    CPPUNIT_ASSERT_EQUAL( std::string( "abcd" ), listener.str );
+
+    transport.close();
+}
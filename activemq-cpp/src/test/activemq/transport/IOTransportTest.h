@@ -34,6 +34,9 @@ namespace transport{
         CPPUNIT_TEST( testWrite );
         CPPUNIT_TEST( testException );
         CPPUNIT_TEST( testNarrow );
+        CPPUNIT_TEST( testConcurrentWrites );
+        CPPUNIT_TEST( testParallelUnmarshal );
+        CPPUNIT_TEST( testParallelUnmarshalException );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -46,6 +49,9 @@ namespace transport{
         void testStartClose();
         void testStressTransportStartClose();
         void testNarrow();
+        void testConcurrentWrites();
+        void testParallelUnmarshal();
+        void testParallelUnmarshalException();
 
     };
 
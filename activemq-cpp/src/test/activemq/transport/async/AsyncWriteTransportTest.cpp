@@ -0,0 +1,369 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncWriteTransportTest.h"
+
+#include <activemq/transport/async/AsyncWriteTransport.h>
+#include <activemq/transport/mock/MockTransport.h>
+#include <activemq/transport/mock/MockTransportFactory.h>
+#include <activemq/transport/TransportListener.h>
+#include <activemq/commands/ActiveMQMessage.h>
+
+#include <decaf/net/URI.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/util/Properties.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/TimeUnit.h>
+
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::transport::mock;
+using namespace activemq::transport::async;
+using namespace decaf;
+using namespace decaf::net;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+namespace {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    class MyTransportListener : public TransportListener {
+    public:
+
+        CountDownLatch exceptionFired;
+
+    public:
+
+        MyTransportListener() : exceptionFired(1) {}
+
+        virtual ~MyTransportListener() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+        }
+
+        virtual void onException(const decaf::lang::Exception& ex) {
+            this->exceptionFired.countDown();
+        }
+
+        virtual void transportInterrupted() {
+        }
+
+        virtual void transportResumed() {
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    class MyOutgoingListener : public TransportListener {
+    public:
+
+        std::vector<int> commandIds;
+        CountDownLatch writing;
+        CountDownLatch release;
+
+    public:
+
+        MyOutgoingListener() : commandIds(), writing(1), release(0) {}
+
+        MyOutgoingListener(int blocked) : commandIds(), writing(1), release(blocked) {}
+
+        virtual ~MyOutgoingListener() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+            this->writing.countDown();
+            this->release.await();
+            this->commandIds.push_back(command->getCommandId());
+        }
+
+        virtual void onException(const decaf::lang::Exception& ex) {
+        }
+
+        virtual void transportInterrupted() {
+        }
+
+        virtual void transportResumed() {
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    Pointer<Command> createMessage(int id) {
+        Pointer<ActiveMQMessage> message(new ActiveMQMessage());
+        message->setCommandId(id);
+        return message;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    class MyFailingListener : public MyOutgoingListener {
+    public:
+
+        MyFailingListener() : MyOutgoingListener(1) {}
+
+        virtual ~MyFailingListener() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+            this->writing.countDown();
+            this->release.await();
+            throw IOException(__FILE__, __LINE__, "Failed to write the command.");
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    class MyOnewayThread : public Thread {
+    private:
+
+        AsyncWriteTransport* transport;
+
+        MyOnewayThread(const MyOnewayThread&);
+        MyOnewayThread& operator= (const MyOnewayThread&);
+
+    public:
+
+        bool failed;
+
+        MyOnewayThread(AsyncWriteTransport* transport) : Thread(), transport(transport), failed(false) {}
+
+        virtual ~MyOnewayThread() {}
+
+        virtual void run() {
+            try {
+                transport->oneway(createMessage(2));
+            } catch (IOException& ex) {
+                failed = true;
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncWriteTransportTest::AsyncWriteTransportTest() : transport() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+AsyncWriteTransportTest::~AsyncWriteTransportTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransportTest::setUp() {
+
+    URI uri( "mock://mock?wireformat=openwire" );
+    MockTransportFactory factory;
+
+    this->transport = factory.createComposite( uri ).dynamicCast<MockTransport>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransportTest::tearDown() {
+    this->transport.reset( NULL );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransportTest::testCreate() {
+
+    AsyncWriteTransport defaults( this->transport );
+
+    CPPUNIT_ASSERT_EQUAL( 1000, defaults.getQueueSize() );
+    CPPUNIT_ASSERT_EQUAL( 32LL * 1024 * 1024, defaults.getQueueBytes() );
+    CPPUNIT_ASSERT_EQUAL( true, defaults.isBlockWhenFull() );
+    CPPUNIT_ASSERT_EQUAL( 15000LL, defaults.getCloseTimeout() );
+    CPPUNIT_ASSERT( defaults.isClosed() == false );
+
+    Properties properties;
+    properties.setProperty( "transport.asyncWriteQueueSize", "10" );
+    properties.setProperty( "transport.asyncWriteQueueBytes", "4096" );
+    properties.setProperty( "transport.asyncWriteBlockWhenFull", "false" );
+    properties.setProperty( "transport.asyncWriteCloseTimeout", "500" );
+
+    AsyncWriteTransport configured( this->transport, properties );
+
+    CPPUNIT_ASSERT_EQUAL( 10, configured.getQueueSize() );
+    CPPUNIT_ASSERT_EQUAL( 4096LL, configured.getQueueBytes() );
+    CPPUNIT_ASSERT_EQUAL( false, configured.isBlockWhenFull() );
+    CPPUNIT_ASSERT_EQUAL( 500LL, configured.getCloseTimeout() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransportTest::testWriteOrder() {
+
+    MyTransportListener listener;
+    MyOutgoingListener outgoing;
+    this->transport->setOutgoingListener( &outgoing );
+
+    AsyncWriteTransport asyncTransport( this->transport );
+    asyncTransport.setQueueSize( 8 );
+    asyncTransport.setTransportListener( &listener );
+    asyncTransport.start();
+
+    for( int i = 0; i < 100; ++i ) {
+        asyncTransport.oneway( createMessage( i ) );
+    }
+
+    // Stopping waits for the queued commands to be written.
+    asyncTransport.close();
+
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 100, outgoing.commandIds.size() );
+    for( int i = 0; i < 100; ++i ) {
+        CPPUNIT_ASSERT_EQUAL( i, outgoing.commandIds[i] );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 1, listener.exceptionFired.getCount() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransportTest::testWriteFailure() {
+
+    MyTransportListener listener;
+    this->transport->setFailOnSendMessage( true );
+    this->transport->setNumSentMessageBeforeFail( 2 );
+
+    AsyncWriteTransport asyncTransport( this->transport );
+    asyncTransport.setTransportListener( &listener );
+    asyncTransport.start();
+
+    for( int i = 0; i < 3; ++i ) {
+        asyncTransport.oneway( createMessage( i ) );
+    }
+
+    CPPUNIT_ASSERT( listener.exceptionFired.await( 5, TimeUnit::SECONDS ) );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException after a failed write",
+        asyncTransport.oneway( createMessage( 3 ) ),
+        IOException );
+
+    asyncTransport.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransportTest::testQueueFullFailFast() {
+
+    MyTransportListener listener;
+    MyOutgoingListener outgoing( 1 );
+    this->transport->setOutgoingListener( &outgoing );
+
+    AsyncWriteTransport asyncTransport( this->transport );
+    asyncTransport.setQueueSize( 1 );
+    asyncTransport.setBlockWhenFull( false );
+    asyncTransport.setTransportListener( &listener );
+    asyncTransport.start();
+
+    // The first command holds the writer, the second fills the queue.
+    asyncTransport.oneway( createMessage( 0 ) );
+    CPPUNIT_ASSERT( outgoing.writing.await( 5, TimeUnit::SECONDS ) );
+    asyncTransport.oneway( createMessage( 1 ) );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException when the queue is full",
+        asyncTransport.oneway( createMessage( 2 ) ),
+        IOException );
+
+    outgoing.release.countDown();
+    asyncTransport.close();
+
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 2, outgoing.commandIds.size() );
+    CPPUNIT_ASSERT_EQUAL( 1, listener.exceptionFired.getCount() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransportTest::testQueueBytesFull() {
+
+    MyTransportListener listener;
+    MyOutgoingListener outgoing( 1 );
+    this->transport->setOutgoingListener( &outgoing );
+
+    // Room for plenty of commands but not for the bytes of a second Message.
+    AsyncWriteTransport asyncTransport( this->transport );
+    asyncTransport.setQueueSize( 100 );
+    asyncTransport.setQueueBytes( 1500 );
+    asyncTransport.setBlockWhenFull( false );
+    asyncTransport.setTransportListener( &listener );
+    asyncTransport.start();
+
+    // The first command holds the writer, the second is taken by the empty queue.
+    asyncTransport.oneway( createMessage( 0 ) );
+    CPPUNIT_ASSERT( outgoing.writing.await( 5, TimeUnit::SECONDS ) );
+    asyncTransport.oneway( createMessage( 1 ) );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException when the queued bytes are at the limit",
+        asyncTransport.oneway( createMessage( 2 ) ),
+        IOException );
+
+    outgoing.release.countDown();
+    asyncTransport.close();
+
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 2, outgoing.commandIds.size() );
+    CPPUNIT_ASSERT_EQUAL( 1, listener.exceptionFired.getCount() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransportTest::testBlockedOnewayFailure() {
+
+    MyTransportListener listener;
+    MyFailingListener outgoing;
+    this->transport->setOutgoingListener( &outgoing );
+
+    AsyncWriteTransport asyncTransport( this->transport );
+    asyncTransport.setQueueSize( 1 );
+    asyncTransport.setTransportListener( &listener );
+    asyncTransport.start();
+
+    // The first command holds the writer, the second fills the queue so the third
+    // waits for room until the write fails.
+    asyncTransport.oneway( createMessage( 0 ) );
+    CPPUNIT_ASSERT( outgoing.writing.await( 5, TimeUnit::SECONDS ) );
+    asyncTransport.oneway( createMessage( 1 ) );
+
+    MyOnewayThread blocked( &asyncTransport );
+    blocked.start();
+    Thread::sleep( 100 );
+
+    outgoing.release.countDown();
+    blocked.join();
+
+    CPPUNIT_ASSERT_MESSAGE( "A caller waiting for room should see the write failure", blocked.failed );
+    CPPUNIT_ASSERT( listener.exceptionFired.await( 5, TimeUnit::SECONDS ) );
+
+    asyncTransport.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void AsyncWriteTransportTest::testOnewayAfterStop() {
+
+    MyTransportListener listener;
+    MyOutgoingListener outgoing;
+    this->transport->setOutgoingListener( &outgoing );
+
+    AsyncWriteTransport asyncTransport( this->transport );
+    asyncTransport.setTransportListener( &listener );
+    asyncTransport.start();
+
+    asyncTransport.oneway( createMessage( 0 ) );
+    asyncTransport.stop();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException once stopped",
+        asyncTransport.oneway( createMessage( 1 ) ),
+        IOException );
+
+    asyncTransport.close();
+
+    CPPUNIT_ASSERT_EQUAL( (std::size_t) 1, outgoing.commandIds.size() );
+}
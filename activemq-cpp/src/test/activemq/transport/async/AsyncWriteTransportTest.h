@@ -0,0 +1,69 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _ACTIVEMQ_TRANSPORT_ASYNC_ASYNCWRITETRANSPORTTEST_H_
+#define _ACTIVEMQ_TRANSPORT_ASYNC_ASYNCWRITETRANSPORTTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <activemq/util/Config.h>
+#include <activemq/transport/mock/MockTransport.h>
+
+#include <decaf/lang/Pointer.h>
+
+namespace activemq {
+namespace transport {
+namespace async {
+
+    class AsyncWriteTransportTest : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( AsyncWriteTransportTest );
+        CPPUNIT_TEST( testCreate );
+        CPPUNIT_TEST( testWriteOrder );
+        CPPUNIT_TEST( testWriteFailure );
+        CPPUNIT_TEST( testQueueFullFailFast );
+        CPPUNIT_TEST( testQueueBytesFull );
+        CPPUNIT_TEST( testBlockedOnewayFailure );
+        CPPUNIT_TEST( testOnewayAfterStop );
+        CPPUNIT_TEST_SUITE_END();
+
+    private:
+
+        decaf::lang::Pointer<mock::MockTransport> transport;
+
+    public:
+
+        AsyncWriteTransportTest();
+        virtual ~AsyncWriteTransportTest();
+
+        virtual void setUp();
+        virtual void tearDown();
+
+        void testCreate();
+        void testWriteOrder();
+        void testWriteFailure();
+        void testQueueFullFailFast();
+        void testQueueBytesFull();
+        void testBlockedOnewayFailure();
+        void testOnewayAfterStop();
+
+    };
+
+}}}
+
+#endif /* _ACTIVEMQ_TRANSPORT_ASYNC_ASYNCWRITETRANSPORTTEST_H_ */
@@ -0,0 +1,390 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NioIOTransportTest.h"
+
+#include <activemq/transport/nio/NioIOTransport.h>
+#include <activemq/transport/nio/NioReactor.h>
+#include <activemq/transport/nio/NioTransport.h>
+#include <activemq/transport/nio/NioTransportFactory.h>
+#include <activemq/transport/TransportListener.h>
+#include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/commands/Response.h>
+
+#include <decaf/io/BufferedOutputStream.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/DataInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/net/ServerSocket.h>
+#include <decaf/net/Socket.h>
+#include <decaf/net/URI.h>
+#include <decaf/util/Properties.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/Mutex.h>
+
+#include <memory>
+#include <typeinfo>
+#include <vector>
+
+using namespace activemq;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::transport::nio;
+using namespace activemq::wireformat;
+using namespace activemq::wireformat::openwire;
+using namespace decaf;
+using namespace decaf::io;
+using namespace decaf::lang;
+using namespace decaf::net;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class RecordingListener : public TransportListener {
+    private:
+
+        RecordingListener(const RecordingListener&);
+        RecordingListener& operator= (const RecordingListener&);
+
+    public:
+
+        Mutex mutex;
+        std::vector<int> received;
+        CountDownLatch commands;
+        CountDownLatch exceptions;
+
+        RecordingListener(int expected) : mutex(), received(), commands(expected), exceptions(1) {}
+        virtual ~RecordingListener() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+            synchronized(&mutex) {
+                received.push_back(command.dynamicCast<Response>()->getCorrelationId());
+            }
+            commands.countDown();
+        }
+
+        virtual void onException(const decaf::lang::Exception& ex AMQCPP_UNUSED) {
+            exceptions.countDown();
+        }
+
+        virtual void transportInterrupted() {}
+        virtual void transportResumed() {}
+    };
+
+    /**
+     * Holds up the thread that delivers its first command until it is released.
+     */
+    class BlockingListener : public RecordingListener {
+    private:
+
+        BlockingListener(const BlockingListener&);
+        BlockingListener& operator= (const BlockingListener&);
+
+    public:
+
+        CountDownLatch blocked;
+        CountDownLatch release;
+
+        BlockingListener(int expected) : RecordingListener(expected), blocked(1), release(1) {}
+        virtual ~BlockingListener() {}
+
+        virtual void onCommand(const Pointer<Command> command) {
+            blocked.countDown();
+            release.await();
+            RecordingListener::onCommand(command);
+        }
+    };
+
+    /**
+     * A connected pair of sockets, the client end is read by a NioIOTransport and the
+     * worker end plays the part of the broker.
+     */
+    class Endpoint {
+    private:
+
+        Endpoint(const Endpoint&);
+        Endpoint& operator= (const Endpoint&);
+
+    public:
+
+        Properties properties;
+        Pointer<OpenWireFormat> brokerWireFormat;
+        ServerSocket server;
+        Socket client;
+        std::auto_ptr<Socket> worker;
+        DataInputStream input;
+        DataOutputStream output;
+        DataOutputStream brokerOutput;
+        NioIOTransport transport;
+
+        Endpoint(const Pointer<NioReactor> reactor) :
+            properties(),
+            brokerWireFormat(new OpenWireFormat(properties)),
+            server(0),
+            client("127.0.0.1", server.getLocalPort()),
+            worker(server.accept()),
+            input(client.getInputStream()),
+            output(new BufferedOutputStream(client.getOutputStream()), true),
+            brokerOutput(new BufferedOutputStream(worker->getOutputStream()), true),
+            transport(Pointer<WireFormat>(new OpenWireFormat(properties)), reactor) {
+
+            transport.setInputStream(&input);
+            transport.setOutputStream(&output);
+            transport.setSocket(&client);
+        }
+
+        ~Endpoint() {
+            try {
+                transport.close();
+                worker->close();
+                client.close();
+                server.close();
+            } catch (...) {
+            }
+        }
+
+        static Pointer<Command> createCommand(int id) {
+            Pointer<Response> response(new Response());
+            response->setCorrelationId(id);
+            return response;
+        }
+
+        void send(int first, int count) {
+            for (int i = first; i < first + count; ++i) {
+                brokerWireFormat->marshal(createCommand(i), &transport, &brokerOutput);
+            }
+            brokerOutput.flush();
+        }
+    };
+
+    bool isSequence(const std::vector<int>& values, int count) {
+        if ((int) values.size() != count) {
+            return false;
+        }
+        for (int i = 0; i < count; ++i) {
+            if (values[i] != i) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioIOTransportTest::testReadCommands() {
+
+    Pointer<NioReactor> reactor(new NioReactor(1));
+    Endpoint endpoint(reactor);
+
+    RecordingListener listener(500);
+    endpoint.transport.setTransportListener(&listener);
+    endpoint.transport.start();
+
+    endpoint.send(0, 200);
+    endpoint.send(200, 300);
+
+    CPPUNIT_ASSERT(listener.commands.await(10000));
+    CPPUNIT_ASSERT(isSequence(listener.received, 500));
+    CPPUNIT_ASSERT_EQUAL(1, (int) listener.exceptions.getCount());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioIOTransportTest::testFragmentedFrames() {
+
+    Pointer<NioReactor> reactor(new NioReactor(1));
+    Endpoint endpoint(reactor);
+
+    RecordingListener listener(3);
+    endpoint.transport.setTransportListener(&listener);
+    endpoint.transport.start();
+
+    ByteArrayOutputStream bytes;
+    DataOutputStream frames(&bytes);
+    for (int i = 0; i < 3; ++i) {
+        endpoint.brokerWireFormat->marshal(Endpoint::createCommand(i), &endpoint.transport, &frames);
+    }
+
+    // Trickle the frames out so that they arrive split at every possible point.
+    std::pair<const unsigned char*, int> array = bytes.toByteArray();
+    std::vector<unsigned char> data(array.first, array.first + array.second);
+    delete [] array.first;
+
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        endpoint.brokerOutput.write(data[i]);
+        endpoint.brokerOutput.flush();
+        Thread::sleep(1);
+    }
+
+    CPPUNIT_ASSERT(listener.commands.await(10000));
+    CPPUNIT_ASSERT(isSequence(listener.received, 3));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioIOTransportTest::testSharedReactor() {
+
+    static const int CONNECTIONS = 4;
+    static const int COMMANDS = 250;
+
+    Pointer<NioReactor> reactor(new NioReactor(1));
+
+    std::vector<Endpoint*> endpoints;
+    std::vector<RecordingListener*> listeners;
+
+    for (int i = 0; i < CONNECTIONS; ++i) {
+        endpoints.push_back(new Endpoint(reactor));
+        listeners.push_back(new RecordingListener(COMMANDS));
+        endpoints[i]->transport.setTransportListener(listeners[i]);
+        endpoints[i]->transport.start();
+    }
+
+    for (int j = 0; j < COMMANDS; j += 50) {
+        for (int i = 0; i < CONNECTIONS; ++i) {
+            endpoints[i]->send(j, 50);
+        }
+    }
+
+    for (int i = 0; i < CONNECTIONS; ++i) {
+        CPPUNIT_ASSERT(listeners[i]->commands.await(10000));
+        CPPUNIT_ASSERT(isSequence(listeners[i]->received, COMMANDS));
+    }
+
+    for (int i = 0; i < CONNECTIONS; ++i) {
+        delete endpoints[i];
+        delete listeners[i];
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioIOTransportTest::testBlockedListener() {
+
+    // Both transports are read by the one reactor thread, the listeners run on the
+    // dispatch threads.
+    Pointer<NioReactor> reactor(new NioReactor(1, 2));
+
+    Endpoint slowEndpoint(reactor);
+    Endpoint endpoint(reactor);
+
+    BlockingListener slowListener(10);
+    RecordingListener listener(10);
+
+    slowEndpoint.transport.setTransportListener(&slowListener);
+    slowEndpoint.transport.start();
+    endpoint.transport.setTransportListener(&listener);
+    endpoint.transport.start();
+
+    slowEndpoint.send(0, 10);
+    CPPUNIT_ASSERT(slowListener.blocked.await(10000));
+
+    endpoint.send(0, 10);
+    CPPUNIT_ASSERT_MESSAGE("A blocked listener should not hold up the reactor thread",
+                           listener.commands.await(10000));
+    CPPUNIT_ASSERT(isSequence(listener.received, 10));
+
+    slowListener.release.countDown();
+    CPPUNIT_ASSERT(slowListener.commands.await(10000));
+    CPPUNIT_ASSERT(isSequence(slowListener.received, 10));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioIOTransportTest::testWrite() {
+
+    Pointer<NioReactor> reactor(new NioReactor(1));
+    Endpoint endpoint(reactor);
+
+    RecordingListener listener(1);
+    endpoint.transport.setTransportListener(&listener);
+    endpoint.transport.start();
+
+    endpoint.transport.oneway(Endpoint::createCommand(7));
+
+    DataInputStream brokerInput(endpoint.worker->getInputStream());
+    Pointer<Command> command = endpoint.brokerWireFormat->unmarshal(&endpoint.transport, &brokerInput);
+    CPPUNIT_ASSERT_EQUAL(7, command.dynamicCast<Response>()->getCorrelationId());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioIOTransportTest::testRemoteClose() {
+
+    Pointer<NioReactor> reactor(new NioReactor(1));
+    Endpoint endpoint(reactor);
+
+    RecordingListener listener(1);
+    endpoint.transport.setTransportListener(&listener);
+    endpoint.transport.start();
+
+    endpoint.send(0, 1);
+    CPPUNIT_ASSERT(listener.commands.await(10000));
+
+    endpoint.worker->close();
+    CPPUNIT_ASSERT(listener.exceptions.await(10000));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioIOTransportTest::testOversizedFrame() {
+
+    Pointer<NioReactor> reactor(new NioReactor(1));
+    Endpoint endpoint(reactor);
+
+    RecordingListener listener(1);
+    endpoint.transport.setTransportListener(&listener);
+    endpoint.transport.start();
+
+    // A size prefix past the wire format's limit fails the transport instead of
+    // growing the read buffer to fit it.
+    endpoint.brokerOutput.writeInt(0x7FFFFFFE);
+    endpoint.brokerOutput.flush();
+
+    CPPUNIT_ASSERT(listener.exceptions.await(10000));
+    CPPUNIT_ASSERT(listener.received.empty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioIOTransportTest::testCloseWhileIdle() {
+
+    Pointer<NioReactor> reactor(new NioReactor(2));
+    CPPUNIT_ASSERT_EQUAL(2, reactor->getThreadCount());
+
+    Endpoint endpoint(reactor);
+
+    RecordingListener listener(1);
+    endpoint.transport.setTransportListener(&listener);
+    endpoint.transport.start();
+
+    endpoint.transport.close();
+    CPPUNIT_ASSERT(endpoint.transport.isClosed());
+
+    // Nothing is read once the transport has left the reactor.
+    endpoint.send(0, 1);
+    CPPUNIT_ASSERT(!listener.commands.await(200));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void NioIOTransportTest::testFactoryCreate() {
+
+    NioTransportFactory factory;
+    Pointer<Transport> transport(factory.createComposite(URI("nio://127.0.0.1:61616")));
+
+    CPPUNIT_ASSERT(transport != NULL);
+    CPPUNIT_ASSERT(transport->narrow(typeid(NioTransport)) != NULL);
+    CPPUNIT_ASSERT(transport->narrow(typeid(NioIOTransport)) != NULL);
+    CPPUNIT_ASSERT(transport->narrow(typeid(IOTransport)) != NULL);
+
+    transport->close();
+}
@@ -336,3 +336,34 @@ void MarshallingSupportTest::testReadString32() {
 
     delete [] array.first;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void MarshallingSupportTest::testModifiedUtf8AsciiPrefix() {
+
+    const unsigned char special[] = { 0x00, 0x7F, 0x80, 0xFF };
+
+    std::string encoded;
+    std::string decoded;
+
+    for( int i = 0; i < 4; ++i ) {
+        for( std::size_t position = 0; position <= 70; ++position ) {
+
+            std::string value( 70, 'z' );
+            if( position < value.length() ) {
+                value[position] = (char) special[i];
+            }
+
+            MarshallingSupport::asciiToModifiedUtf8( value, encoded );
+            CPPUNIT_ASSERT_EQUAL( MarshallingSupport::asciiToModifiedUtf8( value ), encoded );
+
+            std::size_t expectedLength = value.length();
+            if( position < value.length() && special[i] != 0x7F ) {
+                expectedLength++;
+            }
+            CPPUNIT_ASSERT_EQUAL( expectedLength, encoded.length() );
+
+            MarshallingSupport::modifiedUtf8ToAscii( encoded, decoded );
+            CPPUNIT_ASSERT_EQUAL( value, decoded );
+        }
+    }
+}
@@ -17,18 +17,113 @@
 
 #include "OpenWireFormatTest.h"
 
+#include <decaf/lang/Integer.h>
+#include <decaf/lang/Long.h>
 #include <decaf/util/Properties.h>
+#include <decaf/io/ByteArrayOutputStream.h>
+#include <decaf/io/ByteArrayInputStream.h>
+#include <decaf/io/DataOutputStream.h>
+#include <decaf/io/DataInputStream.h>
 #include <activemq/wireformat/openwire/OpenWireFormat.h>
+#include <activemq/wireformat/openwire/OpenWireResponseBuilder.h>
+#include <activemq/wireformat/openwire/utils/BooleanStream.h>
+#include <activemq/transport/mock/MockTransport.h>
+#include <activemq/commands/ActiveMQTextMessage.h>
+#include <activemq/commands/ActiveMQBytesMessage.h>
+#include <activemq/commands/ActiveMQQueue.h>
+#include <activemq/commands/ActiveMQTopic.h>
+#include <activemq/commands/ProducerId.h>
+#include <activemq/commands/MessageId.h>
+#include <activemq/commands/MessageAck.h>
+#include <activemq/commands/MessageDispatch.h>
+#include <activemq/commands/ConsumerId.h>
 
 using namespace std;
 using namespace activemq;
 using namespace activemq::util;
+using namespace activemq::commands;
+using namespace activemq::transport;
+using namespace activemq::transport::mock;
 using namespace decaf::io;
 using namespace decaf::lang;
 using namespace decaf::util;
 using namespace activemq::exceptions;
 using namespace activemq::wireformat;
 using namespace activemq::wireformat::openwire;
+using namespace activemq::wireformat::openwire::utils;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    Pointer<OpenWireFormat> createCachingWireFormat(bool tight, int cacheSize) {
+        Properties properties;
+        Pointer<OpenWireFormat> wireFormat(new OpenWireFormat(properties));
+        wireFormat->setTightEncodingEnabled(tight);
+        wireFormat->setCacheSize(cacheSize);
+        wireFormat->setCacheEnabled(true);
+        return wireFormat;
+    }
+
+    Pointer<ActiveMQTextMessage> createMessage(const std::string& destination, long long sequenceId) {
+        Pointer<ProducerId> producerId(new ProducerId());
+        producerId->setConnectionId("ID:test-connection-1");
+        producerId->setSessionId(1);
+        producerId->setValue(2);
+
+        Pointer<ActiveMQTextMessage> message(new ActiveMQTextMessage());
+        message->setProducerId(producerId);
+        message->setMessageId(Pointer<MessageId>(new MessageId(producerId, sequenceId)));
+        message->setDestination(Pointer<ActiveMQDestination>(new ActiveMQQueue(destination)));
+        message->setText("payload");
+        return message;
+    }
+
+    std::vector<unsigned char> marshalCommand(Pointer<OpenWireFormat> wireFormat, Pointer<Command> command) {
+        MockTransport transport(wireFormat, Pointer<ResponseBuilder>(new OpenWireResponseBuilder()));
+        ByteArrayOutputStream bytes;
+        DataOutputStream dataOut(&bytes);
+        wireFormat->marshal(command, &transport, &dataOut);
+        dataOut.flush();
+
+        std::pair<unsigned char*, int> array = bytes.toByteArray();
+        std::vector<unsigned char> result(array.first, array.first + array.second);
+        delete [] array.first;
+        return result;
+    }
+
+    Pointer<ActiveMQTextMessage> unmarshalMessage(Pointer<OpenWireFormat> wireFormat, const std::vector<unsigned char>& frame) {
+        MockTransport transport(wireFormat, Pointer<ResponseBuilder>(new OpenWireResponseBuilder()));
+        ByteArrayInputStream bytes(&frame[0], (int) frame.size());
+        DataInputStream dataIn(&bytes);
+        return wireFormat->unmarshal(&transport, &dataIn).dynamicCast<ActiveMQTextMessage>();
+    }
+
+    void doTestMarshalCache(bool tight) {
+
+        Pointer<OpenWireFormat> sender = createCachingWireFormat(tight, 1024);
+        Pointer<OpenWireFormat> receiver = createCachingWireFormat(tight, 1024);
+
+        std::vector<unsigned char> first = marshalCommand(sender, createMessage("TEST.QUEUE", 1));
+        std::vector<unsigned char> second = marshalCommand(sender, createMessage("TEST.QUEUE", 2));
+
+        CPPUNIT_ASSERT_MESSAGE("Cached ids should shrink the second frame", second.size() < first.size());
+
+        Pointer<ActiveMQTextMessage> message1 = unmarshalMessage(receiver, first);
+        Pointer<ActiveMQTextMessage> message2 = unmarshalMessage(receiver, second);
+
+        CPPUNIT_ASSERT(message1->getDestination() != NULL);
+        CPPUNIT_ASSERT(message2->getDestination() != NULL);
+        CPPUNIT_ASSERT_EQUAL(std::string("TEST.QUEUE"), message2->getDestination()->getPhysicalName());
+        CPPUNIT_ASSERT(message1->getDestination()->equals(message2->getDestination().get()));
+        CPPUNIT_ASSERT(message1->getDestination() != message2->getDestination());
+        CPPUNIT_ASSERT(message2->getProducerId() != NULL);
+        CPPUNIT_ASSERT_EQUAL(std::string("ID:test-connection-1"), message2->getProducerId()->getConnectionId());
+        CPPUNIT_ASSERT_EQUAL(2LL, message2->getMessageId()->getProducerSequenceId());
+        CPPUNIT_ASSERT(message2->getMessageId()->getProducerId()->equals(message1->getProducerId().get()));
+        CPPUNIT_ASSERT(message2->getTransactionId() == NULL);
+        CPPUNIT_ASSERT_EQUAL(std::string("payload"), message2->getText());
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 void OpenWireFormatTest::test()
@@ -36,3 +131,398 @@ void OpenWireFormatTest::test()
     Properties properties;
     //OpenWireFormat myWireFormat( properties );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testLooseMarshalCache() {
+    doTestMarshalCache(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testTightMarshalCache() {
+    doTestMarshalCache(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testMarshalCacheEviction() {
+
+    const char* destinations[] = { "QUEUE.A", "QUEUE.B", "QUEUE.C" };
+
+    for (int pass = 0; pass < 2; ++pass) {
+
+        bool tight = pass == 1;
+
+        // The cache only holds two entries so every message evicts something.
+        Pointer<OpenWireFormat> sender = createCachingWireFormat(tight, 2);
+        Pointer<OpenWireFormat> receiver = createCachingWireFormat(tight, 2);
+
+        for (int i = 0; i < 12; ++i) {
+            std::string destination = destinations[i % 3];
+            Pointer<ActiveMQTextMessage> message = unmarshalMessage(receiver, marshalCommand(sender, createMessage(destination, i)));
+
+            CPPUNIT_ASSERT_EQUAL(destination, message->getDestination()->getPhysicalName());
+            CPPUNIT_ASSERT_EQUAL((long long) i, message->getMessageId()->getProducerSequenceId());
+            CPPUNIT_ASSERT_EQUAL(std::string("ID:test-connection-1"), message->getProducerId()->getConnectionId());
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testMarshalCacheKeyIncludesType() {
+
+    for (int pass = 0; pass < 2; ++pass) {
+
+        bool tight = pass == 1;
+
+        Pointer<OpenWireFormat> sender = createCachingWireFormat(tight, 1024);
+        Pointer<OpenWireFormat> receiver = createCachingWireFormat(tight, 1024);
+
+        // Destinations compare equal by name alone, the cache must still tell
+        // a queue from a topic with the same name.
+        Pointer<ActiveMQTextMessage> queueMessage = createMessage("SAME.NAME", 1);
+        Pointer<ActiveMQTextMessage> topicMessage = createMessage("SAME.NAME", 2);
+        topicMessage->setDestination(Pointer<ActiveMQDestination>(new ActiveMQTopic("SAME.NAME")));
+
+        Pointer<ActiveMQTextMessage> result1 = unmarshalMessage(receiver, marshalCommand(sender, queueMessage));
+        Pointer<ActiveMQTextMessage> result2 = unmarshalMessage(receiver, marshalCommand(sender, topicMessage));
+
+        CPPUNIT_ASSERT_EQUAL((int) ActiveMQQueue::ID_ACTIVEMQQUEUE, (int) result1->getDestination()->getDataStructureType());
+        CPPUNIT_ASSERT_EQUAL((int) ActiveMQTopic::ID_ACTIVEMQTOPIC, (int) result2->getDestination()->getDataStructureType());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testUnmarshalCacheIndexAboveCacheSize() {
+
+    for (int pass = 0; pass < 2; ++pass) {
+
+        bool tight = pass == 1;
+
+        // The sender fills its cache past the size the receiver was configured
+        // with, the way a Java broker uses its whole cache.
+        Pointer<OpenWireFormat> sender = createCachingWireFormat(tight, OpenWireFormat::MARSHAL_CACHE_SIZE);
+        Pointer<OpenWireFormat> receiver = createCachingWireFormat(tight, 16);
+
+        for (int i = 0; i < 64; ++i) {
+            std::string name = "TEST.QUEUE." + Integer::toString(i);
+            Pointer<ActiveMQTextMessage> message = unmarshalMessage(receiver, marshalCommand(sender, createMessage(name, i)));
+            CPPUNIT_ASSERT_EQUAL(name, message->getDestination()->getPhysicalName());
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testLooseMarshalFrameBuffer() {
+
+    Pointer<OpenWireFormat> sender = createCachingWireFormat(false, 1024);
+    Pointer<OpenWireFormat> receiver = createCachingWireFormat(false, 1024);
+
+    // Alternate small and large frames so the staging buffer is both reused
+    // and discarded after growing past the retained size.
+    const int sizes[] = { 10, 100 * 1024, 20, 1000, 200 * 1024, 5 };
+
+    for (int i = 0; i < 6; ++i) {
+
+        Pointer<ActiveMQTextMessage> message = createMessage("TEST.QUEUE", i);
+        message->setText(std::string(sizes[i], 'a' + i));
+
+        std::vector<unsigned char> frame = marshalCommand(sender, message);
+
+        CPPUNIT_ASSERT(frame.size() > 4);
+        int prefix = (frame[0] << 24) | (frame[1] << 16) | (frame[2] << 8) | frame[3];
+        CPPUNIT_ASSERT_EQUAL((int) frame.size() - 4, prefix);
+
+        Pointer<ActiveMQTextMessage> result = unmarshalMessage(receiver, frame);
+        CPPUNIT_ASSERT_EQUAL(message->getText(), result->getText());
+        CPPUNIT_ASSERT_EQUAL((long long) i, result->getMessageId()->getProducerSequenceId());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testUnmarshalFrames() {
+
+    for (int pass = 0; pass < 2; ++pass) {
+
+        bool tight = pass == 1;
+
+        Pointer<OpenWireFormat> sender = createCachingWireFormat(tight, 1024);
+        Pointer<OpenWireFormat> receiver = createCachingWireFormat(tight, 1024);
+
+        // Several frames back to back in one stream, each read must stop at the
+        // end of its own frame.
+        const int sizes[] = { 10, 100 * 1024, 0, 20 };
+        std::vector<unsigned char> stream;
+
+        for (int i = 0; i < 4; ++i) {
+            Pointer<ActiveMQTextMessage> message = createMessage("TEST.QUEUE", i);
+            message->setText(std::string(sizes[i], 'a' + i));
+            std::vector<unsigned char> frame = marshalCommand(sender, message);
+            stream.insert(stream.end(), frame.begin(), frame.end());
+        }
+
+        MockTransport transport(receiver, Pointer<ResponseBuilder>(new OpenWireResponseBuilder()));
+        ByteArrayInputStream bytes(&stream[0], (int) stream.size());
+        DataInputStream dataIn(&bytes);
+
+        for (int i = 0; i < 4; ++i) {
+            Pointer<ActiveMQTextMessage> message = receiver->unmarshal(&transport, &dataIn).dynamicCast<ActiveMQTextMessage>();
+            CPPUNIT_ASSERT_EQUAL(std::string(sizes[i], 'a' + i), message->getText());
+            CPPUNIT_ASSERT_EQUAL((long long) i, message->getMessageId()->getProducerSequenceId());
+        }
+
+        CPPUNIT_ASSERT_EQUAL(0, bytes.available());
+
+        // A truncated frame must fail rather than read into whatever follows.
+        std::vector<unsigned char> frame = marshalCommand(sender, createMessage("TEST.QUEUE", 5));
+        frame.resize(frame.size() - 3);
+        ByteArrayInputStream truncated(&frame[0], (int) frame.size());
+        DataInputStream truncatedIn(&truncated);
+
+        CPPUNIT_ASSERT_THROW_MESSAGE(
+            "Should throw an IOException",
+            receiver->unmarshal(&transport, &truncatedIn),
+            IOException);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testUnmarshalLargeBody() {
+
+    for (int pass = 0; pass < 2; ++pass) {
+
+        bool tight = pass == 1;
+
+        Pointer<OpenWireFormat> sender = createCachingWireFormat(tight, 1024);
+        Pointer<OpenWireFormat> receiver = createCachingWireFormat(tight, 1024);
+
+        // Bodies on either side of the retained frame size, the larger one grows the
+        // frame buffer past what is kept, both must arrive intact with the properties.
+        const int sizes[] = { 1024, OpenWireFormat::MAX_RETAINED_FRAME_BUFFER_SIZE * 4 };
+        std::vector<unsigned char> stream;
+
+        for (int i = 0; i < 2; ++i) {
+            Pointer<ActiveMQBytesMessage> message(new ActiveMQBytesMessage());
+            message->setMessageId(createMessage("TEST.QUEUE", i)->getMessageId());
+            message->setIntProperty("index", i);
+
+            std::vector<unsigned char> body(sizes[i]);
+            for (int j = 0; j < sizes[i]; ++j) {
+                body[j] = (unsigned char) (j % 251);
+            }
+            message->setContent(body);
+
+            std::vector<unsigned char> frame = marshalCommand(sender, message);
+            stream.insert(stream.end(), frame.begin(), frame.end());
+        }
+
+        MockTransport transport(receiver, Pointer<ResponseBuilder>(new OpenWireResponseBuilder()));
+        ByteArrayInputStream bytes(&stream[0], (int) stream.size());
+        DataInputStream dataIn(&bytes);
+
+        for (int i = 0; i < 2; ++i) {
+            Pointer<ActiveMQBytesMessage> message = receiver->unmarshal(&transport, &dataIn).dynamicCast<ActiveMQBytesMessage>();
+            const std::vector<unsigned char>& content = message->getContent();
+            CPPUNIT_ASSERT_EQUAL((std::size_t) sizes[i], content.size());
+            for (int j = 0; j < sizes[i]; ++j) {
+                CPPUNIT_ASSERT_EQUAL((unsigned char) (j % 251), content[j]);
+            }
+            CPPUNIT_ASSERT_EQUAL(i, message->getIntProperty("index"));
+        }
+
+        CPPUNIT_ASSERT_EQUAL(0, bytes.available());
+
+        // A large frame whose size prefix is too small must fail without reading
+        // into the frame that follows it.
+        Pointer<ActiveMQBytesMessage> large(new ActiveMQBytesMessage());
+        large->setMessageId(createMessage("TEST.QUEUE", 3)->getMessageId());
+        large->setContent(std::vector<unsigned char>(sizes[1], 0x42));
+
+        std::vector<unsigned char> corrupt = marshalCommand(sender, large);
+        int prefix = (int) corrupt.size() - 4 - 1024;
+        corrupt[0] = (unsigned char) (prefix >> 24);
+        corrupt[1] = (unsigned char) (prefix >> 16);
+        corrupt[2] = (unsigned char) (prefix >> 8);
+        corrupt[3] = (unsigned char) prefix;
+
+        ByteArrayInputStream corruptBytes(&corrupt[0], (int) corrupt.size());
+        DataInputStream corruptIn(&corruptBytes);
+
+        CPPUNIT_ASSERT_THROW_MESSAGE(
+            "Should throw an IOException",
+            receiver->unmarshal(&transport, &corruptIn),
+            IOException);
+        CPPUNIT_ASSERT(corruptBytes.available() >= 1024);
+
+        // And a truncated large frame fails rather than returning a short body.
+        std::vector<unsigned char> truncated = marshalCommand(sender, large);
+        truncated.resize(truncated.size() - 100);
+        ByteArrayInputStream truncatedBytes(&truncated[0], (int) truncated.size());
+        DataInputStream truncatedIn(&truncatedBytes);
+
+        CPPUNIT_ASSERT_THROW_MESSAGE(
+            "Should throw an IOException",
+            receiver->unmarshal(&transport, &truncatedIn),
+            IOException);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testMaxFrameSize() {
+
+    Pointer<OpenWireFormat> sender = createCachingWireFormat(true, 1024);
+    Pointer<OpenWireFormat> receiver = createCachingWireFormat(true, 1024);
+    MockTransport transport(receiver, Pointer<ResponseBuilder>(new OpenWireResponseBuilder()));
+
+    CPPUNIT_ASSERT_EQUAL(Long::MAX_VALUE, receiver->getMaxFrameSize());
+
+    // With a limit configured a size prefix near the int limit must be refused before
+    // anything is allocated.
+    receiver->setMaxFrameSize(1024 * 1024);
+
+    unsigned char hostile[] = { 0x7F, 0xFF, 0xFF, 0xF0, 0x01 };
+    ByteArrayInputStream hostileBytes(hostile, 5);
+    DataInputStream hostileIn(&hostileBytes);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        receiver->unmarshal(&transport, &hostileIn),
+        IOException);
+
+    ByteArrayInputStream hostileFrameBytes(hostile, 5);
+    DataInputStream hostileFrameIn(&hostileFrameBytes);
+    std::vector<unsigned char> frame;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        receiver->readFrame(&hostileFrameIn, frame),
+        IOException);
+
+    // Frames at the configured limit are accepted, larger ones are not.
+    Pointer<ActiveMQTextMessage> message = createMessage("TEST.QUEUE", 1);
+    message->setText(std::string(1000, 'a'));
+    std::vector<unsigned char> marshaled = marshalCommand(sender, message);
+
+    receiver->setMaxFrameSize((long long) marshaled.size() - 4);
+    CPPUNIT_ASSERT(unmarshalMessage(receiver, marshaled) != NULL);
+
+    receiver->setMaxFrameSize((long long) marshaled.size() - 5);
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IOException",
+        unmarshalMessage(receiver, marshaled),
+        IOException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testNestedIdFastPath() {
+
+    Pointer<ConsumerId> consumerId(new ConsumerId());
+    consumerId->setConnectionId("ID:test-connection-1");
+    consumerId->setSessionId(1);
+    consumerId->setValue(3);
+
+    Pointer<MessageAck> ack(new MessageAck());
+    ack->setConsumerId(consumerId);
+    ack->setDestination(Pointer<ActiveMQDestination>(new ActiveMQQueue("TEST.QUEUE")));
+    ack->setFirstMessageId(createMessage("TEST.QUEUE", 1)->getMessageId());
+    ack->setLastMessageId(createMessage("TEST.QUEUE", 9)->getMessageId());
+    ack->setMessageCount(9);
+
+    // The single pass tight marshal writes the ids with their own marshallers while
+    // the two pass marshal still goes through the marshaller table, both must match.
+    Pointer<OpenWireFormat> wireFormat = createCachingWireFormat(true, 1024);
+    wireFormat->setCacheEnabled(false);
+
+    ByteArrayOutputStream expected;
+    DataOutputStream expectedOut(&expected);
+    BooleanStream bs;
+    wireFormat->tightMarshalNestedObject1(ack.get(), &bs);
+    bs.marshal(&expectedOut);
+    wireFormat->tightMarshalNestedObject2(ack.get(), &expectedOut, &bs);
+
+    ByteArrayOutputStream body;
+    DataOutputStream bodyOut(&body);
+    BooleanStream singleBs;
+    wireFormat->tightMarshalNestedObject(ack.get(), &bodyOut, &singleBs);
+
+    ByteArrayOutputStream actual;
+    DataOutputStream actualOut(&actual);
+    singleBs.marshal(&actualOut);
+    body.writeTo(&actualOut);
+
+    CPPUNIT_ASSERT_EQUAL(expected.toString(), actual.toString());
+
+    // Round trip with the cache on so that the second ack reads its ids from the cache.
+    for (int pass = 0; pass < 2; ++pass) {
+
+        bool tight = pass == 1;
+
+        Pointer<OpenWireFormat> sender = createCachingWireFormat(tight, 1024);
+        Pointer<OpenWireFormat> receiver = createCachingWireFormat(tight, 1024);
+
+        std::vector<unsigned char> stream = marshalCommand(sender, ack);
+        std::vector<unsigned char> second = marshalCommand(sender, ack);
+        CPPUNIT_ASSERT(second.size() < stream.size());
+        stream.insert(stream.end(), second.begin(), second.end());
+
+        MockTransport transport(receiver, Pointer<ResponseBuilder>(new OpenWireResponseBuilder()));
+        ByteArrayInputStream bytes(&stream[0], (int) stream.size());
+        DataInputStream dataIn(&bytes);
+
+        for (int i = 0; i < 2; ++i) {
+            Pointer<MessageAck> received = receiver->unmarshal(&transport, &dataIn).dynamicCast<MessageAck>();
+            CPPUNIT_ASSERT(received->getConsumerId()->equals(consumerId.get()));
+            CPPUNIT_ASSERT(received->getFirstMessageId()->equals(ack->getFirstMessageId().get()));
+            CPPUNIT_ASSERT(received->getLastMessageId()->equals(ack->getLastMessageId().get()));
+            CPPUNIT_ASSERT_EQUAL(9, received->getMessageCount());
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void OpenWireFormatTest::testReadFrame() {
+
+    for (int pass = 0; pass < 2; ++pass) {
+
+        bool tight = pass == 1;
+
+        Pointer<OpenWireFormat> sender = createCachingWireFormat(tight, 1024);
+        Pointer<OpenWireFormat> receiver = createCachingWireFormat(tight, 1024);
+        sender->setCacheEnabled(false);
+        receiver->setCacheEnabled(false);
+
+        CPPUNIT_ASSERT(receiver->isFrameUnmarshalSupported());
+
+        Pointer<MessageDispatch> dispatch(new MessageDispatch());
+        dispatch->setMessage(createMessage("TEST.QUEUE", 1));
+        dispatch->setDestination(dispatch->getMessage()->getDestination());
+
+        std::vector<unsigned char> stream = marshalCommand(sender, dispatch);
+        std::vector<unsigned char> ack = marshalCommand(sender, Pointer<Command>(new MessageAck()));
+        stream.insert(stream.end(), ack.begin(), ack.end());
+
+        MockTransport transport(receiver, Pointer<ResponseBuilder>(new OpenWireResponseBuilder()));
+        ByteArrayInputStream bytes(&stream[0], (int) stream.size());
+        DataInputStream dataIn(&bytes);
+
+        // Only the dispatch can be decoded out of order.
+        std::vector<unsigned char> frame;
+        CPPUNIT_ASSERT(receiver->readFrame(&dataIn, frame));
+        Pointer<MessageDispatch> result = receiver->unmarshalFrame(&transport, frame).dynamicCast<MessageDispatch>();
+        CPPUNIT_ASSERT(result != NULL);
+        CPPUNIT_ASSERT_EQUAL(std::string("payload"),
+            result->getMessage().dynamicCast<ActiveMQTextMessage>()->getText());
+
+        CPPUNIT_ASSERT(!receiver->readFrame(&dataIn, frame));
+        CPPUNIT_ASSERT(receiver->unmarshalFrame(&transport, frame).dynamicCast<MessageAck>() != NULL);
+        CPPUNIT_ASSERT_EQUAL(0, bytes.available());
+
+        // With the cache on a dispatch may refer to entries set by earlier frames.
+        Pointer<OpenWireFormat> caching = createCachingWireFormat(tight, 1024);
+        std::vector<unsigned char> cached = marshalCommand(caching, dispatch);
+        ByteArrayInputStream cachedBytes(&cached[0], (int) cached.size());
+        DataInputStream cachedIn(&cachedBytes);
+        CPPUNIT_ASSERT(!caching->readFrame(&cachedIn, frame));
+
+        receiver->setSizePrefixDisabled(true);
+        CPPUNIT_ASSERT(!receiver->isFrameUnmarshalSupported());
+    }
+}
@@ -29,6 +29,17 @@ namespace openwire {
 
         CPPUNIT_TEST_SUITE( OpenWireFormatTest );
         CPPUNIT_TEST( test );
+        CPPUNIT_TEST( testLooseMarshalCache );
+        CPPUNIT_TEST( testTightMarshalCache );
+        CPPUNIT_TEST( testMarshalCacheEviction );
+        CPPUNIT_TEST( testMarshalCacheKeyIncludesType );
+        CPPUNIT_TEST( testUnmarshalCacheIndexAboveCacheSize );
+        CPPUNIT_TEST( testLooseMarshalFrameBuffer );
+        CPPUNIT_TEST( testUnmarshalFrames );
+        CPPUNIT_TEST( testUnmarshalLargeBody );
+        CPPUNIT_TEST( testMaxFrameSize );
+        CPPUNIT_TEST( testNestedIdFastPath );
+        CPPUNIT_TEST( testReadFrame );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -37,6 +48,17 @@ namespace openwire {
         virtual ~OpenWireFormatTest() {}
 
         virtual void test();
+        virtual void testLooseMarshalCache();
+        virtual void testTightMarshalCache();
+        virtual void testMarshalCacheEviction();
+        virtual void testMarshalCacheKeyIncludesType();
+        virtual void testUnmarshalCacheIndexAboveCacheSize();
+        virtual void testLooseMarshalFrameBuffer();
+        virtual void testUnmarshalFrames();
+        virtual void testUnmarshalLargeBody();
+        virtual void testMaxFrameSize();
+        virtual void testNestedIdFastPath();
+        virtual void testReadFrame();
 
     };
 
@@ -167,3 +167,56 @@ void BaseDataStreamMarshallerTest::testTightMarshal()
 
     delete [] array.first;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void BaseDataStreamMarshallerTest::testTightMarshalSinglePass()
+{
+    SimpleDataStructureMarshaller* simpleMarshaller = new SimpleDataStructureMarshaller();
+    ComplexDataStructureMarshaller* complexMarshaller = new ComplexDataStructureMarshaller();
+    Properties props;
+    OpenWireFormat openWireFormat(props);
+    openWireFormat.addMarshaller( simpleMarshaller );
+    openWireFormat.addMarshaller( complexMarshaller );
+
+    // Two pass marshal to use as the expected result.
+    ByteArrayOutputStream expected;
+    DataOutputStream expectedOut( &expected );
+
+    BooleanStream bs;
+    int size = complexMarshaller->tightMarshal1( &openWireFormat, dataStructure, &bs );
+    bs.marshal( &expectedOut );
+    int header = (int) expected.size();
+    complexMarshaller->tightMarshal2( &openWireFormat, dataStructure, &expectedOut, &bs );
+
+    CPPUNIT_ASSERT_EQUAL( size, (int) expected.size() - header );
+
+    // Single pass marshal, body first and then the boolean stream.
+    ByteArrayOutputStream body;
+    DataOutputStream bodyOut( &body );
+    BooleanStream singleBs;
+    complexMarshaller->tightMarshal( &openWireFormat, dataStructure, &bodyOut, &singleBs );
+
+    ByteArrayOutputStream actual;
+    DataOutputStream actualOut( &actual );
+    singleBs.marshal( &actualOut );
+    body.writeTo( &actualOut );
+
+    CPPUNIT_ASSERT_EQUAL( expected.toString(), actual.toString() );
+
+    // Now read it back in and make sure it's all right.
+    std::pair<const unsigned char*, int> array = actual.toByteArray();
+    ByteArrayInputStream bais( array.first, array.second );
+    DataInputStream dataIn( &bais );
+
+    ComplexDataStructure ds;
+    bs.clear();
+    bs.unmarshal( &dataIn );
+    complexMarshaller->tightUnmarshal( &openWireFormat, &ds, &dataIn, &bs );
+
+    CPPUNIT_ASSERT_EQUAL( dataStructure->boolValue, ds.boolValue );
+    CPPUNIT_ASSERT( ds.cachedChild != NULL );
+    CPPUNIT_ASSERT_EQUAL( dataStructure->cachedChild->longValue3, ds.cachedChild->longValue3 );
+    CPPUNIT_ASSERT_EQUAL( dataStructure->cachedChild->stringValue, ds.cachedChild->stringValue );
+
+    delete [] array.first;
+}
@@ -34,6 +34,7 @@ namespace marshal{
         CPPUNIT_TEST_SUITE( BaseDataStreamMarshallerTest );
         CPPUNIT_TEST( testLooseMarshal );
         CPPUNIT_TEST( testTightMarshal );
+        CPPUNIT_TEST( testTightMarshalSinglePass );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -175,6 +176,30 @@ namespace marshal{
 
             }
 
+            virtual void tightMarshal(OpenWireFormat* wireFormat,
+                                      commands::DataStructure* dataStructure,
+                                      decaf::io::DataOutputStream* dataOut,
+                                      utils::BooleanStream* bs)
+            {
+                SimpleDataStructure* info =
+                    dynamic_cast<SimpleDataStructure*>( dataStructure );
+
+                BaseDataStreamMarshaller::tightMarshal( wireFormat, dataStructure, dataOut, bs );
+
+                bs->writeBoolean( info->boolValue );
+                dataOut->writeChar( info->charValue );
+                dataOut->writeShort( info->shortValue );
+                dataOut->writeInt( info->intValue );
+                tightMarshalLong(wireFormat, info->longValue1, dataOut, bs);
+                tightMarshalLong(wireFormat, info->longValue2, dataOut, bs);
+                tightMarshalLong(wireFormat, info->longValue3, dataOut, bs);
+                tightMarshalLong(wireFormat, info->longValue4, dataOut, bs);
+                tightMarshalLong(wireFormat, info->longValue5, dataOut, bs);
+                dataOut->writeFloat( info->floatValue );
+                dataOut->writeDouble( info->doubleValue );
+                tightMarshalString( info->stringValue, dataOut, bs );
+            }
+
             virtual void looseUnmarshal(OpenWireFormat* wireFormat,
                                         commands::DataStructure* dataStructure,
                                         decaf::io::DataInputStream* dataIn)
@@ -337,6 +362,20 @@ namespace marshal{
 
             }
 
+            virtual void tightMarshal( OpenWireFormat* wireFormat,
+                                       commands::DataStructure* dataStructure,
+                                       decaf::io::DataOutputStream* dataOut,
+                                       utils::BooleanStream* bs )
+            {
+                ComplexDataStructure* info =
+                    dynamic_cast<ComplexDataStructure*>( dataStructure );
+
+                BaseDataStreamMarshaller::tightMarshal( wireFormat, dataStructure, dataOut, bs );
+
+                bs->writeBoolean( info->boolValue );
+                tightMarshalCachedObject( wireFormat, info->cachedChild, dataOut, bs );
+            }
+
             virtual void looseUnmarshal( OpenWireFormat* wireFormat,
                                          commands::DataStructure* dataStructure,
                                          decaf::io::DataInputStream* dataIn )
@@ -382,6 +421,7 @@ namespace marshal{
 
         void testLooseMarshal();
         void testTightMarshal();
+        void testTightMarshalSinglePass();
 
     };
 
@@ -0,0 +1,159 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TimerTaskWheelTest.h"
+
+#include <decaf/internal/util/TimerTaskWheel.h>
+#include <decaf/util/TimerTask.h>
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+using namespace decaf;
+using namespace decaf::internal;
+using namespace decaf::internal::util;
+using namespace decaf::util;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class TestTimerTask : public TimerTask {
+    public:
+
+        virtual void run() {}
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerTaskWheelTest::testCreate() {
+
+    TimerTaskWheel wheel;
+
+    CPPUNIT_ASSERT( wheel.isEmpty() == true );
+    CPPUNIT_ASSERT( wheel.size() == 0 );
+    CPPUNIT_ASSERT( wheel.getTickMillis() == TimerTaskWheel::DEFAULT_TICK_MILLIS );
+    CPPUNIT_ASSERT( wheel.nextExecutionTime() == -1 );
+    CPPUNIT_ASSERT( wheel.poll( System::currentTimeMillis() ) == NULL );
+
+    TimerTaskWheel coarse( 10 );
+    CPPUNIT_ASSERT( coarse.getTickMillis() == 10 );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        TimerTaskWheel( 0 ),
+        IllegalArgumentException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerTaskWheelTest::testInsertAndPoll() {
+
+    TimerTaskWheel wheel;
+
+    Pointer<TestTimerTask> task1( new TestTimerTask() );
+    Pointer<TestTimerTask> task2( new TestTimerTask() );
+    Pointer<TestTimerTask> task3( new TestTimerTask() );
+
+    // Unscheduled tasks are due at time zero so they go in the next slot.
+    wheel.insert( task1 );
+    wheel.insert( task2 );
+    wheel.insert( task3 );
+
+    CPPUNIT_ASSERT( wheel.isEmpty() == false );
+    CPPUNIT_ASSERT( wheel.size() == 3 );
+    CPPUNIT_ASSERT( wheel.nextExecutionTime() <= System::currentTimeMillis() + wheel.getTickMillis() );
+
+    long long now = System::currentTimeMillis() + wheel.getTickMillis();
+
+    CPPUNIT_ASSERT( wheel.poll( now ) == task1 );
+    CPPUNIT_ASSERT( wheel.poll( now ) == task2 );
+    CPPUNIT_ASSERT( wheel.poll( now ) == task3 );
+    CPPUNIT_ASSERT( wheel.poll( now ) == NULL );
+
+    CPPUNIT_ASSERT( wheel.isEmpty() == true );
+    CPPUNIT_ASSERT( wheel.nextExecutionTime() == -1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerTaskWheelTest::testRemove() {
+
+    TimerTaskWheel wheel;
+
+    Pointer<TestTimerTask> task1( new TestTimerTask() );
+    Pointer<TestTimerTask> task2( new TestTimerTask() );
+    Pointer<TestTimerTask> task3( new TestTimerTask() );
+
+    wheel.insert( task1 );
+    wheel.insert( task2 );
+    wheel.insert( task3 );
+
+    CPPUNIT_ASSERT( wheel.remove( task2.get() ) == true );
+    CPPUNIT_ASSERT( wheel.remove( task2.get() ) == false );
+    CPPUNIT_ASSERT( wheel.size() == 2 );
+
+    CPPUNIT_ASSERT( wheel.remove( task1.get() ) == true );
+    CPPUNIT_ASSERT( wheel.size() == 1 );
+
+    long long now = System::currentTimeMillis() + wheel.getTickMillis();
+
+    CPPUNIT_ASSERT( wheel.poll( now ) == task3 );
+    CPPUNIT_ASSERT( wheel.remove( task3.get() ) == false );
+    CPPUNIT_ASSERT( wheel.isEmpty() == true );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerTaskWheelTest::testReset() {
+
+    TimerTaskWheel wheel;
+
+    Pointer<TestTimerTask> task1( new TestTimerTask() );
+    Pointer<TestTimerTask> task2( new TestTimerTask() );
+
+    wheel.insert( task1 );
+    wheel.insert( task2 );
+    CPPUNIT_ASSERT( wheel.isEmpty() == false );
+
+    wheel.reset();
+
+    CPPUNIT_ASSERT( wheel.isEmpty() == true );
+    CPPUNIT_ASSERT( wheel.remove( task1.get() ) == false );
+    CPPUNIT_ASSERT( wheel.poll( System::currentTimeMillis() + wheel.getTickMillis() ) == NULL );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerTaskWheelTest::testDeleteIfCancelled() {
+
+    TimerTaskWheel wheel;
+
+    Pointer<TestTimerTask> task1( new TestTimerTask() );
+    Pointer<TestTimerTask> task2( new TestTimerTask() );
+    Pointer<TestTimerTask> task3( new TestTimerTask() );
+
+    wheel.insert( task1 );
+    wheel.insert( task2 );
+    wheel.insert( task3 );
+
+    // Not scheduled through a Timer so cancel leaves them in the wheel.
+    task1->cancel();
+    task3->cancel();
+
+    CPPUNIT_ASSERT( wheel.deleteIfCancelled() == 2 );
+    CPPUNIT_ASSERT( wheel.deleteIfCancelled() == 0 );
+    CPPUNIT_ASSERT( wheel.size() == 1 );
+    CPPUNIT_ASSERT( wheel.poll( System::currentTimeMillis() + wheel.getTickMillis() ) == task2 );
+}
@@ -137,7 +137,7 @@ void BufferedOutputStreamTest::testWrite() {
 
         CPPUNIT_ASSERT_MESSAGE(
             "Incorrect bytes written",
-            testString.substr(0, 1012) == string( (const char*)wbytes ) );
+            testString.substr(0, 1013) == string( (const char*)wbytes ) );
 
     } catch( IOException& e) {
         CPPUNIT_FAIL("write test failed: ");
@@ -280,8 +280,8 @@ void BufferedOutputStreamTest::testSmallerBuffer(){
     CPPUNIT_ASSERT( strcmp( buffer, "T" ) == 0 );
 
     bufStream.write( (unsigned char*)"ST", 2, 0, 2 );
-    // This time the ES should have been written.
-    CPPUNIT_ASSERT( strcmp( buffer, "TES" ) == 0 );
+    // This time the E and the ST that doesn't fit in the buffer should have been written.
+    CPPUNIT_ASSERT( strcmp( buffer, "TEST" ) == 0 );
 
     bufStream.flush();
     CPPUNIT_ASSERT( strcmp( buffer, "TEST" ) == 0 );
@@ -306,8 +306,70 @@ void BufferedOutputStreamTest::testBiggerBuffer(){
     bufStream.write( (unsigned char*)"TEST", 4, 0, 4 );
     bufStream.write( (unsigned char*)"12345678910", 11, 0, 11 );
 
-    CPPUNIT_ASSERT( strcmp( buffer, "TESTTEST123456" ) == 0 );
+    // Data that overflows the buffer is written through along with what was buffered.
+    CPPUNIT_ASSERT( strcmp( buffer, "TESTTEST12345678910" ) == 0 );
 
     bufStream.flush();
     CPPUNIT_ASSERT( strcmp( buffer, "TESTTEST12345678910" ) == 0 );
 }
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class GatherOutputStream : public ByteArrayOutputStream {
+    public:
+
+        int gathers;
+        int lastSecondLength;
+
+        GatherOutputStream() : ByteArrayOutputStream(), gathers(0), lastSecondLength(0) {}
+        virtual ~GatherOutputStream() {}
+
+    protected:
+
+        virtual void doWriteGather( const unsigned char* first, int firstLength,
+                                    const unsigned char* second, int secondLength ) {
+            gathers++;
+            lastSecondLength = secondLength;
+            ByteArrayOutputStream::doWriteGather( first, firstLength, second, secondLength );
+        }
+    };
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void BufferedOutputStreamTest::testWriteGather() {
+
+    GatherOutputStream sink;
+    BufferedOutputStream bufStream( &sink, 16 );
+
+    std::vector<unsigned char> body( 1000 );
+    for( std::size_t i = 0; i < body.size(); ++i ) {
+        body[i] = (unsigned char)( i % 251 );
+    }
+
+    // The header stays in the buffer, the body goes out with it in one write.
+    bufStream.write( (unsigned char*)"HEADER", 6, 0, 6 );
+    CPPUNIT_ASSERT_EQUAL( 0, sink.gathers );
+    bufStream.write( &body[0], (int) body.size(), 0, (int) body.size() );
+    CPPUNIT_ASSERT_EQUAL( 1, sink.gathers );
+    CPPUNIT_ASSERT_EQUAL( (int) body.size(), sink.lastSecondLength );
+    CPPUNIT_ASSERT_EQUAL( 1006L, (long) sink.size() );
+
+    // Small writes are buffered again afterwards.
+    bufStream.write( (unsigned char*)"TAIL", 4, 0, 4 );
+    CPPUNIT_ASSERT_EQUAL( 1006L, (long) sink.size() );
+    bufStream.flush();
+
+    std::pair<unsigned char*, int> array = sink.toByteArray();
+    CPPUNIT_ASSERT_EQUAL( 1010, array.second );
+    CPPUNIT_ASSERT( memcmp( array.first, "HEADER", 6 ) == 0 );
+    CPPUNIT_ASSERT( memcmp( array.first + 6, &body[0], body.size() ) == 0 );
+    CPPUNIT_ASSERT( memcmp( array.first + 1006, "TAIL", 4 ) == 0 );
+    delete [] array.first;
+
+    // A gathered write to the buffered stream is the same as two writes.
+    bufStream.writeGather( (unsigned char*)"AB", 2, NULL, 0 );
+    bufStream.flush();
+    CPPUNIT_ASSERT_EQUAL( 1012L, (long) sink.size() );
+}
@@ -676,3 +676,39 @@ void DataInputStreamTest::testUTFDecoding() {
     }
 
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void DataInputStreamTest::testUTFAsciiPrefix() {
+
+    // Strings long enough to be scanned in blocks with a single value that needs
+    // encoding placed at every position, including in the trailing partial block.
+    const unsigned char special[] = { 0x00, 0x80, 0xFF };
+
+    ByteArrayOutputStream bytesOut;
+    DataOutputStream dataOut( &bytesOut );
+    std::vector<std::string> expected;
+
+    for( int i = 0; i < 3; ++i ) {
+        for( std::size_t position = 0; position <= 70; ++position ) {
+            std::string value( 70, 'a' );
+            if( position < value.length() ) {
+                value[position] = (char) special[i];
+            }
+            expected.push_back( value );
+            dataOut.writeUTF( value );
+        }
+    }
+
+    std::pair<unsigned char*, int> array = bytesOut.toByteArray();
+    ByteArrayInputStream bytesIn( array.first, array.second, true );
+    DataInputStream dataIn( &bytesIn );
+
+    // The same string is reused for each read.
+    std::string result;
+    for( std::size_t i = 0; i < expected.size(); ++i ) {
+        dataIn.readUTF( result );
+        CPPUNIT_ASSERT_EQUAL( expected[i], result );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( 0, dataIn.available() );
+}
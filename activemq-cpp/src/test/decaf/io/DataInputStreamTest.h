@@ -40,6 +40,7 @@ namespace io{
         CPPUNIT_TEST( testString );
         CPPUNIT_TEST( testUTF );
         CPPUNIT_TEST( testUTFDecoding );
+        CPPUNIT_TEST( testUTFAsciiPrefix );
         CPPUNIT_TEST( testConstructor );
         CPPUNIT_TEST( testRead1 );
         CPPUNIT_TEST( testRead2 );
@@ -92,6 +93,7 @@ namespace io{
         void testString();
         void testUTF();
         void testUTFDecoding();
+        void testUTFAsciiPrefix();
         void testConstructor();
         void testRead1();
         void testRead2();
@@ -27,6 +27,8 @@
 #include <decaf/util/concurrent/Mutex.h>
 #include <decaf/lang/Thread.h>
 #include <list>
+#include <memory>
+#include <vector>
 #include <string.h>
 
 using namespace std;
@@ -822,3 +824,161 @@ void SocketTest::testTrxNoDelay() {
         printf( "%s\n", ex.getMessage().c_str() );
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class GatherReaderRunnable : public Runnable {
+    private:
+
+        Socket* socket;
+
+    private:
+
+        GatherReaderRunnable(const GatherReaderRunnable&);
+        GatherReaderRunnable& operator= (const GatherReaderRunnable&);
+
+    public:
+
+        std::vector<unsigned char> received;
+
+        GatherReaderRunnable( Socket* socket, int expected ) : socket( socket ), received( expected ) {
+        }
+
+        virtual void run() {
+
+            try {
+                InputStream* in = socket->getInputStream();
+                int pos = 0;
+                while( pos < (int) received.size() ) {
+                    int count = in->read( &received[0], (int) received.size(), pos, (int) received.size() - pos );
+                    if( count == -1 ) {
+                        break;
+                    }
+                    pos += count;
+                }
+            } catch( IOException& e ) {
+                e.printStackTrace();
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SocketTest::testWriteGather() {
+
+    ServerSocket server(0);
+    Socket client( "127.0.0.1", server.getLocalPort() );
+    std::auto_ptr<Socket> worker( server.accept() );
+
+    // Large enough that the socket can't take the body in a single send.
+    std::vector<unsigned char> body( 4 * 1024 * 1024 );
+    for( std::size_t i = 0; i < body.size(); ++i ) {
+        body[i] = (unsigned char)( i % 253 );
+    }
+    const unsigned char header[] = { 1, 2, 3, 4, 5 };
+
+    GatherReaderRunnable reader( worker.get(), (int)( sizeof( header ) + body.size() ) );
+    Thread thread( &reader );
+    thread.start();
+
+    client.getOutputStream()->writeGather( header, (int) sizeof( header ), &body[0], (int) body.size() );
+
+    thread.join();
+
+    CPPUNIT_ASSERT( memcmp( &reader.received[0], header, sizeof( header ) ) == 0 );
+    CPPUNIT_ASSERT( memcmp( &reader.received[sizeof( header )], &body[0], body.size() ) == 0 );
+
+    worker->close();
+    client.close();
+    server.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SocketTest::testGetReceiveSpinTime() {
+
+    ServerSocket server(0);
+    Socket client( "localhost", server.getLocalPort() );
+    std::auto_ptr<Socket> worker( server.accept() );
+
+    CPPUNIT_ASSERT_EQUAL( 0, client.getReceiveSpinTime() );
+    client.setReceiveSpinTime( 200 );
+    CPPUNIT_ASSERT_EQUAL( 200, client.getReceiveSpinTime() );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should Throw an IllegalArgumentException",
+        client.setReceiveSpinTime( -1 ),
+        IllegalArgumentException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should Throw an IllegalArgumentException",
+        client.setBusyPoll( -1 ),
+        IllegalArgumentException );
+
+    client.close();
+    worker->close();
+    server.close();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should Throw an IOException",
+        client.getReceiveSpinTime(),
+        IOException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class DelayedWriterRunnable : public Runnable {
+    private:
+
+        Socket* socket;
+
+    private:
+
+        DelayedWriterRunnable( const DelayedWriterRunnable& );
+        DelayedWriterRunnable& operator= ( const DelayedWriterRunnable& );
+
+    public:
+
+        DelayedWriterRunnable( Socket* socket ) : Runnable(), socket( socket ) {}
+        virtual ~DelayedWriterRunnable() {}
+
+        virtual void run() {
+            try {
+                // Longer than the reader spins so it has to block for this one.
+                Thread::sleep( 50 );
+                socket->getOutputStream()->write( (unsigned char) 2 );
+                socket->shutdownOutput();
+            } catch( IOException& e ) {
+                e.printStackTrace();
+            }
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SocketTest::testSpinRead() {
+
+    ServerSocket server(0);
+    Socket client( "127.0.0.1", server.getLocalPort() );
+    std::auto_ptr<Socket> worker( server.accept() );
+
+    client.setReceiveSpinTime( 1000 );
+
+    // Already waiting when the read starts.
+    worker->getOutputStream()->write( (unsigned char) 1 );
+    CPPUNIT_ASSERT_EQUAL( 1, client.getInputStream()->read() );
+
+    DelayedWriterRunnable writer( worker.get() );
+    Thread thread( &writer );
+    thread.start();
+
+    CPPUNIT_ASSERT_EQUAL( 2, client.getInputStream()->read() );
+    CPPUNIT_ASSERT_EQUAL( -1, client.getInputStream()->read() );
+
+    thread.join();
+
+    worker->close();
+    client.close();
+    server.close();
+}
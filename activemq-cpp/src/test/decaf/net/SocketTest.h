@@ -49,6 +49,9 @@ namespace net{
         CPPUNIT_TEST( testTrx );
         CPPUNIT_TEST( testTrxNoDelay );
         CPPUNIT_TEST( testRxFail );
+        CPPUNIT_TEST( testWriteGather );
+        CPPUNIT_TEST( testGetReceiveSpinTime );
+        CPPUNIT_TEST( testSpinRead );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -79,6 +82,9 @@ namespace net{
         void testTrx();
         void testRxFail();
         void testTrxNoDelay();
+        void testWriteGather();
+        void testGetReceiveSpinTime();
+        void testSpinRead();
 
     };
 
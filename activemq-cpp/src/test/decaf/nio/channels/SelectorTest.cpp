@@ -0,0 +1,271 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SelectorTest.h"
+
+#include <decaf/nio/channels/Selector.h>
+#include <decaf/nio/channels/SelectionKey.h>
+#include <decaf/nio/channels/SocketChannel.h>
+#include <decaf/net/ServerSocket.h>
+#include <decaf/net/Socket.h>
+#include <decaf/lang/Runnable.h>
+#include <decaf/lang/System.h>
+#include <decaf/lang/Thread.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/IllegalStateException.h>
+
+#include <memory>
+
+using namespace decaf;
+using namespace decaf::nio;
+using namespace decaf::nio::channels;
+using namespace decaf::net;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class Connection {
+    private:
+
+        Connection(const Connection&);
+        Connection& operator= (const Connection&);
+
+    public:
+
+        ServerSocket server;
+        Socket client;
+        std::auto_ptr<Socket> worker;
+
+        Connection() : server(0), client("127.0.0.1", server.getLocalPort()), worker(server.accept()) {
+        }
+
+        ~Connection() {
+            try {
+                worker->close();
+                client.close();
+                server.close();
+            } catch (...) {
+            }
+        }
+
+        void send(const std::string& data) {
+            client.getOutputStream()->write((const unsigned char*) data.c_str(), (int) data.size(), 0, (int) data.size());
+            client.getOutputStream()->flush();
+        }
+    };
+
+    class WakeupRunnable : public Runnable {
+    private:
+
+        WakeupRunnable(const WakeupRunnable&);
+        WakeupRunnable& operator= (const WakeupRunnable&);
+
+        Selector* selector;
+
+    public:
+
+        WakeupRunnable(Selector* selector) : Runnable(), selector(selector) {
+        }
+
+        virtual void run() {
+            Thread::sleep(100);
+            selector->wakeup();
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testSelectNowNothingReady() {
+
+    Connection connection;
+    Selector selector;
+    SocketChannel channel(connection.worker.get());
+
+    SelectionKey* key = channel.registerWith(&selector, SelectionKey::OP_READ);
+
+    CPPUNIT_ASSERT(key != NULL);
+    CPPUNIT_ASSERT(key->isValid());
+    CPPUNIT_ASSERT(key->channel() == &channel);
+    CPPUNIT_ASSERT(key->selector() == &selector);
+    CPPUNIT_ASSERT_EQUAL(SelectionKey::OP_READ, key->interestOps());
+
+    CPPUNIT_ASSERT_EQUAL(0, selector.selectNow());
+    CPPUNIT_ASSERT(selector.selectedKeys().empty());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testSelectReadable() {
+
+    Connection connection;
+    Selector selector;
+    SocketChannel channel(connection.worker.get());
+
+    int attachment = 42;
+    SelectionKey* key = channel.registerWith(&selector, SelectionKey::OP_READ, &attachment);
+
+    connection.send("hello");
+
+    CPPUNIT_ASSERT_EQUAL(1, selector.select(5000));
+    CPPUNIT_ASSERT_EQUAL((std::size_t) 1, selector.selectedKeys().size());
+    CPPUNIT_ASSERT(selector.selectedKeys()[0] == key);
+    CPPUNIT_ASSERT(key->isReadable());
+    CPPUNIT_ASSERT(!key->isWritable());
+    CPPUNIT_ASSERT(key->attachment() == &attachment);
+
+    unsigned char buffer[64];
+    int count = channel.read(buffer, (int) sizeof(buffer), 0, (int) sizeof(buffer));
+    CPPUNIT_ASSERT_EQUAL(5, count);
+    CPPUNIT_ASSERT_EQUAL(std::string("hello"), std::string((const char*) buffer, count));
+
+    // Drained, so nothing should be reported until more data arrives.
+    CPPUNIT_ASSERT_EQUAL(0, selector.selectNow());
+
+    // The remote close shows up as readable with an end of stream read.
+    connection.client.close();
+    CPPUNIT_ASSERT_EQUAL(1, selector.select(5000));
+    CPPUNIT_ASSERT_EQUAL(-1, channel.read(buffer, (int) sizeof(buffer), 0, (int) sizeof(buffer)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testSelectTimeout() {
+
+    Connection connection;
+    Selector selector;
+    SocketChannel channel(connection.worker.get());
+
+    channel.registerWith(&selector, SelectionKey::OP_READ);
+
+    long long start = System::currentTimeMillis();
+    CPPUNIT_ASSERT_EQUAL(0, selector.select(200));
+    CPPUNIT_ASSERT(System::currentTimeMillis() - start >= 150);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        selector.select(-1),
+        IllegalArgumentException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testWakeup() {
+
+    Connection connection;
+    Selector selector;
+    SocketChannel channel(connection.worker.get());
+
+    channel.registerWith(&selector, SelectionKey::OP_READ);
+
+    WakeupRunnable waker(&selector);
+    Thread thread(&waker);
+    thread.start();
+
+    long long start = System::currentTimeMillis();
+    CPPUNIT_ASSERT_EQUAL(0, selector.select());
+    CPPUNIT_ASSERT(System::currentTimeMillis() - start < 5000);
+
+    thread.join();
+
+    // A wakeup with no selection in progress makes the next one return at once.
+    selector.wakeup();
+    CPPUNIT_ASSERT_EQUAL(0, selector.select(10000));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testCancel() {
+
+    Connection connection;
+    Selector selector;
+    SocketChannel channel(connection.worker.get());
+
+    SelectionKey* key = channel.registerWith(&selector, SelectionKey::OP_READ);
+
+    connection.send("data");
+
+    key->cancel();
+    CPPUNIT_ASSERT(!key->isValid());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalStateException",
+        key->interestOps(),
+        IllegalStateException);
+
+    // Cancelling twice is harmless.
+    key->cancel();
+
+    CPPUNIT_ASSERT_EQUAL(0, selector.selectNow());
+
+    // The channel can be registered again once the old key is gone.
+    SelectionKey* second = channel.registerWith(&selector, SelectionKey::OP_READ);
+    CPPUNIT_ASSERT_EQUAL(1, selector.select(5000));
+    CPPUNIT_ASSERT(selector.selectedKeys()[0] == second);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testInterestOps() {
+
+    Connection connection;
+    Selector selector;
+    SocketChannel channel(connection.worker.get());
+
+    SelectionKey* key = channel.registerWith(&selector, 0);
+
+    connection.send("data");
+    CPPUNIT_ASSERT_EQUAL(0, selector.selectNow());
+
+    key->interestOps(SelectionKey::OP_READ);
+    CPPUNIT_ASSERT_EQUAL(1, selector.select(5000));
+    CPPUNIT_ASSERT(key->isReadable());
+
+    // An idle socket is always writable.
+    key->interestOps(SelectionKey::OP_WRITE);
+    CPPUNIT_ASSERT_EQUAL(1, selector.select(5000));
+    CPPUNIT_ASSERT(key->isWritable());
+    CPPUNIT_ASSERT(!key->isReadable());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalArgumentException",
+        key->interestOps(0x100),
+        IllegalArgumentException);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void SelectorTest::testClose() {
+
+    Connection connection;
+    Selector selector;
+    SocketChannel channel(connection.worker.get());
+
+    channel.registerWith(&selector, SelectionKey::OP_READ);
+
+    CPPUNIT_ASSERT(selector.isOpen());
+    selector.close();
+    CPPUNIT_ASSERT(!selector.isOpen());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalStateException",
+        selector.selectNow(),
+        IllegalStateException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an IllegalStateException",
+        channel.registerWith(&selector, SelectionKey::OP_READ),
+        IllegalStateException);
+
+    // Closing again does nothing.
+    selector.close();
+}
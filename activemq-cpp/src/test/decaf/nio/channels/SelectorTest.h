@@ -0,0 +1,57 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_NIO_CHANNELS_SELECTORTEST_H_
+#define _DECAF_NIO_CHANNELS_SELECTORTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace decaf {
+namespace nio {
+namespace channels {
+
+    class SelectorTest : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( SelectorTest );
+        CPPUNIT_TEST( testSelectNowNothingReady );
+        CPPUNIT_TEST( testSelectReadable );
+        CPPUNIT_TEST( testSelectTimeout );
+        CPPUNIT_TEST( testWakeup );
+        CPPUNIT_TEST( testCancel );
+        CPPUNIT_TEST( testInterestOps );
+        CPPUNIT_TEST( testClose );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        SelectorTest() {}
+        virtual ~SelectorTest() {}
+
+        void testSelectNowNothingReady();
+        void testSelectReadable();
+        void testSelectTimeout();
+        void testWakeup();
+        void testCancel();
+        void testInterestOps();
+        void testClose();
+
+    };
+
+}}}
+
+#endif /* _DECAF_NIO_CHANNELS_SELECTORTEST_H_ */
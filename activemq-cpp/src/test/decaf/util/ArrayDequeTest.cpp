@@ -0,0 +1,681 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ArrayDequeTest.h"
+
+#include <memory>
+#include <decaf/util/ArrayDeque.h>
+#include <decaf/util/LinkedList.h>
+#include <decaf/lang/Integer.h>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+
+////////////////////////////////////////////////////////////////////////////////
+const int ArrayDequeTest::SIZE = 256;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    void populate( ArrayDeque<int>& deque, int n ) {
+
+        CPPUNIT_ASSERT( deque.isEmpty() );
+
+        for( int i = 0; i < n; ++i ) {
+            deque.add( i );
+        }
+
+        CPPUNIT_ASSERT( !deque.isEmpty() );
+        CPPUNIT_ASSERT_EQUAL( n, deque.size() );
+    }
+
+    void populate( ArrayDeque<std::string>& deque, int n ) {
+
+        CPPUNIT_ASSERT( deque.isEmpty() );
+
+        for( int i = 0; i < n; ++i ) {
+            deque.add( Integer::toString( i ) );
+        }
+
+        CPPUNIT_ASSERT( !deque.isEmpty() );
+        CPPUNIT_ASSERT_EQUAL( n, deque.size() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ArrayDequeTest::ArrayDequeTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ArrayDequeTest::~ArrayDequeTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testConstructor1() {
+
+    ArrayDeque<int> deque;
+
+    CPPUNIT_ASSERT( deque.isEmpty() );
+    CPPUNIT_ASSERT_EQUAL( 0, deque.size() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testConstructor2() {
+
+    ArrayDeque<int> deque( 1 );
+    CPPUNIT_ASSERT( deque.isEmpty() );
+
+    populate( deque, SIZE );
+
+    for( int i = 0; i < SIZE; ++i ) {
+        CPPUNIT_ASSERT_EQUAL( i, deque.removeFirst() );
+    }
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalArgumentException",
+        ArrayDeque<int>( -1 ),
+        IllegalArgumentException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testConstructor3() {
+
+    LinkedList<int> list;
+    for( int i = 0; i < SIZE; ++i ) {
+        list.add( i );
+    }
+
+    ArrayDeque<int> deque( list );
+    CPPUNIT_ASSERT_EQUAL( SIZE, deque.size() );
+
+    for( int i = 0; i < SIZE; ++i ) {
+        CPPUNIT_ASSERT_EQUAL( i, deque.removeFirst() );
+    }
+
+    ArrayDeque<int> source;
+    populate( source, SIZE );
+    ArrayDeque<int> copy( source );
+
+    CPPUNIT_ASSERT_EQUAL( SIZE, copy.size() );
+    CPPUNIT_ASSERT( copy.equals( source ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testEquals() {
+
+    ArrayDeque<int> deque1;
+    populate( deque1, 7 );
+    ArrayDeque<int> deque2;
+    populate( deque2, 7 );
+
+    CPPUNIT_ASSERT( deque1 == deque2 );
+
+    deque2.removeLast();
+    CPPUNIT_ASSERT( deque1 != deque2 );
+
+    deque2 = deque1;
+    CPPUNIT_ASSERT( deque1 == deque2 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testAddFirst() {
+
+    ArrayDeque<int> deque;
+
+    for( int i = 0; i < SIZE; ++i ) {
+        deque.addFirst( i );
+        CPPUNIT_ASSERT_EQUAL( i, deque.getFirst() );
+        CPPUNIT_ASSERT_EQUAL( 0, deque.getLast() );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( SIZE, deque.size() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testAddLast() {
+
+    ArrayDeque<int> deque;
+
+    for( int i = 0; i < SIZE; ++i ) {
+        deque.addLast( i );
+        CPPUNIT_ASSERT_EQUAL( 0, deque.getFirst() );
+        CPPUNIT_ASSERT_EQUAL( i, deque.getLast() );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( SIZE, deque.size() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testAddAll() {
+
+    ArrayDeque<int> deque;
+    populate( deque, 10 );
+
+    LinkedList<int> list;
+    for( int i = 10; i < SIZE; ++i ) {
+        list.add( i );
+    }
+
+    CPPUNIT_ASSERT( deque.addAll( list ) );
+    CPPUNIT_ASSERT_EQUAL( SIZE, deque.size() );
+
+    for( int i = 0; i < SIZE; ++i ) {
+        CPPUNIT_ASSERT_EQUAL( i, deque.removeFirst() );
+    }
+
+    CPPUNIT_ASSERT( !deque.addAll( LinkedList<int>() ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testAddAllSelf() {
+
+    ArrayDeque<int> deque;
+    populate( deque, 10 );
+
+    CPPUNIT_ASSERT( deque.addAll( deque ) );
+    CPPUNIT_ASSERT_EQUAL( 20, deque.size() );
+
+    for( int i = 0; i < 20; ++i ) {
+        CPPUNIT_ASSERT_EQUAL( i % 10, deque.removeFirst() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testGrowWhenWrapped() {
+
+    ArrayDeque<int> deque;
+
+    // Move the head part way around the array before it has to grow so that the
+    // contents are split across the end of the array when it is copied.
+    for( int i = 0; i < 10; ++i ) {
+        deque.addLast( i );
+    }
+    for( int i = 0; i < 10; ++i ) {
+        deque.removeFirst();
+    }
+
+    for( int i = 0; i < SIZE; ++i ) {
+        if( i % 2 == 0 ) {
+            deque.addLast( i );
+        } else {
+            deque.addFirst( i );
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL( SIZE, deque.size() );
+
+    for( int i = SIZE - 1; i >= 0; i -= 2 ) {
+        CPPUNIT_ASSERT_EQUAL( i, deque.removeFirst() );
+    }
+    for( int i = 0; i < SIZE; i += 2 ) {
+        CPPUNIT_ASSERT_EQUAL( i, deque.removeFirst() );
+    }
+
+    CPPUNIT_ASSERT( deque.isEmpty() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testRemoveFirst() {
+
+    ArrayDeque<int> deque;
+    populate( deque, SIZE );
+
+    for( int i = 0; i < SIZE; ++i ) {
+        CPPUNIT_ASSERT_EQUAL( i, deque.removeFirst() );
+    }
+
+    CPPUNIT_ASSERT( deque.isEmpty() );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an NoSuchElementException",
+        deque.removeFirst(),
+        NoSuchElementException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testRemoveLast() {
+
+    ArrayDeque<int> deque;
+    populate( deque, SIZE );
+
+    for( int i = 0; i < SIZE; ++i ) {
+        CPPUNIT_ASSERT_EQUAL( SIZE - i - 1, deque.removeLast() );
+    }
+
+    CPPUNIT_ASSERT( deque.isEmpty() );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an NoSuchElementException",
+        deque.removeLast(),
+        NoSuchElementException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testPollFirst() {
+
+    ArrayDeque<int> deque;
+    populate( deque, SIZE );
+
+    int result = 0;
+    for( int i = 0; i < SIZE; ++i ) {
+        CPPUNIT_ASSERT( deque.pollFirst( result ) );
+        CPPUNIT_ASSERT_EQUAL( i, result );
+    }
+
+    CPPUNIT_ASSERT( !deque.pollFirst( result ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testPollLast() {
+
+    ArrayDeque<int> deque;
+    populate( deque, SIZE );
+
+    int result = 0;
+    for( int i = SIZE - 1; i >= 0; --i ) {
+        CPPUNIT_ASSERT( deque.pollLast( result ) );
+        CPPUNIT_ASSERT_EQUAL( i, result );
+    }
+
+    CPPUNIT_ASSERT( !deque.pollLast( result ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testPeekFirst() {
+
+    ArrayDeque<int> deque;
+
+    int result = 0;
+    CPPUNIT_ASSERT( !deque.peekFirst( result ) );
+
+    populate( deque, SIZE );
+
+    CPPUNIT_ASSERT( deque.peekFirst( result ) );
+    CPPUNIT_ASSERT_EQUAL( 0, result );
+    CPPUNIT_ASSERT_EQUAL( SIZE, deque.size() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testPeekLast() {
+
+    ArrayDeque<int> deque;
+
+    int result = 0;
+    CPPUNIT_ASSERT( !deque.peekLast( result ) );
+
+    populate( deque, SIZE );
+
+    CPPUNIT_ASSERT( deque.peekLast( result ) );
+    CPPUNIT_ASSERT_EQUAL( SIZE - 1, result );
+    CPPUNIT_ASSERT_EQUAL( SIZE, deque.size() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testGetFirst() {
+
+    ArrayDeque<int> deque;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an NoSuchElementException",
+        deque.getFirst(),
+        NoSuchElementException );
+
+    populate( deque, SIZE );
+
+    CPPUNIT_ASSERT_EQUAL( 0, deque.getFirst() );
+    deque.getFirst() = 42;
+    CPPUNIT_ASSERT_EQUAL( 42, deque.removeFirst() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testGetLast() {
+
+    ArrayDeque<int> deque;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an NoSuchElementException",
+        deque.getLast(),
+        NoSuchElementException );
+
+    populate( deque, SIZE );
+
+    CPPUNIT_ASSERT_EQUAL( SIZE - 1, deque.getLast() );
+    deque.getLast() = 42;
+    CPPUNIT_ASSERT_EQUAL( 42, deque.removeLast() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testOfferAndPoll() {
+
+    ArrayDeque<std::string> deque;
+
+    for( int i = 0; i < SIZE; ++i ) {
+        CPPUNIT_ASSERT( deque.offer( Integer::toString( i ) ) );
+    }
+
+    std::string result;
+    for( int i = 0; i < SIZE; ++i ) {
+        CPPUNIT_ASSERT( deque.peek( result ) );
+        CPPUNIT_ASSERT_EQUAL( Integer::toString( i ), result );
+        CPPUNIT_ASSERT( deque.poll( result ) );
+        CPPUNIT_ASSERT_EQUAL( Integer::toString( i ), result );
+    }
+
+    CPPUNIT_ASSERT( !deque.poll( result ) );
+    CPPUNIT_ASSERT( !deque.peek( result ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testElement() {
+
+    ArrayDeque<int> deque;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an NoSuchElementException",
+        deque.element(),
+        NoSuchElementException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an NoSuchElementException",
+        deque.remove(),
+        NoSuchElementException );
+
+    populate( deque, SIZE );
+
+    CPPUNIT_ASSERT_EQUAL( 0, deque.element() );
+    CPPUNIT_ASSERT_EQUAL( 0, deque.remove() );
+    CPPUNIT_ASSERT_EQUAL( 1, deque.element() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testPushAndPop() {
+
+    ArrayDeque<int> deque;
+
+    for( int i = 0; i < SIZE; ++i ) {
+        deque.push( i );
+    }
+
+    for( int i = SIZE - 1; i >= 0; --i ) {
+        CPPUNIT_ASSERT_EQUAL( i, deque.pop() );
+    }
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an NoSuchElementException",
+        deque.pop(),
+        NoSuchElementException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testContains() {
+
+    ArrayDeque<std::string> deque;
+    populate( deque, SIZE );
+
+    for( int i = 0; i < SIZE; ++i ) {
+        CPPUNIT_ASSERT( deque.contains( Integer::toString( i ) ) );
+    }
+
+    CPPUNIT_ASSERT( !deque.contains( Integer::toString( SIZE ) ) );
+    CPPUNIT_ASSERT( !deque.contains( "" ) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testRemoveByValue() {
+
+    ArrayDeque<int> deque;
+    populate( deque, SIZE );
+
+    CPPUNIT_ASSERT( deque.remove( 10 ) );
+    CPPUNIT_ASSERT( !deque.remove( 10 ) );
+    CPPUNIT_ASSERT( deque.remove( SIZE - 10 ) );
+    CPPUNIT_ASSERT_EQUAL( SIZE - 2, deque.size() );
+
+    int expected = 0;
+    while( !deque.isEmpty() ) {
+        if( expected == 10 || expected == SIZE - 10 ) {
+            expected++;
+        }
+        CPPUNIT_ASSERT_EQUAL( expected++, deque.removeFirst() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testRemoveFirstOccurrence() {
+
+    ArrayDeque<int> deque;
+    CPPUNIT_ASSERT( !deque.removeFirstOccurrence( 1 ) );
+
+    deque.add( 1 );
+    deque.add( 2 );
+    deque.add( 1 );
+    deque.add( 3 );
+
+    CPPUNIT_ASSERT( deque.removeFirstOccurrence( 1 ) );
+    CPPUNIT_ASSERT_EQUAL( 3, deque.size() );
+    CPPUNIT_ASSERT_EQUAL( 2, deque.removeFirst() );
+    CPPUNIT_ASSERT_EQUAL( 1, deque.removeFirst() );
+    CPPUNIT_ASSERT_EQUAL( 3, deque.removeFirst() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testRemoveLastOccurrence() {
+
+    ArrayDeque<int> deque;
+    CPPUNIT_ASSERT( !deque.removeLastOccurrence( 1 ) );
+
+    deque.add( 1 );
+    deque.add( 2 );
+    deque.add( 1 );
+    deque.add( 3 );
+
+    CPPUNIT_ASSERT( deque.removeLastOccurrence( 1 ) );
+    CPPUNIT_ASSERT_EQUAL( 3, deque.size() );
+    CPPUNIT_ASSERT_EQUAL( 1, deque.removeFirst() );
+    CPPUNIT_ASSERT_EQUAL( 2, deque.removeFirst() );
+    CPPUNIT_ASSERT_EQUAL( 3, deque.removeFirst() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testClear() {
+
+    ArrayDeque<int> deque;
+    populate( deque, SIZE );
+
+    deque.clear();
+
+    CPPUNIT_ASSERT( deque.isEmpty() );
+    CPPUNIT_ASSERT_EQUAL( 0, deque.size() );
+
+    populate( deque, SIZE );
+    CPPUNIT_ASSERT_EQUAL( 0, deque.getFirst() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testToArray() {
+
+    ArrayDeque<int> deque;
+    populate( deque, SIZE );
+    deque.addFirst( -1 );
+
+    std::vector<int> array = deque.toArray();
+
+    CPPUNIT_ASSERT_EQUAL( SIZE + 1, (int)array.size() );
+    for( int i = 0; i <= SIZE; ++i ) {
+        CPPUNIT_ASSERT_EQUAL( i - 1, array[i] );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testIterator() {
+
+    ArrayDeque<int> deque;
+    populate( deque, SIZE );
+
+    std::auto_ptr< Iterator<int> > iter( deque.iterator() );
+
+    int expected = 0;
+    while( iter->hasNext() ) {
+        CPPUNIT_ASSERT_EQUAL( expected++, iter->next() );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( SIZE, expected );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an NoSuchElementException",
+        iter->next(),
+        NoSuchElementException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testIteratorRemove() {
+
+    ArrayDeque<int> deque;
+    populate( deque, SIZE );
+
+    std::auto_ptr< Iterator<int> > iter( deque.iterator() );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalStateException",
+        iter->remove(),
+        IllegalStateException );
+
+    while( iter->hasNext() ) {
+        if( iter->next() % 2 == 0 ) {
+            iter->remove();
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL( SIZE / 2, deque.size() );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an IllegalStateException",
+        iter->remove(),
+        IllegalStateException );
+
+    for( int i = 1; i < SIZE; i += 2 ) {
+        CPPUNIT_ASSERT_EQUAL( i, deque.removeFirst() );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testDescendingIterator() {
+
+    ArrayDeque<int> deque;
+    populate( deque, SIZE );
+
+    std::auto_ptr< Iterator<int> > iter( deque.descendingIterator() );
+
+    int expected = SIZE - 1;
+    while( iter->hasNext() ) {
+        CPPUNIT_ASSERT_EQUAL( expected--, iter->next() );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( -1, expected );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an NoSuchElementException",
+        iter->next(),
+        NoSuchElementException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testDescendingIteratorRemove() {
+
+    ArrayDeque<int> deque;
+    populate( deque, SIZE );
+
+    std::auto_ptr< Iterator<int> > iter( deque.descendingIterator() );
+
+    int expected = SIZE - 1;
+    while( iter->hasNext() ) {
+        int value = iter->next();
+        CPPUNIT_ASSERT_EQUAL( expected--, value );
+        if( value % 3 == 0 ) {
+            iter->remove();
+        }
+    }
+
+    for( int i = 0; i < SIZE; ++i ) {
+        if( i % 3 != 0 ) {
+            CPPUNIT_ASSERT_EQUAL( i, deque.removeFirst() );
+        }
+    }
+
+    CPPUNIT_ASSERT( deque.isEmpty() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testIteratorFailFast() {
+
+    ArrayDeque<int> deque;
+    populate( deque, SIZE );
+
+    std::auto_ptr< Iterator<int> > iter( deque.iterator() );
+    iter->next();
+
+    deque.addLast( SIZE );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an ConcurrentModificationException",
+        iter->next(),
+        ConcurrentModificationException );
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an ConcurrentModificationException",
+        iter->remove(),
+        ConcurrentModificationException );
+
+    std::auto_ptr< Iterator<int> > descending( deque.descendingIterator() );
+    descending->next();
+
+    deque.pop();
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an ConcurrentModificationException",
+        descending->next(),
+        ConcurrentModificationException );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ArrayDequeTest::testConstIterator() {
+
+    ArrayDeque<int> deque;
+    populate( deque, SIZE );
+
+    const ArrayDeque<int>& constDeque = deque;
+
+    std::auto_ptr< Iterator<int> > iter( constDeque.iterator() );
+    int expected = 0;
+    while( iter->hasNext() ) {
+        CPPUNIT_ASSERT_EQUAL( expected++, iter->next() );
+    }
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should have thrown an UnsupportedOperationException",
+        iter->remove(),
+        UnsupportedOperationException );
+
+    std::auto_ptr< Iterator<int> > descending( constDeque.descendingIterator() );
+    expected = SIZE - 1;
+    while( descending->hasNext() ) {
+        CPPUNIT_ASSERT_EQUAL( expected--, descending->next() );
+    }
+}
@@ -0,0 +1,110 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_ARRAYDEQUETEST_H_
+#define _DECAF_UTIL_ARRAYDEQUETEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace decaf {
+namespace util {
+
+    class ArrayDequeTest : public CppUnit::TestFixture {
+
+        CPPUNIT_TEST_SUITE( ArrayDequeTest );
+        CPPUNIT_TEST( testConstructor1 );
+        CPPUNIT_TEST( testConstructor2 );
+        CPPUNIT_TEST( testConstructor3 );
+        CPPUNIT_TEST( testEquals );
+        CPPUNIT_TEST( testAddFirst );
+        CPPUNIT_TEST( testAddLast );
+        CPPUNIT_TEST( testAddAll );
+        CPPUNIT_TEST( testAddAllSelf );
+        CPPUNIT_TEST( testGrowWhenWrapped );
+        CPPUNIT_TEST( testRemoveFirst );
+        CPPUNIT_TEST( testRemoveLast );
+        CPPUNIT_TEST( testPollFirst );
+        CPPUNIT_TEST( testPollLast );
+        CPPUNIT_TEST( testPeekFirst );
+        CPPUNIT_TEST( testPeekLast );
+        CPPUNIT_TEST( testGetFirst );
+        CPPUNIT_TEST( testGetLast );
+        CPPUNIT_TEST( testOfferAndPoll );
+        CPPUNIT_TEST( testElement );
+        CPPUNIT_TEST( testPushAndPop );
+        CPPUNIT_TEST( testContains );
+        CPPUNIT_TEST( testRemoveByValue );
+        CPPUNIT_TEST( testRemoveFirstOccurrence );
+        CPPUNIT_TEST( testRemoveLastOccurrence );
+        CPPUNIT_TEST( testClear );
+        CPPUNIT_TEST( testToArray );
+        CPPUNIT_TEST( testIterator );
+        CPPUNIT_TEST( testIteratorRemove );
+        CPPUNIT_TEST( testDescendingIterator );
+        CPPUNIT_TEST( testDescendingIteratorRemove );
+        CPPUNIT_TEST( testIteratorFailFast );
+        CPPUNIT_TEST( testConstIterator );
+        CPPUNIT_TEST_SUITE_END();
+
+    private:
+
+        static const int SIZE;
+
+    public:
+
+        ArrayDequeTest();
+        virtual ~ArrayDequeTest();
+
+        void testConstructor1();
+        void testConstructor2();
+        void testConstructor3();
+        void testEquals();
+        void testAddFirst();
+        void testAddLast();
+        void testAddAll();
+        void testAddAllSelf();
+        void testGrowWhenWrapped();
+        void testRemoveFirst();
+        void testRemoveLast();
+        void testPollFirst();
+        void testPollLast();
+        void testPeekFirst();
+        void testPeekLast();
+        void testGetFirst();
+        void testGetLast();
+        void testOfferAndPoll();
+        void testElement();
+        void testPushAndPop();
+        void testContains();
+        void testRemoveByValue();
+        void testRemoveFirstOccurrence();
+        void testRemoveLastOccurrence();
+        void testClear();
+        void testToArray();
+        void testIterator();
+        void testIteratorRemove();
+        void testDescendingIterator();
+        void testDescendingIteratorRemove();
+        void testIteratorFailFast();
+        void testConstIterator();
+
+    };
+
+}}
+
+#endif /* _DECAF_UTIL_ARRAYDEQUETEST_H_ */
@@ -1713,3 +1713,75 @@ void TimerTest::testScheduleAtFixedRate_TimerTask_Date_Long2() {
                             lastDelta < 300 );
     t->cancel();
 }
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerTest::testTimingWheel() {
+
+    std::auto_ptr<Timer> t;
+    TimerTaskReport report;
+
+    t.reset( new Timer( "Timing Wheel Timer", Timer::TIMING_WHEEL ) );
+
+    // Ensure a one-shot task is run once.
+    TimerTestTask* testTask = new TimerTestTask( &report, &this->timerCounter, &this->gsync );
+    t->schedule( testTask, 100 );
+
+    synchronized( &this->gsync ) {
+        try {
+            this->gsync.wait( 1000 );
+        } catch( InterruptedException& e ) {}
+    }
+
+    CPPUNIT_ASSERT_MESSAGE( "TimerTask.run() method not called after 100ms",
+                            1 == report.wasRun.get() );
+
+    // Ensure a repeating task is run repeatedly.
+    report.reset();
+    testTask = new TimerTestTask( &report, &this->timerCounter, &this->gsync );
+    t->scheduleAtFixedRate( testTask, 100, 100 );
+
+    try {
+        Thread::sleep( 400 );
+    } catch( InterruptedException& e ) {}
+
+    CPPUNIT_ASSERT_MESSAGE( std::string( "TimerTask.run() method should have been called at least twice (" ) +
+                            Integer::toString( report.wasRun.get() ) + ")",
+                            report.wasRun.get() >= 2 );
+
+    t->cancel();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimerTest::testTimingWheelCancel() {
+
+    std::auto_ptr<Timer> t;
+    TimerTaskReport report;
+
+    t.reset( new Timer( "Timing Wheel Timer", Timer::TIMING_WHEEL ) );
+
+    std::vector< Pointer<TimerTestTask> > tasks;
+    int delayTime[] = { 50, 80, 20, 70, 40, 10, 90, 30, 60 };
+
+    for( int i = 0; i < 90; i++ ) {
+        Pointer<TimerTestTask> task( new TimerTestTask( &report, &this->timerCounter, &this->gsync ) );
+        tasks.push_back( task );
+        t->schedule( task, 100 + delayTime[i % 9] );
+    }
+
+    // Canceling takes the tasks out of the Timer so there's nothing left to purge.
+    for( int i = 0; i < 90; i += 2 ) {
+        CPPUNIT_ASSERT( tasks[i]->cancel() );
+    }
+
+    CPPUNIT_ASSERT( 0 == t->purge() );
+
+    try {
+        Thread::sleep( 500 );
+    } catch( InterruptedException& e ) {}
+
+    CPPUNIT_ASSERT_MESSAGE( std::string( "Only the tasks that weren't canceled should run, not " ) +
+                            Integer::toString( report.wasRun.get() ),
+                            45 == report.wasRun.get() );
+
+    t->cancel();
+}
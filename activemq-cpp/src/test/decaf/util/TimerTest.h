@@ -51,6 +51,8 @@ namespace util {
         CPPUNIT_TEST( testScheduleAtFixedRate_TimerTask_Long_Long2 );
         CPPUNIT_TEST( testScheduleAtFixedRate_TimerTask_Date_Long );
         CPPUNIT_TEST( testScheduleAtFixedRate_TimerTask_Date_Long2 );
+        CPPUNIT_TEST( testTimingWheel );
+        CPPUNIT_TEST( testTimingWheelCancel );
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -73,6 +75,8 @@ namespace util {
         void testScheduleAtFixedRate_TimerTask_Long_Long2();
         void testScheduleAtFixedRate_TimerTask_Date_Long();
         void testScheduleAtFixedRate_TimerTask_Date_Long2();
+        void testTimingWheel();
+        void testTimingWheelCancel();
 
         virtual void setUp();
 
@@ -0,0 +1,434 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ScheduledThreadPoolExecutorTest.h"
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/lang/System.h>
+#include <decaf/util/concurrent/ScheduledThreadPoolExecutor.h>
+#include <decaf/util/concurrent/Executors.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/CancellationException.h>
+#include <decaf/util/concurrent/ExecutionException.h>
+#include <decaf/util/concurrent/Mutex.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+#include <decaf/lang/exceptions/RuntimeException.h>
+#include <decaf/lang/exceptions/NullPointerException.h>
+
+#include <vector>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class CountingRunnable : public Runnable {
+    private:
+
+        AtomicInteger* counter;
+        CountDownLatch* done;
+
+    private:
+
+        CountingRunnable(const CountingRunnable&);
+        CountingRunnable operator= (const CountingRunnable&);
+
+    public:
+
+        CountingRunnable(AtomicInteger* counter, CountDownLatch* done) :
+            Runnable(), counter(counter), done(done) {
+        }
+
+        virtual ~CountingRunnable() {}
+
+        virtual void run() {
+            this->counter->incrementAndGet();
+            this->done->countDown();
+        }
+    };
+
+    class RecordingRunnable : public Runnable {
+    private:
+
+        Mutex* mutex;
+        std::vector<int>* order;
+        CountDownLatch* done;
+        int id;
+
+    private:
+
+        RecordingRunnable(const RecordingRunnable&);
+        RecordingRunnable operator= (const RecordingRunnable&);
+
+    public:
+
+        RecordingRunnable(Mutex* mutex, std::vector<int>* order, CountDownLatch* done, int id) :
+            Runnable(), mutex(mutex), order(order), done(done), id(id) {
+        }
+
+        virtual ~RecordingRunnable() {}
+
+        virtual void run() {
+            synchronized(mutex) {
+                order->push_back(id);
+            }
+            this->done->countDown();
+        }
+    };
+
+    class ThrowingRunnable : public Runnable {
+    private:
+
+        AtomicInteger* counter;
+
+    private:
+
+        ThrowingRunnable(const ThrowingRunnable&);
+        ThrowingRunnable operator= (const ThrowingRunnable&);
+
+    public:
+
+        ThrowingRunnable(AtomicInteger* counter) : Runnable(), counter(counter) {}
+
+        virtual ~ThrowingRunnable() {}
+
+        virtual void run() {
+            this->counter->incrementAndGet();
+            throw RuntimeException(__FILE__, __LINE__, "Periodic task failure");
+        }
+    };
+
+    class ResultCallable : public Callable<int> {
+    public:
+
+        ResultCallable() : Callable<int>() {}
+        virtual ~ResultCallable() {}
+
+        virtual int call() {
+            return 42;
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ScheduledThreadPoolExecutorTest::ScheduledThreadPoolExecutorTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+ScheduledThreadPoolExecutorTest::~ScheduledThreadPoolExecutorTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutorTest::testConstructor() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a IllegalArgumentException",
+        ScheduledThreadPoolExecutor(0),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NullPointerException",
+        ScheduledThreadPoolExecutor(1, (ThreadFactory*) NULL),
+        NullPointerException);
+
+    ScheduledThreadPoolExecutor executor(2, new SimpleThreadFactory());
+    CPPUNIT_ASSERT_EQUAL(2, executor.getCorePoolSize());
+    CPPUNIT_ASSERT(!executor.getContinueExistingPeriodicTasksAfterShutdownPolicy());
+    CPPUNIT_ASSERT(executor.getExecuteExistingDelayedTasksAfterShutdownPolicy());
+    CPPUNIT_ASSERT(executor.getRemoveOnCancelPolicy());
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutorTest::testExecute() {
+
+    ScheduledThreadPoolExecutor executor(2);
+    AtomicInteger counter;
+    CountDownLatch done(10);
+
+    for (int i = 0; i < 10; ++i) {
+        executor.execute(new CountingRunnable(&counter, &done));
+    }
+
+    CPPUNIT_ASSERT(done.await(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT_EQUAL(10, counter.get());
+
+    Pointer< Future<int> > future(executor.submit(new ResultCallable()));
+    CPPUNIT_ASSERT_EQUAL(42, future->get());
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutorTest::testScheduleCallable() {
+
+    ScheduledThreadPoolExecutor executor(1);
+
+    long long start = System::currentTimeMillis();
+    Pointer< ScheduledFuture<int> > future(
+        executor.schedule(new ResultCallable(), SHORT_DELAY_MS, TimeUnit::MILLISECONDS));
+
+    CPPUNIT_ASSERT(future->getDelay(TimeUnit::MILLISECONDS) <= SHORT_DELAY_MS);
+    CPPUNIT_ASSERT_EQUAL(42, future->get());
+    CPPUNIT_ASSERT(System::currentTimeMillis() - start >= SHORT_DELAY_MS - 1);
+    CPPUNIT_ASSERT(future->isDone());
+    CPPUNIT_ASSERT(!future->isCancelled());
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutorTest::testScheduleRunnable() {
+
+    ScheduledThreadPoolExecutor executor(1);
+    AtomicInteger counter;
+    CountDownLatch done(1);
+    CountingRunnable task(&counter, &done);
+
+    Pointer< ScheduledFuture<bool> > future(
+        executor.schedule(&task, SHORT_DELAY_MS, TimeUnit::MILLISECONDS, false));
+
+    CPPUNIT_ASSERT_EQUAL(0, counter.get());
+    CPPUNIT_ASSERT(done.await(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+    future->get();
+    CPPUNIT_ASSERT_EQUAL(1, counter.get());
+    CPPUNIT_ASSERT_EQUAL(0, executor.getQueue()->size());
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutorTest::testScheduleOrder() {
+
+    ScheduledThreadPoolExecutor executor(1);
+    Mutex mutex;
+    std::vector<int> order;
+    CountDownLatch done(3);
+
+    // Scheduled latest first, they must run soonest first.
+    delete executor.schedule(new RecordingRunnable(&mutex, &order, &done, 3), SHORT_DELAY_MS * 3, TimeUnit::MILLISECONDS);
+    delete executor.schedule(new RecordingRunnable(&mutex, &order, &done, 2), SHORT_DELAY_MS * 2, TimeUnit::MILLISECONDS);
+    delete executor.schedule(new RecordingRunnable(&mutex, &order, &done, 1), SHORT_DELAY_MS, TimeUnit::MILLISECONDS);
+
+    CPPUNIT_ASSERT(done.await(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+
+    synchronized(&mutex) {
+        CPPUNIT_ASSERT_EQUAL(3, (int) order.size());
+        CPPUNIT_ASSERT_EQUAL(1, order[0]);
+        CPPUNIT_ASSERT_EQUAL(2, order[1]);
+        CPPUNIT_ASSERT_EQUAL(3, order[2]);
+    }
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutorTest::testScheduleAtFixedRate() {
+
+    ScheduledThreadPoolExecutor executor(2);
+    AtomicInteger counter;
+    CountDownLatch done(5);
+    NoOpRunnable noop;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a IllegalArgumentException",
+        executor.scheduleAtFixedRate(&noop, 0, 0, TimeUnit::MILLISECONDS, false),
+        IllegalArgumentException);
+
+    Pointer< ScheduledFuture<bool> > future(executor.scheduleAtFixedRate(
+        new CountingRunnable(&counter, &done), 0, 10, TimeUnit::MILLISECONDS));
+
+    CPPUNIT_ASSERT(done.await(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT(!future->isDone());
+    CPPUNIT_ASSERT(future->cancel(false));
+    CPPUNIT_ASSERT(future->isCancelled());
+
+    // No further runs once the cancel has returned and a running copy has finished.
+    Thread::sleep(SHORT_DELAY_MS);
+    int count = counter.get();
+    Thread::sleep(SHORT_DELAY_MS);
+    CPPUNIT_ASSERT_EQUAL(count, counter.get());
+    CPPUNIT_ASSERT_EQUAL(0, executor.getQueue()->size());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a CancellationException",
+        future->get(),
+        CancellationException);
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutorTest::testScheduleWithFixedDelay() {
+
+    ScheduledThreadPoolExecutor executor(1);
+    AtomicInteger counter;
+    CountDownLatch done(3);
+    NoOpRunnable noop;
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a IllegalArgumentException",
+        executor.scheduleWithFixedDelay(&noop, 0, -1, TimeUnit::MILLISECONDS, false),
+        IllegalArgumentException);
+
+    long long start = System::currentTimeMillis();
+    Pointer< ScheduledFuture<bool> > future(executor.scheduleWithFixedDelay(
+        new CountingRunnable(&counter, &done), 0, SHORT_DELAY_MS, TimeUnit::MILLISECONDS));
+
+    CPPUNIT_ASSERT(done.await(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT(System::currentTimeMillis() - start >= (SHORT_DELAY_MS * 2) - 1);
+    CPPUNIT_ASSERT(future->cancel(false));
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutorTest::testPeriodicTaskException() {
+
+    ScheduledThreadPoolExecutor executor(1);
+    AtomicInteger counter;
+
+    Pointer< ScheduledFuture<bool> > future(executor.scheduleAtFixedRate(
+        new ThrowingRunnable(&counter), 0, 10, TimeUnit::MILLISECONDS));
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw an ExecutionException",
+        future->get(LONG_DELAY_MS, TimeUnit::MILLISECONDS),
+        ExecutionException);
+
+    // The failed run ends the task.
+    Thread::sleep(SHORT_DELAY_MS);
+    CPPUNIT_ASSERT_EQUAL(1, counter.get());
+    CPPUNIT_ASSERT(future->isDone());
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutorTest::testCancelRemovesTask() {
+
+    ScheduledThreadPoolExecutor executor(1);
+    std::vector< Pointer< ScheduledFuture<bool> > > futures;
+
+    for (int i = 0; i < 10; ++i) {
+        futures.push_back(Pointer< ScheduledFuture<bool> >(
+            executor.schedule(new NoOpRunnable(), LONG_DELAY_MS, TimeUnit::MILLISECONDS)));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(10, executor.getQueue()->size());
+
+    for (int i = 0; i < 10; i += 2) {
+        CPPUNIT_ASSERT(futures[i]->cancel(false));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(5, executor.getQueue()->size());
+
+    for (int i = 1; i < 10; i += 2) {
+        CPPUNIT_ASSERT(futures[i]->cancel(false));
+        CPPUNIT_ASSERT(!futures[i]->cancel(false));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(0, executor.getQueue()->size());
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutorTest::testCancelWithoutRemove() {
+
+    ScheduledThreadPoolExecutor executor(1);
+    executor.setRemoveOnCancelPolicy(false);
+
+    Pointer< ScheduledFuture<bool> > future(
+        executor.schedule(new NoOpRunnable(), LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+
+    CPPUNIT_ASSERT(future->cancel(false));
+    CPPUNIT_ASSERT_EQUAL(1, executor.getQueue()->size());
+
+    executor.purge();
+    CPPUNIT_ASSERT_EQUAL(0, executor.getQueue()->size());
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutorTest::testShutdownPolicies() {
+
+    ScheduledThreadPoolExecutor executor(1);
+    AtomicInteger counter;
+    CountDownLatch delayedDone(1);
+    CountDownLatch periodicDone(1000);
+
+    Pointer< ScheduledFuture<bool> > delayed(executor.schedule(
+        new CountingRunnable(&counter, &delayedDone), SHORT_DELAY_MS, TimeUnit::MILLISECONDS));
+    Pointer< ScheduledFuture<bool> > periodic(executor.scheduleAtFixedRate(
+        new CountingRunnable(&counter, &periodicDone), SHORT_DELAY_MS, SHORT_DELAY_MS, TimeUnit::MILLISECONDS));
+
+    executor.shutdown();
+
+    NoOpRunnable noop;
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a RejectedExecutionException",
+        executor.schedule(&noop, 0, TimeUnit::MILLISECONDS, false),
+        RejectedExecutionException);
+
+    // By default the delayed task still runs but the periodic one is canceled.
+    CPPUNIT_ASSERT(periodic->isCancelled());
+    CPPUNIT_ASSERT(executor.awaitTermination(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT_EQUAL(0, delayedDone.getCount());
+    CPPUNIT_ASSERT(delayed->isDone());
+    CPPUNIT_ASSERT(!delayed->isCancelled());
+    CPPUNIT_ASSERT_EQUAL(1, counter.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutorTest::testShutdownNow() {
+
+    ScheduledThreadPoolExecutor executor(1);
+
+    for (int i = 0; i < 5; ++i) {
+        delete executor.schedule(new NoOpRunnable(), LONG_DELAY_MS, TimeUnit::MILLISECONDS);
+    }
+
+    ArrayList<Runnable*> leftovers = executor.shutdownNow();
+    CPPUNIT_ASSERT_EQUAL(5, leftovers.size());
+    CPPUNIT_ASSERT(executor.isShutdown());
+    CPPUNIT_ASSERT(executor.awaitTermination(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+
+    destroyRemaining(leftovers);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ScheduledThreadPoolExecutorTest::testNewScheduledThreadPool() {
+
+    Pointer<ScheduledThreadPoolExecutor> executor(Executors::newScheduledThreadPool(2));
+    AtomicInteger counter;
+    CountDownLatch done(1);
+
+    delete executor->schedule(new CountingRunnable(&counter, &done), 0, TimeUnit::MILLISECONDS);
+    CPPUNIT_ASSERT(done.await(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+
+    joinPool(executor.get());
+}
@@ -0,0 +1,68 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_SCHEDULEDTHREADPOOLEXECUTORTEST_H_
+#define _DECAF_UTIL_CONCURRENT_SCHEDULEDTHREADPOOLEXECUTORTEST_H_
+
+#include <decaf/util/concurrent/ExecutorsTestSupport.h>
+
+namespace decaf {
+namespace util {
+namespace concurrent {
+
+    class ScheduledThreadPoolExecutorTest : public ExecutorsTestSupport {
+
+        CPPUNIT_TEST_SUITE( ScheduledThreadPoolExecutorTest );
+        CPPUNIT_TEST( testConstructor );
+        CPPUNIT_TEST( testExecute );
+        CPPUNIT_TEST( testScheduleCallable );
+        CPPUNIT_TEST( testScheduleRunnable );
+        CPPUNIT_TEST( testScheduleOrder );
+        CPPUNIT_TEST( testScheduleAtFixedRate );
+        CPPUNIT_TEST( testScheduleWithFixedDelay );
+        CPPUNIT_TEST( testPeriodicTaskException );
+        CPPUNIT_TEST( testCancelRemovesTask );
+        CPPUNIT_TEST( testCancelWithoutRemove );
+        CPPUNIT_TEST( testShutdownPolicies );
+        CPPUNIT_TEST( testShutdownNow );
+        CPPUNIT_TEST( testNewScheduledThreadPool );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        ScheduledThreadPoolExecutorTest();
+        virtual ~ScheduledThreadPoolExecutorTest();
+
+        void testConstructor();
+        void testExecute();
+        void testScheduleCallable();
+        void testScheduleRunnable();
+        void testScheduleOrder();
+        void testScheduleAtFixedRate();
+        void testScheduleWithFixedDelay();
+        void testPeriodicTaskException();
+        void testCancelRemovesTask();
+        void testCancelWithoutRemove();
+        void testShutdownPolicies();
+        void testShutdownNow();
+        void testNewScheduledThreadPool();
+
+    };
+
+}}}
+
+#endif /* _DECAF_UTIL_CONCURRENT_SCHEDULEDTHREADPOOLEXECUTORTEST_H_ */
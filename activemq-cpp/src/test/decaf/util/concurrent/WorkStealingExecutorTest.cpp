@@ -0,0 +1,353 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WorkStealingExecutorTest.h"
+
+#include <decaf/lang/Pointer.h>
+#include <decaf/util/concurrent/WorkStealingExecutor.h>
+#include <decaf/util/concurrent/Executors.h>
+#include <decaf/util/concurrent/CountDownLatch.h>
+#include <decaf/util/concurrent/atomic/AtomicInteger.h>
+#include <decaf/lang/exceptions/IllegalArgumentException.h>
+
+using namespace std;
+using namespace decaf;
+using namespace decaf::lang;
+using namespace decaf::lang::exceptions;
+using namespace decaf::util;
+using namespace decaf::util::concurrent;
+using namespace decaf::util::concurrent::atomic;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace {
+
+    class CountingRunnable : public Runnable {
+    private:
+
+        AtomicInteger* counter;
+        CountDownLatch* done;
+
+    private:
+
+        CountingRunnable(const CountingRunnable&);
+        CountingRunnable operator= (const CountingRunnable&);
+
+    public:
+
+        CountingRunnable(AtomicInteger* counter, CountDownLatch* done) :
+            Runnable(), counter(counter), done(done) {
+        }
+
+        virtual ~CountingRunnable() {}
+
+        virtual void run() {
+            this->counter->incrementAndGet();
+            this->done->countDown();
+        }
+    };
+
+    class BlockingRunnable : public Runnable {
+    private:
+
+        CountDownLatch* started;
+        CountDownLatch* release;
+
+    private:
+
+        BlockingRunnable(const BlockingRunnable&);
+        BlockingRunnable operator= (const BlockingRunnable&);
+
+    public:
+
+        BlockingRunnable(CountDownLatch* started, CountDownLatch* release) :
+            Runnable(), started(started), release(release) {
+        }
+
+        virtual ~BlockingRunnable() {}
+
+        virtual void run() {
+            this->started->countDown();
+            this->release->await();
+        }
+    };
+
+    /**
+     * Splits itself in two until it reaches the bottom depth, each leaf counts down.
+     */
+    class SplittingRunnable : public Runnable {
+    private:
+
+        ExecutorService* executor;
+        CountDownLatch* done;
+        int depth;
+
+    private:
+
+        SplittingRunnable(const SplittingRunnable&);
+        SplittingRunnable operator= (const SplittingRunnable&);
+
+    public:
+
+        SplittingRunnable(ExecutorService* executor, CountDownLatch* done, int depth) :
+            Runnable(), executor(executor), done(done), depth(depth) {
+        }
+
+        virtual ~SplittingRunnable() {}
+
+        virtual void run() {
+            if (depth == 0) {
+                this->done->countDown();
+                return;
+            }
+
+            this->executor->execute(new SplittingRunnable(executor, done, depth - 1));
+            this->executor->execute(new SplittingRunnable(executor, done, depth - 1));
+        }
+    };
+
+    /**
+     * Queues tasks on its own worker and then blocks until they have run, so they can
+     * only complete if the other workers steal them.
+     */
+    class ForkingRunnable : public Runnable {
+    private:
+
+        ExecutorService* executor;
+        AtomicInteger* counter;
+        CountDownLatch* done;
+        int count;
+
+    private:
+
+        ForkingRunnable(const ForkingRunnable&);
+        ForkingRunnable operator= (const ForkingRunnable&);
+
+    public:
+
+        ForkingRunnable(ExecutorService* executor, AtomicInteger* counter, CountDownLatch* done, int count) :
+            Runnable(), executor(executor), counter(counter), done(done), count(count) {
+        }
+
+        virtual ~ForkingRunnable() {}
+
+        virtual void run() {
+            for (int i = 0; i < count; ++i) {
+                this->executor->execute(new CountingRunnable(counter, done));
+            }
+
+            this->done->await();
+        }
+    };
+
+    class ResultCallable : public Callable<int> {
+    public:
+
+        ResultCallable() : Callable<int>() {}
+        virtual ~ResultCallable() {}
+
+        virtual int call() {
+            return 42;
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WorkStealingExecutorTest::WorkStealingExecutorTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+WorkStealingExecutorTest::~WorkStealingExecutorTest() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testConstructor() {
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a IllegalArgumentException",
+        WorkStealingExecutor(0),
+        IllegalArgumentException);
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a NullPointerException",
+        WorkStealingExecutor(2, NULL),
+        NullPointerException);
+
+    WorkStealingExecutor executor(3, new SimpleThreadFactory());
+    CPPUNIT_ASSERT_EQUAL(3, executor.getParallelism());
+    CPPUNIT_ASSERT(!executor.isShutdown());
+    CPPUNIT_ASSERT(!executor.isTerminated());
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testExecute() {
+
+    static const int NUM_TASKS = 10000;
+
+    WorkStealingExecutor executor(4);
+    AtomicInteger counter;
+    CountDownLatch done(NUM_TASKS);
+
+    for (int i = 0; i < NUM_TASKS; ++i) {
+        executor.execute(new CountingRunnable(&counter, &done));
+    }
+
+    CPPUNIT_ASSERT(done.await(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT_EQUAL(NUM_TASKS, counter.get());
+    CPPUNIT_ASSERT_EQUAL(0, executor.getQueuedTaskCount());
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testExecuteUnowned() {
+
+    WorkStealingExecutor executor(2);
+    AtomicInteger counter;
+    CountDownLatch done(1);
+    CountingRunnable task(&counter, &done);
+
+    executor.execute(&task, false);
+
+    CPPUNIT_ASSERT(done.await(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT_EQUAL(1, counter.get());
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testExecuteFromWorker() {
+
+    static const int DEPTH = 10;
+
+    WorkStealingExecutor executor(4);
+    CountDownLatch done(1 << DEPTH);
+
+    executor.execute(new SplittingRunnable(&executor, &done, DEPTH));
+
+    CPPUNIT_ASSERT(done.await(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testStealing() {
+
+    static const int NUM_TASKS = 500;
+
+    WorkStealingExecutor executor(3);
+    AtomicInteger counter;
+    CountDownLatch done(NUM_TASKS);
+
+    executor.execute(new ForkingRunnable(&executor, &counter, &done, NUM_TASKS));
+
+    CPPUNIT_ASSERT(done.await(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT_EQUAL(NUM_TASKS, counter.get());
+    CPPUNIT_ASSERT(executor.getStealCount() >= NUM_TASKS);
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testSubmit() {
+
+    WorkStealingExecutor executor(2);
+
+    Pointer< Future<int> > future(executor.submit(new ResultCallable()));
+    CPPUNIT_ASSERT_EQUAL(42, future->get());
+    CPPUNIT_ASSERT(future->isDone());
+
+    joinPool(executor);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testShutdown() {
+
+    WorkStealingExecutor executor(2);
+    AtomicInteger counter;
+    CountDownLatch started(1);
+    CountDownLatch release(1);
+    CountDownLatch done(5);
+
+    executor.execute(new BlockingRunnable(&started, &release));
+    CPPUNIT_ASSERT(started.await(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+
+    for (int i = 0; i < 5; ++i) {
+        executor.execute(new CountingRunnable(&counter, &done));
+    }
+
+    executor.shutdown();
+    CPPUNIT_ASSERT(executor.isShutdown());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a RejectedExecutionException",
+        executor.execute(new NoOpRunnable()),
+        RejectedExecutionException);
+
+    // Tasks queued before the shutdown still run.
+    CPPUNIT_ASSERT(done.await(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT(!executor.isTerminated());
+
+    release.countDown();
+    CPPUNIT_ASSERT(executor.awaitTermination(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT(executor.isTerminated());
+    CPPUNIT_ASSERT_EQUAL(5, counter.get());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testShutdownNow() {
+
+    WorkStealingExecutor executor(1);
+    AtomicInteger counter;
+    CountDownLatch started(1);
+    CountDownLatch release(1);
+    CountDownLatch done(5);
+
+    executor.execute(new BlockingRunnable(&started, &release));
+    CPPUNIT_ASSERT(started.await(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+
+    for (int i = 0; i < 5; ++i) {
+        executor.execute(new CountingRunnable(&counter, &done));
+    }
+
+    ArrayList<Runnable*> leftovers = executor.shutdownNow();
+    CPPUNIT_ASSERT_EQUAL(5, leftovers.size());
+    CPPUNIT_ASSERT(executor.isShutdown());
+
+    release.countDown();
+    CPPUNIT_ASSERT(executor.awaitTermination(LONG_DELAY_MS, TimeUnit::MILLISECONDS));
+    CPPUNIT_ASSERT_EQUAL(0, counter.get());
+
+    destroyRemaining(leftovers);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void WorkStealingExecutorTest::testNewWorkStealingPool() {
+
+    Pointer<ExecutorService> executor(Executors::newWorkStealingPool());
+    CPPUNIT_ASSERT(executor.dynamicCast<WorkStealingExecutor>()->getParallelism() > 0);
+
+    executor->execute(new NoOpRunnable());
+    executor->execute(new NoOpRunnable());
+    joinPool(executor.get());
+
+    CPPUNIT_ASSERT_THROW_MESSAGE(
+        "Should throw a IllegalArgumentException",
+        Executors::newWorkStealingPool(0),
+        IllegalArgumentException);
+}
@@ -0,0 +1,60 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DECAF_UTIL_CONCURRENT_WORKSTEALINGEXECUTORTEST_H_
+#define _DECAF_UTIL_CONCURRENT_WORKSTEALINGEXECUTORTEST_H_
+
+#include <decaf/util/concurrent/ExecutorsTestSupport.h>
+
+namespace decaf {
+namespace util {
+namespace concurrent {
+
+    class WorkStealingExecutorTest : public ExecutorsTestSupport {
+
+        CPPUNIT_TEST_SUITE( WorkStealingExecutorTest );
+        CPPUNIT_TEST( testConstructor );
+        CPPUNIT_TEST( testExecute );
+        CPPUNIT_TEST( testExecuteUnowned );
+        CPPUNIT_TEST( testExecuteFromWorker );
+        CPPUNIT_TEST( testStealing );
+        CPPUNIT_TEST( testSubmit );
+        CPPUNIT_TEST( testShutdown );
+        CPPUNIT_TEST( testShutdownNow );
+        CPPUNIT_TEST( testNewWorkStealingPool );
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+
+        WorkStealingExecutorTest();
+        virtual ~WorkStealingExecutorTest();
+
+        void testConstructor();
+        void testExecute();
+        void testExecuteUnowned();
+        void testExecuteFromWorker();
+        void testStealing();
+        void testSubmit();
+        void testShutdown();
+        void testShutdownNow();
+        void testNewWorkStealingPool();
+
+    };
+
+}}}
+
+#endif /* _DECAF_UTIL_CONCURRENT_WORKSTEALINGEXECUTORTEST_H_ */
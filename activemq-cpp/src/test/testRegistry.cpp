@@ -86,12 +86,18 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQConnectionTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQSessionTest );
 #include <activemq/core/FifoMessageDispatchChannelTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::FifoMessageDispatchChannelTest );
+#include <activemq/core/LockFreeMessageDispatchChannelTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::LockFreeMessageDispatchChannelTest );
 #include <activemq/core/SimplePriorityMessageDispatchChannelTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::SimplePriorityMessageDispatchChannelTest );
+#include <activemq/core/IndexedPriorityMessageDispatchChannelTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::IndexedPriorityMessageDispatchChannelTest );
 #include <activemq/core/ActiveMQMessageAuditTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ActiveMQMessageAuditTest );
 #include <activemq/core/ConnectionAuditTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::ConnectionAuditTest );
+#include <activemq/core/DeliveredMessageListTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::core::DeliveredMessageListTest );
 
 #include <activemq/state/ConnectionStateTrackerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::state::ConnectionStateTrackerTest );
@@ -118,6 +124,12 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::correlator::ResponseCorrel
 #include <activemq/transport/mock/MockTransportFactoryTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::mock::MockTransportFactoryTest );
 
+#include <activemq/transport/async/AsyncWriteTransportTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::async::AsyncWriteTransportTest );
+
+#include <activemq/transport/nio/NioIOTransportTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::nio::NioIOTransportTest );
+
 #include <activemq/transport/inactivity/InactivityMonitorTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::transport::inactivity::InactivityMonitorTest );
 
@@ -163,10 +175,16 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::util::MarshallingSupportTest );
 
 #include <activemq/threads/SchedulerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::SchedulerTest );
+#include <activemq/threads/SchedulerTimerPoolTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::SchedulerTimerPoolTest );
 #include <activemq/threads/DedicatedTaskRunnerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::DedicatedTaskRunnerTest );
 #include <activemq/threads/CompositeTaskRunnerTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::CompositeTaskRunnerTest );
+#include <activemq/threads/PooledTaskRunnerTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::PooledTaskRunnerTest );
+#include <activemq/threads/TaskRunnerFactoryTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( activemq::threads::TaskRunnerFactoryTest );
 
 #include <activemq/wireformat/WireFormatRegistryTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::WireFormatRegistryTest );
@@ -175,6 +193,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( activemq::wireformat::WireFormatRegistryTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::util::ByteArrayAdapterTest );
 #include <decaf/internal/util/TimerTaskHeapTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::util::TimerTaskHeapTest );
+#include <decaf/internal/util/TimerTaskWheelTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::util::TimerTaskWheelTest );
 
 #include <decaf/internal/net/ssl/DefaultSSLSocketFactoryTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::net::ssl::DefaultSSLSocketFactoryTest );
@@ -203,6 +223,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::internal::net::URIHelperTest );
 
 #include <decaf/nio/BufferTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::nio::BufferTest );
+#include <decaf/nio/channels/SelectorTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::nio::channels::SelectorTest );
 
 #include <decaf/io/InputStreamTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::io::InputStreamTest );
@@ -324,6 +346,10 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::FutureTaskTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::AbstractExecutorServiceTest );
 #include <decaf/util/concurrent/ConcurrentHashMapTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::ConcurrentHashMapTest );
+#include <decaf/util/concurrent/WorkStealingExecutorTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::WorkStealingExecutorTest );
+#include <decaf/util/concurrent/ScheduledThreadPoolExecutorTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::ScheduledThreadPoolExecutorTest );
 
 #include <decaf/util/concurrent/atomic/AtomicBooleanTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::concurrent::atomic::AtomicBooleanTest );
@@ -369,6 +395,8 @@ CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::UUIDTest );
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::ListTest );
 #include <decaf/util/LinkedListTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::LinkedListTest );
+#include <decaf/util/ArrayDequeTest.h>
+CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::ArrayDequeTest );
 #include <decaf/util/ArrayListTest.h>
 CPPUNIT_TEST_SUITE_REGISTRATION( decaf::util::ArrayListTest );
 #include <decaf/util/ArraysTest.h>